@@ -1,60 +1,35 @@
-from langchain_community.llms import LlamaCpp
-from langchain_core.callbacks import CallbackManager, StreamingStdOutCallbackHandler
-from langchain.chains import LLMChain
-from langchain.output_parsers import StructuredOutputParser, ResponseSchema
-from langchain.prompts import ChatPromptTemplate
-from llm_manager import LLMManager
+from model_host import get_host
+from reply_grammars import MAX_TOKENS
 import json
-import unreal
+
+# Zephyr chat markup, like the worker's chat prompt. The reply itself is held to reply_grammars' "dimensions".
+DIMENSIONS_PROMPT = (
+    "<|system|>\nYou are a game dimension generator for Minesweeper. Extract the grid dimensions and mine count from "
+    "the request. Beginner is 9 by 9 with 10 mines, intermediate 16 by 16 with 40, expert 16 by 30 with 99.</s>\n"
+    "<|user|>\n{query}</s>\n"
+    "<|assistant|>\n"
+)
 
 class GameDimensionGenerator:
     """Handles querying the LLM to generate Minesweeper dimensions."""
-    
-    def __init__(self):
-        self.llm_manager = LLMManager()
-        self.model_path = self.llm_manager.get_model_path()
-        
-        self.llm = LlamaCpp(
-            model_path=self.model_path,
-            n_gpu_layers=1,
-            n_batch=512,
-            n_ctx=2048,
-            f16_kv=True,
-            callback_manager=CallbackManager([StreamingStdOutCallbackHandler()]),
-            verbose=True,
-        )
-
-        # Define JSON response schema
-        self.response_schemas = [
-            ResponseSchema(name="rows", description="Number of rows in the grid."),
-            ResponseSchema(name="columns", description="Number of columns in the grid."),
-            ResponseSchema(name="mines", description="Number of mines."),
-        ]
-        self.output_parser = StructuredOutputParser.from_response_schemas(self.response_schemas)
-        self.format_instructions = self.output_parser.get_format_instructions()
 
-        # Prompt template
-        self.custom_prompt = ChatPromptTemplate.from_template(
-            f"""You are a game dimension generator for Minesweeper.
-            Extract grid dimensions and mine count.
-            Return only valid JSON with keys: "rows", "columns", "mines".
-            {self.format_instructions}
-            User request: {{input}}
-            Answer:"""
-        )
+    def __init__(self, model_path=None):
+        # The shared host loads the model on first use, constructing a generator is cheap.
+        self.host = get_host(model_path)
 
-        self.chain = LLMChain(llm=self.llm, prompt=self.custom_prompt)
+    @property
+    def llm(self):
+        return self.host.get_llm()
 
     def generate_dimensions(self, query: str) -> dict:
-        """Queries the LLM and returns parsed JSON."""
-        raw_output = self.chain.run({"input": query})
-        try:
-            parsed = self.output_parser.parse(raw_output)
-            return parsed
-        except Exception as e:
-            unreal.log_error(f"Parsing failed: {e}")
-            return {}
+        """Asks the model for {"rows","columns","mines"}. The JSON comes back as "text" and is parsed by the caller.
+
+        The grammar leaves the model no way to answer anything else, so there is nothing to repair or retry here.
+        """
+        return self.host.complete_cached(DIMENSIONS_PROMPT.format(query=query), MAX_TOKENS["dimensions"],
+                                         grammar="dimensions")
 
 if __name__ == "__main__":
     generator = GameDimensionGenerator()
-    print(json.dumps(generator.generate_dimensions("Create an expert level Minesweeper game"), indent=4))
+    reply = generator.generate_dimensions("Create an expert level Minesweeper game")
+    print(json.dumps(json.loads(reply["text"]), indent=4), f"({reply['completion_tokens']} tokens)")
@@ -0,0 +1,244 @@
+"""Long-lived inference worker for the MinesweeperMind editor plugin.
+
+Loads the model once and then answers requests until stdin closes, so the editor no longer pays interpreter startup,
+imports and a model reload per request.
+
+Every message in either direction is one frame: a 4-byte little-endian payload length followed by UTF-8 JSON.
+    request:  {"id": 7, "method": "chat", "params": {"message": "..."}, "stream": true}
+    partial:  {"id": 7, "token": "..."}              (streamed requests only, any number before the response)
+    response: {"id": 7, "result": {...}}  or  {"id": 7, "error": "...", "cancelled": false}
+    cancel:   {"method": "cancel", "params": {"request_id": 7}}   (no response of its own)
+
+generate_dimensions and agent_move answer with {"text", "prompt_tokens", "reused_tokens", "completion_tokens",
+"seconds"}. The text is JSON held to a grammar from reply_grammars and is parsed by the editor. agent_move completes a
+prompt from FMinesweeperPromptEncoder, those only ever grow, so llama.cpp reuses everything it evaluated for the
+previous move and reused_tokens says how much that saved.
+
+Besides the generation methods there are load, unload and model_stats, which the editor's FMinesweeperModelHost uses
+to warm the model up ahead of the first request and to release it under memory pressure. The model is otherwise
+loaded by the first request that needs it.
+
+Requests are answered one at a time in order. Cancels are read while a request runs and stop it at its next token.
+
+Run with --stub to answer without loading a model, which is what client tests and CI use. The stub also answers
+sleep {"seconds"}, which keeps the worker busy so tests can kill it mid-request.
+"""
+import argparse
+import json
+import os
+import queue
+import struct
+import sys
+import threading
+import time
+
+from reply_grammars import MAX_TOKENS
+
+HEADER = struct.Struct("<I")
+MAX_FRAME_BYTES = 16 * 1024 * 1024
+
+CHAT_PROMPT = (
+    "<|system|>\nYou are Minesweeper Mind, a friendly assistant inside a Minesweeper game. Answer briefly.</s>\n"
+    "<|user|>\n{message}</s>\n"
+    "<|assistant|>\n"
+)
+
+
+def read_frame(stream):
+    """Returns the next decoded message, or None once the client has gone away."""
+    header = stream.read(HEADER.size)
+    if len(header) < HEADER.size:
+        return None
+    (length,) = HEADER.unpack(header)
+    if length > MAX_FRAME_BYTES:
+        raise ValueError(f"Frame of {length} bytes is larger than {MAX_FRAME_BYTES}")
+    payload = stream.read(length)
+    if len(payload) < length:
+        return None
+    return json.loads(payload.decode("utf-8"))
+
+
+def write_frame(stream, message):
+    payload = json.dumps(message, separators=(",", ":")).encode("utf-8")
+    stream.write(HEADER.pack(len(payload)) + payload)
+    stream.flush()
+
+
+class StubBackend:
+    """Canned answers with an optional delay, for exercising timeouts and restarts without a model."""
+
+    def __init__(self, delay_seconds):
+        self.delay_seconds = delay_seconds
+        self.loaded = False
+        self.cached_tokens = []
+
+    def load(self):
+        if not self.loaded and self.delay_seconds > 0:
+            time.sleep(self.delay_seconds)
+        self.loaded = True
+        return self.model_stats()
+
+    def unload(self):
+        stats = dict(self.model_stats(), was_loaded=self.loaded)
+        self.loaded = False
+        stats["loaded"] = False
+        return stats
+
+    def model_stats(self):
+        return {"loaded": self.loaded, "load_seconds": self.delay_seconds, "resident_bytes": 0, "num_loads": 0, "num_unloads": 0}
+
+    def generate_dimensions(self, query):
+        if self.delay_seconds > 0:
+            time.sleep(self.delay_seconds)
+        return {"text": '{"rows":16,"columns":30,"mines":99}', "prompt_tokens": len(query.split()), "reused_tokens": 0,
+                "completion_tokens": 15, "seconds": self.delay_seconds}
+
+    def agent_move(self, prompt, max_tokens):
+        # Whitespace-separated words stand in for tokens, enough to exercise the reuse accounting.
+        tokens = prompt.split()
+        reused_tokens = len(os.path.commonprefix([tokens, self.cached_tokens]))
+        text = '{"action":"reveal","row":0,"column":0}'
+        self.cached_tokens = tokens + [text]
+        return {"text": text, "prompt_tokens": len(tokens), "reused_tokens": reused_tokens,
+                "completion_tokens": 15, "seconds": self.delay_seconds}
+
+    def chat(self, message, request):
+        words = f"You said: {message}".split(" ")
+        for index, word in enumerate(words):
+            if self.delay_seconds > 0:
+                time.sleep(self.delay_seconds)
+            request.emit(word if index == 0 else " " + word)
+        return {"text": " ".join(words)}
+
+    def sleep(self, seconds):
+        # Holds the worker busy for as long as a test needs, e.g. to kill it mid-request.
+        time.sleep(seconds)
+        return {"seconds": seconds}
+
+
+class ModelBackend:
+    """The real generator on the worker's shared model host."""
+
+    def __init__(self, model_path):
+        from game_dimension_generator import GameDimensionGenerator
+        self.generator = GameDimensionGenerator(model_path)
+
+    def load(self):
+        return self.generator.host.load()
+
+    def unload(self):
+        return self.generator.host.unload()
+
+    def model_stats(self):
+        return self.generator.host.stats()
+
+    def generate_dimensions(self, query):
+        return self.generator.generate_dimensions(query)
+
+    def agent_move(self, prompt, max_tokens):
+        return self.generator.host.complete_cached(prompt, max_tokens, grammar="move")
+
+    def chat(self, message, request):
+        text = []
+        for token in self.generator.llm.stream(CHAT_PROMPT.format(message=message)):
+            text.append(token)
+            request.emit(token)
+        return {"text": "".join(text)}
+
+
+class Cancelled(Exception):
+    pass
+
+
+class Request:
+    """The request being handled. emit() streams a partial answer and is where cancellation takes effect."""
+
+    def __init__(self, message, output, cancelled_ids):
+        self.id = message.get("id", 0)
+        self.method = message.get("method")
+        self.params = message.get("params") or {}
+        self.stream = bool(message.get("stream"))
+        self.output = output
+        self.cancelled_ids = cancelled_ids
+
+    def check_cancelled(self):
+        if self.id in self.cancelled_ids:
+            raise Cancelled()
+
+    def emit(self, token):
+        self.check_cancelled()
+        if self.stream and token:
+            write_frame(self.output, {"id": self.id, "token": token})
+
+
+def read_requests(stream, requests, cancelled_ids):
+    """Runs on its own thread so cancels arrive while the main thread is busy generating."""
+    try:
+        while True:
+            message = read_frame(stream)
+            if message is None:
+                break
+            if message.get("method") == "cancel":
+                cancelled_ids.add((message.get("params") or {}).get("request_id"))
+            else:
+                requests.put(message)
+    finally:
+        requests.put(None)
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument("--model", help="GGUF model path, defaults to the one LLMManager downloads.")
+    parser.add_argument("--stub", action="store_true", help="Answer with canned results instead of loading a model.")
+    parser.add_argument("--stub-delay", type=float, default=0.0, help="Seconds the stub waits before answering.")
+    args = parser.parse_args()
+
+    # Frames own the real stdout. Everything else that prints, including llama.cpp from native code, goes to stderr
+    # so it can never corrupt the protocol stream.
+    protocol_in = sys.stdin.buffer
+    protocol_out = os.fdopen(os.dup(sys.stdout.fileno()), "wb")
+    os.dup2(sys.stderr.fileno(), sys.stdout.fileno())
+    sys.stdout = sys.stderr
+
+    sys.path.insert(0, os.path.dirname(os.path.abspath(__file__)))
+    backend = StubBackend(args.stub_delay) if args.stub else ModelBackend(args.model)
+
+    handlers = {
+        "ping": lambda request: {"pid": os.getpid()},
+        "load": lambda request: backend.load(),
+        "unload": lambda request: backend.unload(),
+        "model_stats": lambda request: backend.model_stats(),
+        "generate_dimensions": lambda request: backend.generate_dimensions(request.params.get("query", "")),
+        "chat": lambda request: backend.chat(request.params.get("message", ""), request),
+        "agent_move": lambda request: backend.agent_move(request.params.get("prompt", ""),
+                                                         request.params.get("max_tokens", MAX_TOKENS["move"])),
+    }
+    if args.stub:
+        handlers["sleep"] = lambda request: backend.sleep(float(request.params.get("seconds", 0.0)))
+
+    requests = queue.Queue()
+    cancelled_ids = set()
+    threading.Thread(target=read_requests, args=(protocol_in, requests, cancelled_ids), daemon=True).start()
+
+    while True:
+        message = requests.get()
+        if message is None:
+            break
+
+        request = Request(message, protocol_out, cancelled_ids)
+        handler = handlers.get(request.method)
+        try:
+            if handler is None:
+                raise ValueError(f"Unknown method {request.method!r}")
+            request.check_cancelled()
+            write_frame(protocol_out, {"id": request.id, "result": handler(request)})
+        except Cancelled:
+            write_frame(protocol_out, {"id": request.id, "error": "Cancelled", "cancelled": True})
+        except Exception as e:
+            write_frame(protocol_out, {"id": request.id, "error": str(e)})
+        finally:
+            cancelled_ids.discard(request.id)
+
+
+if __name__ == "__main__":
+    main()
@@ -1,7 +1,89 @@
 import os
+import sys
+import json
 import hashlib
 import requests
-import unreal
+
+try:
+    import unreal
+except ImportError:
+    # Imported by the standalone inference worker, outside the editor.
+    unreal = None
+
+
+def _log(message):
+    if unreal:
+        unreal.log(message)
+    else:
+        print(message, file=sys.stderr)
+
+
+def _log_error(message):
+    if unreal:
+        unreal.log_error(message)
+    else:
+        print(message, file=sys.stderr)
+
+# Read size for hashing, the model never has to fit in memory.
+BLOCK_BYTES = 1024 * 1024
+# Small enough that a dropped connection loses little of what already arrived.
+DOWNLOAD_BLOCK_BYTES = 64 * 1024
+
+
+def hash_file(path):
+    """SHA-256 of a file as lowercase hex."""
+    sha256 = hashlib.sha256()
+    with open(path, "rb") as f:
+        for block in iter(lambda: f.read(BLOCK_BYTES), b""):
+            sha256.update(block)
+    return sha256.hexdigest()
+
+
+def stamp_path(model_path):
+    """Written next to a verified model. FMinesweeperModelAssets reads and writes the same file."""
+    return model_path + ".verified.json"
+
+
+def has_valid_stamp(model_path, expected_sha256):
+    """Whether the model was verified and has not changed since, without hashing it."""
+    try:
+        with open(stamp_path(model_path)) as f:
+            stamp = json.load(f)
+        stat = os.stat(model_path)
+    except (OSError, ValueError):
+        return False
+    return (str(stamp.get("sha256", "")).lower() == expected_sha256.lower()
+            and stamp.get("size") == stat.st_size
+            and stamp.get("modified") == int(stat.st_mtime))
+
+
+def write_stamp(model_path, sha256):
+    stat = os.stat(model_path)
+    with open(stamp_path(model_path), "w") as f:
+        json.dump({"size": stat.st_size, "modified": int(stat.st_mtime), "sha256": sha256}, f)
+
+
+def download_resumable(url, target_path):
+    """Downloads url to target_path + ".part" and returns that path.
+
+    Bytes left by an interrupted download are kept and only the rest is requested, servers that ignore the Range header
+    send the whole file again.
+    """
+    part_path = target_path + ".part"
+    offset = os.path.getsize(part_path) if os.path.exists(part_path) else 0
+    headers = {"Range": f"bytes={offset}-"} if offset else {}
+    with requests.get(url, stream=True, headers=headers, timeout=60) as response:
+        response.raise_for_status()
+        if offset and (response.status_code != 206
+                       or not response.headers.get("Content-Range", "").startswith(f"bytes {offset}-")):
+            offset = 0
+        if offset:
+            _log(f"Resuming download at {offset} bytes.")
+        with open(part_path, "ab" if offset else "wb") as f:
+            for chunk in response.iter_content(chunk_size=DOWNLOAD_BLOCK_BYTES):
+                f.write(chunk)
+    return part_path
+
 
 class LLMManager:
     """Handles LLM Model Setup, Download, and Management."""
@@ -11,42 +93,51 @@ class LLMManager:
     EXPECTED_SHA256 = "9fecc3b3cd76bba89d504f29b616eedf7da85b96540e490ca5824d3f7d2776a0"
 
     def __init__(self, plugin_name="MinesweeperMind"):
-        self.plugin_root = os.path.join(unreal.Paths.project_plugins_dir(), plugin_name)
+        if unreal:
+            self.plugin_root = os.path.join(unreal.Paths.project_plugins_dir(), plugin_name)
+        else:
+            # Content/Scripts/llm_manager.py -> plugin root.
+            self.plugin_root = os.path.dirname(os.path.dirname(os.path.dirname(os.path.abspath(__file__))))
         self.models_dir = os.path.join(self.plugin_root, "Content", "LargeLanguageModels")
 
         if not os.path.exists(self.models_dir):
             os.makedirs(self.models_dir)
-            unreal.log(f"Created models directory: {self.models_dir}")
+            _log(f"Created models directory: {self.models_dir}")
 
         self.model_path = os.path.join(self.models_dir, self.TARGET_FILENAME)
         self.ensure_model_exists()
 
     def ensure_model_exists(self):
-        """Ensures that the LLM model file exists and is verified."""
+        """Ensures that the LLM model file exists and is verified. A verified model is stamped and not hashed again."""
         if os.path.exists(self.model_path):
-            unreal.log(f"Model file already exists: {self.model_path}")
-            return
-        
-        unreal.log(f"Downloading LLM model from {self.MODEL_URL}...")
+            if has_valid_stamp(self.model_path, self.EXPECTED_SHA256):
+                return
+            _log(f"Verifying {self.model_path}...")
+            computed_hash = hash_file(self.model_path)
+            if computed_hash == self.EXPECTED_SHA256.lower():
+                write_stamp(self.model_path, computed_hash)
+                _log("SHA256 verification successful.")
+                return
+            _log_error("SHA256 mismatch! Existing model is corrupted, downloading it again.")
+            os.remove(self.model_path)
+
+        _log(f"Downloading LLM model from {self.MODEL_URL}...")
         try:
-            with requests.get(self.MODEL_URL, stream=True) as response:
-                response.raise_for_status()
-                with open(self.model_path, "wb") as f:
-                    for chunk in response.iter_content(chunk_size=8192):
-                        f.write(chunk)
-            unreal.log("Download complete.")
+            part_path = download_resumable(self.MODEL_URL, self.model_path)
+            _log("Download complete.")
         except Exception as e:
-            unreal.log_error(f"Model download failed: {e}")
+            # The partial file stays for the next attempt to resume.
+            _log_error(f"Model download failed: {e}")
             return
-        
-        # Verify SHA256 hash
-        with open(self.model_path, "rb") as f:
-            computed_hash = hashlib.sha256(f.read()).hexdigest()
-        if computed_hash.lower() != self.EXPECTED_SHA256.lower():
-            unreal.log_error("SHA256 mismatch! Downloaded model is corrupted.")
-            os.remove(self.model_path)
+
+        computed_hash = hash_file(part_path)
+        if computed_hash != self.EXPECTED_SHA256.lower():
+            _log_error("SHA256 mismatch! Downloaded model is corrupted.")
+            os.remove(part_path)
             return
-        unreal.log("SHA256 verification successful.")
+        os.replace(part_path, self.model_path)
+        write_stamp(self.model_path, computed_hash)
+        _log("SHA256 verification successful.")
 
     def get_model_path(self):
         """Returns the LLM model path."""
@@ -0,0 +1,141 @@
+"""The one LlamaCpp instance every MinesweeperMind script shares.
+
+The model is loaded on first use rather than at import, and the weights are memory-mapped, so the OS can share the
+pages between processes and drop them under memory pressure without writing them to swap. The inference worker
+exposes load(), unload() and stats() to the editor, which decides when to warm up and when to evict.
+"""
+import gc
+import os
+import threading
+import time
+
+from llm_manager import LLMManager, _log
+
+# Shared by every caller, the prompts they use fit comfortably.
+LLM_SETTINGS = dict(
+    n_gpu_layers=1,
+    n_batch=512,
+    n_ctx=2048,
+    f16_kv=True,
+    use_mmap=True,
+    verbose=False,
+)
+
+
+def resident_bytes():
+    """Resident set size of this process, or 0 when the platform does not tell us cheaply."""
+    try:
+        import psutil
+        return psutil.Process(os.getpid()).memory_info().rss
+    except ImportError:
+        pass
+    try:
+        with open("/proc/self/statm") as statm:
+            return int(statm.read().split()[1]) * os.sysconf("SC_PAGE_SIZE")
+    except (OSError, ValueError, AttributeError):
+        return 0
+
+
+class ModelHost:
+    """Loads the model once and hands the same instance to every caller until it is unloaded."""
+
+    def __init__(self, model_path=None):
+        self.model_path = model_path
+        self.lock = threading.Lock()
+        self.llm = None
+        # Tokens in llama.cpp's context after the last complete_cached(), which it keeps evaluated.
+        self.cached_tokens = []
+        self.load_seconds = 0.0
+        self.num_loads = 0
+        self.num_unloads = 0
+
+    def get_llm(self):
+        """The shared model, loading it if needed. Blocks while another thread is loading it."""
+        with self.lock:
+            if self.llm is None:
+                self._load()
+            return self.llm
+
+    def load(self):
+        self.get_llm()
+        return self.stats()
+
+    def unload(self):
+        """Releases the model. The next get_llm() loads it again."""
+        with self.lock:
+            was_loaded = self.llm is not None
+            if was_loaded:
+                self.llm = None
+                self.cached_tokens = []
+                self.num_unloads += 1
+                gc.collect()
+        stats = self.stats()
+        stats["was_loaded"] = was_loaded
+        return stats
+
+    def complete_cached(self, prompt, max_tokens, stop=None, grammar=None):
+        """Completes prompt, reporting how much of it llama.cpp could reuse from the previous call.
+
+        llama.cpp keeps the tokens it evaluated last and only evaluates the part of a new prompt after the longest
+        common prefix. Prompts that extend the previous one, answer included, cost only their new tokens. grammar
+        names one of reply_grammars.GRAMMARS to constrain the answer to, and generation stops where it ends.
+        """
+        from reply_grammars import get_grammar
+
+        llm = self.get_llm()
+        client = llm.client
+        tokens = client.tokenize(prompt.encode("utf-8"))
+        reused_tokens = len(os.path.commonprefix([tokens, self.cached_tokens]))
+
+        start = time.perf_counter()
+        completion = client.create_completion(prompt, max_tokens=max_tokens, temperature=0.0, stop=stop,
+                                              grammar=get_grammar(grammar) if grammar else None)
+        seconds = time.perf_counter() - start
+
+        text = completion["choices"][0]["text"]
+        completion_tokens = completion.get("usage", {}).get("completion_tokens", 0)
+        evaluated = getattr(client, "_input_ids", None)
+        self.cached_tokens = list(evaluated) if evaluated is not None else tokens
+        return {
+            "text": text,
+            "prompt_tokens": len(tokens),
+            "reused_tokens": reused_tokens,
+            "completion_tokens": completion_tokens,
+            "seconds": seconds,
+        }
+
+    def stats(self):
+        return {
+            "loaded": self.llm is not None,
+            "load_seconds": self.load_seconds,
+            "resident_bytes": resident_bytes(),
+            "num_loads": self.num_loads,
+            "num_unloads": self.num_unloads,
+        }
+
+    def _load(self):
+        from langchain_community.llms import LlamaCpp
+
+        model_path = self.model_path or LLMManager().get_model_path()
+        start = time.perf_counter()
+        self.llm = LlamaCpp(model_path=model_path, **LLM_SETTINGS)
+        self.load_seconds = time.perf_counter() - start
+        self.num_loads += 1
+        _log(f"Loaded {model_path} in {self.load_seconds:.2f} s, {resident_bytes() / (1024 * 1024):.0f} MB resident")
+
+
+_host = None
+_host_lock = threading.Lock()
+
+
+def get_host(model_path=None):
+    """The process-wide host. The model path only matters to the first caller."""
+    global _host
+    with _host_lock:
+        if _host is None:
+            _host = ModelHost(model_path)
+        return _host
+
+
+def get_llm():
+    return get_host().get_llm()
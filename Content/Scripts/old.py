@@ -1,5 +1,6 @@
 import os
 import hashlib
+import json
 import requests
 import unreal
 
@@ -56,8 +57,11 @@ def download_model_if_missing(model_url, target_path, expected_sha256=None):
 
     # Verify file hash if an expected hash is provided.
     if expected_sha256:
+        sha256 = hashlib.sha256()
         with open(target_path, "rb") as f:
-            computed_hash = hashlib.sha256(f.read()).hexdigest()
+            for block in iter(lambda: f.read(1024 * 1024), b""):
+                sha256.update(block)
+        computed_hash = sha256.hexdigest()
 
         if computed_hash.lower() != expected_sha256.lower():
             unreal.log_error(f"SHA256 mismatch! Expected {expected_sha256.lower()}, but got {computed_hash.lower()}.")
@@ -117,62 +121,24 @@ else:
     unreal.log("Using model file at: {}".format(model_file_path))
 
 # --------------------------------------------------------------------------
-# Set up the LLM using LlamaCpp
-from langchain_community.llms import LlamaCpp
-from langchain_core.callbacks import CallbackManager, StreamingStdOutCallbackHandler
-
-GLOBAL_LLM = LlamaCpp(
-    model_path=model_file_path,
-    n_gpu_layers=1,
-    n_batch=512,
-    n_ctx=2048,
-    f16_kv=True,
-    callback_manager=CallbackManager([StreamingStdOutCallbackHandler()]),
-    verbose=True,
-)
+# The LLM is the instance shared through model_host, loaded on the first request.
+from model_host import get_host
+
+get_host(model_file_path)
 
 # --------------------------------------------------------------------------
-# Use an LLMChain to generate game dimensions based on a user's request.
-from langchain.chains import LLMChain
-from langchain.output_parsers import StructuredOutputParser, ResponseSchema
-from langchain.prompts import ChatPromptTemplate
-
-# Define the expected JSON output schema.
-response_schemas = [
-    ResponseSchema(name="rows", description="Number of rows in the Minesweeper grid."),
-    ResponseSchema(name="columns", description="Number of columns in the Minesweeper grid."),
-    ResponseSchema(name="mine_count", description="Number of mines to place on the grid."),
-]
-output_parser = StructuredOutputParser.from_response_schemas(response_schemas)
-format_instructions = output_parser.get_format_instructions()
-
-# Escape curly braces in format_instructions so they are treated literally.
-escaped_format_instructions = format_instructions.replace("{", "{{").replace("}", "}}")
-
-# Create a custom prompt that instructs the LLM to output strictly JSON with the required keys.
-custom_prompt = ChatPromptTemplate.from_template(
-    f"""You are a game dimension generator for Minesweeper.
-Based on the user's request, extract the grid dimensions and mine count.
-Your output must be a valid JSON object with exactly three keys: "rows", "columns", and "mines" (not "mine_count").
-Do not include any additional text.
-{escaped_format_instructions}
-
-User request: {{input}}
-Answer:"""
-)
-
-# Create the LLMChain
-chain = LLMChain(llm=GLOBAL_LLM, prompt=custom_prompt)
+# Generate game dimensions from a user's request. The reply is held to the "dimensions" grammar, so it is always
+# {"rows","columns","mines"} and needs no parser or key renaming afterwards.
+from game_dimension_generator import DIMENSIONS_PROMPT
+from reply_grammars import MAX_TOKENS
 
 def get_game_dimensions(query: str) -> dict:
-    raw_output = chain.run({"input": query})
+    reply = get_host().complete_cached(DIMENSIONS_PROMPT.format(query=query), MAX_TOKENS["dimensions"],
+                                       grammar="dimensions")
     try:
-        parsed = output_parser.parse(raw_output)
-        # Normalize the output by renaming 'mine_count' to 'mines'
-        if "mine_count" in parsed:
-            parsed["mines"] = parsed.pop("mine_count")
-        return parsed
-    except Exception as e:
+        return json.loads(reply["text"])
+    except ValueError as e:
+        # Only a reply cut off by the token limit can get here.
         unreal.log_error(f"Error parsing output: {e}")
         return {}
 
@@ -0,0 +1,93 @@
+"""Local stand-in for the model host, for trying out resumed downloads without touching the network.
+
+Serves the files of a directory with HEAD and single-range GET support, the way Hugging Face and most CDNs do.
+--drop-after cuts every GET off after that many body bytes, so a client has to resume to finish. --no-ranges serves
+whole files only, like a server that cannot resume.
+
+    python range_file_server.py <directory> [--port 8765] [--drop-after BYTES] [--no-ranges]
+
+Point MinesweeperMind.Model.Url or LLMManager.MODEL_URL at http://127.0.0.1:8765/<file>. --port 0 picks a free port,
+the first line printed says which.
+"""
+import argparse
+import functools
+import os
+import re
+from http.server import BaseHTTPRequestHandler, ThreadingHTTPServer
+
+RANGE_PATTERN = re.compile(r"bytes=(\d+)-(\d*)$")
+
+
+class RangeRequestHandler(BaseHTTPRequestHandler):
+    def __init__(self, *args, directory, drop_after, ranges, **kwargs):
+        self.directory = directory
+        self.drop_after = drop_after
+        self.ranges = ranges
+        super().__init__(*args, **kwargs)
+
+    def do_HEAD(self):
+        self.respond(send_body=False)
+
+    def do_GET(self):
+        self.respond(send_body=True)
+
+    def respond(self, send_body):
+        path = os.path.join(self.directory, os.path.basename(self.path.split("?")[0]))
+        if not os.path.isfile(path):
+            self.send_error(404)
+            return
+
+        size = os.path.getsize(path)
+        start, end = 0, size - 1
+        match = RANGE_PATTERN.match(self.headers.get("Range", "")) if self.ranges else None
+        if match:
+            start = int(match.group(1))
+            end = min(int(match.group(2)), size - 1) if match.group(2) else size - 1
+            if start > end:
+                self.send_response(416)
+                self.send_header("Content-Range", f"bytes */{size}")
+                self.end_headers()
+                return
+            self.send_response(206)
+            self.send_header("Content-Range", f"bytes {start}-{end}/{size}")
+        else:
+            self.send_response(200)
+        if self.ranges:
+            self.send_header("Accept-Ranges", "bytes")
+        self.send_header("Content-Length", str(end - start + 1))
+        self.end_headers()
+
+        if not send_body:
+            return
+        remaining = end - start + 1
+        if self.drop_after is not None:
+            remaining = min(remaining, self.drop_after)
+        with open(path, "rb") as f:
+            f.seek(start)
+            while remaining > 0:
+                block = f.read(min(remaining, 64 * 1024))
+                if not block:
+                    break
+                self.wfile.write(block)
+                remaining -= len(block)
+        # A truncated body is only noticed when the connection closes.
+        self.close_connection = True
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument("directory")
+    parser.add_argument("--port", type=int, default=8765)
+    parser.add_argument("--drop-after", type=int, help="Close every GET after this many body bytes.")
+    parser.add_argument("--no-ranges", action="store_true", help="Ignore Range headers and do not advertise them.")
+    args = parser.parse_args()
+
+    handler = functools.partial(RangeRequestHandler, directory=os.path.abspath(args.directory),
+                                drop_after=args.drop_after, ranges=not args.no_ranges)
+    server = ThreadingHTTPServer(("127.0.0.1", args.port), handler)
+    print(f"Serving {args.directory} on http://127.0.0.1:{server.server_address[1]}/", flush=True)
+    server.serve_forever()
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,38 @@
+"""GBNF grammars for the replies the editor parses, so llama.cpp can only sample valid, compact JSON.
+
+Generation ends where the grammar does, at the closing brace, with no prose before or after and no key the C++ side
+does not read. FMinesweeperDimensionReply and FMinesweeperMoveReply parse these exact shapes.
+"""
+import threading
+
+GRAMMARS = {
+    # {"rows":16,"columns":30,"mines":99}, counts 1 to 99999 as FMinesweeperDimensionReply::MaxCount.
+    "dimensions": r'''
+root  ::= "{\"rows\":" count ",\"columns\":" count ",\"mines\":" count "}"
+count ::= [1-9] [0-9]? [0-9]? [0-9]? [0-9]?
+''',
+    # {"action":"reveal","row":3,"column":4}, indices 0 to 9999 as FMinesweeperMoveReply::MaxIndex.
+    "move": r'''
+root   ::= "{\"action\":\"" action "\",\"row\":" index ",\"column\":" index "}"
+action ::= "reveal" | "flag" | "chord"
+index  ::= "0" | [1-9] [0-9]? [0-9]? [0-9]?
+''',
+}
+
+# Longest reply each grammar allows, in tokens, with some room for a tokenizer that splits digits.
+MAX_TOKENS = {
+    "dimensions": 32,
+    "move": 32,
+}
+
+_compiled = {}
+_lock = threading.Lock()
+
+
+def get_grammar(name):
+    """Compiled grammar by name, parsed once per process."""
+    with _lock:
+        if name not in _compiled:
+            from llama_cpp import LlamaGrammar
+            _compiled[name] = LlamaGrammar.from_string(GRAMMARS[name], verbose=False)
+        return _compiled[name]
@@ -17,6 +17,7 @@ public class MinesweeperMind : ModuleRules
 		
 		PrivateIncludePaths.AddRange(
 			new string[] {
+                "MinesweeperMind/Private/Commandlets",
                 "MinesweeperMind/Private/Core",
                 "MinesweeperMind/Private/UI",
                 "MinesweeperMind/Private/Widgets"
@@ -40,7 +41,9 @@ public class MinesweeperMind : ModuleRules
 				"Engine",
 				"Slate",
 				"SlateCore",
+				"HTTP",
 				"InputCore",
+				"Json",
 				"Projects",
 				"PythonScriptPlugin",
 				"ToolMenus",
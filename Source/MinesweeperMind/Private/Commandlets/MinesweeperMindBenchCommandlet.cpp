@@ -0,0 +1,83 @@
+#include "MinesweeperMindBenchCommandlet.h"
+
+#include "Core/MinesweeperSimulation.h"
+#include "HAL/FileManager.h"
+#include "Misc/DateTime.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Parse.h"
+#include "Misc/Paths.h"
+
+UMinesweeperMindBenchCommandlet::UMinesweeperMindBenchCommandlet()
+{
+    IsClient = false;
+    IsServer = false;
+    IsEditor = true;
+    LogToConsole = true;
+}
+
+int32 UMinesweeperMindBenchCommandlet::Main(const FString& Params)
+{
+    FMinesweeperSimulationSettings Settings;
+    FParse::Value(*Params, TEXT("Games="), Settings.NumGames);
+    FParse::Value(*Params, TEXT("Rows="), Settings.NumRows);
+    FParse::Value(*Params, TEXT("Columns="), Settings.NumColumns);
+    FParse::Value(*Params, TEXT("Density="), Settings.MineDensity);
+    FParse::Value(*Params, TEXT("Seed="), Settings.BaseSeed);
+    Settings.bNoGuess = FParse::Param(*Params, TEXT("NoGuess"));
+    Settings.bParallel = !FParse::Param(*Params, TEXT("SingleThread"));
+    Settings.bDeterministic = FParse::Param(*Params, TEXT("Deterministic"));
+    FParse::Value(*Params, TEXT("FailureSnapshots="), Settings.FailureSnapshotDir);
+
+    FString PolicyName = TEXT("Solver");
+    FParse::Value(*Params, TEXT("Policy="), PolicyName);
+    if (!FMinesweeperSimulation::CreatePolicy(PolicyName, 0).IsValid())
+    {
+        UE_LOG(LogTemp, Error, TEXT("Unknown policy '%s', expected Solver, Random or Agent."), *PolicyName);
+        return 1;
+    }
+    // Every agent game talks to the one worker, interleaving them would only throw away its prompt cache.
+    Settings.bParallel &= !PolicyName.Equals(TEXT("Agent"), ESearchCase::IgnoreCase);
+
+    if (Settings.NumGames <= 0 || Settings.NumRows <= 0 || Settings.NumColumns <= 0 || Settings.MineDensity <= 0.f || Settings.MineDensity >= 1.f)
+    {
+        UE_LOG(LogTemp, Error, TEXT("Invalid settings: %d games of %dx%d at density %.3f."), Settings.NumGames, Settings.NumRows, Settings.NumColumns, Settings.MineDensity);
+        return 1;
+    }
+
+    UE_LOG(LogTemp, Display, TEXT("Playing %d games of %dx%d at density %.3f with the %s policy..."),
+        Settings.NumGames, Settings.NumRows, Settings.NumColumns, Settings.MineDensity, *PolicyName);
+
+    const bool bDeterministic = Settings.bDeterministic;
+    const FMinesweeperSimulationReport Report = FMinesweeperSimulation::Run(Settings, PolicyName, [PolicyName, bDeterministic](uint64 GameSeed)
+    {
+        return FMinesweeperSimulation::CreatePolicy(PolicyName, GameSeed, bDeterministic);
+    });
+
+    UE_LOG(LogTemp, Display, TEXT("%.1f games/s, %.0f moves/s, move p50 %.2f us, p99 %.2f us, win rate %.1f%%, peak memory %.1f MB"),
+        Report.GamesPerSecond, Report.MovesPerSecond, Report.MoveMicrosecondsP50, Report.MoveMicrosecondsP99,
+        Report.GetWinRate() * 100.0, Report.PeakUsedPhysicalBytes / (1024.0 * 1024.0));
+    if (Report.NumNoGuessFailures > 0)
+    {
+        UE_LOG(LogTemp, Warning, TEXT("%d of %d boards were not proven guess-free in time and may need a guess."),
+            Report.NumNoGuessFailures, Report.NumGames);
+    }
+
+    FString OutputPath;
+    if (!FParse::Value(*Params, TEXT("Output="), OutputPath))
+    {
+        OutputPath = FPaths::ProjectSavedDir() / TEXT("MinesweeperMind") / FString::Printf(TEXT("Bench-%s.json"), *FDateTime::Now().ToString());
+    }
+
+    if (!FFileHelper::SaveStringToFile(Report.ToJson(), *OutputPath))
+    {
+        UE_LOG(LogTemp, Error, TEXT("Failed to write %s"), *OutputPath);
+        return 1;
+    }
+
+    UE_LOG(LogTemp, Display, TEXT("Report written to %s"), *IFileManager::Get().ConvertToAbsolutePathForExternalAppForWrite(*OutputPath));
+    if (!Settings.FailureSnapshotDir.IsEmpty())
+    {
+        UE_LOG(LogTemp, Display, TEXT("Lost games written to %s, replay one with MinesweeperMind.Snapshot.Replay"), *Settings.FailureSnapshotDir);
+    }
+    return 0;
+}
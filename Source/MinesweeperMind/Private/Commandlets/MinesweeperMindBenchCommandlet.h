@@ -0,0 +1,24 @@
+#pragma once
+
+#include "Commandlets/Commandlet.h"
+#include "MinesweeperMindBenchCommandlet.generated.h"
+
+/**
+ * Plays seeded games headlessly and writes a JSON report, so builds can be compared without clicking through the window.
+ *
+ * UnrealEditor-Cmd <Project> -run=MinesweeperMindBench -nullrhi [-Games=1000] [-Rows=16] [-Columns=30] [-Density=0.20625]
+ *     [-Seed=1] [-Policy=Solver|Random|Agent] [-NoGuess] [-SingleThread] [-Deterministic] [-Output=<path>]
+ *     [-FailureSnapshots=<dir>]
+ */
+UCLASS()
+class UMinesweeperMindBenchCommandlet : public UCommandlet
+{
+	GENERATED_BODY()
+
+public:
+	UMinesweeperMindBenchCommandlet();
+
+	//~ Begin UCommandlet Interface
+	virtual int32 Main(const FString& Params) override;
+	//~ End UCommandlet Interface
+};
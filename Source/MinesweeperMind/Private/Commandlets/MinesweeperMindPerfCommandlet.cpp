@@ -0,0 +1,65 @@
+#include "MinesweeperMindPerfCommandlet.h"
+
+#include "MinesweeperPerfSuite.h"
+#include "HAL/FileManager.h"
+#include "Misc/Parse.h"
+
+UMinesweeperMindPerfCommandlet::UMinesweeperMindPerfCommandlet()
+{
+    IsClient = false;
+    IsServer = false;
+    IsEditor = true;
+    LogToConsole = true;
+}
+
+int32 UMinesweeperMindPerfCommandlet::Main(const FString& Params)
+{
+    int32 NumRepeats = FMinesweeperPerfSuite::DefaultNumRepeats;
+    double TolerancePercent = FMinesweeperPerfSuite::GetTolerancePercent();
+    FString BaselinePath = FMinesweeperPerfSuite::GetDefaultBaselinePath();
+    FParse::Value(*Params, TEXT("Repeats="), NumRepeats);
+    FParse::Value(*Params, TEXT("Tolerance="), TolerancePercent);
+    FParse::Value(*Params, TEXT("Baseline="), BaselinePath);
+
+    if (BaselinePath.IsEmpty())
+    {
+        UE_LOG(LogTemp, Error, TEXT("No baseline path, pass -Baseline=<path>."));
+        return 1;
+    }
+
+    UE_LOG(LogTemp, Display, TEXT("Running board micro-benchmarks, %d repeats each..."), NumRepeats);
+    const TArray<FMinesweeperPerfResult> Results = FMinesweeperPerfSuite::Run(NumRepeats);
+
+    if (FParse::Param(*Params, TEXT("UpdateBaseline")))
+    {
+        if (!FMinesweeperPerfSuite::SaveBaseline(BaselinePath, Results))
+        {
+            UE_LOG(LogTemp, Error, TEXT("Failed to write %s"), *BaselinePath);
+            return 1;
+        }
+        UE_LOG(LogTemp, Display, TEXT("Baseline written to %s"), *IFileManager::Get().ConvertToAbsolutePathForExternalAppForWrite(*BaselinePath));
+        return 0;
+    }
+
+    TMap<FString, double> Baseline;
+    FString Machine;
+    if (!FMinesweeperPerfSuite::LoadBaseline(BaselinePath, Baseline, &Machine))
+    {
+        UE_LOG(LogTemp, Error, TEXT("Failed to read baseline %s, run with -UpdateBaseline on the reference machine to create it."), *BaselinePath);
+        return 1;
+    }
+    if (Machine != FMinesweeperPerfSuite::GetMachineName())
+    {
+        UE_LOG(LogTemp, Warning, TEXT("Baseline was measured on '%s', this is '%s'. Timings may not be comparable."), *Machine, *FMinesweeperPerfSuite::GetMachineName());
+    }
+
+    const int32 NumRegressions = FMinesweeperPerfSuite::CompareToBaseline(Results, Baseline, TolerancePercent);
+    if (NumRegressions > 0)
+    {
+        UE_LOG(LogTemp, Error, TEXT("%d of %d benchmarks regressed by more than %.1f%%."), NumRegressions, Results.Num(), TolerancePercent);
+        return 1;
+    }
+
+    UE_LOG(LogTemp, Display, TEXT("All %d benchmarks within %.1f%% of the baseline."), Results.Num(), TolerancePercent);
+    return 0;
+}
@@ -0,0 +1,24 @@
+#pragma once
+
+#include "Commandlets/Commandlet.h"
+#include "MinesweeperMindPerfCommandlet.generated.h"
+
+/**
+ * Runs every MinesweeperMind.Perf benchmark in one go for CI, failing when any of them is slower than the baseline by
+ * more than the tolerance. -UpdateBaseline writes the baseline instead, run it on the reference machine to create it
+ * and after intended changes. -Tolerance defaults to MinesweeperMind.Perf.TolerancePercent.
+ *
+ * UnrealEditor-Cmd <Project> -run=MinesweeperMindPerf -nullrhi [-Repeats=51] [-Tolerance=15] [-Baseline=<path>] [-UpdateBaseline]
+ */
+UCLASS()
+class UMinesweeperMindPerfCommandlet : public UCommandlet
+{
+	GENERATED_BODY()
+
+public:
+	UMinesweeperMindPerfCommandlet();
+
+	//~ Begin UCommandlet Interface
+	virtual int32 Main(const FString& Params) override;
+	//~ End UCommandlet Interface
+};
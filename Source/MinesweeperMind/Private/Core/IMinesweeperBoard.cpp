@@ -0,0 +1,87 @@
+#include "Core/IMinesweeperBoard.h"
+
+bool IMinesweeperBoard::ApplyMove(const FMinesweeperMove& Move, TArray<FIntPoint>& OutRevealed)
+{
+    OutRevealed.Reset();
+
+    const int32 Row = Move.Cell.X;
+    const int32 Column = Move.Cell.Y;
+    if (IsGameOver() || !IsValidCell(Row, Column))
+    {
+        return false;
+    }
+
+    switch (Move.Type)
+    {
+    case EMinesweeperMoveType::Reveal:
+        return Reveal(Row, Column, OutRevealed) != EMinesweeperRevealResult::Ignored;
+
+    case EMinesweeperMoveType::Flag:
+        return ToggleFlag(Row, Column);
+
+    case EMinesweeperMoveType::Chord:
+        {
+            if (!CanChord(Row, Column))
+            {
+                return false;
+            }
+
+            TArray<FIntPoint> Scratch;
+            for (int32 NeighborRow = Row - 1; NeighborRow <= Row + 1 && !IsGameOver(); ++NeighborRow)
+            {
+                for (int32 NeighborCol = Column - 1; NeighborCol <= Column + 1 && !IsGameOver(); ++NeighborCol)
+                {
+                    if (IsValidCell(NeighborRow, NeighborCol) && !IsFlagged(NeighborRow, NeighborCol)
+                        && Reveal(NeighborRow, NeighborCol, Scratch) != EMinesweeperRevealResult::Ignored)
+                    {
+                        OutRevealed.Append(Scratch);
+                    }
+                }
+            }
+            return !OutRevealed.IsEmpty();
+        }
+    }
+
+    return false;
+}
+
+void IMinesweeperBoard::ApplyMoves(TArrayView<const FMinesweeperMove> Moves, FMinesweeperChangeSet& OutChanges)
+{
+    OutChanges.Reset();
+
+    TArray<FIntPoint> Revealed;
+    for (const FMinesweeperMove& Move : Moves)
+    {
+        if (IsGameOver())
+        {
+            break;
+        }
+
+        if (ApplyMove(Move, Revealed))
+        {
+            if (Move.Type == EMinesweeperMoveType::Flag)
+            {
+                OutChanges.Flagged.Add(Move.Cell);
+            }
+            OutChanges.Revealed.Append(Revealed);
+        }
+    }
+}
+
+bool IMinesweeperBoard::CanChord(int32 Row, int32 Column) const
+{
+    if (!IsValidCell(Row, Column) || !IsRevealed(Row, Column))
+    {
+        return false;
+    }
+
+    int32 NumFlags = 0;
+    for (int32 NeighborRow = Row - 1; NeighborRow <= Row + 1; ++NeighborRow)
+    {
+        for (int32 NeighborCol = Column - 1; NeighborCol <= Column + 1; ++NeighborCol)
+        {
+            NumFlags += (IsValidCell(NeighborRow, NeighborCol) && IsFlagged(NeighborRow, NeighborCol)) ? 1 : 0;
+        }
+    }
+    return NumFlags == GetAdjacentMines(Row, Column);
+}
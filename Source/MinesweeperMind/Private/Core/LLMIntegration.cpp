@@ -1,25 +1,39 @@
 #include "Core/LLMIntegration.h"
 
-#include "Misc/FileHelper.h"
-#include "Misc/Paths.h"
-#include "HAL/PlatformProcess.h"
-#include "Serialization/JsonReader.h"
-#include "Serialization/JsonSerializer.h"
+#include "Core/MinesweeperDimensionCache.h"
+#include "Core/MinesweeperInferenceClient.h"
+#include "Core/MinesweeperModelReplies.h"
+#include "MinesweeperMindStats.h"
+#include "Dom/JsonObject.h"
+#include "HAL/PlatformTime.h"
 
-FString LLMIntegration::GetMinesweeperDimensions()
+FString LLMIntegration::GetMinesweeperDimensions(const FString& Query)
 {
-    FString PythonScriptPath = FPaths::ProjectPluginsDir() / TEXT("Content/Scripts/game_integration.py");
-    FString Command = FString::Printf(TEXT("python \"%s\""), *PythonScriptPath);
-    
-    FString Output, Errors;
-    int32 ReturnCode;
-    FPlatformProcess::ExecProcess(*Command, TEXT(""), &ReturnCode, &Output, &Errors);
+    MINESWEEPER_SCOPE_CYCLE_COUNTER(DimensionRequest);
 
-    if (ReturnCode != 0)
+    FMinesweeperDimensionReply Reply;
+    TSharedPtr<FJsonObject> Result = FMinesweeperDimensionCache::Get().Find(Query);
+    if (!FMinesweeperDimensionReply::ParseResult(Result, Reply))
     {
-        UE_LOG(LogTemp, Error, TEXT("Python execution failed: %s"), *Errors);
-        return TEXT("");
+        TSharedRef<FJsonObject> Params = MakeShared<FJsonObject>();
+        Params->SetStringField(TEXT("query"), Query);
+
+        FString Error;
+        const double StartTime = FPlatformTime::Seconds();
+        if (!FMinesweeperInferenceClient::Get()->Call(TEXT("generate_dimensions"), Params, Result, Error))
+        {
+            UE_LOG(LogTemp, Error, TEXT("Inference request failed: %s"), *Error);
+            return TEXT("");
+        }
+
+        // Only a reply cut short by the token limit fails to parse, that one is worth asking again.
+        if (!FMinesweeperDimensionReply::ParseResult(Result, Reply))
+        {
+            UE_LOG(LogTemp, Error, TEXT("Unreadable generate_dimensions reply for '%s'"), *Query);
+            return TEXT("");
+        }
+        FMinesweeperDimensionCache::Get().Add(Query, Result.ToSharedRef(), FPlatformTime::Seconds() - StartTime);
     }
 
-    return Output;
+    return FString::Printf(TEXT("{\"rows\":%d,\"columns\":%d,\"mines\":%lld}"), Reply.Rows, Reply.Columns, Reply.Mines);
 }
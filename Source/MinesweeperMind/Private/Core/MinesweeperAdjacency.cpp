@@ -0,0 +1,364 @@
+#include "MinesweeperAdjacency.h"
+
+#include "Core/IMinesweeperBoard.h"
+#include "Async/ParallelFor.h"
+
+#if defined(PLATFORM_ALWAYS_HAS_AVX_2) && PLATFORM_ALWAYS_HAS_AVX_2
+	#include <immintrin.h>
+	#define MINESWEEPER_ADJACENCY_AVX2 1
+	#define MINESWEEPER_ADJACENCY_SSE2 1
+#elif PLATFORM_ENABLE_VECTORINTRINSICS && PLATFORM_CPU_X86_FAMILY
+	#include <emmintrin.h>
+	#define MINESWEEPER_ADJACENCY_AVX2 0
+	#define MINESWEEPER_ADJACENCY_SSE2 1
+#else
+	#define MINESWEEPER_ADJACENCY_AVX2 0
+	#define MINESWEEPER_ADJACENCY_SSE2 0
+#endif
+
+static_assert(PLATFORM_LITTLE_ENDIAN, "Packed cell gathers assume cell N is byte N of a 64-bit load.");
+
+namespace
+{
+    constexpr int32 RowsPerBand = 64;
+    constexpr int32 ParallelCellThreshold = 256 * 256;
+
+    constexpr uint64 LowBitOfEachByte = 0x0101010101010101ull;
+    constexpr uint64 AdjacencyOfEachByte = 0x0F0F0F0F0F0F0F0Full;
+
+    /** One 64-bit word of lanes, the portable fallback. */
+    struct FScalarLanes
+    {
+        static constexpr int32 NumWords = 1;
+        uint64 V;
+
+        static FORCEINLINE FScalarLanes Load(const uint64* Src) { return { *Src }; }
+        FORCEINLINE void Store(uint64* Dst) const { *Dst = V; }
+
+        friend FORCEINLINE FScalarLanes operator&(FScalarLanes A, FScalarLanes B) { return { A.V & B.V }; }
+        friend FORCEINLINE FScalarLanes operator|(FScalarLanes A, FScalarLanes B) { return { A.V | B.V }; }
+        friend FORCEINLINE FScalarLanes operator^(FScalarLanes A, FScalarLanes B) { return { A.V ^ B.V }; }
+    };
+
+#if MINESWEEPER_ADJACENCY_SSE2
+    struct FSse2Lanes
+    {
+        static constexpr int32 NumWords = 2;
+        __m128i V;
+
+        static FORCEINLINE FSse2Lanes Load(const uint64* Src) { return { _mm_loadu_si128(reinterpret_cast<const __m128i*>(Src)) }; }
+        FORCEINLINE void Store(uint64* Dst) const { _mm_storeu_si128(reinterpret_cast<__m128i*>(Dst), V); }
+
+        friend FORCEINLINE FSse2Lanes operator&(FSse2Lanes A, FSse2Lanes B) { return { _mm_and_si128(A.V, B.V) }; }
+        friend FORCEINLINE FSse2Lanes operator|(FSse2Lanes A, FSse2Lanes B) { return { _mm_or_si128(A.V, B.V) }; }
+        friend FORCEINLINE FSse2Lanes operator^(FSse2Lanes A, FSse2Lanes B) { return { _mm_xor_si128(A.V, B.V) }; }
+    };
+#endif
+
+#if MINESWEEPER_ADJACENCY_AVX2
+    struct FAvx2Lanes
+    {
+        static constexpr int32 NumWords = 4;
+        __m256i V;
+
+        static FORCEINLINE FAvx2Lanes Load(const uint64* Src) { return { _mm256_loadu_si256(reinterpret_cast<const __m256i*>(Src)) }; }
+        FORCEINLINE void Store(uint64* Dst) const { _mm256_storeu_si256(reinterpret_cast<__m256i*>(Dst), V); }
+
+        friend FORCEINLINE FAvx2Lanes operator&(FAvx2Lanes A, FAvx2Lanes B) { return { _mm256_and_si256(A.V, B.V) }; }
+        friend FORCEINLINE FAvx2Lanes operator|(FAvx2Lanes A, FAvx2Lanes B) { return { _mm256_or_si256(A.V, B.V) }; }
+        friend FORCEINLINE FAvx2Lanes operator^(FAvx2Lanes A, FAvx2Lanes B) { return { _mm256_xor_si256(A.V, B.V) }; }
+    };
+#endif
+
+    /** The eight neighbour masks of one row and the four bit planes their sum is written to. */
+    struct FNeighbourRows
+    {
+        const uint64* Inputs[8];
+        uint64* Planes[4];
+    };
+
+    /** Bit-sliced sum of eight one-bit inputs per lane into a 4-bit count (0-8). */
+    template <typename LanesType>
+    FORCEINLINE void SumNeighbours(const FNeighbourRows& Rows, int32 WordIndex)
+    {
+        const LanesType A = LanesType::Load(Rows.Inputs[0] + WordIndex);
+        const LanesType B = LanesType::Load(Rows.Inputs[1] + WordIndex);
+        const LanesType C = LanesType::Load(Rows.Inputs[2] + WordIndex);
+        const LanesType D = LanesType::Load(Rows.Inputs[3] + WordIndex);
+        const LanesType E = LanesType::Load(Rows.Inputs[4] + WordIndex);
+        const LanesType F = LanesType::Load(Rows.Inputs[5] + WordIndex);
+        const LanesType G = LanesType::Load(Rows.Inputs[6] + WordIndex);
+        const LanesType H = LanesType::Load(Rows.Inputs[7] + WordIndex);
+
+        // First layer: two full adders and a half adder fold eight inputs into three ones and three twos.
+        const LanesType AB = A ^ B;
+        const LanesType Ones0 = AB ^ C;
+        const LanesType Twos0 = (A & B) | (C & AB);
+
+        const LanesType DE = D ^ E;
+        const LanesType Ones1 = DE ^ F;
+        const LanesType Twos1 = (D & E) | (F & DE);
+
+        const LanesType Ones2 = G ^ H;
+        const LanesType Twos2 = G & H;
+
+        // Second layer: sum the ones, which may carry a fourth two.
+        const LanesType Ones01 = Ones0 ^ Ones1;
+        const LanesType Bit0 = Ones01 ^ Ones2;
+        const LanesType Twos3 = (Ones0 & Ones1) | (Ones2 & Ones01);
+
+        // Third layer: sum the four twos into a two and up to two fours.
+        const LanesType Twos01 = Twos0 ^ Twos1;
+        const LanesType Twos012 = Twos01 ^ Twos2;
+        const LanesType Fours0 = (Twos0 & Twos1) | (Twos2 & Twos01);
+        const LanesType Bit1 = Twos012 ^ Twos3;
+        const LanesType Fours1 = Twos012 & Twos3;
+
+        Bit0.Store(Rows.Planes[0] + WordIndex);
+        Bit1.Store(Rows.Planes[1] + WordIndex);
+        (Fours0 ^ Fours1).Store(Rows.Planes[2] + WordIndex);
+        (Fours0 & Fours1).Store(Rows.Planes[3] + WordIndex);
+    }
+
+    /** Processes whole vectors starting at WordIndex and returns the first word left over. */
+    template <typename LanesType>
+    FORCEINLINE int32 SumNeighbourRange(const FNeighbourRows& Rows, int32 WordIndex, int32 NumWords)
+    {
+        for (; WordIndex + LanesType::NumWords <= NumWords; WordIndex += LanesType::NumWords)
+        {
+            SumNeighbours<LanesType>(Rows, WordIndex);
+        }
+        return WordIndex;
+    }
+
+    void SumNeighbourRow(const FNeighbourRows& Rows, int32 NumWords)
+    {
+        int32 WordIndex = 0;
+#if MINESWEEPER_ADJACENCY_AVX2
+        WordIndex = SumNeighbourRange<FAvx2Lanes>(Rows, WordIndex, NumWords);
+#endif
+#if MINESWEEPER_ADJACENCY_SSE2
+        WordIndex = SumNeighbourRange<FSse2Lanes>(Rows, WordIndex, NumWords);
+#endif
+        SumNeighbourRange<FScalarLanes>(Rows, WordIndex, NumWords);
+    }
+
+    /** Dst[c] = Src[c - 1], the neighbour to the west of every column. */
+    void ShiftWest(const uint64* Src, uint64* Dst, int32 NumWords)
+    {
+        uint64 Carry = 0;
+        for (int32 WordIndex = 0; WordIndex < NumWords; ++WordIndex)
+        {
+            Dst[WordIndex] = (Src[WordIndex] << 1) | Carry;
+            Carry = Src[WordIndex] >> 63;
+        }
+    }
+
+    /** Dst[c] = Src[c + 1], the neighbour to the east of every column. */
+    void ShiftEast(const uint64* Src, uint64* Dst, int32 NumWords)
+    {
+        for (int32 WordIndex = 0; WordIndex < NumWords; ++WordIndex)
+        {
+            const uint64 Next = (WordIndex + 1 < NumWords) ? Src[WordIndex + 1] : 0;
+            Dst[WordIndex] = (Src[WordIndex] >> 1) | (Next << 63);
+        }
+    }
+
+    /** Lookup from 8 bits to 8 bytes holding 0 or 1, so eight counts are assembled per 64-bit store. */
+    struct FSpreadTable
+    {
+        uint64 Entries[256];
+
+        FSpreadTable()
+        {
+            for (int32 Bits = 0; Bits < 256; ++Bits)
+            {
+                uint64 Spread = 0;
+                for (int32 Bit = 0; Bit < 8; ++Bit)
+                {
+                    Spread |= uint64((Bits >> Bit) & 1) << (Bit * 8);
+                }
+                Entries[Bits] = Spread;
+            }
+        }
+    };
+
+    void GatherMineBits(const uint8* RowCells, int32 NumColumns, uint64* RowWords)
+    {
+        int32 Column = 0;
+        for (; Column + 8 <= NumColumns; Column += 8)
+        {
+            uint64 Packed;
+            FMemory::Memcpy(&Packed, RowCells + Column, sizeof(Packed));
+
+            // Move the mine bit of each byte to bit 0, then gather the eight bytes' bits into the top byte.
+            const uint64 MineBits = (((Packed >> 4) & LowBitOfEachByte) * 0x0102040810204080ull) >> 56;
+            RowWords[Column >> 6] |= MineBits << (Column & 63);
+        }
+
+        for (; Column < NumColumns; ++Column)
+        {
+            if (RowCells[Column] & MinesweeperCell::Mine)
+            {
+                RowWords[Column >> 6] |= uint64(1) << (Column & 63);
+            }
+        }
+    }
+
+    void WriteCounts(const FNeighbourRows& Rows, uint8* RowCells, int32 NumColumns)
+    {
+        static const FSpreadTable Spread;
+
+        int32 Column = 0;
+        for (; Column + 8 <= NumColumns; Column += 8)
+        {
+            const int32 WordIndex = Column >> 6;
+            const int32 Shift = Column & 63;
+
+            const uint64 Counts =
+                Spread.Entries[(Rows.Planes[0][WordIndex] >> Shift) & 0xFF]
+                | (Spread.Entries[(Rows.Planes[1][WordIndex] >> Shift) & 0xFF] << 1)
+                | (Spread.Entries[(Rows.Planes[2][WordIndex] >> Shift) & 0xFF] << 2)
+                | (Spread.Entries[(Rows.Planes[3][WordIndex] >> Shift) & 0xFF] << 3);
+
+            uint64 Packed;
+            FMemory::Memcpy(&Packed, RowCells + Column, sizeof(Packed));
+
+            const uint64 MineBytes = ((Packed >> 4) & LowBitOfEachByte) * MinesweeperCell::AdjacencyMask;
+            Packed = (Packed & ~AdjacencyOfEachByte) | (Counts & ~MineBytes);
+
+            FMemory::Memcpy(RowCells + Column, &Packed, sizeof(Packed));
+        }
+
+        for (; Column < NumColumns; ++Column)
+        {
+            const int32 WordIndex = Column >> 6;
+            const int32 Shift = Column & 63;
+
+            uint8 Count = 0;
+            for (int32 Plane = 0; Plane < 4; ++Plane)
+            {
+                Count |= uint8(((Rows.Planes[Plane][WordIndex] >> Shift) & 1) << Plane);
+            }
+
+            uint8& Cell = RowCells[Column];
+            Cell &= ~MinesweeperCell::AdjacencyMask;
+            if ((Cell & MinesweeperCell::Mine) == 0)
+            {
+                Cell |= Count;
+            }
+        }
+    }
+}
+
+void FMinesweeperAdjacency::Calculate(uint8* Cells, int32 NumRows, int32 NumColumns)
+{
+    if (NumRows <= 0 || NumColumns <= 0)
+    {
+        return;
+    }
+
+    const int32 WordsPerRow = (NumColumns + 63) / 64;
+    const int32 NumBands = (NumRows + RowsPerBand - 1) / RowsPerBand;
+    const EParallelForFlags ParallelFlags = (int64(NumRows) * NumColumns >= ParallelCellThreshold)
+                                                ? EParallelForFlags::None
+                                                : EParallelForFlags::ForceSingleThread;
+
+    TArray<uint64> MineRows;
+    MineRows.SetNumZeroed(NumRows * WordsPerRow);
+
+    ParallelFor(NumBands, [&](int32 BandIndex)
+    {
+        const int32 FirstRow = BandIndex * RowsPerBand;
+        const int32 EndRow = FMath::Min(FirstRow + RowsPerBand, NumRows);
+        for (int32 Row = FirstRow; Row < EndRow; ++Row)
+        {
+            GatherMineBits(Cells + int64(Row) * NumColumns, NumColumns, MineRows.GetData() + Row * WordsPerRow);
+        }
+    }, ParallelFlags);
+
+    TArray<uint64> ZeroRow;
+    ZeroRow.SetNumZeroed(WordsPerRow);
+
+    ParallelFor(NumBands, [&](int32 BandIndex)
+    {
+        // Six shifted neighbour rows and four output planes per band.
+        TArray<uint64> Scratch;
+        Scratch.SetNumUninitialized(10 * WordsPerRow);
+        uint64* UpWest = Scratch.GetData();
+        uint64* UpEast = UpWest + WordsPerRow;
+        uint64* West = UpEast + WordsPerRow;
+        uint64* East = West + WordsPerRow;
+        uint64* DownWest = East + WordsPerRow;
+        uint64* DownEast = DownWest + WordsPerRow;
+
+        FNeighbourRows Rows;
+        for (int32 Plane = 0; Plane < 4; ++Plane)
+        {
+            Rows.Planes[Plane] = DownEast + (Plane + 1) * WordsPerRow;
+        }
+
+        const int32 FirstRow = BandIndex * RowsPerBand;
+        const int32 EndRow = FMath::Min(FirstRow + RowsPerBand, NumRows);
+        for (int32 Row = FirstRow; Row < EndRow; ++Row)
+        {
+            const uint64* Up = (Row > 0) ? MineRows.GetData() + (Row - 1) * WordsPerRow : ZeroRow.GetData();
+            const uint64* Center = MineRows.GetData() + Row * WordsPerRow;
+            const uint64* Down = (Row + 1 < NumRows) ? MineRows.GetData() + (Row + 1) * WordsPerRow : ZeroRow.GetData();
+
+            ShiftWest(Up, UpWest, WordsPerRow);
+            ShiftEast(Up, UpEast, WordsPerRow);
+            ShiftWest(Center, West, WordsPerRow);
+            ShiftEast(Center, East, WordsPerRow);
+            ShiftWest(Down, DownWest, WordsPerRow);
+            ShiftEast(Down, DownEast, WordsPerRow);
+
+            Rows.Inputs[0] = UpWest;
+            Rows.Inputs[1] = Up;
+            Rows.Inputs[2] = UpEast;
+            Rows.Inputs[3] = West;
+            Rows.Inputs[4] = East;
+            Rows.Inputs[5] = DownWest;
+            Rows.Inputs[6] = Down;
+            Rows.Inputs[7] = DownEast;
+
+            SumNeighbourRow(Rows, WordsPerRow);
+            WriteCounts(Rows, Cells + int64(Row) * NumColumns, NumColumns);
+        }
+    }, ParallelFlags);
+}
+
+void FMinesweeperAdjacency::CalculateReference(uint8* Cells, int32 NumRows, int32 NumColumns)
+{
+    for (int32 RowIndex = 0; RowIndex < NumRows; ++RowIndex)
+    {
+        for (int32 ColIndex = 0; ColIndex < NumColumns; ++ColIndex)
+        {
+            uint8& Cell = Cells[int64(RowIndex) * NumColumns + ColIndex];
+            Cell &= ~MinesweeperCell::AdjacencyMask;
+
+            if (Cell & MinesweeperCell::Mine)
+            {
+                continue;
+            }
+
+            uint8 MineCounter = 0;
+            for (int32 OffsetRow = -1; OffsetRow <= 1; ++OffsetRow)
+            {
+                for (int32 OffsetCol = -1; OffsetCol <= 1; ++OffsetCol)
+                {
+                    const int32 NeighborRow = RowIndex + OffsetRow;
+                    const int32 NeighborCol = ColIndex + OffsetCol;
+
+                    if (NeighborRow >= 0 && NeighborRow < NumRows &&
+                        NeighborCol >= 0 && NeighborCol < NumColumns &&
+                        (Cells[int64(NeighborRow) * NumColumns + NeighborCol] & MinesweeperCell::Mine))
+                    {
+                        ++MineCounter;
+                    }
+                }
+            }
+            Cell |= MineCounter;
+        }
+    }
+}
@@ -0,0 +1,20 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+ * Adjacency kernels over a packed Minesweeper cell array (see MinesweeperCell).
+ * Both write the mine count of every safe cell into its low nibble and clear it for mines.
+ */
+struct FMinesweeperAdjacency
+{
+	/**
+	 * Packs each row's mines into 64-bit words and sums the eight shifted neighbour rows with bit-sliced adders,
+	 * 64 cells per word and several words per instruction where SSE2/AVX2 is available.
+	 * Large boards are split into row bands that run through ParallelFor.
+	 */
+	static void Calculate(uint8* Cells, int32 NumRows, int32 NumColumns);
+
+	/** Straightforward bounds-checked 3x3 loop. Kept as the reference for benchmarks and verification. */
+	static void CalculateReference(uint8* Cells, int32 NumRows, int32 NumColumns);
+};
@@ -0,0 +1,96 @@
+#include "Core/MinesweeperAsyncInference.h"
+
+#include "Core/MinesweeperInferenceClient.h"
+#include "Async/Async.h"
+#include "Containers/Ticker.h"
+#include "Dom/JsonObject.h"
+#include "Misc/ScopeLock.h"
+
+namespace
+{
+    /** Roughly two frames, partial replies still look live without relayouting the chat for every token. */
+    constexpr float TokenBatchSeconds = 0.033f;
+}
+
+TSharedRef<FMinesweeperAsyncInference> FMinesweeperAsyncInference::Start(const FString& Method, const TSharedRef<FJsonObject>& Params,
+    FOnTokens OnTokens, FOnFinished OnFinished)
+{
+    check(IsInGameThread());
+
+    TSharedRef<FMinesweeperAsyncInference> Request = MakeShareable(new FMinesweeperAsyncInference(Method, Params, MoveTemp(OnTokens), MoveTemp(OnFinished)));
+
+    // Both hold the request until they are done with it, the caller may drop its reference at any time.
+    FTSTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateLambda([Request](float DeltaTime)
+    {
+        return Request->Tick(DeltaTime);
+    }), TokenBatchSeconds);
+
+    // A dedicated thread rather than the pool, generation can keep it busy for many seconds.
+    Async(EAsyncExecution::Thread, [Request]()
+    {
+        Request->Run();
+    });
+
+    return Request;
+}
+
+FMinesweeperAsyncInference::FMinesweeperAsyncInference(const FString& InMethod, const TSharedRef<FJsonObject>& InParams, FOnTokens InOnTokens,
+    FOnFinished InOnFinished)
+    : Method(InMethod)
+    , Params(InParams)
+    , OnTokens(MoveTemp(InOnTokens))
+    , OnFinished(MoveTemp(InOnFinished))
+{
+}
+
+void FMinesweeperAsyncInference::Cancel()
+{
+    bCancelRequested = true;
+}
+
+void FMinesweeperAsyncInference::Run()
+{
+    TSharedPtr<FJsonObject> CallResult;
+    FString CallError;
+    const bool bCallSucceeded = FMinesweeperInferenceClient::Get()->CallStreaming(Method, Params, [this](const FString& Token)
+    {
+        FScopeLock Lock(&PendingMutex);
+        PendingText += Token;
+    }, bCancelRequested, CallResult, CallError);
+
+    FScopeLock Lock(&PendingMutex);
+    bCallFinished = true;
+    bSucceeded = bCallSucceeded;
+    Result = MoveTemp(CallResult);
+    Error = MoveTemp(CallError);
+}
+
+bool FMinesweeperAsyncInference::Tick(float DeltaTime)
+{
+    if (bCancelRequested)
+    {
+        return false;
+    }
+
+    FString NewText;
+    bool bDone = false;
+    {
+        FScopeLock Lock(&PendingMutex);
+        NewText = MoveTemp(PendingText);
+        PendingText.Reset();
+        bDone = bCallFinished;
+    }
+
+    if (!NewText.IsEmpty())
+    {
+        OnTokens.ExecuteIfBound(NewText);
+    }
+    if (!bDone || bCancelRequested)
+    {
+        return !bCancelRequested;
+    }
+
+    bFinished = true;
+    OnFinished.ExecuteIfBound(bSucceeded, Result, Error);
+    return false;
+}
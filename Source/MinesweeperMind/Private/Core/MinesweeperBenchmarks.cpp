@@ -0,0 +1,555 @@
+#include "MinesweeperAdjacency.h"
+
+#include "Core/MinesweeperBoard.h"
+#include "Core/MinesweeperChunkedBoard.h"
+#include "Core/MinesweeperInferenceClient.h"
+#include "Core/MinesweeperIntentParser.h"
+#include "Core/MinesweeperMoveHistory.h"
+#include "Core/MinesweeperNoGuessGenerator.h"
+#include "Core/MinesweeperProbability.h"
+#include "Core/MinesweeperPromptEncoder.h"
+#include "Core/MinesweeperSimulation.h"
+#include "Core/MinesweeperSolver.h"
+#include "Dom/JsonObject.h"
+#include "HAL/IConsoleManager.h"
+#include "HAL/PlatformTime.h"
+#include "Math/RandomStream.h"
+
+namespace
+{
+    constexpr float BenchmarkMineDensity = 0.15f;
+    constexpr int32 BenchmarkSeed = 1337;
+
+    void FillRandomMines(TArray<uint8>& Cells, int32 NumCells, FRandomStream& Random)
+    {
+        Cells.SetNumUninitialized(NumCells);
+        for (int32 CellIndex = 0; CellIndex < NumCells; ++CellIndex)
+        {
+            Cells[CellIndex] = (Random.GetFraction() < BenchmarkMineDensity) ? MinesweeperCell::Mine : 0;
+        }
+    }
+
+    /** Best-of-N wall time in milliseconds, every run starts from the same untouched layout. */
+    template <typename KernelType>
+    double TimeKernel(const TArray<uint8>& Source, TArray<uint8>& Work, int32 NumRows, int32 NumColumns, int32 NumRuns, KernelType Kernel)
+    {
+        double BestMilliseconds = TNumericLimits<double>::Max();
+        for (int32 Run = 0; Run < NumRuns; ++Run)
+        {
+            Work = Source;
+
+            const double StartTime = FPlatformTime::Seconds();
+            Kernel(Work.GetData(), NumRows, NumColumns);
+            BestMilliseconds = FMath::Min(BestMilliseconds, (FPlatformTime::Seconds() - StartTime) * 1000.0);
+        }
+        return BestMilliseconds;
+    }
+
+    void BenchmarkAdjacency()
+    {
+        static const FIntPoint BoardSizes[] = { FIntPoint(100, 100), FIntPoint(1000, 1000), FIntPoint(10000, 10000) };
+
+        FRandomStream Random(BenchmarkSeed);
+        for (const FIntPoint& BoardSize : BoardSizes)
+        {
+            const int32 NumRows = BoardSize.X;
+            const int32 NumColumns = BoardSize.Y;
+            const int32 NumCells = NumRows * NumColumns;
+            const int32 NumRuns = (NumCells > 10000000) ? 1 : 5;
+
+            TArray<uint8> Source;
+            FillRandomMines(Source, NumCells, Random);
+
+            TArray<uint8> ReferenceCells;
+            TArray<uint8> KernelCells;
+            const double ReferenceMilliseconds = TimeKernel(Source, ReferenceCells, NumRows, NumColumns, NumRuns, &FMinesweeperAdjacency::CalculateReference);
+            const double KernelMilliseconds = TimeKernel(Source, KernelCells, NumRows, NumColumns, NumRuns, &FMinesweeperAdjacency::Calculate);
+
+            const bool bMatches = ReferenceCells == KernelCells;
+            UE_LOG(LogTemp, Log, TEXT("Adjacency %dx%d: reference %.3f ms, bitboard %.3f ms (%.1fx)%s"),
+                NumRows, NumColumns, ReferenceMilliseconds, KernelMilliseconds,
+                ReferenceMilliseconds / FMath::Max(KernelMilliseconds, 0.001),
+                bMatches ? TEXT("") : TEXT(" MISMATCH"));
+        }
+    }
+
+    /** Plays the opening plus a stream of random safe reveals on a board far larger than memory would allow densely. */
+    void BenchmarkChunkedBoard(const TArray<FString>& Args)
+    {
+        const int32 NumRows = Args.Num() > 0 ? FCString::Atoi(*Args[0]) : 100000;
+        const int32 NumColumns = Args.Num() > 1 ? FCString::Atoi(*Args[1]) : NumRows;
+        const int32 NumReveals = Args.Num() > 2 ? FCString::Atoi(*Args[2]) : 10000;
+
+        FMinesweeperChunkedBoard Board;
+        Board.Initialize(NumRows, NumColumns, static_cast<int64>(double(NumRows) * NumColumns * BenchmarkMineDensity));
+        Board.DeferMinePlacement(BenchmarkSeed);
+
+        TArray<FIntPoint> Revealed;
+        const double StartTime = FPlatformTime::Seconds();
+        Board.Reveal(NumRows / 2, NumColumns / 2, Revealed);
+
+        FRandomStream Random(BenchmarkSeed);
+        int32 NumMoves = 1;
+        for (int32 Attempt = 0; Attempt < NumReveals && !Board.IsGameOver(); ++Attempt)
+        {
+            const int32 Row = Random.RandHelper(NumRows);
+            const int32 Column = Random.RandHelper(NumColumns);
+            if (!Board.IsMine(Row, Column) && !Board.IsRevealed(Row, Column))
+            {
+                Board.Reveal(Row, Column, Revealed);
+                ++NumMoves;
+            }
+        }
+        const double ElapsedMilliseconds = (FPlatformTime::Seconds() - StartTime) * 1000.0;
+
+        UE_LOG(LogTemp, Log, TEXT("Chunked board %dx%d: %d reveals in %.1f ms (%.3f ms each), %lld cells revealed"),
+            NumRows, NumColumns, NumMoves, ElapsedMilliseconds, ElapsedMilliseconds / NumMoves, Board.GetSafeCellsRevealed());
+        UE_LOG(LogTemp, Log, TEXT("Chunked board %dx%d: %d chunks (%d compressed), %.2f MB vs %.2f MB dense"),
+            NumRows, NumColumns, Board.GetNumChunks(), Board.GetNumCompressedChunks(),
+            Board.GetAllocatedSize() / (1024.0 * 1024.0), Board.GetNumCells() / (1024.0 * 1024.0));
+    }
+
+    FAutoConsoleCommand BenchmarkChunkedBoardCommand(
+        TEXT("MinesweeperMind.Benchmark.ChunkedBoard"),
+        TEXT("Random safe reveals on a huge chunked board, reports time and memory. Args: [Rows=100000] [Columns=Rows] [Reveals=10000]"),
+        FConsoleCommandWithArgsDelegate::CreateStatic(&BenchmarkChunkedBoard));
+
+    /** Plays expert boards using only solver moves and reports how long each incremental solve takes. */
+    void BenchmarkSolver(const TArray<FString>& Args)
+    {
+        const int32 NumGames = Args.Num() > 0 ? FCString::Atoi(*Args[0]) : 1000;
+
+        FMinesweeperBoard Board;
+        FMinesweeperSolver Solver;
+        TArray<FIntPoint> Revealed;
+        TArray<FIntPoint> SafeCells;
+
+        int32 NumSolved = 0;
+        int32 NumSolves = 0;
+        double SolveSeconds = 0.0;
+        for (int32 Game = 0; Game < NumGames; ++Game)
+        {
+            Board.Initialize(16, 30, 99);
+            Board.DeferMinePlacement(BenchmarkSeed + Game);
+            Board.Reveal(8, 15, Revealed);
+
+            Solver.Reset(Board);
+            Solver.AddRevealedCells(Revealed);
+
+            for (;;)
+            {
+                const double StartTime = FPlatformTime::Seconds();
+                Solver.Solve();
+                SolveSeconds += FPlatformTime::Seconds() - StartTime;
+                ++NumSolves;
+
+                SafeCells = Solver.GetSafeCells();
+                if (SafeCells.IsEmpty())
+                {
+                    break;
+                }
+
+                for (const FIntPoint& Cell : SafeCells)
+                {
+                    Board.Reveal(Cell.X, Cell.Y, Revealed);
+                    Solver.AddRevealedCells(Revealed);
+                }
+            }
+
+            NumSolved += Board.IsGameWon() ? 1 : 0;
+        }
+
+        UE_LOG(LogTemp, Log, TEXT("Solver: %d/%d expert games won without guessing, %.2f us per solve over %d solves"),
+            NumSolved, NumGames, SolveSeconds * 1000000.0 / FMath::Max(NumSolves, 1), NumSolves);
+    }
+
+    FAutoConsoleCommand BenchmarkSolverCommand(
+        TEXT("MinesweeperMind.Benchmark.Solver"),
+        TEXT("Plays expert boards with deterministic solver moves only. Args: [Games=1000]"),
+        FConsoleCommandWithArgsDelegate::CreateStatic(&BenchmarkSolver));
+
+    /**
+     * Clears a board with solver rounds twice, applying each round's safe cells one ApplyMove at a time and then as
+     * one ApplyMoves batch. Only the board work is timed, both runs play the same moves.
+     */
+    void BenchmarkBatchMoves(const TArray<FString>& Args)
+    {
+        const int32 NumRows = Args.Num() > 0 ? FCString::Atoi(*Args[0]) : 1000;
+        const int32 NumColumns = Args.Num() > 1 ? FCString::Atoi(*Args[1]) : NumRows;
+
+        double Milliseconds[2] = {};
+        int64 NumRevealed[2] = {};
+        int32 NumMoves = 0;
+        int32 NumBatches = 0;
+        for (int32 Run = 0; Run < 2; ++Run)
+        {
+            const bool bBatched = Run == 1;
+
+            FMinesweeperBoard Board;
+            Board.Initialize(NumRows, NumColumns, static_cast<int64>(double(NumRows) * NumColumns * BenchmarkMineDensity));
+            Board.DeferMinePlacement(BenchmarkSeed);
+
+            FMinesweeperSolver Solver;
+            Solver.Reset(Board);
+
+            TArray<FIntPoint> Revealed;
+            Board.Reveal(NumRows / 2, NumColumns / 2, Revealed);
+            Solver.AddRevealedCells(Revealed);
+
+            TArray<FMinesweeperMove> Moves;
+            FMinesweeperChangeSet Changes;
+            int32 NumFlagged = 0;
+            NumMoves = 0;
+            NumBatches = 0;
+            while (Solver.Solve() && !Board.IsGameOver())
+            {
+                Moves.Reset();
+                for (const FIntPoint& Cell : Solver.GetSafeCells())
+                {
+                    Moves.Add(FMinesweeperMove(Cell, EMinesweeperMoveType::Reveal));
+                }
+                // Mines accumulate across solves, only flag the new ones so earlier flags aren't toggled off.
+                for (; NumFlagged < Solver.GetMineCells().Num(); ++NumFlagged)
+                {
+                    Moves.Add(FMinesweeperMove(Solver.GetMineCells()[NumFlagged], EMinesweeperMoveType::Flag));
+                }
+                NumMoves += Moves.Num();
+                ++NumBatches;
+
+                const double StartTime = FPlatformTime::Seconds();
+                if (bBatched)
+                {
+                    Board.ApplyMoves(Moves, Changes);
+                }
+                else
+                {
+                    Changes.Reset();
+                    for (const FMinesweeperMove& Move : Moves)
+                    {
+                        if (Board.ApplyMove(Move, Revealed))
+                        {
+                            Changes.Revealed.Append(Revealed);
+                        }
+                    }
+                }
+                Milliseconds[Run] += (FPlatformTime::Seconds() - StartTime) * 1000.0;
+
+                Solver.AddRevealedCells(Changes.Revealed);
+            }
+            NumRevealed[Run] = Board.GetSafeCellsRevealed();
+        }
+
+        UE_LOG(LogTemp, Log, TEXT("Batch moves %dx%d: %d moves in %d batches, one at a time %.2f ms, batched %.2f ms (%.1fx), %lld vs %lld cells revealed"),
+            NumRows, NumColumns, NumMoves, NumBatches, Milliseconds[0], Milliseconds[1], Milliseconds[0] / FMath::Max(Milliseconds[1], 0.001),
+            NumRevealed[0], NumRevealed[1]);
+    }
+
+    FAutoConsoleCommand BenchmarkBatchMovesCommand(
+        TEXT("MinesweeperMind.Benchmark.BatchMoves"),
+        TEXT("Applies solver rounds move by move and as batches on the same board. Args: [Rows=1000] [Columns=Rows]"),
+        FConsoleCommandWithArgsDelegate::CreateStatic(&BenchmarkBatchMoves));
+
+    /**
+     * Plays solver rounds on a sparse board through a move history, one step per round, then undoes and redoes every
+     * step. The opening floods most of the board, so its undo is compared with rebuilding the board from scratch.
+     */
+    void BenchmarkUndo(const TArray<FString>& Args)
+    {
+        const int32 NumRows = Args.Num() > 0 ? FCString::Atoi(*Args[0]) : 2000;
+        const int32 NumColumns = Args.Num() > 1 ? FCString::Atoi(*Args[1]) : NumRows;
+        const int64 NumMines = static_cast<int64>(double(NumRows) * NumColumns * 0.02);
+
+        FMinesweeperBoard Board;
+        Board.Initialize(NumRows, NumColumns, NumMines);
+        Board.DeferMinePlacement(BenchmarkSeed);
+
+        FMinesweeperMoveHistory History;
+        History.Reset(Board);
+        FMinesweeperSolver Solver;
+        Solver.Reset(Board);
+
+        Solver.AddRevealedCells(History.Apply(FMinesweeperMove(FIntPoint(NumRows / 2, NumColumns / 2), EMinesweeperMoveType::Reveal)).Revealed);
+        const int32 NumOpened = History.GetLastChanges().Revealed.Num();
+
+        TArray<FMinesweeperMove> Moves;
+        while (Solver.Solve() && !Board.IsGameOver())
+        {
+            Moves.Reset();
+            for (const FIntPoint& Cell : Solver.GetSafeCells())
+            {
+                Moves.Add(FMinesweeperMove(Cell, EMinesweeperMoveType::Reveal));
+            }
+            Solver.AddRevealedCells(History.Apply(Moves).Revealed);
+        }
+        const int64 NumRevealed = Board.GetSafeCellsRevealed();
+        const int32 NumSteps = History.GetNumSteps();
+
+        double StartTime = FPlatformTime::Seconds();
+        while (History.GetNumApplied() > 1)
+        {
+            History.Undo();
+        }
+        const double UndoMilliseconds = (FPlatformTime::Seconds() - StartTime) * 1000.0;
+
+        StartTime = FPlatformTime::Seconds();
+        History.Undo();
+        const double UndoOpeningMilliseconds = (FPlatformTime::Seconds() - StartTime) * 1000.0;
+
+        StartTime = FPlatformTime::Seconds();
+        while (History.Redo())
+        {
+        }
+        const double RedoMilliseconds = (FPlatformTime::Seconds() - StartTime) * 1000.0;
+
+        FMinesweeperBoard Rebuilt;
+        StartTime = FPlatformTime::Seconds();
+        Rebuilt.Initialize(NumRows, NumColumns, NumMines);
+        Rebuilt.PlaceMines(Board.GetSeed(), Board.GetSafeCell());
+        const double RebuildMilliseconds = (FPlatformTime::Seconds() - StartTime) * 1000.0;
+
+        UE_LOG(LogTemp, Log, TEXT("Undo %dx%d: %d steps, %lld cells revealed, history %.2f MB"),
+            NumRows, NumColumns, NumSteps, NumRevealed, History.GetAllocatedSize() / (1024.0 * 1024.0));
+        UE_LOG(LogTemp, Log, TEXT("Undo %dx%d: later steps undone in %.3f ms, opening of %d cells in %.3f ms vs %.3f ms to rebuild, all redone in %.3f ms (%s)"),
+            NumRows, NumColumns, UndoMilliseconds, NumOpened, UndoOpeningMilliseconds, RebuildMilliseconds, RedoMilliseconds,
+            Board.GetSafeCellsRevealed() == NumRevealed ? TEXT("same position") : TEXT("DIFFERENT position"));
+    }
+
+    FAutoConsoleCommand BenchmarkUndoCommand(
+        TEXT("MinesweeperMind.Benchmark.Undo"),
+        TEXT("Undoes and redoes a solver game step by step through a move history. Args: [Rows=2000] [Columns=Rows]"),
+        FConsoleCommandWithArgsDelegate::CreateStatic(&BenchmarkUndo));
+
+    /**
+     * Opens a board, lets the solver take every safe move, then times the probability engine on the position where
+     * logic ran out.
+     */
+    void BenchmarkProbability(const TArray<FString>& Args)
+    {
+        const int32 NumRows = Args.Num() > 0 ? FCString::Atoi(*Args[0]) : 200;
+        const int32 NumColumns = Args.Num() > 1 ? FCString::Atoi(*Args[1]) : NumRows;
+        const double TimeBudgetMilliseconds = Args.Num() > 2 ? FCString::Atod(*Args[2]) : 16.0;
+
+        FMinesweeperBoard Board;
+        Board.Initialize(NumRows, NumColumns, static_cast<int64>(double(NumRows) * NumColumns * BenchmarkMineDensity));
+        Board.DeferMinePlacement(BenchmarkSeed);
+
+        FMinesweeperSolver Solver;
+        Solver.Reset(Board);
+
+        TArray<FIntPoint> Revealed;
+        Board.Reveal(NumRows / 2, NumColumns / 2, Revealed);
+        Solver.AddRevealedCells(Revealed);
+        while (Solver.Solve() && !Board.IsGameOver())
+        {
+            const TArray<FIntPoint> SafeCells = Solver.GetSafeCells();
+            for (const FIntPoint& Cell : SafeCells)
+            {
+                Board.Reveal(Cell.X, Cell.Y, Revealed);
+                Solver.AddRevealedCells(Revealed);
+            }
+        }
+
+        FMinesweeperProbabilitySettings Settings;
+        Settings.TimeBudgetSeconds = TimeBudgetMilliseconds / 1000.0;
+        Settings.Seed = BenchmarkSeed;
+        const TSharedRef<const FMinesweeperProbabilityResult> Result = FMinesweeperProbability::Calculate(Board, &Solver, Settings);
+
+        UE_LOG(LogTemp, Log, TEXT("Probability %dx%d: %d cells, %d components (%d sampled), %.3f ms, interior %.3f, safest (%d, %d) at %.3f"),
+            NumRows, NumColumns, Result->GetCellProbabilities().Num(), Result->GetNumComponents(), Result->GetNumSampledComponents(),
+            Result->GetElapsedSeconds() * 1000.0, Result->GetInteriorProbability(),
+            Result->GetSafestCell().X, Result->GetSafestCell().Y, Result->GetMineProbability(Result->GetSafestCell().X, Result->GetSafestCell().Y));
+    }
+
+    FAutoConsoleCommand BenchmarkProbabilityCommand(
+        TEXT("MinesweeperMind.Benchmark.Probability"),
+        TEXT("Times the probability engine once logic runs out. Args: [Rows=200] [Columns=Rows] [BudgetMs=16]"),
+        FConsoleCommandWithArgsDelegate::CreateStatic(&BenchmarkProbability));
+
+    /** Generation time and attempts of no-guess boards across the classic sizes and a few densities. */
+    void BenchmarkNoGuess(const TArray<FString>& Args)
+    {
+        const int32 NumBoards = Args.Num() > 0 ? FCString::Atoi(*Args[0]) : 20;
+
+        static const FIntPoint BoardSizes[] = { FIntPoint(9, 9), FIntPoint(16, 16), FIntPoint(16, 30), FIntPoint(100, 100) };
+        static const float Densities[] = { 0.12f, 0.16f, 0.20f };
+
+        FMinesweeperNoGuessSettings Settings;
+        Settings.TimeBudgetSeconds = 5.0;
+
+        for (const FIntPoint& BoardSize : BoardSizes)
+        {
+            for (const float Density : Densities)
+            {
+                const int64 NumMines = static_cast<int64>(BoardSize.X * BoardSize.Y * Density);
+                const FIntPoint FirstClick(BoardSize.X / 2, BoardSize.Y / 2);
+
+                int32 NumFound = 0;
+                int64 TotalAttempts = 0;
+                double TotalMilliseconds = 0.0;
+                double WorstMilliseconds = 0.0;
+                for (int32 BoardIndex = 0; BoardIndex < NumBoards; ++BoardIndex)
+                {
+                    const FMinesweeperNoGuessResult Result = FMinesweeperNoGuessGenerator::Generate(
+                        BoardSize.X, BoardSize.Y, NumMines, FirstClick, BenchmarkSeed + BoardIndex, Settings);
+                    NumFound += Result.bFound ? 1 : 0;
+                    TotalAttempts += Result.NumAttempts;
+                    TotalMilliseconds += Result.ElapsedSeconds * 1000.0;
+                    WorstMilliseconds = FMath::Max(WorstMilliseconds, Result.ElapsedSeconds * 1000.0);
+                }
+
+                UE_LOG(LogTemp, Log, TEXT("No-guess %dx%d, %lld mines (%.0f%%): %d/%d found, %.1f attempts and %.2f ms on average, %.2f ms worst"),
+                    BoardSize.X, BoardSize.Y, NumMines, Density * 100.f, NumFound, NumBoards,
+                    double(TotalAttempts) / NumBoards, TotalMilliseconds / NumBoards, WorstMilliseconds);
+            }
+        }
+    }
+
+    FAutoConsoleCommand BenchmarkNoGuessCommand(
+        TEXT("MinesweeperMind.Benchmark.NoGuess"),
+        TEXT("Reports no-guess generation time and attempts per board size and density. Args: [BoardsPerSetting=20]"),
+        FConsoleCommandWithArgsDelegate::CreateStatic(&BenchmarkNoGuess));
+
+    /**
+     * Round trips to the inference worker. The first request includes starting the worker and loading the model, the
+     * rest show what a warm request costs. Set MinesweeperMind.Inference.WorkerArguments to the script with --stub to
+     * measure the transport alone.
+     */
+    void BenchmarkInference(const TArray<FString>& Args)
+    {
+        const int32 NumRequests = Args.Num() > 0 ? FMath::Max(1, FCString::Atoi(*Args[0])) : 20;
+        const FString Method = Args.Num() > 1 ? Args[1] : TEXT("ping");
+
+        const TSharedRef<FMinesweeperInferenceClient> Client = FMinesweeperInferenceClient::Get();
+        TSharedRef<FJsonObject> Params = MakeShared<FJsonObject>();
+        Params->SetStringField(TEXT("query"), TEXT("Generate an expert Minesweeper grid"));
+
+        TArray<double> Milliseconds;
+        int64 CompletionTokens = 0;
+        for (int32 Request = 0; Request < NumRequests; ++Request)
+        {
+            TSharedPtr<FJsonObject> Result;
+            FString Error;
+            const double StartTime = FPlatformTime::Seconds();
+            if (!Client->Call(Method, Params, Result, Error))
+            {
+                UE_LOG(LogTemp, Error, TEXT("Inference request %d failed: %s"), Request, *Error);
+                return;
+            }
+            Milliseconds.Add((FPlatformTime::Seconds() - StartTime) * 1000.0);
+
+            // Generation methods say how much they wrote, the grammar keeps that to the JSON and nothing else.
+            int64 RequestTokens = 0;
+            CompletionTokens += Result->TryGetNumberField(TEXT("completion_tokens"), RequestTokens) ? RequestTokens : 0;
+        }
+
+        const double FirstMilliseconds = Milliseconds[0];
+        Milliseconds.RemoveAt(0);
+        Milliseconds.Sort();
+        UE_LOG(LogTemp, Log, TEXT("Inference '%s': first request %.2f ms, then median %.3f ms and worst %.3f ms over %d requests, %d worker starts, %.1f tokens generated per request"),
+            *Method, FirstMilliseconds, Milliseconds.IsEmpty() ? 0.0 : Milliseconds[Milliseconds.Num() / 2],
+            Milliseconds.IsEmpty() ? 0.0 : Milliseconds.Last(), Milliseconds.Num(), Client->GetNumWorkerStarts(), double(CompletionTokens) / NumRequests);
+    }
+
+    FAutoConsoleCommand BenchmarkInferenceCommand(
+        TEXT("MinesweeperMind.Benchmark.Inference"),
+        TEXT("Times requests to the persistent inference worker. Args: [Requests=20] [Method=ping|generate_dimensions]"),
+        FConsoleCommandWithArgsDelegate::CreateStatic(&BenchmarkInference));
+
+    /** Cost of the intent parser on typical chat lines, the path that keeps board requests away from the model. */
+    void BenchmarkIntentParser(const TArray<FString>& Args)
+    {
+        const int32 NumIterations = Args.Num() > 0 ? FMath::Max(1, FCString::Atoi(*Args[0])) : 100000;
+
+        static const TCHAR* const Inputs[] =
+        {
+            TEXT("10 10 15"), TEXT("3x3 with 2 mines"), TEXT("expert"), TEXT("16 by 30, 99 mines"),
+            TEXT("make me an intermediate board"), TEXT("rows: 12 columns 8 mines=20"), TEXT("what should I click next?"),
+        };
+
+        TArray<FString> Lines;
+        for (const TCHAR* Input : Inputs)
+        {
+            Lines.Add(Input);
+        }
+
+        int32 NumParsed = 0;
+        const double StartTime = FPlatformTime::Seconds();
+        for (int32 Iteration = 0; Iteration < NumIterations; ++Iteration)
+        {
+            FMinesweeperBoardRequest Request;
+            NumParsed += FMinesweeperIntentParser::Parse(Lines[Iteration % Lines.Num()], Request) == EMinesweeperIntentMatch::Parsed ? 1 : 0;
+        }
+        const double Elapsed = FPlatformTime::Seconds() - StartTime;
+
+        UE_LOG(LogTemp, Log, TEXT("Intent parser: %.3f us per line over %d lines, %d parsed"),
+            Elapsed * 1000000.0 / NumIterations, NumIterations, NumParsed);
+    }
+
+    FAutoConsoleCommand BenchmarkIntentParserCommand(
+        TEXT("MinesweeperMind.Benchmark.IntentParser"),
+        TEXT("Times the board-request intent parser on typical chat lines. Args: [Iterations=100000]"),
+        FConsoleCommandWithArgsDelegate::CreateStatic(&BenchmarkIntentParser));
+
+    /**
+     * Plays expert games with the solver policy and encodes every position the way the agent would see it, comparing
+     * a whole-grid dump per move with the frontier transcript and the part of it each move appends.
+     */
+    void BenchmarkPromptEncoder(const TArray<FString>& Args)
+    {
+        const int32 NumGames = Args.Num() > 0 ? FMath::Max(1, FCString::Atoi(*Args[0])) : 100;
+
+        FMinesweeperBoard Board;
+        FMinesweeperPromptEncoder Encoder;
+        TArray<FIntPoint> Revealed;
+
+        int64 NumMoves = 0;
+        int64 GridTokens = 0;
+        int64 SentTokens = 0;
+        int64 AppendedTokens = 0;
+        int32 NumRebaselines = 0;
+        double EncodeSeconds = 0.0;
+        for (int32 Game = 0; Game < NumGames; ++Game)
+        {
+            Board.Initialize(16, 30, 99);
+            Board.DeferMinePlacement(BenchmarkSeed + Game);
+            TUniquePtr<IMinesweeperMovePolicy> Policy = FMinesweeperSimulation::CreatePolicy(TEXT("Solver"), BenchmarkSeed + Game);
+            Policy->BeginGame(Board);
+            Encoder.BeginGame(Board);
+
+            while (!Board.IsGameOver())
+            {
+                const FMinesweeperMove Move = Policy->ChooseMove(Board);
+                Board.ApplyMove(Move, Revealed);
+                Policy->OnMoveApplied(Move, Revealed);
+
+                const double StartTime = FPlatformTime::Seconds();
+                Encoder.AddMove(Board, Move, Revealed);
+                EncodeSeconds += FPlatformTime::Seconds() - StartTime;
+
+                GridTokens += FMinesweeperPromptEncoder::EstimateTokens(FMinesweeperPromptEncoder::EncodeGrid(Board));
+            }
+
+            const FMinesweeperPromptStats& Stats = Encoder.GetStats();
+            NumMoves += Stats.NumMoves;
+            SentTokens += Stats.SentTokens;
+            AppendedTokens += Stats.AppendedTokens;
+            NumRebaselines += Stats.NumRebaselines;
+        }
+
+        const double Moves = double(FMath::Max<int64>(NumMoves, 1));
+        UE_LOG(LogTemp, Log, TEXT("Prompt encoder: %lld moves over %d expert games. Tokens per move, estimated: grid dump %.0f, frontier prompt %.0f, ")
+            TEXT("appended %.1f (%.1fx fewer than the grid). %d rebaselines, %.2f us to encode a move."),
+            NumMoves, NumGames, GridTokens / Moves, SentTokens / Moves, AppendedTokens / Moves,
+            GridTokens / FMath::Max(double(AppendedTokens), 1.0), NumRebaselines, EncodeSeconds * 1000000.0 / Moves);
+    }
+
+    FAutoConsoleCommand BenchmarkPromptEncoderCommand(
+        TEXT("MinesweeperMind.Benchmark.PromptEncoder"),
+        TEXT("Estimates the agent's prompt tokens per move on expert games, grid dump against frontier diffs. Args: [Games=100]"),
+        FConsoleCommandWithArgsDelegate::CreateStatic(&BenchmarkPromptEncoder));
+
+    FAutoConsoleCommand BenchmarkAdjacencyCommand(
+        TEXT("MinesweeperMind.Benchmark.Adjacency"),
+        TEXT("Compares the bitboard adjacency kernel against the reference 3x3 loop on 100x100, 1000x1000 and 10000x10000 boards."),
+        FConsoleCommandDelegate::CreateStatic(&BenchmarkAdjacency));
+}
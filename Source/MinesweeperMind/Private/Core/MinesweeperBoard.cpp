@@ -0,0 +1,368 @@
+#include "Core/MinesweeperBoard.h"
+
+#include "MinesweeperAdjacency.h"
+#include "MinesweeperMindStats.h"
+#include "Core/MinesweeperRandom.h"
+#include "Math/UnrealMathUtility.h"
+
+void FMinesweeperBoard::Initialize(int32 InNumRows, int32 InNumColumns, int64 InNumMines)
+{
+    NumRows = FMath::Max(0, InNumRows);
+    NumColumns = FMath::Max(0, InNumColumns);
+    checkf(GetNumCells() <= MAX_int32, TEXT("%dx%d is too large for a dense board, use FMinesweeperChunkedBoard."), NumRows, NumColumns);
+
+    // Room is left for the first click's opening wherever it lands, so PlaceMines can always place every mine.
+    const int64 MaxMines = GetNumCells() - int64(FMath::Min(NumRows, 3)) * FMath::Min(NumColumns, 3);
+    NumMines = static_cast<int32>(FMath::Clamp<int64>(InNumMines, 0, MaxMines));
+    if (NumMines != InNumMines)
+    {
+        UE_LOG(LogTemp, Warning, TEXT("A %dx%d board holds %lld mines at most around its opening, using %d instead of %lld."),
+            NumRows, NumColumns, MaxMines, NumMines, InNumMines);
+    }
+
+    SafeCellsRevealed = 0;
+    ExplodedIndex = INDEX_NONE;
+    Seed = 0;
+    SafeCell = FIntPoint(INDEX_NONE, INDEX_NONE);
+    bMinesPlaced = false;
+    bGameOver = false;
+    bGameWon = false;
+
+    Cells.Reset();
+    Cells.SetNumZeroed(static_cast<int32>(GetNumCells()));
+
+    // The stack never holds more than one entry per cell, start with a small slice and let it grow once.
+    RevealStack.Reset();
+    RevealStack.Reserve(FMath::Min(static_cast<int32>(GetNumCells()), 4096));
+}
+
+void FMinesweeperBoard::PlaceMines(uint64 InSeed, const FIntPoint& InSafeCell)
+{
+    MINESWEEPER_SCOPE_CYCLE_COUNTER(PlaceMines);
+
+    Seed = InSeed;
+    SafeCell = IsValidCell(InSafeCell.X, InSafeCell.Y) ? InSafeCell : FIntPoint(INDEX_NONE, INDEX_NONE);
+    bMinesPlaced = true;
+
+    // Cells that must stay clear, in ascending index order so they can be skipped while mapping samples to cells.
+    TArray<int32, TInlineAllocator<9>> ExcludedCells;
+    if (SafeCell.X != INDEX_NONE)
+    {
+        for (int32 NeighborRow = SafeCell.X - 1; NeighborRow <= SafeCell.X + 1; ++NeighborRow)
+        {
+            for (int32 NeighborCol = SafeCell.Y - 1; NeighborCol <= SafeCell.Y + 1; ++NeighborCol)
+            {
+                if (IsValidCell(NeighborRow, NeighborCol))
+                {
+                    ExcludedCells.Add(ToIndex(NeighborRow, NeighborCol));
+                }
+            }
+        }
+    }
+
+    const int32 NumCandidates = static_cast<int32>(GetNumCells()) - ExcludedCells.Num();
+    check(NumMines <= NumCandidates);
+
+    // Sampling happens in [0, NumCandidates), this maps a sample to its cell by stepping over the excluded ones.
+    auto CandidateToCell = [&ExcludedCells](int32 Candidate)
+    {
+        for (const int32 ExcludedCell : ExcludedCells)
+        {
+            if (ExcludedCell <= Candidate)
+            {
+                ++Candidate;
+            }
+        }
+        return Candidate;
+    };
+
+    // Floyd's algorithm draws exactly NumMines distinct samples. The mapping is a bijection, so the board's own
+    // mine bits double as the "already chosen" set and no extra memory is needed.
+    FMinesweeperRandom Random(Seed);
+    for (int32 Candidate = NumCandidates - NumMines; Candidate < NumCandidates; ++Candidate)
+    {
+        const int32 Sample = static_cast<int32>(Random.NextBounded(static_cast<uint32>(Candidate + 1)));
+        const int32 SampleCell = CandidateToCell(Sample);
+
+        const int32 MineCell = (Cells[SampleCell] & MinesweeperCell::Mine) ? CandidateToCell(Candidate) : SampleCell;
+        Cells[MineCell] |= MinesweeperCell::Mine;
+    }
+
+    CalculateAdjacency();
+}
+
+void FMinesweeperBoard::DeferMinePlacement(uint64 InSeed)
+{
+    Seed = InSeed;
+    bMinesPlaced = false;
+}
+
+void FMinesweeperBoard::PlaceMinesFromLayout(TArrayView<const uint8> MineBits, uint64 InSeed, const FIntPoint& InSafeCell)
+{
+    check(MineBits.Num() * 8 >= Cells.Num());
+
+    Seed = InSeed;
+    SafeCell = InSafeCell;
+    bMinesPlaced = true;
+
+    NumMines = 0;
+    for (int32 CellIndex = 0; CellIndex < Cells.Num(); ++CellIndex)
+    {
+        const uint8 Mine = ((MineBits[CellIndex >> 3] >> (CellIndex & 7)) & 1) ? MinesweeperCell::Mine : 0;
+        Cells[CellIndex] = (Cells[CellIndex] & ~MinesweeperCell::Mine) | Mine;
+        NumMines += Mine ? 1 : 0;
+    }
+
+    CalculateAdjacency();
+}
+
+void FMinesweeperBoard::CalculateAdjacency()
+{
+    MINESWEEPER_SCOPE_CYCLE_COUNTER(CalculateAdjacency);
+    FMinesweeperAdjacency::Calculate(Cells.GetData(), NumRows, NumColumns);
+}
+
+EMinesweeperRevealResult FMinesweeperBoard::Reveal(int32 Row, int32 Column, TArray<FIntPoint>& OutRevealed)
+{
+    MINESWEEPER_SCOPE_CYCLE_COUNTER(Reveal);
+
+    OutRevealed.Reset();
+
+    if (bGameOver || !IsValidCell(Row, Column) || IsRevealed(Row, Column))
+    {
+        return EMinesweeperRevealResult::Ignored;
+    }
+
+    if (!bMinesPlaced)
+    {
+        PlaceMines(Seed, FIntPoint(Row, Column));
+    }
+
+    const int32 CellIndex = ToIndex(Row, Column);
+    if (Cells[CellIndex] & MinesweeperCell::Mine)
+    {
+        Cells[CellIndex] |= MinesweeperCell::Revealed;
+        Cells[CellIndex] &= ~MinesweeperCell::Flagged;
+        ExplodedIndex = CellIndex;
+        bGameOver = true;
+        OutRevealed.Add(FIntPoint(Row, Column));
+        return EMinesweeperRevealResult::HitMine;
+    }
+
+    RevealStack.Reset();
+    PushReveal(CellIndex);
+    FloodReveal(OutRevealed);
+    CheckWinCondition();
+    return EMinesweeperRevealResult::Revealed;
+}
+
+void FMinesweeperBoard::ApplyMoves(TArrayView<const FMinesweeperMove> Moves, FMinesweeperChangeSet& OutChanges)
+{
+    MINESWEEPER_SCOPE_CYCLE_COUNTER(ApplyMoves);
+
+    OutChanges.Reset();
+
+    // Safe reveals only seed the stack, the whole batch is flood filled in one pass when a move needs the board
+    // settled or the batch ends. Cells are marked revealed when seeded, so repeats and overlapping fills cost nothing.
+    RevealStack.Reset();
+    auto Settle = [this, &OutChanges]()
+    {
+        if (!RevealStack.IsEmpty())
+        {
+            FloodReveal(OutChanges.Revealed, &OutChanges.Unflagged);
+            CheckWinCondition();
+        }
+    };
+    auto SeedReveal = [this, &OutChanges, &Settle](int32 Row, int32 Column)
+    {
+        if (IsRevealed(Row, Column))
+        {
+            return;
+        }
+
+        if (!bMinesPlaced)
+        {
+            PlaceMines(Seed, FIntPoint(Row, Column));
+        }
+
+        const int32 CellIndex = ToIndex(Row, Column);
+        if ((Cells[CellIndex] & MinesweeperCell::Mine) == 0)
+        {
+            PushReveal(CellIndex);
+            return;
+        }
+
+        // Earlier reveals happened first, and if they won the game this one never does.
+        Settle();
+        if (!bGameOver)
+        {
+            if (Cells[CellIndex] & MinesweeperCell::Flagged)
+            {
+                OutChanges.Unflagged.Add(FIntPoint(Row, Column));
+            }
+            Cells[CellIndex] |= MinesweeperCell::Revealed;
+            Cells[CellIndex] &= ~MinesweeperCell::Flagged;
+            ExplodedIndex = CellIndex;
+            bGameOver = true;
+            OutChanges.Revealed.Add(FIntPoint(Row, Column));
+        }
+    };
+
+    for (const FMinesweeperMove& Move : Moves)
+    {
+        const int32 Row = Move.Cell.X;
+        const int32 Column = Move.Cell.Y;
+        if (bGameOver)
+        {
+            break;
+        }
+        if (!IsValidCell(Row, Column))
+        {
+            continue;
+        }
+
+        switch (Move.Type)
+        {
+        case EMinesweeperMoveType::Reveal:
+            SeedReveal(Row, Column);
+            break;
+
+        case EMinesweeperMoveType::Flag:
+            // A pending fill may still reach this cell, and a revealed cell can't be flagged.
+            Settle();
+            if (ToggleFlag(Row, Column))
+            {
+                OutChanges.Flagged.Add(Move.Cell);
+            }
+            break;
+
+        case EMinesweeperMoveType::Chord:
+            // The count only holds against a settled neighbourhood. The neighbours then join the batch's fill.
+            Settle();
+            if (!bGameOver && CanChord(Row, Column))
+            {
+                for (int32 NeighborRow = Row - 1; NeighborRow <= Row + 1 && !bGameOver; ++NeighborRow)
+                {
+                    for (int32 NeighborCol = Column - 1; NeighborCol <= Column + 1 && !bGameOver; ++NeighborCol)
+                    {
+                        if (IsValidCell(NeighborRow, NeighborCol) && !IsFlagged(NeighborRow, NeighborCol))
+                        {
+                            SeedReveal(NeighborRow, NeighborCol);
+                        }
+                    }
+                }
+            }
+            break;
+        }
+    }
+
+    Settle();
+}
+
+bool FMinesweeperBoard::ToggleFlag(int32 Row, int32 Column)
+{
+    if (bGameOver || !IsValidCell(Row, Column) || IsRevealed(Row, Column))
+    {
+        return false;
+    }
+
+    Cells[ToIndex(Row, Column)] ^= MinesweeperCell::Flagged;
+    return true;
+}
+
+void FMinesweeperBoard::RevertChanges(TArrayView<const int32> Revealed, TArrayView<const int32> Flagged, TArrayView<const int32> Unflagged)
+{
+    for (const int32 CellIndex : Revealed)
+    {
+        Cells[CellIndex] &= ~MinesweeperCell::Revealed;
+        SafeCellsRevealed -= (Cells[CellIndex] & MinesweeperCell::Mine) ? 0 : 1;
+    }
+    for (const int32 CellIndex : Unflagged)
+    {
+        Cells[CellIndex] |= MinesweeperCell::Flagged;
+    }
+    for (const int32 CellIndex : Flagged)
+    {
+        Cells[CellIndex] ^= MinesweeperCell::Flagged;
+    }
+
+    ExplodedIndex = INDEX_NONE;
+    bGameOver = false;
+    bGameWon = false;
+}
+
+FIntPoint FMinesweeperBoard::GetExplodedCell() const
+{
+    if (ExplodedIndex == INDEX_NONE)
+    {
+        return FIntPoint(INDEX_NONE, INDEX_NONE);
+    }
+    return FIntPoint(ExplodedIndex / NumColumns, ExplodedIndex % NumColumns);
+}
+
+void FMinesweeperBoard::PushReveal(int32 CellIndex)
+{
+    // Cells are marked revealed when pushed, so each one enters the stack at most once. Their flag is cleared when
+    // they are popped, where it can be reported.
+    Cells[CellIndex] |= MinesweeperCell::Revealed;
+    RevealStack.Add(CellIndex);
+}
+
+void FMinesweeperBoard::FloodReveal(TArray<FIntPoint>& OutRevealed, TArray<FIntPoint>* OutUnflagged)
+{
+    const int32 NumRevealedBefore = OutRevealed.Num();
+    while (!RevealStack.IsEmpty())
+    {
+        const int32 CellIndex = RevealStack.Pop(EAllowShrinking::No);
+        const int32 Row = CellIndex / NumColumns;
+        const int32 Column = CellIndex - Row * NumColumns;
+
+        OutRevealed.Add(FIntPoint(Row, Column));
+        if (Cells[CellIndex] & MinesweeperCell::Flagged)
+        {
+            Cells[CellIndex] &= ~MinesweeperCell::Flagged;
+            if (OutUnflagged)
+            {
+                OutUnflagged->Add(FIntPoint(Row, Column));
+            }
+        }
+
+        if ((Cells[CellIndex] & MinesweeperCell::AdjacencyMask) != 0)
+        {
+            continue;
+        }
+
+        const int32 MinRow = FMath::Max(Row - 1, 0);
+        const int32 MaxRow = FMath::Min(Row + 1, NumRows - 1);
+        const int32 MinColumn = FMath::Max(Column - 1, 0);
+        const int32 MaxColumn = FMath::Min(Column + 1, NumColumns - 1);
+
+        for (int32 NeighborRow = MinRow; NeighborRow <= MaxRow; ++NeighborRow)
+        {
+            uint8* RowCells = Cells.GetData() + NeighborRow * NumColumns;
+            for (int32 NeighborCol = MinColumn; NeighborCol <= MaxColumn; ++NeighborCol)
+            {
+                uint8& Neighbor = RowCells[NeighborCol];
+                if ((Neighbor & MinesweeperCell::Revealed) == 0)
+                {
+                    // Neighbours of an empty cell are never mines.
+                    Neighbor |= MinesweeperCell::Revealed;
+                    RevealStack.Add(NeighborRow * NumColumns + NeighborCol);
+                }
+            }
+        }
+    }
+
+    SafeCellsRevealed += OutRevealed.Num() - NumRevealedBefore;
+    INC_DWORD_STAT_BY(STAT_MinesweeperCellsRevealed, OutRevealed.Num() - NumRevealedBefore);
+}
+
+void FMinesweeperBoard::CheckWinCondition()
+{
+    const int64 TotalSafeCells = GetNumCells() - NumMines;
+    if (SafeCellsRevealed == TotalSafeCells)
+    {
+        bGameWon = true;
+        bGameOver = true;
+    }
+}
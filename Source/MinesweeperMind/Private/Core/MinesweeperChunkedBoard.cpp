@@ -0,0 +1,571 @@
+#include "Core/MinesweeperChunkedBoard.h"
+
+#include "MinesweeperAdjacency.h"
+#include "MinesweeperMindStats.h"
+#include "Core/MinesweeperRandom.h"
+#include "Math/UnrealMathUtility.h"
+
+namespace
+{
+    /** Chunks idle for this many moves are compressed on the next sweep. */
+    constexpr uint32 ColdMoveThreshold = 256;
+    /** A sweep over all chunks runs every this many moves. */
+    constexpr uint32 CompressionIntervalMoves = 64;
+
+    /** Mine window around a chunk: the chunk plus one cell of each neighbour on every side. */
+    constexpr int32 PaddedSize = FMinesweeperChunkedBoard::ChunkSize + 2;
+
+    /** Revealed rows followed by flagged rows. */
+    constexpr int32 NumStateWords = FMinesweeperChunkedBoard::ChunkSize * 2;
+}
+
+void FMinesweeperChunkedBoard::Initialize(int32 InNumRows, int32 InNumColumns, int64 InNumMines)
+{
+    NumRows = FMath::Max(0, InNumRows);
+    NumColumns = FMath::Max(0, InNumColumns);
+    NumChunkRows = (NumRows + ChunkMask) >> ChunkShift;
+    NumChunkColumns = (NumColumns + ChunkMask) >> ChunkShift;
+
+    const int64 NumCells = GetNumCells();
+    MineDensity = NumCells > 0 ? double(FMath::Clamp<int64>(InNumMines, 0, NumCells)) / double(NumCells) : 0.0;
+    // Per-chunk shares are floor differences of the running total, so the board total is the share of the last cell.
+    NumMines = static_cast<int64>(FMath::FloorToDouble(double(NumCells) * MineDensity));
+
+    SafeCellsRevealed = 0;
+    ExplodedCell = FIntPoint(INDEX_NONE, INDEX_NONE);
+    Seed = 0;
+    SafeCell = FIntPoint(INDEX_NONE, INDEX_NONE);
+    bMinesPlaced = false;
+    bGameOver = false;
+    bGameWon = false;
+
+    Chunks.Reset();
+    CachedChunkKey = MAX_uint64;
+    CachedChunk = nullptr;
+    MoveCounter = 0;
+    ResetReadLayouts();
+
+    RevealStack.Reset();
+    RevealStack.Reserve(CellsPerChunk);
+}
+
+void FMinesweeperChunkedBoard::PlaceMines(uint64 InSeed, const FIntPoint& InSafeCell)
+{
+    Seed = InSeed;
+    SafeCell = IsValidCell(InSafeCell.X, InSafeCell.Y) ? InSafeCell : FIntPoint(INDEX_NONE, INDEX_NONE);
+    bMinesPlaced = true;
+    ResetReadLayouts();
+
+    // A chunk overlapping the opening may be too small to hold its whole share around it, same as a tiny dense board.
+    NumMines = static_cast<int64>(FMath::FloorToDouble(double(GetNumCells()) * MineDensity));
+    if (SafeCell.X != INDEX_NONE)
+    {
+        const int32 MinChunkRow = FMath::Max(SafeCell.X - 1, 0) >> ChunkShift;
+        const int32 MaxChunkRow = FMath::Min(SafeCell.X + 1, NumRows - 1) >> ChunkShift;
+        const int32 MinChunkCol = FMath::Max(SafeCell.Y - 1, 0) >> ChunkShift;
+        const int32 MaxChunkCol = FMath::Min(SafeCell.Y + 1, NumColumns - 1) >> ChunkShift;
+        for (int32 ChunkRow = MinChunkRow; ChunkRow <= MaxChunkRow; ++ChunkRow)
+        {
+            for (int32 ChunkCol = MinChunkCol; ChunkCol <= MaxChunkCol; ++ChunkCol)
+            {
+                TArray<int32, TInlineAllocator<9>> ExcludedCells;
+                GetExcludedCells(ChunkRow, ChunkCol, ExcludedCells);
+
+                const int32 ChunkCells = FMath::Min(ChunkSize, NumRows - (ChunkRow << ChunkShift)) * FMath::Min(ChunkSize, NumColumns - (ChunkCol << ChunkShift));
+                NumMines -= FMath::Max(0, GetChunkMineShare(ChunkRow, ChunkCol) - (ChunkCells - ExcludedCells.Num()));
+            }
+        }
+    }
+
+    // Layouts are generated on demand, chunks touched before placement (flags) only need their state kept.
+    for (TPair<uint64, TUniquePtr<FChunk>>& Pair : Chunks)
+    {
+        CompressChunk(*Pair.Value);
+    }
+}
+
+void FMinesweeperChunkedBoard::DeferMinePlacement(uint64 InSeed)
+{
+    Seed = InSeed;
+    bMinesPlaced = false;
+    ResetReadLayouts();
+}
+
+EMinesweeperRevealResult FMinesweeperChunkedBoard::Reveal(int32 Row, int32 Column, TArray<FIntPoint>& OutRevealed)
+{
+    MINESWEEPER_SCOPE_CYCLE_COUNTER(Reveal);
+
+    OutRevealed.Reset();
+
+    if (bGameOver || !IsValidCell(Row, Column) || IsRevealed(Row, Column))
+    {
+        return EMinesweeperRevealResult::Ignored;
+    }
+
+    if (!bMinesPlaced)
+    {
+        PlaceMines(Seed, FIntPoint(Row, Column));
+    }
+
+    ++MoveCounter;
+
+    uint8& StartCell = AccessCell(Row, Column);
+    StartCell |= MinesweeperCell::Revealed;
+    StartCell &= ~MinesweeperCell::Flagged;
+
+    if (StartCell & MinesweeperCell::Mine)
+    {
+        ExplodedCell = FIntPoint(Row, Column);
+        bGameOver = true;
+        OutRevealed.Add(ExplodedCell);
+        EndMove();
+        return EMinesweeperRevealResult::HitMine;
+    }
+
+    // Same flood fill as the dense board. Chunks never move once created, so cell references stay valid while
+    // neighbouring chunks are created or warmed.
+    RevealStack.Reset();
+    RevealStack.Add(FIntPoint(Row, Column));
+
+    while (!RevealStack.IsEmpty())
+    {
+        const FIntPoint Cell = RevealStack.Pop(EAllowShrinking::No);
+        OutRevealed.Add(Cell);
+
+        if ((AccessCell(Cell.X, Cell.Y) & MinesweeperCell::AdjacencyMask) != 0)
+        {
+            continue;
+        }
+
+        const int32 MinRow = FMath::Max(Cell.X - 1, 0);
+        const int32 MaxRow = FMath::Min(Cell.X + 1, NumRows - 1);
+        const int32 MinColumn = FMath::Max(Cell.Y - 1, 0);
+        const int32 MaxColumn = FMath::Min(Cell.Y + 1, NumColumns - 1);
+
+        for (int32 NeighborRow = MinRow; NeighborRow <= MaxRow; ++NeighborRow)
+        {
+            for (int32 NeighborCol = MinColumn; NeighborCol <= MaxColumn; ++NeighborCol)
+            {
+                uint8& Neighbor = AccessCell(NeighborRow, NeighborCol);
+                if ((Neighbor & MinesweeperCell::Revealed) == 0)
+                {
+                    Neighbor |= MinesweeperCell::Revealed;
+                    Neighbor &= ~MinesweeperCell::Flagged;
+                    RevealStack.Add(FIntPoint(NeighborRow, NeighborCol));
+                }
+            }
+        }
+    }
+
+    SafeCellsRevealed += OutRevealed.Num();
+    INC_DWORD_STAT_BY(STAT_MinesweeperCellsRevealed, OutRevealed.Num());
+    CheckWinCondition();
+    EndMove();
+    return EMinesweeperRevealResult::Revealed;
+}
+
+uint8 FMinesweeperChunkedBoard::GetCell(int32 Row, int32 Column) const
+{
+    const int32 LocalRow = Row & ChunkMask;
+    const int32 LocalColumn = Column & ChunkMask;
+    const FChunk* Chunk = FindChunk(Row >> ChunkShift, Column >> ChunkShift);
+    if (Chunk && !Chunk->Cells.IsEmpty())
+    {
+        return Chunk->Cells[(LocalRow << ChunkShift) | LocalColumn];
+    }
+
+    // What warming the chunk would produce, without creating it.
+    uint8 Cell = 0;
+    if (bMinesPlaced)
+    {
+        if (IsLayoutMine(Row, Column))
+        {
+            Cell = MinesweeperCell::Mine;
+        }
+        else
+        {
+            const int32 MaxRow = FMath::Min(Row + 1, NumRows - 1);
+            const int32 MaxColumn = FMath::Min(Column + 1, NumColumns - 1);
+            for (int32 NeighborRow = FMath::Max(Row - 1, 0); NeighborRow <= MaxRow; ++NeighborRow)
+            {
+                for (int32 NeighborCol = FMath::Max(Column - 1, 0); NeighborCol <= MaxColumn; ++NeighborCol)
+                {
+                    Cell += IsLayoutMine(NeighborRow, NeighborCol) ? 1 : 0;
+                }
+            }
+        }
+    }
+    if (Chunk)
+    {
+        Cell |= ReadCompressedState(*Chunk, LocalRow, LocalColumn);
+    }
+    return Cell;
+}
+
+bool FMinesweeperChunkedBoard::ToggleFlag(int32 Row, int32 Column)
+{
+    if (bGameOver || !IsValidCell(Row, Column) || IsRevealed(Row, Column))
+    {
+        return false;
+    }
+
+    ++MoveCounter;
+    AccessCell(Row, Column) ^= MinesweeperCell::Flagged;
+    EndMove();
+    return true;
+}
+
+SIZE_T FMinesweeperChunkedBoard::GetAllocatedSize() const
+{
+    SIZE_T Size = Chunks.GetAllocatedSize() + RevealStack.GetAllocatedSize();
+    for (const TPair<uint64, TUniquePtr<FChunk>>& Pair : Chunks)
+    {
+        Size += sizeof(FChunk) + Pair.Value->Cells.GetAllocatedSize() + Pair.Value->CompressedState.GetAllocatedSize();
+    }
+    return Size;
+}
+
+void FMinesweeperChunkedBoard::CompressColdChunks()
+{
+    for (TPair<uint64, TUniquePtr<FChunk>>& Pair : Chunks)
+    {
+        FChunk& Chunk = *Pair.Value;
+        if (!Chunk.Cells.IsEmpty() && MoveCounter - Chunk.LastTouchedMove > ColdMoveThreshold)
+        {
+            CompressChunk(Chunk);
+        }
+    }
+}
+
+int32 FMinesweeperChunkedBoard::GetNumCompressedChunks() const
+{
+    int32 NumCompressed = 0;
+    for (const TPair<uint64, TUniquePtr<FChunk>>& Pair : Chunks)
+    {
+        NumCompressed += Pair.Value->Cells.IsEmpty() ? 1 : 0;
+    }
+    return NumCompressed;
+}
+
+uint8* FMinesweeperChunkedBoard::GetHotChunkCells(int32 ChunkRow, int32 ChunkColumn)
+{
+    const uint64 Key = MakeChunkKey(ChunkRow, ChunkColumn);
+    if (Key != CachedChunkKey)
+    {
+        TUniquePtr<FChunk>& Chunk = Chunks.FindOrAdd(Key);
+        if (!Chunk.IsValid())
+        {
+            Chunk = MakeUnique<FChunk>();
+        }
+        CachedChunkKey = Key;
+        CachedChunk = Chunk.Get();
+    }
+
+    if (CachedChunk->Cells.IsEmpty())
+    {
+        WarmChunk(*CachedChunk, ChunkRow, ChunkColumn);
+    }
+    CachedChunk->LastTouchedMove = MoveCounter;
+    return CachedChunk->Cells.GetData();
+}
+
+void FMinesweeperChunkedBoard::WarmChunk(FChunk& Chunk, int32 ChunkRow, int32 ChunkColumn) const
+{
+    Chunk.Cells.SetNumZeroed(CellsPerChunk);
+
+    if (bMinesPlaced)
+    {
+        // Chunked boards place their mines here, one chunk at a time as play first touches it.
+        MINESWEEPER_SCOPE_CYCLE_COUNTER(PlaceMines);
+
+        // Stamp the mines of this chunk and the bordering cells of its neighbours into a padded window, then let the
+        // adjacency kernel count it. Neighbour layouts are regenerated, never stored.
+        uint8 Padded[PaddedSize * PaddedSize] = {};
+        uint64 RowBits[ChunkSize];
+
+        for (int32 OffsetRow = -1; OffsetRow <= 1; ++OffsetRow)
+        {
+            for (int32 OffsetCol = -1; OffsetCol <= 1; ++OffsetCol)
+            {
+                const int32 NeighborChunkRow = ChunkRow + OffsetRow;
+                const int32 NeighborChunkCol = ChunkColumn + OffsetCol;
+                if (NeighborChunkRow < 0 || NeighborChunkRow >= NumChunkRows || NeighborChunkCol < 0 || NeighborChunkCol >= NumChunkColumns)
+                {
+                    continue;
+                }
+
+                BuildMineLayout(NeighborChunkRow, NeighborChunkCol, RowBits);
+
+                for (int32 LocalRow = 0; LocalRow < ChunkSize; ++LocalRow)
+                {
+                    const int32 PaddedRow = OffsetRow * ChunkSize + LocalRow + 1;
+                    if (PaddedRow < 0 || PaddedRow >= PaddedSize)
+                    {
+                        continue;
+                    }
+
+                    for (uint64 Bits = RowBits[LocalRow]; Bits != 0; Bits &= Bits - 1)
+                    {
+                        const int32 PaddedCol = OffsetCol * ChunkSize + static_cast<int32>(FMath::CountTrailingZeros64(Bits)) + 1;
+                        if (PaddedCol >= 0 && PaddedCol < PaddedSize)
+                        {
+                            Padded[PaddedRow * PaddedSize + PaddedCol] = MinesweeperCell::Mine;
+                        }
+                    }
+                }
+            }
+        }
+
+        FMinesweeperAdjacency::Calculate(Padded, PaddedSize, PaddedSize);
+
+        for (int32 LocalRow = 0; LocalRow < ChunkSize; ++LocalRow)
+        {
+            FMemory::Memcpy(&Chunk.Cells[LocalRow << ChunkShift], &Padded[(LocalRow + 1) * PaddedSize + 1], ChunkSize);
+        }
+    }
+
+    if (!Chunk.CompressedState.IsEmpty())
+    {
+        int32 WordIndex = 0;
+        for (int32 Offset = 0; Offset < Chunk.CompressedState.Num(); Offset += 1 + sizeof(uint64))
+        {
+            const int32 RunLength = Chunk.CompressedState[Offset];
+            uint64 Word;
+            FMemory::Memcpy(&Word, &Chunk.CompressedState[Offset + 1], sizeof(uint64));
+
+            for (int32 Run = 0; Run < RunLength; ++Run, ++WordIndex)
+            {
+                const uint8 StateBit = WordIndex < ChunkSize ? MinesweeperCell::Revealed : MinesweeperCell::Flagged;
+                const int32 LocalRow = WordIndex & ChunkMask;
+                for (uint64 Bits = Word; Bits != 0; Bits &= Bits - 1)
+                {
+                    Chunk.Cells[(LocalRow << ChunkShift) | static_cast<int32>(FMath::CountTrailingZeros64(Bits))] |= StateBit;
+                }
+            }
+        }
+        Chunk.CompressedState.Empty();
+    }
+}
+
+void FMinesweeperChunkedBoard::CompressChunk(FChunk& Chunk)
+{
+    if (Chunk.Cells.IsEmpty())
+    {
+        return;
+    }
+
+    uint64 StateWords[NumStateWords] = {};
+    for (int32 LocalRow = 0; LocalRow < ChunkSize; ++LocalRow)
+    {
+        const uint8* RowCells = &Chunk.Cells[LocalRow << ChunkShift];
+        for (int32 LocalCol = 0; LocalCol < ChunkSize; ++LocalCol)
+        {
+            StateWords[LocalRow] |= uint64((RowCells[LocalCol] & MinesweeperCell::Revealed) != 0) << LocalCol;
+            StateWords[ChunkSize + LocalRow] |= uint64((RowCells[LocalCol] & MinesweeperCell::Flagged) != 0) << LocalCol;
+        }
+    }
+
+    // Explored chunks are mostly all-ones or all-zero rows, so runs of equal words shrink them to a few bytes.
+    Chunk.CompressedState.Reset();
+    for (int32 WordIndex = 0; WordIndex < NumStateWords;)
+    {
+        int32 RunLength = 1;
+        while (WordIndex + RunLength < NumStateWords && RunLength < MAX_uint8 && StateWords[WordIndex + RunLength] == StateWords[WordIndex])
+        {
+            ++RunLength;
+        }
+
+        const int32 Offset = Chunk.CompressedState.AddUninitialized(1 + sizeof(uint64));
+        Chunk.CompressedState[Offset] = static_cast<uint8>(RunLength);
+        FMemory::Memcpy(&Chunk.CompressedState[Offset + 1], &StateWords[WordIndex], sizeof(uint64));
+        WordIndex += RunLength;
+    }
+    Chunk.CompressedState.Shrink();
+
+    Chunk.Cells.Empty();
+    if (&Chunk == CachedChunk)
+    {
+        CachedChunkKey = MAX_uint64;
+        CachedChunk = nullptr;
+    }
+}
+
+const FMinesweeperChunkedBoard::FChunk* FMinesweeperChunkedBoard::FindChunk(int32 ChunkRow, int32 ChunkColumn) const
+{
+    const uint64 Key = MakeChunkKey(ChunkRow, ChunkColumn);
+    if (Key == CachedChunkKey)
+    {
+        return CachedChunk;
+    }
+    const TUniquePtr<FChunk>* Chunk = Chunks.Find(Key);
+    return Chunk ? Chunk->Get() : nullptr;
+}
+
+uint8 FMinesweeperChunkedBoard::ReadCompressedState(const FChunk& Chunk, int32 LocalRow, int32 LocalColumn)
+{
+    // The revealed word of the row is WordIndex LocalRow, its flagged word ChunkSize + LocalRow.
+    const int32 RevealedWord = LocalRow;
+    const int32 FlaggedWord = ChunkSize + LocalRow;
+
+    uint8 State = 0;
+    int32 WordIndex = 0;
+    for (int32 Offset = 0; Offset < Chunk.CompressedState.Num() && WordIndex <= FlaggedWord; Offset += 1 + sizeof(uint64))
+    {
+        const int32 RunLength = Chunk.CompressedState[Offset];
+        const bool bHasRevealedWord = WordIndex <= RevealedWord && RevealedWord < WordIndex + RunLength;
+        const bool bHasFlaggedWord = WordIndex <= FlaggedWord && FlaggedWord < WordIndex + RunLength;
+        if (bHasRevealedWord || bHasFlaggedWord)
+        {
+            uint64 Word;
+            FMemory::Memcpy(&Word, &Chunk.CompressedState[Offset + 1], sizeof(uint64));
+            if ((Word >> LocalColumn) & 1)
+            {
+                State |= (bHasRevealedWord ? MinesweeperCell::Revealed : 0) | (bHasFlaggedWord ? MinesweeperCell::Flagged : 0);
+            }
+        }
+        WordIndex += RunLength;
+    }
+    return State;
+}
+
+bool FMinesweeperChunkedBoard::IsLayoutMine(int32 Row, int32 Column) const
+{
+    const int32 ChunkRow = Row >> ChunkShift;
+    const int32 ChunkColumn = Column >> ChunkShift;
+    const uint64 Key = MakeChunkKey(ChunkRow, ChunkColumn);
+
+    FReadLayout* Layout = nullptr;
+    for (FReadLayout& ReadLayout : ReadLayouts)
+    {
+        if (ReadLayout.Key == Key)
+        {
+            Layout = &ReadLayout;
+            break;
+        }
+    }
+    if (!Layout)
+    {
+        Layout = &ReadLayouts[NextReadLayout];
+        NextReadLayout = (NextReadLayout + 1) % static_cast<int32>(UE_ARRAY_COUNT(ReadLayouts));
+        BuildMineLayout(ChunkRow, ChunkColumn, Layout->RowBits);
+        Layout->Key = Key;
+    }
+    return ((Layout->RowBits[Row & ChunkMask] >> (Column & ChunkMask)) & 1) != 0;
+}
+
+void FMinesweeperChunkedBoard::ResetReadLayouts()
+{
+    for (FReadLayout& ReadLayout : ReadLayouts)
+    {
+        ReadLayout.Key = MAX_uint64;
+    }
+    NextReadLayout = 0;
+}
+
+void FMinesweeperChunkedBoard::BuildMineLayout(int32 ChunkRow, int32 ChunkColumn, uint64 (&OutRowBits)[ChunkSize]) const
+{
+    FMemory::Memzero(OutRowBits, sizeof(OutRowBits));
+
+    const int32 FirstRow = ChunkRow << ChunkShift;
+    const int32 FirstColumn = ChunkColumn << ChunkShift;
+    const int32 ChunkRows = FMath::Min(ChunkSize, NumRows - FirstRow);
+    const int32 ChunkColumns = FMath::Min(ChunkSize, NumColumns - FirstColumn);
+
+    TArray<int32, TInlineAllocator<9>> ExcludedCells;
+    GetExcludedCells(ChunkRow, ChunkColumn, ExcludedCells);
+
+    const int32 NumCandidates = ChunkRows * ChunkColumns - ExcludedCells.Num();
+    const int32 ChunkMines = FMath::Min(GetChunkMineShare(ChunkRow, ChunkColumn), NumCandidates);
+
+    auto CandidateToCell = [&ExcludedCells](int32 Candidate)
+    {
+        for (const int32 ExcludedCell : ExcludedCells)
+        {
+            if (ExcludedCell <= Candidate)
+            {
+                ++Candidate;
+            }
+        }
+        return Candidate;
+    };
+
+    auto TestAndSet = [&OutRowBits, ChunkColumns](int32 LocalCell)
+    {
+        const int32 LocalRow = LocalCell / ChunkColumns;
+        const uint64 Bit = 1ull << (LocalCell - LocalRow * ChunkColumns);
+        const bool bWasSet = (OutRowBits[LocalRow] & Bit) != 0;
+        OutRowBits[LocalRow] |= Bit;
+        return bWasSet;
+    };
+
+    // Same Floyd sampling as the dense board, on a stream private to this chunk.
+    FMinesweeperRandom Random(Seed, MakeChunkKey(ChunkRow, ChunkColumn));
+    for (int32 Candidate = NumCandidates - ChunkMines; Candidate < NumCandidates; ++Candidate)
+    {
+        const int32 Sample = static_cast<int32>(Random.NextBounded(static_cast<uint32>(Candidate + 1)));
+        if (TestAndSet(CandidateToCell(Sample)))
+        {
+            TestAndSet(CandidateToCell(Candidate));
+        }
+    }
+}
+
+int32 FMinesweeperChunkedBoard::GetChunkMineShare(int32 ChunkRow, int32 ChunkColumn) const
+{
+    const int32 FirstRow = ChunkRow << ChunkShift;
+    const int32 FirstColumn = ChunkColumn << ChunkShift;
+    const int32 ChunkRows = FMath::Min(ChunkSize, NumRows - FirstRow);
+    const int32 ChunkColumns = FMath::Min(ChunkSize, NumColumns - FirstColumn);
+
+    // Chunks are numbered row band by row band, so the cells before this one are all full bands above it plus the
+    // earlier chunks of its own band. Flooring the running total keeps the per-chunk shares summing to the board total.
+    const int64 CellsBefore = int64(FirstRow) * NumColumns + int64(ChunkRows) * FirstColumn;
+    const int64 MinesBefore = static_cast<int64>(FMath::FloorToDouble(double(CellsBefore) * MineDensity));
+    const int64 MinesThrough = static_cast<int64>(FMath::FloorToDouble(double(CellsBefore + ChunkRows * ChunkColumns) * MineDensity));
+    return static_cast<int32>(MinesThrough - MinesBefore);
+}
+
+void FMinesweeperChunkedBoard::GetExcludedCells(int32 ChunkRow, int32 ChunkColumn, TArray<int32, TInlineAllocator<9>>& OutExcludedCells) const
+{
+    if (SafeCell.X == INDEX_NONE)
+    {
+        return;
+    }
+
+    const int32 FirstRow = ChunkRow << ChunkShift;
+    const int32 FirstColumn = ChunkColumn << ChunkShift;
+    const int32 ChunkRows = FMath::Min(ChunkSize, NumRows - FirstRow);
+    const int32 ChunkColumns = FMath::Min(ChunkSize, NumColumns - FirstColumn);
+
+    // Local indices of the opening's 3x3 that fall inside this chunk, ascending.
+    for (int32 NeighborRow = SafeCell.X - 1; NeighborRow <= SafeCell.X + 1; ++NeighborRow)
+    {
+        for (int32 NeighborCol = SafeCell.Y - 1; NeighborCol <= SafeCell.Y + 1; ++NeighborCol)
+        {
+            const int32 LocalRow = NeighborRow - FirstRow;
+            const int32 LocalCol = NeighborCol - FirstColumn;
+            if (LocalRow >= 0 && LocalRow < ChunkRows && LocalCol >= 0 && LocalCol < ChunkColumns)
+            {
+                OutExcludedCells.Add(LocalRow * ChunkColumns + LocalCol);
+            }
+        }
+    }
+}
+
+void FMinesweeperChunkedBoard::EndMove()
+{
+    if (MoveCounter % CompressionIntervalMoves == 0)
+    {
+        CompressColdChunks();
+    }
+}
+
+void FMinesweeperChunkedBoard::CheckWinCondition()
+{
+    const int64 TotalSafeCells = GetNumCells() - NumMines;
+    if (SafeCellsRevealed == TotalSafeCells)
+    {
+        bGameWon = true;
+        bGameOver = true;
+    }
+}
@@ -0,0 +1,266 @@
+#include "Core/MinesweeperDimensionCache.h"
+
+#include "Core/MinesweeperInferenceClient.h"
+#include "Core/MinesweeperIntentParser.h"
+#include "Dom/JsonObject.h"
+#include "HAL/FileManager.h"
+#include "HAL/IConsoleManager.h"
+#include "HAL/PlatformTime.h"
+#include "Interfaces/IPluginManager.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "Misc/ScopeLock.h"
+#include "Misc/SecureHash.h"
+#include "Serialization/JsonReader.h"
+#include "Serialization/JsonSerializer.h"
+#include "Serialization/JsonWriter.h"
+
+namespace
+{
+    /** Bump when the entry format or the normalization changes, old entries then stop matching. 2 stores the reply text. */
+    constexpr int32 CacheFormatVersion = 2;
+
+    TAutoConsoleVariable<bool> CVarCacheEnabled(
+        TEXT("MinesweeperMind.DimensionCache.Enabled"),
+        true,
+        TEXT("Reuse earlier generate_dimensions answers for the same normalized request."));
+
+    TAutoConsoleVariable<int32> CVarMemoryEntries(
+        TEXT("MinesweeperMind.DimensionCache.MemoryEntries"),
+        256,
+        TEXT("Answers kept in memory, read when the cache is first used. Every answer is also kept on disk."));
+
+    FString GetPluginDir(const TCHAR* RelativePath)
+    {
+        const TSharedPtr<IPlugin> Plugin = IPluginManager::Get().FindPlugin(TEXT("MinesweeperMind"));
+        return Plugin.IsValid() ? FPaths::ConvertRelativePathToFull(Plugin->GetBaseDir() / RelativePath) : FString();
+    }
+
+    FString HashString(const FString& Text)
+    {
+        const FTCHARToUTF8 Utf8(*Text);
+        FMD5 Md5;
+        Md5.Update(reinterpret_cast<const uint8*>(Utf8.Get()), Utf8.Length());
+        FMD5Hash Hash;
+        Hash.Set(Md5);
+        return LexToString(Hash);
+    }
+
+    TSharedPtr<FJsonObject> LoadEntry(const FString& Path, const FString& Query)
+    {
+        FString Json;
+        if (!FFileHelper::LoadFileToString(Json, *Path))
+        {
+            return nullptr;
+        }
+
+        TSharedPtr<FJsonObject> Entry;
+        const TSharedRef<TJsonReader<>> Reader = TJsonReaderFactory<>::Create(Json);
+        const TSharedPtr<FJsonObject>* Result = nullptr;
+        FString StoredQuery;
+        // The file name is a hash, the stored query rules out a collision.
+        if (!FJsonSerializer::Deserialize(Reader, Entry) || !Entry.IsValid() || !Entry->TryGetStringField(TEXT("query"), StoredQuery)
+            || StoredQuery != Query || !Entry->TryGetObjectField(TEXT("result"), Result))
+        {
+            return nullptr;
+        }
+        return *Result;
+    }
+
+    FAutoConsoleCommand DimensionCacheStatsCommand(
+        TEXT("MinesweeperMind.DimensionCache.Stats"),
+        TEXT("Logs hits, misses and lookup times of the generate_dimensions cache."),
+        FConsoleCommandDelegate::CreateLambda([]()
+        {
+            const FMinesweeperDimensionCacheStats Stats = FMinesweeperDimensionCache::Get().GetStats();
+            const int32 NumLookups = Stats.GetNumHits() + Stats.NumMisses;
+            UE_LOG(LogTemp, Log, TEXT("Dimension cache: %d memory hits, %d disk hits, %d misses (%.0f%% hit rate), %.1f us per lookup, %.2f s per model answer"),
+                Stats.NumMemoryHits, Stats.NumDiskHits, Stats.NumMisses, Stats.GetHitRate() * 100.0,
+                NumLookups > 0 ? Stats.LookupSeconds * 1000000.0 / NumLookups : 0.0,
+                Stats.NumStores > 0 ? Stats.ModelSeconds / Stats.NumStores : 0.0);
+        }));
+
+    FAutoConsoleCommand DimensionCacheClearCommand(
+        TEXT("MinesweeperMind.DimensionCache.Clear"),
+        TEXT("Forgets every cached generate_dimensions answer, in memory and on disk."),
+        FConsoleCommandDelegate::CreateLambda([]()
+        {
+            FMinesweeperDimensionCache::Get().Clear();
+        }));
+}
+
+FMinesweeperDimensionCache& FMinesweeperDimensionCache::Get()
+{
+    static FMinesweeperDimensionCache Cache(GetPluginDir(TEXT("Saved/QueryCache")), CVarMemoryEntries.GetValueOnAnyThread());
+    return Cache;
+}
+
+FMinesweeperDimensionCache::FMinesweeperDimensionCache(const FString& InDirectory, int32 InMaxMemoryEntries, const FString& InContentDir)
+    : Directory(InDirectory)
+    , ContentDir(InContentDir.IsEmpty() ? GetPluginDir(TEXT("Content")) : InContentDir)
+    , MaxMemoryEntries(FMath::Max(1, InMaxMemoryEntries))
+    , MemoryEntries(MaxMemoryEntries)
+{
+}
+
+TSharedPtr<FJsonObject> FMinesweeperDimensionCache::Find(const FString& Query)
+{
+    if (!CVarCacheEnabled.GetValueOnAnyThread())
+    {
+        return nullptr;
+    }
+
+    const double StartTime = FPlatformTime::Seconds();
+    const FString NormalizedQuery = FMinesweeperIntentParser::Normalize(Query);
+
+    FScopeLock Lock(&Mutex);
+    const FString Fingerprint = GetFingerprint();
+    const FString Key = Fingerprint + TEXT("|") + NormalizedQuery;
+    TSharedPtr<FJsonObject> Result;
+    if (NormalizedQuery.IsEmpty())
+    {
+        ++Stats.NumMisses;
+    }
+    else if (const TSharedPtr<FJsonObject>* MemoryResult = MemoryEntries.FindAndTouch(Key))
+    {
+        Result = *MemoryResult;
+        ++Stats.NumMemoryHits;
+    }
+    else
+    {
+        const FString EntryDirectory = GetEntryDirectory(Fingerprint);
+        Result = EntryDirectory.IsEmpty() ? nullptr : LoadEntry(EntryDirectory / HashString(NormalizedQuery) + TEXT(".json"), NormalizedQuery);
+        if (Result.IsValid())
+        {
+            MemoryEntries.Add(Key, Result);
+            ++Stats.NumDiskHits;
+        }
+        else
+        {
+            ++Stats.NumMisses;
+        }
+    }
+
+    Stats.LookupSeconds += FPlatformTime::Seconds() - StartTime;
+    return Result;
+}
+
+void FMinesweeperDimensionCache::Add(const FString& Query, const TSharedRef<FJsonObject>& Result, double ModelSeconds)
+{
+    const FString NormalizedQuery = FMinesweeperIntentParser::Normalize(Query);
+    if (!CVarCacheEnabled.GetValueOnAnyThread() || NormalizedQuery.IsEmpty())
+    {
+        return;
+    }
+
+    FScopeLock Lock(&Mutex);
+    const FString Fingerprint = GetFingerprint();
+    MemoryEntries.Add(Fingerprint + TEXT("|") + NormalizedQuery, Result);
+    ++Stats.NumStores;
+    Stats.ModelSeconds += ModelSeconds;
+
+    const FString EntryDirectory = GetEntryDirectory(Fingerprint);
+    if (EntryDirectory.IsEmpty())
+    {
+        return;
+    }
+
+    TSharedRef<FJsonObject> Entry = MakeShared<FJsonObject>();
+    Entry->SetStringField(TEXT("query"), NormalizedQuery);
+    Entry->SetObjectField(TEXT("result"), Result);
+
+    FString Json;
+    const TSharedRef<TJsonWriter<>> Writer = TJsonWriterFactory<>::Create(&Json);
+    const FString Path = EntryDirectory / HashString(NormalizedQuery) + TEXT(".json");
+    if (!FJsonSerializer::Serialize(Entry, Writer) || !FFileHelper::SaveStringToFile(Json, *Path))
+    {
+        UE_LOG(LogTemp, Warning, TEXT("Could not write dimension cache entry %s"), *Path);
+    }
+}
+
+void FMinesweeperDimensionCache::Clear()
+{
+    FScopeLock Lock(&Mutex);
+    MemoryEntries.Empty(MaxMemoryEntries);
+    PrunedFingerprint.Reset();
+    CachedFingerprint.Reset();
+    if (!Directory.IsEmpty())
+    {
+        IFileManager::Get().DeleteDirectory(*Directory, false, true);
+    }
+}
+
+void FMinesweeperDimensionCache::InvalidateFingerprint()
+{
+    FScopeLock Lock(&Mutex);
+    CachedFingerprint.Reset();
+}
+
+FMinesweeperDimensionCacheStats FMinesweeperDimensionCache::GetStats() const
+{
+    FScopeLock Lock(&Mutex);
+    return Stats;
+}
+
+const FString& FMinesweeperDimensionCache::GetFingerprint()
+{
+    const FMinesweeperInferenceWorkerSettings Settings = FMinesweeperInferenceClient::Get()->GetSettings();
+    const FString WorkerCommandLine = FString::Printf(TEXT("%s %s"), *Settings.Executable, *Settings.Arguments);
+    if (CachedFingerprint.IsEmpty() || FingerprintWorkerCommandLine != WorkerCommandLine)
+    {
+        CachedFingerprint = ComputeFingerprint(WorkerCommandLine);
+        FingerprintWorkerCommandLine = WorkerCommandLine;
+    }
+    return CachedFingerprint;
+}
+
+FString FMinesweeperDimensionCache::ComputeFingerprint(const FString& WorkerCommandLine) const
+{
+    // Size and timestamp rather than a content hash, hashing a model of several hundred megabytes would cost far more
+    // than the cache saves. A re-download or a swapped file changes both.
+    FString Description = FString::Printf(TEXT("format %d\n"), CacheFormatVersion);
+    Description += WorkerCommandLine + TEXT("\n");
+
+    const FString ModelsDir = ContentDir / TEXT("LargeLanguageModels");
+    TArray<FString> ModelFiles;
+    IFileManager::Get().FindFiles(ModelFiles, *(ModelsDir / TEXT("*.gguf")), true, false);
+    ModelFiles.Sort();
+    for (const FString& ModelFile : ModelFiles)
+    {
+        const FString ModelPath = ModelsDir / ModelFile;
+        Description += FString::Printf(TEXT("%s %lld %s\n"), *ModelFile, IFileManager::Get().FileSize(*ModelPath),
+            *IFileManager::Get().GetTimeStamp(*ModelPath).ToString());
+    }
+
+    // The prompt template lives in the generator script and the reply grammar next to it, any edit to either may change
+    // the answers.
+    Description += LexToString(FMD5Hash::HashFile(*(ContentDir / TEXT("Scripts/game_dimension_generator.py"))));
+    Description += LexToString(FMD5Hash::HashFile(*(ContentDir / TEXT("Scripts/reply_grammars.py"))));
+
+    return HashString(Description);
+}
+
+FString FMinesweeperDimensionCache::GetEntryDirectory(const FString& Fingerprint)
+{
+    if (Directory.IsEmpty())
+    {
+        return FString();
+    }
+
+    if (PrunedFingerprint != Fingerprint)
+    {
+        TArray<FString> FingerprintDirs;
+        IFileManager::Get().FindFiles(FingerprintDirs, *(Directory / TEXT("*")), false, true);
+        for (const FString& FingerprintDir : FingerprintDirs)
+        {
+            if (FingerprintDir != Fingerprint)
+            {
+                UE_LOG(LogTemp, Log, TEXT("Model or prompt changed, removing stale dimension cache %s"), *FingerprintDir);
+                IFileManager::Get().DeleteDirectory(*(Directory / FingerprintDir), false, true);
+            }
+        }
+        PrunedFingerprint = Fingerprint;
+    }
+
+    return Directory / Fingerprint;
+}
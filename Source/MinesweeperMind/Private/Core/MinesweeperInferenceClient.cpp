@@ -0,0 +1,373 @@
+#include "Core/MinesweeperInferenceClient.h"
+#include "MinesweeperMindStats.h"
+
+#include "Dom/JsonObject.h"
+#include "HAL/IConsoleManager.h"
+#include "HAL/PlatformTime.h"
+#include "Interfaces/IPluginManager.h"
+#include "Misc/Paths.h"
+#include "Misc/ScopeLock.h"
+#include "Serialization/JsonReader.h"
+#include "Serialization/JsonSerializer.h"
+#include "Serialization/JsonWriter.h"
+
+namespace
+{
+    constexpr int32 FrameHeaderBytes = 4;
+    /** Matches MAX_FRAME_BYTES in inference_worker.py, anything longer means the stream is out of sync. */
+    constexpr uint32 MaxFrameBytes = 16 * 1024 * 1024;
+    /** How long a stopping worker gets to exit on its own once its stdin is closed. */
+    constexpr double WorkerExitGraceSeconds = 2.0;
+
+    TAutoConsoleVariable<FString> CVarWorkerExecutable(
+        TEXT("MinesweeperMind.Inference.WorkerExecutable"),
+        TEXT("python"),
+        TEXT("Program that runs the inference worker."));
+
+    TAutoConsoleVariable<FString> CVarWorkerArguments(
+        TEXT("MinesweeperMind.Inference.WorkerArguments"),
+        TEXT(""),
+        TEXT("Inference worker command line. Empty runs the plugin's inference_worker.py, add --stub to that script to run without a model."));
+
+    TAutoConsoleVariable<float> CVarTimeoutSeconds(
+        TEXT("MinesweeperMind.Inference.TimeoutSeconds"),
+        120.f,
+        TEXT("Longest an inference request waits for its answer."));
+
+    FCriticalSection SharedClientMutex;
+    TSharedPtr<FMinesweeperInferenceClient> SharedClient;
+
+    FString GetScriptsDir()
+    {
+        const TSharedPtr<IPlugin> Plugin = IPluginManager::Get().FindPlugin(TEXT("MinesweeperMind"));
+        return Plugin.IsValid() ? FPaths::ConvertRelativePathToFull(Plugin->GetBaseDir() / TEXT("Content/Scripts")) : FString();
+    }
+}
+
+FMinesweeperInferenceClient::FMinesweeperInferenceClient(const FMinesweeperInferenceWorkerSettings& InSettings)
+    : Settings(InSettings)
+{
+}
+
+FMinesweeperInferenceClient::~FMinesweeperInferenceClient()
+{
+    Stop();
+}
+
+bool FMinesweeperInferenceClient::Call(const FString& Method, const TSharedRef<FJsonObject>& Params, TSharedPtr<FJsonObject>& OutResult, FString& OutError)
+{
+    return CallInternal(Method, Params, nullptr, nullptr, OutResult, OutError);
+}
+
+bool FMinesweeperInferenceClient::CallStreaming(const FString& Method, const TSharedRef<FJsonObject>& Params, TFunctionRef<void(const FString&)> OnToken,
+    const std::atomic<bool>& bCancelRequested, TSharedPtr<FJsonObject>& OutResult, FString& OutError)
+{
+    return CallInternal(Method, Params, &OnToken, &bCancelRequested, OutResult, OutError);
+}
+
+bool FMinesweeperInferenceClient::CallInternal(const FString& Method, const TSharedRef<FJsonObject>& Params, const TFunctionRef<void(const FString&)>* OnToken,
+    const std::atomic<bool>* bCancelRequested, TSharedPtr<FJsonObject>& OutResult, FString& OutError)
+{
+    MINESWEEPER_SCOPE_CYCLE_COUNTER(InferenceCall);
+
+    FScopeLock Lock(&Mutex);
+    OutResult.Reset();
+    const double StartTime = FPlatformTime::Seconds();
+    int32 NumStreamedTokens = 0;
+
+    const int64 RequestId = NextRequestId++;
+    TSharedRef<FJsonObject> Request = MakeShared<FJsonObject>();
+    Request->SetNumberField(TEXT("id"), double(RequestId));
+    Request->SetStringField(TEXT("method"), Method);
+    Request->SetObjectField(TEXT("params"), Params);
+    if (OnToken)
+    {
+        Request->SetBoolField(TEXT("stream"), true);
+    }
+
+    FString RequestJson;
+    const TSharedRef<TJsonWriter<TCHAR, TCondensedJsonPrintPolicy<TCHAR>>> Writer = TJsonWriterFactory<TCHAR, TCondensedJsonPrintPolicy<TCHAR>>::Create(&RequestJson);
+    FJsonSerializer::Serialize(Request, Writer);
+
+    for (int32 Restarts = 0; ; ++Restarts)
+    {
+        if (!(Process.IsValid() && FPlatformProcess::IsProcRunning(Process)) && !StartWorker(OutError))
+        {
+            return false;
+        }
+
+        double Deadline = FPlatformTime::Seconds() + Settings.TimeoutSeconds;
+        FString ResponseJson;
+        if (SendFrame(RequestJson))
+        {
+            while (ReceiveFrame(ResponseJson, Deadline, bCancelRequested))
+            {
+                TSharedPtr<FJsonObject> Response;
+                int64 ResponseId = 0;
+                if (!FJsonSerializer::Deserialize(TJsonReaderFactory<>::Create(ResponseJson), Response) || !Response.IsValid()
+                    || !Response->TryGetNumberField(TEXT("id"), ResponseId))
+                {
+                    UE_LOG(LogTemp, Warning, TEXT("Ignoring malformed inference worker message: %s"), *ResponseJson);
+                    continue;
+                }
+                if (ResponseId != RequestId)
+                {
+                    // Late answer to a request that already timed out or was cancelled.
+                    continue;
+                }
+
+                FString Token;
+                if (Response->TryGetStringField(TEXT("token"), Token))
+                {
+                    if (OnToken)
+                    {
+                        (*OnToken)(Token);
+                    }
+                    ++NumStreamedTokens;
+                    Deadline = FPlatformTime::Seconds() + Settings.TimeoutSeconds;
+                    continue;
+                }
+
+                FString Error;
+                if (Response->TryGetStringField(TEXT("error"), Error))
+                {
+                    OutError = Error;
+                    return false;
+                }
+
+                const TSharedPtr<FJsonObject>* Result = nullptr;
+                if (!Response->TryGetObjectField(TEXT("result"), Result))
+                {
+                    OutError = FString::Printf(TEXT("The inference worker answered '%s' without a result."), *Method);
+                    return false;
+                }
+
+                OutResult = *Result;
+
+                // Generation methods time themselves in the worker, streams are timed here including the transport.
+                int32 NumTokens = 0;
+                double Seconds = 0.0;
+                if (!(OutResult->TryGetNumberField(TEXT("completion_tokens"), NumTokens) && OutResult->TryGetNumberField(TEXT("seconds"), Seconds)))
+                {
+                    NumTokens = NumStreamedTokens;
+                    Seconds = FPlatformTime::Seconds() - StartTime;
+                }
+                if (NumTokens > 0 && Seconds > 0.0)
+                {
+                    SET_FLOAT_STAT(STAT_MinesweeperTokensPerSecond, NumTokens / Seconds);
+                }
+                return true;
+            }
+        }
+
+        if (bCancelRequested && *bCancelRequested)
+        {
+            SendCancel(RequestId);
+            OutError = TEXT("Cancelled");
+            return false;
+        }
+        if (FPlatformProcess::IsProcRunning(Process))
+        {
+            // The worker is still generating the abandoned answer, stop it so the next call isn't queued behind it.
+            SendCancel(RequestId);
+            OutError = FString::Printf(TEXT("No answer to '%s' within %.0f seconds."), *Method, Settings.TimeoutSeconds);
+            return false;
+        }
+        if (Restarts >= Settings.MaxRestarts)
+        {
+            OutError = FString::Printf(TEXT("The inference worker exited while handling '%s'."), *Method);
+            return false;
+        }
+
+        UE_LOG(LogTemp, Warning, TEXT("Inference worker exited while handling '%s', restarting it."), *Method);
+    }
+}
+
+void FMinesweeperInferenceClient::Stop()
+{
+    FScopeLock Lock(&Mutex);
+    StopWorker();
+}
+
+bool FMinesweeperInferenceClient::IsWorkerRunning()
+{
+    FScopeLock Lock(&Mutex);
+    return Process.IsValid() && FPlatformProcess::IsProcRunning(Process);
+}
+
+TSharedRef<FMinesweeperInferenceClient> FMinesweeperInferenceClient::Get()
+{
+    FMinesweeperInferenceWorkerSettings CurrentSettings;
+    CurrentSettings.Executable = CVarWorkerExecutable.GetValueOnAnyThread();
+    CurrentSettings.Arguments = CVarWorkerArguments.GetValueOnAnyThread();
+    CurrentSettings.TimeoutSeconds = CVarTimeoutSeconds.GetValueOnAnyThread();
+
+    FScopeLock Lock(&SharedClientMutex);
+    if (!SharedClient.IsValid() || !(SharedClient->GetSettings() == CurrentSettings))
+    {
+        SharedClient = MakeShared<FMinesweeperInferenceClient>(CurrentSettings);
+    }
+    return SharedClient.ToSharedRef();
+}
+
+void FMinesweeperInferenceClient::Shutdown()
+{
+    FScopeLock Lock(&SharedClientMutex);
+    SharedClient.Reset();
+}
+
+bool FMinesweeperInferenceClient::StartWorker(FString& OutError)
+{
+    StopWorker();
+
+    const FString ScriptsDir = GetScriptsDir();
+    FString Arguments = Settings.Arguments;
+    if (Arguments.IsEmpty())
+    {
+        if (ScriptsDir.IsEmpty())
+        {
+            OutError = TEXT("Plugin 'MinesweeperMind' not found, cannot locate inference_worker.py.");
+            return false;
+        }
+        Arguments = FString::Printf(TEXT("\"%s\""), *(ScriptsDir / TEXT("inference_worker.py")));
+    }
+
+    // The worker reads stdin, so that pipe's write end stays on this side.
+    if (!FPlatformProcess::CreatePipe(StdInRead, StdInWrite, true) || !FPlatformProcess::CreatePipe(StdOutRead, StdOutWrite)
+        || !FPlatformProcess::CreatePipe(StdErrRead, StdErrWrite))
+    {
+        StopWorker();
+        OutError = TEXT("Could not create the inference worker pipes.");
+        return false;
+    }
+
+    Process = FPlatformProcess::CreateProc(*Settings.Executable, *Arguments, false, true, true, nullptr, 0,
+        ScriptsDir.IsEmpty() ? nullptr : *ScriptsDir, StdOutWrite, StdInRead, StdErrWrite);
+    if (!Process.IsValid())
+    {
+        StopWorker();
+        OutError = FString::Printf(TEXT("Could not start the inference worker: %s %s"), *Settings.Executable, *Arguments);
+        return false;
+    }
+
+    ++NumWorkerStarts;
+    UE_LOG(LogTemp, Log, TEXT("Started inference worker: %s %s"), *Settings.Executable, *Arguments);
+    return true;
+}
+
+void FMinesweeperInferenceClient::StopWorker()
+{
+    if (Process.IsValid())
+    {
+        // End of input finishes the worker's request loop.
+        FPlatformProcess::ClosePipe(StdInRead, StdInWrite);
+        StdInRead = StdInWrite = nullptr;
+
+        const double Deadline = FPlatformTime::Seconds() + WorkerExitGraceSeconds;
+        while (FPlatformProcess::IsProcRunning(Process) && FPlatformTime::Seconds() < Deadline)
+        {
+            DrainWorkerLog();
+            FPlatformProcess::Sleep(0.01f);
+        }
+        if (FPlatformProcess::IsProcRunning(Process))
+        {
+            FPlatformProcess::TerminateProc(Process, true);
+        }
+        DrainWorkerLog();
+        FPlatformProcess::CloseProc(Process);
+    }
+
+    FPlatformProcess::ClosePipe(StdInRead, StdInWrite);
+    FPlatformProcess::ClosePipe(StdOutRead, StdOutWrite);
+    FPlatformProcess::ClosePipe(StdErrRead, StdErrWrite);
+    StdInRead = StdInWrite = StdOutRead = StdOutWrite = StdErrRead = StdErrWrite = nullptr;
+    ReceiveBuffer.Reset();
+}
+
+bool FMinesweeperInferenceClient::SendFrame(const FString& Json)
+{
+    const FTCHARToUTF8 Utf8(*Json);
+    const uint32 Length = static_cast<uint32>(Utf8.Length());
+
+    TArray<uint8> Frame;
+    Frame.SetNumUninitialized(FrameHeaderBytes + Length);
+    Frame[0] = static_cast<uint8>(Length);
+    Frame[1] = static_cast<uint8>(Length >> 8);
+    Frame[2] = static_cast<uint8>(Length >> 16);
+    Frame[3] = static_cast<uint8>(Length >> 24);
+    FMemory::Memcpy(Frame.GetData() + FrameHeaderBytes, Utf8.Get(), Length);
+
+    int32 BytesWritten = 0;
+    return FPlatformProcess::WritePipe(StdInWrite, Frame.GetData(), Frame.Num(), &BytesWritten) && BytesWritten == Frame.Num();
+}
+
+void FMinesweeperInferenceClient::SendCancel(int64 RequestId)
+{
+    TSharedRef<FJsonObject> CancelParams = MakeShared<FJsonObject>();
+    CancelParams->SetNumberField(TEXT("request_id"), double(RequestId));
+    TSharedRef<FJsonObject> Cancel = MakeShared<FJsonObject>();
+    Cancel->SetStringField(TEXT("method"), TEXT("cancel"));
+    Cancel->SetObjectField(TEXT("params"), CancelParams);
+
+    FString CancelJson;
+    FJsonSerializer::Serialize(Cancel, TJsonWriterFactory<TCHAR, TCondensedJsonPrintPolicy<TCHAR>>::Create(&CancelJson));
+    SendFrame(CancelJson);
+}
+
+bool FMinesweeperInferenceClient::ReceiveFrame(FString& OutJson, double Deadline, const std::atomic<bool>* bCancelRequested)
+{
+    TArray<uint8> Chunk;
+    for (;;)
+    {
+        if (ReceiveBuffer.Num() >= FrameHeaderBytes)
+        {
+            const uint32 Length = uint32(ReceiveBuffer[0]) | (uint32(ReceiveBuffer[1]) << 8) | (uint32(ReceiveBuffer[2]) << 16) | (uint32(ReceiveBuffer[3]) << 24);
+            if (Length > MaxFrameBytes)
+            {
+                UE_LOG(LogTemp, Error, TEXT("Inference worker sent a %u byte frame, the stream is out of sync. Killing the worker."), Length);
+                FPlatformProcess::TerminateProc(Process, true);
+                return false;
+            }
+
+            const int32 FrameBytes = FrameHeaderBytes + static_cast<int32>(Length);
+            if (ReceiveBuffer.Num() >= FrameBytes)
+            {
+                const FUTF8ToTCHAR Text(reinterpret_cast<const ANSICHAR*>(ReceiveBuffer.GetData() + FrameHeaderBytes), Length);
+                OutJson = FString(Text.Length(), Text.Get());
+                ReceiveBuffer.RemoveAt(0, FrameBytes, EAllowShrinking::No);
+                return true;
+            }
+        }
+
+        DrainWorkerLog();
+
+        // Checked before reading, so output written just before the worker exited is still picked up.
+        const bool bWorkerRunning = FPlatformProcess::IsProcRunning(Process);
+        if (FPlatformProcess::ReadPipeToArray(StdOutRead, Chunk) && !Chunk.IsEmpty())
+        {
+            ReceiveBuffer.Append(Chunk);
+            continue;
+        }
+        if (!bWorkerRunning || FPlatformTime::Seconds() >= Deadline || (bCancelRequested && *bCancelRequested))
+        {
+            return false;
+        }
+        FPlatformProcess::Sleep(0.001f);
+    }
+}
+
+void FMinesweeperInferenceClient::DrainWorkerLog()
+{
+    const FString Output = FPlatformProcess::ReadPipe(StdErrRead);
+    if (Output.IsEmpty())
+    {
+        return;
+    }
+
+    TArray<FString> Lines;
+    Output.ParseIntoArrayLines(Lines);
+    for (const FString& Line : Lines)
+    {
+        UE_LOG(LogTemp, Log, TEXT("[InferenceWorker] %s"), *Line);
+    }
+}
@@ -0,0 +1,342 @@
+#include "Core/MinesweeperIntentParser.h"
+
+#include <atomic>
+
+namespace
+{
+    /** Matches the widget's default 10x10 board with 15 mines. */
+    constexpr double DefaultMineDensity = 0.15;
+
+    /** Keeps digit runs from overflowing, anything this large fails validation anyway. */
+    constexpr int64 MaxParsedNumber = 1000000000000ll;
+
+    std::atomic<int32> NumParserAnswers = 0;
+    std::atomic<int32> NumModelAnswers = 0;
+    std::atomic<int32> NumCacheAnswers = 0;
+
+    struct FPreset
+    {
+        const TCHAR* Names[2];
+        int32 NumRows;
+        int32 NumColumns;
+        int64 NumMines;
+    };
+
+    const FPreset Presets[] =
+    {
+        { { TEXT("beginner"), TEXT("easy") }, 9, 9, 10 },
+        { { TEXT("intermediate"), TEXT("medium") }, 16, 16, 40 },
+        { { TEXT("expert"), TEXT("hard") }, 16, 30, 99 },
+    };
+
+    const TCHAR* const MineWords[] = { TEXT("mine"), TEXT("mines"), TEXT("bomb"), TEXT("bombs") };
+    const TCHAR* const RowWords[] = { TEXT("row"), TEXT("rows") };
+    const TCHAR* const ColumnWords[] = { TEXT("column"), TEXT("columns"), TEXT("col"), TEXT("cols") };
+    const TCHAR* const SeparatorWords[] = { TEXT("x"), TEXT("by") };
+    const TCHAR* const BoardWords[] = { TEXT("board"), TEXT("grid"), TEXT("field"), TEXT("minesweeper") };
+
+    /** Words that carry nothing in a board request, so they never make a parse uncertain. */
+    const TCHAR* const FillerWords[] =
+    {
+        TEXT("a"), TEXT("an"), TEXT("the"), TEXT("with"), TEXT("and"), TEXT("of"), TEXT("for"), TEXT("me"), TEXT("i"),
+        TEXT("want"), TEXT("please"), TEXT("can"), TEXT("you"), TEXT("make"), TEXT("create"), TEXT("generate"),
+        TEXT("give"), TEXT("start"), TEXT("new"), TEXT("play"), TEXT("let"), TEXT("s"), TEXT("game"), TEXT("level"),
+        TEXT("difficulty"), TEXT("mode"), TEXT("size"), TEXT("sized"), TEXT("one"), TEXT("custom"), TEXT("containing"),
+    };
+
+    struct FToken
+    {
+        FStringView Word;
+        int64 Number = INDEX_NONE;
+
+        bool IsNumber() const { return Number != INDEX_NONE; }
+
+        bool IsAnyOf(TArrayView<const TCHAR* const> Words) const
+        {
+            for (const TCHAR* Candidate : Words)
+            {
+                if (Word.Equals(Candidate, ESearchCase::CaseSensitive))
+                {
+                    return true;
+                }
+            }
+            return false;
+        }
+    };
+
+    /** Spelling Normalize folds a word to, words not listed stay as they are. */
+    const TCHAR* CanonicalWord(const FToken& Token)
+    {
+        for (const FPreset& Preset : Presets)
+        {
+            if (Token.IsAnyOf(Preset.Names))
+            {
+                return Preset.Names[0];
+            }
+        }
+        if (Token.IsAnyOf(MineWords))
+        {
+            return TEXT("mines");
+        }
+        if (Token.IsAnyOf(RowWords))
+        {
+            return TEXT("rows");
+        }
+        if (Token.IsAnyOf(ColumnWords))
+        {
+            return TEXT("columns");
+        }
+        if (Token.IsAnyOf(SeparatorWords))
+        {
+            return TEXT("x");
+        }
+        return nullptr;
+    }
+
+    /** Splits lowercase text into digit runs and letter runs, "16x30" becomes 16, x, 30. Other characters separate. */
+    void Tokenize(const FString& LowerText, TArray<FToken, TInlineAllocator<32>>& OutTokens)
+    {
+        const TCHAR* const Start = *LowerText;
+        const TCHAR* Char = Start;
+        while (*Char)
+        {
+            if (FChar::IsDigit(*Char))
+            {
+                FToken& Token = OutTokens.AddDefaulted_GetRef();
+                Token.Number = 0;
+                for (; FChar::IsDigit(*Char); ++Char)
+                {
+                    Token.Number = FMath::Min(Token.Number * 10 + (*Char - TEXT('0')), MaxParsedNumber);
+                }
+            }
+            else if (FChar::IsAlpha(*Char))
+            {
+                const TCHAR* const WordStart = Char;
+                while (FChar::IsAlpha(*Char))
+                {
+                    ++Char;
+                }
+                OutTokens.AddDefaulted_GetRef().Word = FStringView(WordStart, UE_PTRDIFF_TO_INT32(Char - WordStart));
+            }
+            else
+            {
+                if (*Char == TEXT('*') || *Char == TCHAR(0x00D7))
+                {
+                    OutTokens.AddDefaulted_GetRef().Word = TEXT("x");
+                }
+                ++Char;
+            }
+        }
+    }
+}
+
+EMinesweeperIntentMatch FMinesweeperIntentParser::Parse(const FString& Text, FMinesweeperBoardRequest& OutRequest)
+{
+    const FString LowerText = Text.ToLower();
+    TArray<FToken, TInlineAllocator<32>> Tokens;
+    Tokenize(LowerText, Tokens);
+
+    int64 Rows = 0;
+    int64 Columns = 0;
+    int64 Mines = 0;
+    const FPreset* Preset = nullptr;
+    TArray<int64, TInlineAllocator<4>> BareNumbers;
+    bool bHasNumbers = false;
+    bool bHasBoardWords = false;
+    bool bHasUnknownWords = false;
+
+    for (int32 Index = 0; Index < Tokens.Num(); ++Index)
+    {
+        const FToken& Token = Tokens[Index];
+        const FToken* Next = (Index + 1 < Tokens.Num()) ? &Tokens[Index + 1] : nullptr;
+
+        if (Token.IsNumber())
+        {
+            bHasNumbers = true;
+            if (Next && Next->IsAnyOf(SeparatorWords) && Index + 2 < Tokens.Num() && Tokens[Index + 2].IsNumber())
+            {
+                Rows = Token.Number;
+                Columns = Tokens[Index + 2].Number;
+                bHasBoardWords = true;
+                Index += 2;
+            }
+            else if (Next && Next->IsAnyOf(MineWords))
+            {
+                Mines = Token.Number;
+                bHasBoardWords = true;
+                ++Index;
+            }
+            else if (Next && Next->IsAnyOf(RowWords))
+            {
+                Rows = Token.Number;
+                bHasBoardWords = true;
+                ++Index;
+            }
+            else if (Next && Next->IsAnyOf(ColumnWords))
+            {
+                Columns = Token.Number;
+                bHasBoardWords = true;
+                ++Index;
+            }
+            else
+            {
+                BareNumbers.Add(Token.Number);
+            }
+            continue;
+        }
+
+        // "mines: 10", "rows 16".
+        const bool bNextIsNumber = Next && Next->IsNumber();
+        if (Token.IsAnyOf(MineWords) || Token.IsAnyOf(RowWords) || Token.IsAnyOf(ColumnWords))
+        {
+            bHasBoardWords = true;
+            if (bNextIsNumber)
+            {
+                int64& Target = Token.IsAnyOf(MineWords) ? Mines : (Token.IsAnyOf(RowWords) ? Rows : Columns);
+                Target = Next->Number;
+                bHasNumbers = true;
+                ++Index;
+            }
+            continue;
+        }
+
+        bool bIsPreset = false;
+        for (const FPreset& Candidate : Presets)
+        {
+            if (Token.IsAnyOf(Candidate.Names))
+            {
+                bHasUnknownWords |= (Preset != nullptr && Preset != &Candidate);
+                Preset = &Candidate;
+                bIsPreset = true;
+            }
+        }
+        if (bIsPreset || Token.IsAnyOf(SeparatorWords) || Token.IsAnyOf(FillerWords))
+        {
+            continue;
+        }
+        if (Token.IsAnyOf(BoardWords))
+        {
+            bHasBoardWords = true;
+            continue;
+        }
+        bHasUnknownWords = true;
+    }
+
+    // Unlabelled numbers: "10 10 15" is rows, columns, mines, "16x30 99" adds the mines.
+    int32 NumUnresolved = BareNumbers.Num();
+    if (Rows == 0 && Columns == 0 && (BareNumbers.Num() == 2 || (BareNumbers.Num() == 3 && Mines == 0)))
+    {
+        Rows = BareNumbers[0];
+        Columns = BareNumbers[1];
+        Mines = BareNumbers.Num() == 3 ? BareNumbers[2] : Mines;
+        NumUnresolved = 0;
+    }
+    else if (Rows > 0 && Columns > 0 && Mines == 0 && BareNumbers.Num() == 1)
+    {
+        Mines = BareNumbers[0];
+        NumUnresolved = 0;
+    }
+
+    if (Preset && Rows == 0 && Columns == 0)
+    {
+        Rows = Preset->NumRows;
+        Columns = Preset->NumColumns;
+        Mines = (Mines > 0) ? Mines : Preset->NumMines;
+    }
+    if (Rows > 0 && Columns > 0 && Mines == 0)
+    {
+        Mines = FMath::Max<int64>(1, FMath::RoundToInt64(double(Rows) * double(Columns) * DefaultMineDensity));
+    }
+
+    const bool bLooksLikeBoard = Preset != nullptr || (bHasNumbers && bHasBoardWords);
+    if (bHasUnknownWords || NumUnresolved > 0 || Rows <= 0 || Columns <= 0 || Rows > MAX_int32 || Columns > MAX_int32)
+    {
+        return bLooksLikeBoard ? EMinesweeperIntentMatch::NeedsModel : EMinesweeperIntentMatch::NotABoard;
+    }
+
+    FMinesweeperBoardRequest Request;
+    Request.NumRows = static_cast<int32>(Rows);
+    Request.NumColumns = static_cast<int32>(Columns);
+    Request.NumMines = Mines;
+    Request.Source = EMinesweeperBoardRequestSource::Parser;
+    if (!Request.IsValid())
+    {
+        return EMinesweeperIntentMatch::NeedsModel;
+    }
+
+    OutRequest = Request;
+    return EMinesweeperIntentMatch::Parsed;
+}
+
+FString FMinesweeperIntentParser::Normalize(const FString& Text)
+{
+    const FString LowerText = Text.ToLower();
+    TArray<FToken, TInlineAllocator<32>> Tokens;
+    Tokenize(LowerText, Tokens);
+
+    FString Normalized;
+    Normalized.Reserve(LowerText.Len());
+    for (const FToken& Token : Tokens)
+    {
+        if (!Token.IsNumber() && (Token.IsAnyOf(FillerWords) || Token.IsAnyOf(BoardWords)))
+        {
+            continue;
+        }
+
+        if (!Normalized.IsEmpty())
+        {
+            Normalized += TEXT(' ');
+        }
+        if (Token.IsNumber())
+        {
+            Normalized += LexToString(Token.Number);
+        }
+        else if (const TCHAR* Canonical = CanonicalWord(Token))
+        {
+            Normalized += Canonical;
+        }
+        else
+        {
+            Normalized.Append(Token.Word.GetData(), Token.Word.Len());
+        }
+    }
+    return Normalized;
+}
+
+void FMinesweeperIntentParser::RecordAnswer(EMinesweeperBoardRequestSource Source)
+{
+    switch (Source)
+    {
+    case EMinesweeperBoardRequestSource::Parser:
+        ++NumParserAnswers;
+        break;
+    case EMinesweeperBoardRequestSource::Model:
+        ++NumModelAnswers;
+        break;
+    case EMinesweeperBoardRequestSource::Cache:
+        ++NumCacheAnswers;
+        break;
+    }
+}
+
+int32 FMinesweeperIntentParser::GetNumParserAnswers()
+{
+    return NumParserAnswers;
+}
+
+int32 FMinesweeperIntentParser::GetNumModelAnswers()
+{
+    return NumModelAnswers;
+}
+
+int32 FMinesweeperIntentParser::GetNumCacheAnswers()
+{
+    return NumCacheAnswers;
+}
+
+double FMinesweeperIntentParser::GetModelBypassRate()
+{
+    const int32 NumBypassed = NumParserAnswers + NumCacheAnswers;
+    const int32 NumAnswers = NumBypassed + NumModelAnswers;
+    return NumAnswers > 0 ? double(NumBypassed) / NumAnswers : 0.0;
+}
@@ -2,9 +2,12 @@
 
 #include "MinesweeperMind.h"
 
+#include "Core/MinesweeperInferenceClient.h"
+#include "Core/MinesweeperModelHost.h"
 #include "IPythonScriptPlugin.h"
 #include "MinesweeperMindStyle.h"
 #include "MinesweeperMindCommands.h"
+#include "MinesweeperMindStats.h"
 #include "SMinesweeperMindWindow.h"
 #include "Misc/MessageDialog.h"
 #include "ToolMenus.h"
@@ -56,6 +59,7 @@ void FMinesweeperMindModule::ExecutePythonScriptFromFile(const FString& ScriptFi
         IPythonScriptPlugin* PythonScriptPluginInner = FModuleManager::Get().GetModulePtr<IPythonScriptPlugin>("PythonScriptPlugin");
         if (PythonScriptPluginInner)
         {
+            MINESWEEPER_SCOPE_CYCLE_COUNTER(PythonScript);
             UE_LOG(LogTemp, Log, TEXT("Executing Python script..."));
             PythonScriptPluginInner->ExecPythonCommand(*PythonScriptContent);
             UE_LOG(LogTemp, Log, TEXT("Executed Python agent script successfully."));
@@ -74,8 +78,12 @@ void FMinesweeperMindModule::ExecutePythonScriptFromFile(const FString& ScriptFi
 
 void FMinesweeperMindModule::StartupModule()
 {
-    // Load the LLM on startup
-    ExecutePythonScriptFromFile(TEXT("Content/Scripts/minesweeper_agent.py"));
+    // The model is loaded by the worker when it is first needed, the host only warms it up ahead of time. Headless runs
+    // such as the bench commandlet have no use for it.
+    if (!IsRunningCommandlet())
+    {
+        FMinesweeperModelHost::Startup();
+    }
 
     FMinesweeperMindStyle::Initialize();
     FMinesweeperMindStyle::ReloadTextures();
@@ -95,6 +103,9 @@ void FMinesweeperMindModule::ShutdownModule()
 	// This function may be called during shutdown to clean up your module.  For modules that support dynamic reloading,
 	// we call this function before unloading the module.
 
+	FMinesweeperModelHost::Shutdown();
+	FMinesweeperInferenceClient::Shutdown();
+
 	UToolMenus::UnRegisterStartupCallback(this);
 
 	UToolMenus::UnregisterOwner(this);
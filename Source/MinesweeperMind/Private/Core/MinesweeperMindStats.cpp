@@ -0,0 +1,18 @@
+#include "MinesweeperMindStats.h"
+
+DEFINE_STAT(STAT_MinesweeperGenerateGrid);
+DEFINE_STAT(STAT_MinesweeperPlaceMines);
+DEFINE_STAT(STAT_MinesweeperCalculateAdjacency);
+DEFINE_STAT(STAT_MinesweeperReveal);
+DEFINE_STAT(STAT_MinesweeperApplyMoves);
+DEFINE_STAT(STAT_MinesweeperFlushDirtyCells);
+DEFINE_STAT(STAT_MinesweeperProbabilityOverlay);
+DEFINE_STAT(STAT_MinesweeperPaintGrid);
+DEFINE_STAT(STAT_MinesweeperPythonScript);
+DEFINE_STAT(STAT_MinesweeperDimensionRequest);
+DEFINE_STAT(STAT_MinesweeperInferenceCall);
+
+DEFINE_STAT(STAT_MinesweeperCellsRevealed);
+DEFINE_STAT(STAT_MinesweeperInvalidations);
+DEFINE_STAT(STAT_MinesweeperTokensPerSecond);
+DEFINE_STAT(STAT_MinesweeperModelLoadSeconds);
@@ -0,0 +1,34 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "ProfilingDebugging/CpuProfilerTrace.h"
+#include "Stats/Stats.h"
+
+/**
+ * The plugin's stats, shown with `stat MinesweeperMind`. Traces recorded with -trace=cpu,stats carry the same scopes
+ * as CPU events and the counters as Insights counters.
+ */
+DECLARE_STATS_GROUP(TEXT("MinesweeperMind"), STATGROUP_MinesweeperMind, STATCAT_Advanced);
+
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Generate Grid"), STAT_MinesweeperGenerateGrid, STATGROUP_MinesweeperMind, );
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Place Mines"), STAT_MinesweeperPlaceMines, STATGROUP_MinesweeperMind, );
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Calculate Adjacency"), STAT_MinesweeperCalculateAdjacency, STATGROUP_MinesweeperMind, );
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Reveal"), STAT_MinesweeperReveal, STATGROUP_MinesweeperMind, );
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Apply Moves"), STAT_MinesweeperApplyMoves, STATGROUP_MinesweeperMind, );
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Flush Dirty Cells"), STAT_MinesweeperFlushDirtyCells, STATGROUP_MinesweeperMind, );
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Probability Overlay"), STAT_MinesweeperProbabilityOverlay, STATGROUP_MinesweeperMind, );
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Paint Grid"), STAT_MinesweeperPaintGrid, STATGROUP_MinesweeperMind, );
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Python Script"), STAT_MinesweeperPythonScript, STATGROUP_MinesweeperMind, );
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Dimension Request"), STAT_MinesweeperDimensionRequest, STATGROUP_MinesweeperMind, );
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Inference Call"), STAT_MinesweeperInferenceCall, STATGROUP_MinesweeperMind, );
+
+/** Counters are per frame, the accumulators keep their last value. */
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Cells Revealed"), STAT_MinesweeperCellsRevealed, STATGROUP_MinesweeperMind, );
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Invalidations"), STAT_MinesweeperInvalidations, STATGROUP_MinesweeperMind, );
+DECLARE_FLOAT_ACCUMULATOR_STAT_EXTERN(TEXT("Tokens Per Second"), STAT_MinesweeperTokensPerSecond, STATGROUP_MinesweeperMind, );
+DECLARE_FLOAT_ACCUMULATOR_STAT_EXTERN(TEXT("Model Load Seconds"), STAT_MinesweeperModelLoadSeconds, STATGROUP_MinesweeperMind, );
+
+/** Times the enclosing scope under STAT_Minesweeper<Name> and as the Insights CPU event Minesweeper<Name>. */
+#define MINESWEEPER_SCOPE_CYCLE_COUNTER(Name) \
+	SCOPE_CYCLE_COUNTER(STAT_Minesweeper##Name); \
+	TRACE_CPUPROFILER_EVENT_SCOPE(Minesweeper##Name)
@@ -0,0 +1,443 @@
+#include "Core/MinesweeperModelAssets.h"
+
+#include "Core/MinesweeperDimensionCache.h"
+#include "MinesweeperSha256.h"
+#include "Async/Async.h"
+#include "Dom/JsonObject.h"
+#include "HAL/Event.h"
+#include "HAL/FileManager.h"
+#include "HAL/IConsoleManager.h"
+#include "HAL/PlatformProcess.h"
+#include "HAL/PlatformTime.h"
+#include "HttpModule.h"
+#include "Interfaces/IHttpRequest.h"
+#include "Interfaces/IHttpResponse.h"
+#include "Interfaces/IPluginManager.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "Serialization/JsonReader.h"
+#include "Serialization/JsonSerializer.h"
+#include "Serialization/JsonWriter.h"
+
+namespace
+{
+    /** Matches LLMManager in llm_manager.py. */
+    const TCHAR* DefaultModelUrl = TEXT("https://huggingface.co/TheBloke/TinyLlama-1.1B-Chat-v1.0-GGUF/resolve/main/tinyllama-1.1b-chat-v1.0.Q4_K_M.gguf");
+    const TCHAR* DefaultModelFileName = TEXT("tinyllama-1.1b-chat-v1.0.Q4_K_M.gguf");
+    const TCHAR* DefaultModelSha256 = TEXT("9fecc3b3cd76bba89d504f29b616eedf7da85b96540e490ca5824d3f7d2776a0");
+
+    constexpr int64 HashBlockBytes = 1024 * 1024;
+    /** Each ranged request asks for this much, so no single request has to outlive ChunkTimeoutSeconds. */
+    constexpr int64 DownloadChunkBytes = 16 * 1024 * 1024;
+    /** Requests in a row that may fail without adding a byte to the .part file. */
+    constexpr int32 MaxChunkAttempts = 3;
+    constexpr float ChunkTimeoutSeconds = 120.f;
+    /** Range Not Satisfiable, what a server answers when the .part already reaches the end of the file. */
+    constexpr int32 HttpRangeNotSatisfiable = 416;
+
+    TAutoConsoleVariable<FString> CVarModelUrl(
+        TEXT("MinesweeperMind.Model.Url"),
+        TEXT(""),
+        TEXT("Where the default model is downloaded from, for a mirror or a local range_file_server.py. Empty uses Hugging Face."));
+
+    using FHttpRequestRef = TSharedRef<IHttpRequest, ESPMode::ThreadSafe>;
+
+    /** Runs Request and waits for it, the completion is delivered on the HTTP thread so this never needs the game thread. */
+    bool ProcessRequestAndWait(const FHttpRequestRef& Request)
+    {
+        check(!IsInGameThread());
+
+        FEvent* Done = FPlatformProcess::GetSynchEventFromPool(true);
+        Request->SetTimeout(ChunkTimeoutSeconds);
+        Request->SetDelegateThreadPolicy(EHttpRequestDelegateThreadPolicy::CompleteOnHttpThread);
+        Request->OnProcessRequestComplete().BindLambda([Done](FHttpRequestPtr, FHttpResponsePtr, bool)
+        {
+            Done->Trigger();
+        });
+        Request->ProcessRequest();
+        Done->Wait();
+        FPlatformProcess::ReturnSynchEventToPool(Done);
+
+        return Request->GetStatus() == EHttpRequestStatus::Succeeded;
+    }
+
+    /**
+     * Parses a Content-Range such as "bytes 100-199/1000" into 100 and 1000. The unsatisfied range a 416 carries has
+     * "*" for the range and gives INDEX_NONE as the start. False if it is neither.
+     */
+    bool ParseContentRange(const FString& ContentRange, int64& OutStart, int64& OutTotalBytes)
+    {
+        FString Range;
+        FString Total;
+        if (!ContentRange.Split(TEXT("bytes "), nullptr, &Range) || !Range.Split(TEXT("/"), &Range, &Total) || Total.IsEmpty() || !Total.IsNumeric())
+        {
+            return false;
+        }
+        OutStart = Range.StartsWith(TEXT("*")) ? int64(INDEX_NONE) : FCString::Atoi64(*Range);
+        OutTotalBytes = FCString::Atoi64(*Total);
+        return true;
+    }
+
+    /**
+     * Streams a ranged GET into the .part file. What the bytes are is only known once the status arrives with them, so
+     * the file is opened on the first write, as in download_resumable in llm_manager.py: a 206 whose Content-Range
+     * starts at Offset is appended, a 200 from a server that ignored the Range is the whole file and replaces the
+     * .part, anything else is an error page and is dropped.
+     */
+    class FPartFileWriter : public FArchive
+    {
+    public:
+        enum class EMode : uint8
+        {
+            None,
+            Appended,
+            Replaced,
+        };
+
+        FPartFileWriter(const FString& InPath, int64 InOffset, const IHttpRequest& InRequest)
+            : Path(InPath)
+            , Offset(InOffset)
+            , Request(InRequest)
+        {
+            SetIsSaving(true);
+        }
+
+        virtual void Serialize(void* Data, int64 Num) override
+        {
+            if (Mode == EMode::None && !bRejected)
+            {
+                Open();
+            }
+            if (File)
+            {
+                File->Serialize(Data, Num);
+                NumWritten += Num;
+                if (File->IsError())
+                {
+                    SetError();
+                }
+            }
+        }
+
+        virtual bool Close() override
+        {
+            if (File && !File->Close())
+            {
+                SetError();
+            }
+            File.Reset();
+            return !IsError();
+        }
+
+        EMode GetMode() const { return Mode; }
+        int64 GetNumWritten() const { return NumWritten; }
+
+    private:
+        void Open()
+        {
+            const FHttpResponsePtr Response = Request.GetResponse();
+            const int32 Code = Response.IsValid() ? Response->GetResponseCode() : 0;
+            int64 Start = INDEX_NONE;
+            int64 TotalBytes = INDEX_NONE;
+            if (Code == EHttpResponseCodes::PartialContent && ParseContentRange(Response->GetHeader(TEXT("Content-Range")), Start, TotalBytes) && Start == Offset)
+            {
+                Mode = EMode::Appended;
+            }
+            else if (Code == EHttpResponseCodes::Ok)
+            {
+                Mode = EMode::Replaced;
+            }
+            else
+            {
+                bRejected = true;
+                return;
+            }
+
+            File.Reset(IFileManager::Get().CreateFileWriter(*Path, Mode == EMode::Appended ? FILEWRITE_Append : FILEWRITE_None));
+            if (!File)
+            {
+                SetError();
+            }
+        }
+
+        FString Path;
+        int64 Offset = 0;
+        const IHttpRequest& Request;
+        TUniquePtr<FArchive> File;
+        EMode Mode = EMode::None;
+        bool bRejected = false;
+        int64 NumWritten = 0;
+    };
+
+    bool WriteStamp(const FString& ModelPath, const FString& Sha256)
+    {
+        TSharedRef<FJsonObject> Stamp = MakeShared<FJsonObject>();
+        Stamp->SetNumberField(TEXT("size"), static_cast<double>(IFileManager::Get().FileSize(*ModelPath)));
+        Stamp->SetNumberField(TEXT("modified"), static_cast<double>(IFileManager::Get().GetTimeStamp(*ModelPath).ToUnixTimestamp()));
+        Stamp->SetStringField(TEXT("sha256"), Sha256);
+
+        FString Json;
+        const TSharedRef<TJsonWriter<>> Writer = TJsonWriterFactory<>::Create(&Json);
+        return FJsonSerializer::Serialize(Stamp, Writer) && FFileHelper::SaveStringToFile(Json, *FMinesweeperModelAssets::GetStampPath(ModelPath));
+    }
+
+    FAutoConsoleCommand ModelVerifyCommand(
+        TEXT("MinesweeperMind.Model.Verify"),
+        TEXT("Hashes the default model on a background thread and stamps it if it matches, even if a stamp exists."),
+        FConsoleCommandDelegate::CreateLambda([]()
+        {
+            Async(EAsyncExecution::Thread, []()
+            {
+                const FMinesweeperModelAsset Asset = FMinesweeperModelAsset::GetDefault();
+                const double StartTime = FPlatformTime::Seconds();
+                FString Error;
+                if (FMinesweeperModelAssets::Verify(Asset, Error))
+                {
+                    const double Elapsed = FPlatformTime::Seconds() - StartTime;
+                    UE_LOG(LogTemp, Log, TEXT("Verified %s in %.2f s (%.0f MB/s)"), *Asset.Path, Elapsed,
+                        IFileManager::Get().FileSize(*Asset.Path) / (1024.0 * 1024.0) / FMath::Max(Elapsed, 0.001));
+                }
+                else
+                {
+                    UE_LOG(LogTemp, Error, TEXT("%s"), *Error);
+                }
+            });
+        }));
+}
+
+FMinesweeperModelAsset FMinesweeperModelAsset::GetDefault()
+{
+    FMinesweeperModelAsset Asset;
+    Asset.Url = CVarModelUrl.GetValueOnAnyThread();
+    if (Asset.Url.IsEmpty())
+    {
+        Asset.Url = DefaultModelUrl;
+    }
+    Asset.Sha256 = DefaultModelSha256;
+
+    const TSharedPtr<IPlugin> Plugin = IPluginManager::Get().FindPlugin(TEXT("MinesweeperMind"));
+    if (Plugin.IsValid())
+    {
+        Asset.Path = FPaths::ConvertRelativePathToFull(Plugin->GetBaseDir() / TEXT("Content/LargeLanguageModels") / DefaultModelFileName);
+    }
+    return Asset;
+}
+
+FString FMinesweeperModelAssets::HashFile(const FString& Path, const std::atomic<bool>* bCancelRequested)
+{
+    TUniquePtr<FArchive> Reader(IFileManager::Get().CreateFileReader(*Path));
+    if (!Reader)
+    {
+        return FString();
+    }
+
+    FMinesweeperSha256 Hasher;
+    TArray<uint8> Block;
+    Block.SetNumUninitialized(HashBlockBytes);
+    for (int64 Remaining = Reader->TotalSize(); Remaining > 0; )
+    {
+        if (bCancelRequested && *bCancelRequested)
+        {
+            return FString();
+        }
+
+        const int64 NumBytes = FMath::Min(Remaining, HashBlockBytes);
+        Reader->Serialize(Block.GetData(), NumBytes);
+        if (Reader->IsError())
+        {
+            return FString();
+        }
+        Hasher.Update(Block.GetData(), NumBytes);
+        Remaining -= NumBytes;
+    }
+    return Hasher.Finalize();
+}
+
+FString FMinesweeperModelAssets::GetStampPath(const FString& ModelPath)
+{
+    return ModelPath + TEXT(".verified.json");
+}
+
+bool FMinesweeperModelAssets::HasValidStamp(const FMinesweeperModelAsset& Asset)
+{
+    FString Json;
+    if (!FFileHelper::LoadFileToString(Json, *GetStampPath(Asset.Path)))
+    {
+        return false;
+    }
+
+    TSharedPtr<FJsonObject> Stamp;
+    const TSharedRef<TJsonReader<>> Reader = TJsonReaderFactory<>::Create(Json);
+    int64 Size = 0;
+    int64 Modified = 0;
+    FString Sha256;
+    if (!FJsonSerializer::Deserialize(Reader, Stamp) || !Stamp.IsValid() || !Stamp->TryGetNumberField(TEXT("size"), Size)
+        || !Stamp->TryGetNumberField(TEXT("modified"), Modified) || !Stamp->TryGetStringField(TEXT("sha256"), Sha256))
+    {
+        return false;
+    }
+
+    // Any rewrite of the file moves its timestamp, so a matching size and time means the stamped bytes are still there.
+    return Sha256.Equals(Asset.Sha256, ESearchCase::IgnoreCase)
+        && Size == IFileManager::Get().FileSize(*Asset.Path)
+        && Modified == IFileManager::Get().GetTimeStamp(*Asset.Path).ToUnixTimestamp();
+}
+
+bool FMinesweeperModelAssets::Verify(const FMinesweeperModelAsset& Asset, FString& OutError)
+{
+    const FString Sha256 = HashFile(Asset.Path);
+    if (Sha256.IsEmpty())
+    {
+        OutError = FString::Printf(TEXT("Could not read %s"), *Asset.Path);
+        return false;
+    }
+    if (!Sha256.Equals(Asset.Sha256, ESearchCase::IgnoreCase))
+    {
+        OutError = FString::Printf(TEXT("SHA-256 mismatch for %s, expected %s but got %s"), *Asset.Path, *Asset.Sha256, *Sha256);
+        return false;
+    }
+    if (!WriteStamp(Asset.Path, Sha256))
+    {
+        UE_LOG(LogTemp, Warning, TEXT("Verified %s but could not write its stamp, it will be hashed again next time."), *Asset.Path);
+    }
+    return true;
+}
+
+bool FMinesweeperModelAssets::Download(const FMinesweeperModelAsset& Asset, FString& OutError)
+{
+    const FString PartPath = Asset.Path + TEXT(".part");
+
+    // Whatever an interrupted download left is kept, the server's answer to the first range decides if it is used.
+    int64 Offset = FMath::Max<int64>(IFileManager::Get().FileSize(*PartPath), 0);
+    if (Offset > 0)
+    {
+        UE_LOG(LogTemp, Log, TEXT("Resuming %s at %lld bytes"), *Asset.Url, Offset);
+    }
+
+    int64 TotalBytes = INDEX_NONE;
+    int32 LastLoggedPercent = 0;
+    for (int32 NumFailures = 0; TotalBytes == INDEX_NONE || Offset < TotalBytes; )
+    {
+        FHttpRequestRef Request = FHttpModule::Get().CreateRequest();
+        Request->SetVerb(TEXT("GET"));
+        Request->SetURL(Asset.Url);
+        Request->SetHeader(TEXT("Range"), FString::Printf(TEXT("bytes=%lld-%lld"), Offset, Offset + DownloadChunkBytes - 1));
+        const TSharedRef<FPartFileWriter> Writer = MakeShared<FPartFileWriter>(PartPath, Offset, *Request);
+        Request->SetResponseBodyReceiveStream(Writer);
+
+        const bool bSucceeded = ProcessRequestAndWait(Request);
+        if (!Writer->Close())
+        {
+            OutError = FString::Printf(TEXT("Could not write %s"), *PartPath);
+            return false;
+        }
+
+        const FHttpResponsePtr Response = Request->GetResponse();
+        int64 Start = INDEX_NONE;
+        int64 ResponseTotalBytes = INDEX_NONE;
+        const bool bHasContentRange = Response.IsValid() && ParseContentRange(Response->GetHeader(TEXT("Content-Range")), Start, ResponseTotalBytes);
+        bool bProgressed = Writer->GetNumWritten() > 0;
+        switch (Writer->GetMode())
+        {
+        case FPartFileWriter::EMode::Appended:
+            TotalBytes = ResponseTotalBytes;
+            break;
+
+        case FPartFileWriter::EMode::Replaced:
+            if (Offset > 0)
+            {
+                UE_LOG(LogTemp, Log, TEXT("%s does not support ranged requests, downloading it in one piece."), *Asset.Url);
+            }
+            // Only a complete answer says how long the file is, an interrupted one is requested again in full.
+            TotalBytes = bSucceeded ? Writer->GetNumWritten() : int64(INDEX_NONE);
+            break;
+
+        case FPartFileWriter::EMode::None:
+            if (Response.IsValid() && Response->GetResponseCode() == HttpRangeNotSatisfiable && bHasContentRange)
+            {
+                // The .part already holds the whole file, or more than it, which no resume can fix.
+                TotalBytes = ResponseTotalBytes;
+                if (Offset != TotalBytes)
+                {
+                    IFileManager::Get().Delete(*PartPath);
+                    TotalBytes = INDEX_NONE;
+                }
+                bProgressed = true;
+            }
+            break;
+        }
+
+        Offset = FMath::Max<int64>(IFileManager::Get().FileSize(*PartPath), 0);
+        if (!bProgressed)
+        {
+            if (++NumFailures >= MaxChunkAttempts)
+            {
+                // What arrived so far stays in the .part file for the next attempt.
+                OutError = FString::Printf(TEXT("Downloading %s failed at byte %lld"), *Asset.Url, Offset);
+                return false;
+            }
+            continue;
+        }
+        NumFailures = 0;
+
+        const int32 Percent = TotalBytes > 0 ? static_cast<int32>(Offset * 100 / TotalBytes) : 0;
+        if (Percent / 10 != LastLoggedPercent / 10)
+        {
+            UE_LOG(LogTemp, Log, TEXT("Downloading %s: %d%%"), *Asset.Url, Percent);
+            LastLoggedPercent = Percent;
+        }
+    }
+
+    const FString Sha256 = HashFile(PartPath);
+    if (!Sha256.Equals(Asset.Sha256, ESearchCase::IgnoreCase))
+    {
+        // Resuming a corrupt file would never finish, start over next time.
+        IFileManager::Get().Delete(*PartPath);
+        OutError = FString::Printf(TEXT("SHA-256 mismatch for %s, expected %s but got %s"), *Asset.Url, *Asset.Sha256, *Sha256);
+        return false;
+    }
+
+    if (!IFileManager::Get().Move(*Asset.Path, *PartPath, true))
+    {
+        OutError = FString::Printf(TEXT("Could not move %s to %s"), *PartPath, *Asset.Path);
+        return false;
+    }
+    WriteStamp(Asset.Path, Sha256);
+    return true;
+}
+
+bool FMinesweeperModelAssets::Ensure(const FMinesweeperModelAsset& Asset, FString& OutError)
+{
+    if (HasValidStamp(Asset))
+    {
+        return true;
+    }
+
+    if (IFileManager::Get().FileExists(*Asset.Path))
+    {
+        UE_LOG(LogTemp, Log, TEXT("Verifying %s"), *Asset.Path);
+        if (Verify(Asset, OutError))
+        {
+            return true;
+        }
+        UE_LOG(LogTemp, Warning, TEXT("%s, downloading it again."), *OutError);
+        IFileManager::Get().Delete(*Asset.Path);
+        IFileManager::Get().Delete(*GetStampPath(Asset.Path));
+    }
+
+    if (Asset.Url.IsEmpty())
+    {
+        OutError = FString::Printf(TEXT("%s is missing and has no download URL"), *Asset.Path);
+        return false;
+    }
+
+    UE_LOG(LogTemp, Log, TEXT("Downloading %s to %s"), *Asset.Url, *Asset.Path);
+    if (!Download(Asset, OutError))
+    {
+        return false;
+    }
+
+    // Answers cached for the previous file no longer apply.
+    FMinesweeperDimensionCache::Get().InvalidateFingerprint();
+    return true;
+}
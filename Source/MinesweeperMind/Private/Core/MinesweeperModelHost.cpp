@@ -0,0 +1,219 @@
+#include "Core/MinesweeperModelHost.h"
+
+#include "Core/MinesweeperInferenceClient.h"
+#include "Core/MinesweeperModelAssets.h"
+#include "MinesweeperMindStats.h"
+#include "Async/Async.h"
+#include "Dom/JsonObject.h"
+#include "Framework/Application/SlateApplication.h"
+#include "HAL/IConsoleManager.h"
+#include "HAL/PlatformMemory.h"
+#include "HAL/PlatformTime.h"
+#include "Misc/ScopeLock.h"
+
+namespace
+{
+    /** How often the host looks at idle time and free memory. */
+    constexpr float TickSeconds = 1.f;
+    /** Keeps a machine that stays short of memory from sending an unload every tick. */
+    constexpr double EvictionCooldownSeconds = 30.0;
+
+    TAutoConsoleVariable<float> CVarIdleWarmupSeconds(
+        TEXT("MinesweeperMind.Model.IdleWarmupSeconds"),
+        30.f,
+        TEXT("Load the model in the background once the editor has been idle this long, negative waits for the window to open."));
+
+    TAutoConsoleVariable<int32> CVarMinFreeMemoryMB(
+        TEXT("MinesweeperMind.Model.MinFreeMemoryMB"),
+        1024,
+        TEXT("Unload the model when free physical memory drops below this, and do not warm it up until there is more. 0 never evicts."));
+
+    FCriticalSection SharedHostMutex;
+    TSharedPtr<FMinesweeperModelHost, ESPMode::ThreadSafe> SharedHost;
+
+    void WithHost(void (FMinesweeperModelHost::*Action)())
+    {
+        if (const TSharedPtr<FMinesweeperModelHost, ESPMode::ThreadSafe> Host = FMinesweeperModelHost::Get())
+        {
+            (Host.Get()->*Action)();
+        }
+        else
+        {
+            UE_LOG(LogTemp, Warning, TEXT("The model host only runs in the editor."));
+        }
+    }
+
+    FAutoConsoleCommand ModelWarmupCommand(
+        TEXT("MinesweeperMind.Model.Warmup"),
+        TEXT("Loads the inference worker's model in the background."),
+        FConsoleCommandDelegate::CreateLambda([]() { WithHost(&FMinesweeperModelHost::RequestWarmup); }));
+
+    FAutoConsoleCommand ModelEvictCommand(
+        TEXT("MinesweeperMind.Model.Evict"),
+        TEXT("Releases the inference worker's model, the next request loads it again."),
+        FConsoleCommandDelegate::CreateLambda([]() { WithHost(&FMinesweeperModelHost::Evict); }));
+
+    FAutoConsoleCommand ModelStatsCommand(
+        TEXT("MinesweeperMind.Model.Stats"),
+        TEXT("Logs whether the model is loaded, its load time and the worker's resident size."),
+        FConsoleCommandDelegate::CreateLambda([]() { WithHost(&FMinesweeperModelHost::RefreshStats); }));
+}
+
+void FMinesweeperModelHost::Startup()
+{
+    check(IsInGameThread());
+
+    TSharedRef<FMinesweeperModelHost, ESPMode::ThreadSafe> Host = MakeShared<FMinesweeperModelHost, ESPMode::ThreadSafe>();
+    Host->StartTime = FPlatformTime::Seconds();
+    Host->TickerHandle = FTSTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateSP(Host, &FMinesweeperModelHost::Tick), TickSeconds);
+
+    FScopeLock Lock(&SharedHostMutex);
+    SharedHost = Host;
+}
+
+void FMinesweeperModelHost::Shutdown()
+{
+    TSharedPtr<FMinesweeperModelHost, ESPMode::ThreadSafe> Host;
+    {
+        FScopeLock Lock(&SharedHostMutex);
+        Host = MoveTemp(SharedHost);
+    }
+
+    // A background call still in flight keeps its own reference and finishes on the old host.
+    if (Host.IsValid())
+    {
+        FTSTicker::GetCoreTicker().RemoveTicker(Host->TickerHandle);
+    }
+}
+
+TSharedPtr<FMinesweeperModelHost, ESPMode::ThreadSafe> FMinesweeperModelHost::Get()
+{
+    FScopeLock Lock(&SharedHostMutex);
+    return SharedHost;
+}
+
+void FMinesweeperModelHost::RequestWarmup()
+{
+    if (GetStats().bLoaded)
+    {
+        return;
+    }
+    if (IsMemoryLow())
+    {
+        UE_LOG(LogTemp, Log, TEXT("Not warming up the model, free memory is below MinesweeperMind.Model.MinFreeMemoryMB."));
+        return;
+    }
+    RunInBackground(TEXT("load"));
+}
+
+void FMinesweeperModelHost::Evict()
+{
+    LastEvictionTime = FPlatformTime::Seconds();
+    RunInBackground(TEXT("unload"));
+}
+
+void FMinesweeperModelHost::RefreshStats()
+{
+    RunInBackground(TEXT("model_stats"));
+}
+
+FMinesweeperModelStats FMinesweeperModelHost::GetStats() const
+{
+    FScopeLock Lock(&StatsMutex);
+    return Stats;
+}
+
+bool FMinesweeperModelHost::Tick(float DeltaTime)
+{
+    const double Now = FPlatformTime::Seconds();
+
+    if (IsMemoryLow())
+    {
+        // Whether a request has loaded the model since we last asked is unknown, the unload is a no-op if not.
+        if (Now - LastEvictionTime >= EvictionCooldownSeconds)
+        {
+            Evict();
+        }
+        return true;
+    }
+
+    const float IdleWarmupSeconds = CVarIdleWarmupSeconds.GetValueOnGameThread();
+    if (!bIdleWarmupDone && IdleWarmupSeconds >= 0.f && Now - StartTime >= IdleWarmupSeconds && FSlateApplication::IsInitialized())
+    {
+        const FSlateApplication& SlateApplication = FSlateApplication::Get();
+        if (SlateApplication.GetCurrentTime() - SlateApplication.GetLastUserInteractionTime() >= IdleWarmupSeconds)
+        {
+            bIdleWarmupDone = true;
+            RequestWarmup();
+        }
+    }
+    return true;
+}
+
+bool FMinesweeperModelHost::RunInBackground(const FString& Method)
+{
+    if (bBusy.exchange(true))
+    {
+        return false;
+    }
+
+    TSharedRef<FMinesweeperModelHost, ESPMode::ThreadSafe> Host = AsShared();
+    Async(EAsyncExecution::Thread, [Host, Method]()
+    {
+        const TSharedRef<FMinesweeperInferenceClient> Client = FMinesweeperInferenceClient::Get();
+
+        // The default worker loads the plugin's model. Verifying or fetching it here keeps that out of the worker,
+        // which would otherwise hash or download it while a request waits.
+        TSharedPtr<FJsonObject> Result;
+        FString Error;
+        if (Method == TEXT("load") && Client->GetSettings().Arguments.IsEmpty() && !FMinesweeperModelAssets::Ensure(FMinesweeperModelAsset::GetDefault(), Error))
+        {
+            UE_LOG(LogTemp, Error, TEXT("Model warmup skipped: %s"), *Error);
+        }
+        // A worker that is not running holds no model, starting one only to unload it would be wasted work.
+        else if (Method == TEXT("load") || Client->IsWorkerRunning())
+        {
+            if (Client->Call(Method, MakeShared<FJsonObject>(), Result, Error))
+            {
+                Host->ApplyStats(Method, Result);
+            }
+            else
+            {
+                UE_LOG(LogTemp, Warning, TEXT("Model %s failed: %s"), *Method, *Error);
+            }
+        }
+        else
+        {
+            FScopeLock Lock(&Host->StatsMutex);
+            Host->Stats.bLoaded = false;
+        }
+
+        Host->bBusy = false;
+    });
+    return true;
+}
+
+void FMinesweeperModelHost::ApplyStats(const FString& Method, const TSharedPtr<FJsonObject>& Result)
+{
+    FMinesweeperModelStats NewStats;
+    {
+        FScopeLock Lock(&StatsMutex);
+        Stats.bLoaded = Result->GetBoolField(TEXT("loaded"));
+        Stats.LoadSeconds = Result->GetNumberField(TEXT("load_seconds"));
+        Stats.ResidentBytes = static_cast<int64>(Result->GetNumberField(TEXT("resident_bytes")));
+        Stats.NumWarmups += Method == TEXT("load") ? 1 : 0;
+        Stats.NumEvictions += (Method == TEXT("unload") && Result->GetBoolField(TEXT("was_loaded"))) ? 1 : 0;
+        NewStats = Stats;
+    }
+    SET_FLOAT_STAT(STAT_MinesweeperModelLoadSeconds, NewStats.LoadSeconds);
+
+    UE_LOG(LogTemp, Log, TEXT("Model %s: %s, loaded in %.2f s, worker resident %.0f MB (%d warmups, %d evictions)"),
+        *Method, NewStats.bLoaded ? TEXT("loaded") : TEXT("not loaded"), NewStats.LoadSeconds,
+        NewStats.ResidentBytes / (1024.0 * 1024.0), NewStats.NumWarmups, NewStats.NumEvictions);
+}
+
+bool FMinesweeperModelHost::IsMemoryLow()
+{
+    const int32 MinFreeMemoryMB = CVarMinFreeMemoryMB.GetValueOnAnyThread();
+    return MinFreeMemoryMB > 0 && FPlatformMemory::GetStats().AvailablePhysical < uint64(MinFreeMemoryMB) * 1024 * 1024;
+}
@@ -0,0 +1,108 @@
+#include "Core/MinesweeperModelReplies.h"
+
+#include "Dom/JsonObject.h"
+#include "Serialization/JsonReader.h"
+#include "Serialization/JsonSerializer.h"
+
+namespace
+{
+    /** The reply as an object with exactly NumFields keys, as many as its grammar writes. */
+    TSharedPtr<FJsonObject> ReadObject(const FString& Json, int32 NumFields)
+    {
+        TSharedPtr<FJsonObject> Object;
+        const TSharedRef<TJsonReader<>> Reader = TJsonReaderFactory<>::Create(Json);
+        if (!FJsonSerializer::Deserialize(Reader, Object) || !Object.IsValid() || Object->Values.Num() != NumFields)
+        {
+            return nullptr;
+        }
+        return Object;
+    }
+
+    /**
+     * Whole numbers only, in [Min, Max], the range the reply's grammar allows. The grammar never writes anything else
+     * but cached or older replies might.
+     */
+    bool ReadCount(const FJsonObject& Object, const TCHAR* Field, int64 Min, int64 Max, int64& OutValue)
+    {
+        double Value = 0.0;
+        if (!Object.TryGetNumberField(Field, Value) || Value != FMath::FloorToDouble(Value) || Value < double(Min) || Value > double(Max))
+        {
+            return false;
+        }
+        OutValue = static_cast<int64>(Value);
+        return true;
+    }
+
+    const TCHAR* GetActionName(EMinesweeperMoveType Type)
+    {
+        switch (Type)
+        {
+        case EMinesweeperMoveType::Flag:
+            return TEXT("flag");
+        case EMinesweeperMoveType::Chord:
+            return TEXT("chord");
+        default:
+            return TEXT("reveal");
+        }
+    }
+}
+
+bool FMinesweeperDimensionReply::Parse(const FString& Json, FMinesweeperDimensionReply& OutReply)
+{
+    const TSharedPtr<FJsonObject> Object = ReadObject(Json, 3);
+    int64 Rows = 0;
+    int64 Columns = 0;
+    int64 Mines = 0;
+    if (!Object.IsValid() || !ReadCount(*Object, TEXT("rows"), 1, MaxCount, Rows) || !ReadCount(*Object, TEXT("columns"), 1, MaxCount, Columns)
+        || !ReadCount(*Object, TEXT("mines"), 1, MaxCount, Mines))
+    {
+        return false;
+    }
+
+    OutReply.Rows = static_cast<int32>(Rows);
+    OutReply.Columns = static_cast<int32>(Columns);
+    OutReply.Mines = Mines;
+    return true;
+}
+
+bool FMinesweeperDimensionReply::ParseResult(const TSharedPtr<FJsonObject>& Result, FMinesweeperDimensionReply& OutReply)
+{
+    FString Text;
+    return Result.IsValid() && Result->TryGetStringField(TEXT("text"), Text) && Parse(Text, OutReply);
+}
+
+bool FMinesweeperMoveReply::Parse(const FString& Json, FMinesweeperMoveReply& OutReply)
+{
+    const TSharedPtr<FJsonObject> Object = ReadObject(Json, 3);
+    FString Action;
+    int64 Row = 0;
+    int64 Column = 0;
+    if (!Object.IsValid() || !Object->TryGetStringField(TEXT("action"), Action) || !ReadCount(*Object, TEXT("row"), 0, MaxIndex, Row)
+        || !ReadCount(*Object, TEXT("column"), 0, MaxIndex, Column))
+    {
+        return false;
+    }
+
+    static const EMinesweeperMoveType Types[] = { EMinesweeperMoveType::Reveal, EMinesweeperMoveType::Flag, EMinesweeperMoveType::Chord };
+    for (const EMinesweeperMoveType Type : Types)
+    {
+        if (Action == GetActionName(Type))
+        {
+            OutReply.Move = FMinesweeperMove(FIntPoint(static_cast<int32>(Row), static_cast<int32>(Column)), Type);
+            return true;
+        }
+    }
+    return false;
+}
+
+bool FMinesweeperMoveReply::ParseResult(const TSharedPtr<FJsonObject>& Result, FMinesweeperMoveReply& OutReply)
+{
+    FString Text;
+    return Result.IsValid() && Result->TryGetStringField(TEXT("text"), Text) && Parse(Text, OutReply);
+}
+
+FString FMinesweeperMoveReply::ToJson(const FMinesweeperMove& Move)
+{
+    // Written by hand to match the grammar byte for byte, a JSON writer would add whitespace.
+    return FString::Printf(TEXT("{\"action\":\"%s\",\"row\":%d,\"column\":%d}"), GetActionName(Move.Type), Move.Cell.X, Move.Cell.Y);
+}
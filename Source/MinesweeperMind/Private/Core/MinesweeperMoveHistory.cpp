@@ -0,0 +1,126 @@
+#include "Core/MinesweeperMoveHistory.h"
+
+#include "Core/MinesweeperBoard.h"
+#include "Core/MinesweeperSnapshot.h"
+
+void FMinesweeperMoveHistory::Reset(FMinesweeperBoard& InBoard)
+{
+    Board = &InBoard;
+    Steps.Reset();
+    NumApplied = 0;
+    MoveArena.Reset();
+    CellArena.Reset();
+    Changes.Reset();
+}
+
+const FMinesweeperChangeSet& FMinesweeperMoveHistory::Apply(TArrayView<const FMinesweeperMove> Moves)
+{
+    check(Board);
+
+    Board->ApplyMoves(Moves, Changes);
+    if (Changes.IsEmpty())
+    {
+        return Changes;
+    }
+
+    // A new step ends the redo branch, its arena ranges are the tail of both arenas.
+    if (NumApplied < Steps.Num())
+    {
+        MoveArena.SetNum(Steps[NumApplied].FirstMove, EAllowShrinking::No);
+        CellArena.SetNum(Steps[NumApplied].FirstCell, EAllowShrinking::No);
+        Steps.SetNum(NumApplied, EAllowShrinking::No);
+    }
+
+    FStep& Step = Steps.AddDefaulted_GetRef();
+    Step.FirstMove = MoveArena.Num();
+    Step.NumMoves = Moves.Num();
+    Step.FirstCell = CellArena.Num();
+    Step.NumRevealed = Changes.Revealed.Num();
+    Step.NumFlagged = Changes.Flagged.Num();
+    Step.NumUnflagged = Changes.Unflagged.Num();
+
+    MoveArena.Append(Moves.GetData(), Moves.Num());
+    CellArena.Reserve(CellArena.Num() + Step.NumRevealed + Step.NumFlagged + Step.NumUnflagged);
+    AppendCells(Changes.Revealed);
+    AppendCells(Changes.Flagged);
+    AppendCells(Changes.Unflagged);
+
+    ++NumApplied;
+    return Changes;
+}
+
+bool FMinesweeperMoveHistory::Undo()
+{
+    if (!CanUndo())
+    {
+        return false;
+    }
+
+    const FStep& Step = Steps[--NumApplied];
+    const int32* StepCells = CellArena.GetData() + Step.FirstCell;
+    const TArrayView<const int32> Revealed(StepCells, Step.NumRevealed);
+    const TArrayView<const int32> Flagged(StepCells + Step.NumRevealed, Step.NumFlagged);
+    const TArrayView<const int32> Unflagged(StepCells + Step.NumRevealed + Step.NumFlagged, Step.NumUnflagged);
+    Board->RevertChanges(Revealed, Flagged, Unflagged);
+
+    // Report the same cells again, the caller only needs to know what to redraw.
+    Changes.Reset();
+    const int32 NumColumns = Board->GetNumColumns();
+    for (const int32 CellIndex : Revealed)
+    {
+        Changes.Revealed.Add(FIntPoint(CellIndex / NumColumns, CellIndex % NumColumns));
+    }
+    for (const int32 CellIndex : Flagged)
+    {
+        Changes.Flagged.Add(FIntPoint(CellIndex / NumColumns, CellIndex % NumColumns));
+    }
+    return true;
+}
+
+bool FMinesweeperMoveHistory::Redo()
+{
+    if (!CanRedo())
+    {
+        return false;
+    }
+
+    const FStep& Step = Steps[NumApplied++];
+    Board->ApplyMoves(TArrayView<const FMinesweeperMove>(MoveArena.GetData() + Step.FirstMove, Step.NumMoves), Changes);
+    checkSlow(Changes.Revealed.Num() == Step.NumRevealed && Changes.Flagged.Num() == Step.NumFlagged);
+    return true;
+}
+
+TArrayView<const FMinesweeperMove> FMinesweeperMoveHistory::GetAppliedMoves() const
+{
+    const int32 NumMoves = NumApplied < Steps.Num() ? Steps[NumApplied].FirstMove : MoveArena.Num();
+    return TArrayView<const FMinesweeperMove>(MoveArena.GetData(), NumMoves);
+}
+
+bool FMinesweeperMoveHistory::SaveSnapshot(const FString& Path, bool bWithMineLayout) const
+{
+    check(Board);
+
+    FMinesweeperGameSetup Setup;
+    Setup.BoardKind = EMinesweeperBoardKind::Dense;
+    Setup.NumRows = Board->GetNumRows();
+    Setup.NumColumns = Board->GetNumColumns();
+    Setup.NumMines = Board->GetNumMines();
+    Setup.Seed = Board->GetSeed();
+    Setup.bMinesPlaced = Board->AreMinesPlaced();
+    Setup.SafeCell = Board->GetSafeCell();
+    return FMinesweeperSnapshot::WriteToFile(Path, Setup, GetAppliedMoves(), bWithMineLayout ? Board : nullptr);
+}
+
+SIZE_T FMinesweeperMoveHistory::GetAllocatedSize() const
+{
+    return Steps.GetAllocatedSize() + MoveArena.GetAllocatedSize() + CellArena.GetAllocatedSize();
+}
+
+void FMinesweeperMoveHistory::AppendCells(TArrayView<const FIntPoint> Points)
+{
+    const int32 NumColumns = Board->GetNumColumns();
+    for (const FIntPoint& Point : Points)
+    {
+        CellArena.Add(Point.X * NumColumns + Point.Y);
+    }
+}
@@ -0,0 +1,78 @@
+#include "Core/MinesweeperNoGuessGenerator.h"
+
+#include "Core/MinesweeperBoard.h"
+#include "Core/MinesweeperRandom.h"
+#include "Core/MinesweeperSolver.h"
+#include "Async/ParallelFor.h"
+#include "HAL/PlatformMisc.h"
+#include "HAL/PlatformTime.h"
+
+FMinesweeperNoGuessResult FMinesweeperNoGuessGenerator::Generate(int32 NumRows, int32 NumColumns, int64 NumMines, const FIntPoint& FirstClick,
+    uint64 BaseSeed, const FMinesweeperNoGuessSettings& Settings)
+{
+    const double StartTime = FPlatformTime::Seconds();
+    const int32 BatchSize = Settings.BatchSize > 0 ? Settings.BatchSize : FMath::Max(1, FPlatformMisc::NumberOfCoresIncludingHyperthreads());
+
+    FMinesweeperNoGuessResult Result;
+    TArray<uint8> Passed;
+
+    for (int32 FirstAttempt = 0; ; FirstAttempt += BatchSize)
+    {
+        int32 NumCandidates = BatchSize;
+        if (Settings.MaxAttempts > 0)
+        {
+            NumCandidates = FMath::Min(NumCandidates, Settings.MaxAttempts - FirstAttempt);
+        }
+        if (NumCandidates <= 0 || (FirstAttempt > 0 && FPlatformTime::Seconds() - StartTime > Settings.TimeBudgetSeconds))
+        {
+            break;
+        }
+
+        Passed.Init(0, NumCandidates);
+        ParallelFor(NumCandidates, [&](int32 Candidate)
+        {
+            const uint64 Seed = FMinesweeperRandom::MixSeed(BaseSeed, FirstAttempt + Candidate);
+            Passed[Candidate] = IsSolvableWithoutGuessing(NumRows, NumColumns, NumMines, FirstClick, Seed) ? 1 : 0;
+        });
+
+        Result.NumAttempts = FirstAttempt + NumCandidates;
+        const int32 Winner = Passed.Find(1);
+        Result.Seed = FMinesweeperRandom::MixSeed(BaseSeed, Winner != INDEX_NONE ? FirstAttempt + Winner : Result.NumAttempts - 1);
+        if (Winner != INDEX_NONE)
+        {
+            Result.NumAttempts = FirstAttempt + Winner + 1;
+            Result.bFound = true;
+            break;
+        }
+    }
+
+    Result.ElapsedSeconds = FPlatformTime::Seconds() - StartTime;
+    return Result;
+}
+
+bool FMinesweeperNoGuessGenerator::IsSolvableWithoutGuessing(int32 NumRows, int32 NumColumns, int64 NumMines, const FIntPoint& FirstClick, uint64 Seed)
+{
+    FMinesweeperBoard Board;
+    Board.Initialize(NumRows, NumColumns, NumMines);
+    Board.PlaceMines(Seed, FirstClick);
+
+    FMinesweeperSolver Solver;
+    Solver.Reset(Board);
+
+    TArray<FIntPoint> Revealed;
+    Board.Reveal(FirstClick.X, FirstClick.Y, Revealed);
+    Solver.AddRevealedCells(Revealed);
+
+    TArray<FIntPoint> SafeCells;
+    while (!Board.IsGameOver() && Solver.Solve())
+    {
+        SafeCells = Solver.GetSafeCells();
+        for (const FIntPoint& Cell : SafeCells)
+        {
+            Board.Reveal(Cell.X, Cell.Y, Revealed);
+            Solver.AddRevealedCells(Revealed);
+        }
+    }
+
+    return Board.IsGameWon();
+}
@@ -0,0 +1,299 @@
+#include "MinesweeperPerfSuite.h"
+
+#include "Core/MinesweeperBoard.h"
+#include "Dom/JsonObject.h"
+#include "HAL/IConsoleManager.h"
+#include "HAL/PlatformMisc.h"
+#include "HAL/PlatformTime.h"
+#include "Interfaces/IPluginManager.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "Serialization/JsonReader.h"
+#include "Serialization/JsonSerializer.h"
+#include "Serialization/JsonWriter.h"
+
+namespace
+{
+    constexpr uint64 PerfSeed = 1337;
+
+    TAutoConsoleVariable<float> CVarTolerancePercent(
+        TEXT("MinesweeperMind.Perf.TolerancePercent"),
+        15.f,
+        TEXT("How much slower than the baseline a MinesweeperMind.Perf benchmark may get before it counts as a regression."));
+
+    /** Differences below this are timer noise, whatever the percentage says. */
+    constexpr double MinRegressionMicroseconds = 0.5;
+
+    struct FPerfBoardSize
+    {
+        int32 NumRows;
+        int32 NumColumns;
+        int64 NumMines;
+    };
+
+    const FPerfBoardSize PerfBoardSizes[] =
+    {
+        { 9, 9, 10 },
+        { 16, 30, 99 },
+        { 100, 100, 1500 },
+        { 1000, 1000, 150000 },
+    };
+
+    /**
+     * Median microseconds of Measure over NumRepeats runs. Setup runs before every repeat and is not timed, so each
+     * repeat starts from the same state.
+     */
+    template <typename SetupType, typename MeasureType>
+    double TimeMedian(int32 NumRepeats, SetupType Setup, MeasureType Measure)
+    {
+        TArray<double> Samples;
+        Samples.Reserve(NumRepeats);
+        for (int32 Repeat = 0; Repeat < NumRepeats; ++Repeat)
+        {
+            Setup();
+            const double StartTime = FPlatformTime::Seconds();
+            Measure();
+            Samples.Add((FPlatformTime::Seconds() - StartTime) * 1000000.0);
+        }
+        Samples.Sort();
+        return Samples[Samples.Num() / 2];
+    }
+
+    enum class EPerfOperation : uint8
+    {
+        Restart,
+        PlaceMines,
+        CalculateAdjacency,
+        FloodReveal,
+        RevealToWin,
+    };
+
+    const TCHAR* const OperationNames[] =
+    {
+        TEXT("Restart"),
+        TEXT("PlaceMines"),
+        TEXT("CalculateAdjacency"),
+        TEXT("FloodReveal"),
+        TEXT("RevealToWin"),
+    };
+
+    FString MakeName(const TCHAR* OperationName, const FPerfBoardSize& Size)
+    {
+        return FString::Printf(TEXT("%s.%dx%d"), OperationName, Size.NumRows, Size.NumColumns);
+    }
+
+    double Measure(EPerfOperation Operation, const FPerfBoardSize& Size, int32 NumRepeats)
+    {
+        FMinesweeperBoard Board;
+        TArray<FIntPoint> Revealed;
+        const FIntPoint Center(Size.NumRows / 2, Size.NumColumns / 2);
+
+        // The biggest board is slow enough that a few repeats give a stable median.
+        const int32 Repeats = (int64(Size.NumRows) * Size.NumColumns >= 1000000) ? FMath::Max(1, NumRepeats / 10) : NumRepeats;
+
+        auto InitializeBoard = [&Board, &Size]()
+        {
+            Board.Initialize(Size.NumRows, Size.NumColumns, Size.NumMines);
+        };
+        auto PlaceBoard = [&Board, &Size, &Center]()
+        {
+            Board.Initialize(Size.NumRows, Size.NumColumns, Size.NumMines);
+            Board.PlaceMines(PerfSeed, Center);
+        };
+
+        switch (Operation)
+        {
+        case EPerfOperation::Restart:
+            // What restarting costs the board: fresh storage and a deferred layout.
+            return TimeMedian(Repeats, [] {}, [&Board, &Size]()
+            {
+                Board.Initialize(Size.NumRows, Size.NumColumns, Size.NumMines);
+                Board.DeferMinePlacement(PerfSeed);
+            });
+
+        case EPerfOperation::PlaceMines:
+            // Placement includes the adjacency pass, the next entry isolates it.
+            return TimeMedian(Repeats, InitializeBoard, [&Board, &Center]()
+            {
+                Board.PlaceMines(PerfSeed, Center);
+            });
+
+        case EPerfOperation::CalculateAdjacency:
+            return TimeMedian(Repeats, PlaceBoard, [&Board]()
+            {
+                Board.CalculateAdjacency();
+            });
+
+        case EPerfOperation::FloodReveal:
+            // The opening click, which flood fills from a guaranteed empty cell.
+            return TimeMedian(Repeats, PlaceBoard, [&Board, &Center, &Revealed]()
+            {
+                Board.Reveal(Center.X, Center.Y, Revealed);
+            });
+
+        case EPerfOperation::RevealToWin:
+            // Clicks every remaining safe cell one by one, each click running the win check, until the game is won.
+            return TimeMedian(Repeats, [&PlaceBoard, &Board, &Center, &Revealed]()
+            {
+                PlaceBoard();
+                Board.Reveal(Center.X, Center.Y, Revealed);
+            }, [&Board, &Size, &Revealed]()
+            {
+                for (int32 Row = 0; Row < Size.NumRows; ++Row)
+                {
+                    for (int32 Column = 0; Column < Size.NumColumns; ++Column)
+                    {
+                        if (!Board.IsMine(Row, Column) && !Board.IsRevealed(Row, Column))
+                        {
+                            Board.Reveal(Row, Column, Revealed);
+                        }
+                    }
+                }
+                check(Board.IsGameWon());
+            });
+        }
+        return 0.0;
+    }
+}
+
+TArray<FString> FMinesweeperPerfSuite::GetNames()
+{
+    TArray<FString> Names;
+    for (const FPerfBoardSize& Size : PerfBoardSizes)
+    {
+        for (const TCHAR* const OperationName : OperationNames)
+        {
+            Names.Add(MakeName(OperationName, Size));
+        }
+    }
+    return Names;
+}
+
+bool FMinesweeperPerfSuite::Run(const FString& Name, int32 NumRepeats, FMinesweeperPerfResult& OutResult)
+{
+    for (const FPerfBoardSize& Size : PerfBoardSizes)
+    {
+        for (int32 Operation = 0; Operation < static_cast<int32>(UE_ARRAY_COUNT(OperationNames)); ++Operation)
+        {
+            if (MakeName(OperationNames[Operation], Size) == Name)
+            {
+                OutResult.Name = Name;
+                OutResult.Microseconds = Measure(static_cast<EPerfOperation>(Operation), Size, FMath::Max(1, NumRepeats));
+                return true;
+            }
+        }
+    }
+    return false;
+}
+
+TArray<FMinesweeperPerfResult> FMinesweeperPerfSuite::Run(int32 NumRepeats)
+{
+    TArray<FMinesweeperPerfResult> Results;
+    for (const FString& Name : GetNames())
+    {
+        Run(Name, NumRepeats, Results.AddDefaulted_GetRef());
+    }
+    return Results;
+}
+
+double FMinesweeperPerfSuite::GetTolerancePercent()
+{
+    return CVarTolerancePercent.GetValueOnAnyThread();
+}
+
+FString FMinesweeperPerfSuite::GetDefaultBaselinePath()
+{
+    const TSharedPtr<IPlugin> Plugin = IPluginManager::Get().FindPlugin(TEXT("MinesweeperMind"));
+    return Plugin.IsValid() ? FPaths::Combine(Plugin->GetBaseDir(), TEXT("Content/Benchmarks/PerfBaseline.json")) : FString();
+}
+
+FString FMinesweeperPerfSuite::GetMachineName()
+{
+    return FPlatformMisc::GetCPUBrand().TrimStartAndEnd();
+}
+
+bool FMinesweeperPerfSuite::LoadBaseline(const FString& Path, TMap<FString, double>& OutBaseline, FString* OutMachine)
+{
+    FString Json;
+    if (!FFileHelper::LoadFileToString(Json, *Path))
+    {
+        return false;
+    }
+
+    TSharedPtr<FJsonObject> Root;
+    const TSharedRef<TJsonReader<>> Reader = TJsonReaderFactory<>::Create(Json);
+    if (!FJsonSerializer::Deserialize(Reader, Root) || !Root.IsValid())
+    {
+        return false;
+    }
+
+    const TSharedPtr<FJsonObject>* Timings = nullptr;
+    if (!Root->TryGetObjectField(TEXT("microseconds"), Timings))
+    {
+        return false;
+    }
+
+    if (OutMachine)
+    {
+        Root->TryGetStringField(TEXT("machine"), *OutMachine);
+    }
+
+    OutBaseline.Reset();
+    for (const TPair<FString, TSharedPtr<FJsonValue>>& Pair : (*Timings)->Values)
+    {
+        OutBaseline.Add(Pair.Key, Pair.Value->AsNumber());
+    }
+    return true;
+}
+
+bool FMinesweeperPerfSuite::SaveBaseline(const FString& Path, TArrayView<const FMinesweeperPerfResult> Results)
+{
+    TSharedRef<FJsonObject> Timings = MakeShared<FJsonObject>();
+    for (const FMinesweeperPerfResult& Result : Results)
+    {
+        // Two decimals keep the file readable and diffs small.
+        Timings->SetNumberField(Result.Name, FMath::RoundToDouble(Result.Microseconds * 100.0) / 100.0);
+    }
+
+    TSharedRef<FJsonObject> Root = MakeShared<FJsonObject>();
+    Root->SetStringField(TEXT("machine"), GetMachineName());
+    Root->SetObjectField(TEXT("microseconds"), Timings);
+
+    FString Json;
+    const TSharedRef<TJsonWriter<>> Writer = TJsonWriterFactory<>::Create(&Json);
+    return FJsonSerializer::Serialize(Root, Writer) && FFileHelper::SaveStringToFile(Json, *Path);
+}
+
+bool FMinesweeperPerfSuite::IsRegression(double Microseconds, double BaselineMicroseconds, double TolerancePercent)
+{
+    const double ChangePercent = (BaselineMicroseconds > 0.0) ? (Microseconds / BaselineMicroseconds - 1.0) * 100.0 : 0.0;
+    return ChangePercent > TolerancePercent && Microseconds - BaselineMicroseconds > MinRegressionMicroseconds;
+}
+
+int32 FMinesweeperPerfSuite::CompareToBaseline(TArrayView<const FMinesweeperPerfResult> Results, const TMap<FString, double>& Baseline, double TolerancePercent)
+{
+    int32 NumRegressions = 0;
+    for (const FMinesweeperPerfResult& Result : Results)
+    {
+        const double* BaselineMicroseconds = Baseline.Find(Result.Name);
+        if (!BaselineMicroseconds)
+        {
+            UE_LOG(LogTemp, Display, TEXT("%-28s %12.2f us  (no baseline)"), *Result.Name, Result.Microseconds);
+            continue;
+        }
+
+        const double ChangePercent = (*BaselineMicroseconds > 0.0) ? (Result.Microseconds / *BaselineMicroseconds - 1.0) * 100.0 : 0.0;
+        const bool bRegressed = IsRegression(Result.Microseconds, *BaselineMicroseconds, TolerancePercent);
+        NumRegressions += bRegressed ? 1 : 0;
+
+        if (bRegressed)
+        {
+            UE_LOG(LogTemp, Error, TEXT("%-28s %12.2f us  baseline %12.2f us  %+7.1f%%  REGRESSION"), *Result.Name, Result.Microseconds, *BaselineMicroseconds, ChangePercent);
+        }
+        else
+        {
+            UE_LOG(LogTemp, Display, TEXT("%-28s %12.2f us  baseline %12.2f us  %+7.1f%%"), *Result.Name, Result.Microseconds, *BaselineMicroseconds, ChangePercent);
+        }
+    }
+    return NumRegressions;
+}
@@ -0,0 +1,50 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+struct FMinesweeperPerfResult
+{
+	/** "<Operation>.<Rows>x<Columns>", the key in the baseline file. */
+	FString Name;
+	/** Median over all repeats. */
+	double Microseconds = 0.0;
+};
+
+/**
+ * Micro-benchmarks of the board hot paths at several sizes, and the comparison against a baseline measured on the
+ * reference machine. The MinesweeperMind.Perf automation tests fail on a regression, UMinesweeperMindPerfCommandlet
+ * runs them all at once and writes the baseline.
+ */
+struct FMinesweeperPerfSuite
+{
+	static constexpr int32 DefaultNumRepeats = 51;
+
+	/** How much slower than the baseline a benchmark may get, MinesweeperMind.Perf.TolerancePercent. */
+	static double GetTolerancePercent();
+
+	/** Every benchmark, in the order Run measures them. */
+	static TArray<FString> GetNames();
+
+	/** Measures one benchmark by name. False if there is no benchmark of that name. */
+	static bool Run(const FString& Name, int32 NumRepeats, FMinesweeperPerfResult& OutResult);
+
+	static TArray<FMinesweeperPerfResult> Run(int32 NumRepeats);
+
+	/** Plugin-relative default baseline, Content/Benchmarks/PerfBaseline.json, checked in from the reference machine. */
+	static FString GetDefaultBaselinePath();
+
+	/** What SaveBaseline records as the machine, timings are only comparable on the machine that measured them. */
+	static FString GetMachineName();
+
+	static bool LoadBaseline(const FString& Path, TMap<FString, double>& OutBaseline, FString* OutMachine = nullptr);
+	static bool SaveBaseline(const FString& Path, TArrayView<const FMinesweeperPerfResult> Results);
+
+	/** Slower than the baseline by more than TolerancePercent, and by more than timer noise. */
+	static bool IsRegression(double Microseconds, double BaselineMicroseconds, double TolerancePercent);
+
+	/**
+	 * Logs every result next to its baseline and returns how many are slower than the baseline by more than
+	 * TolerancePercent. Results missing from the baseline are reported but never count as regressions.
+	 */
+	static int32 CompareToBaseline(TArrayView<const FMinesweeperPerfResult> Results, const TMap<FString, double>& Baseline, double TolerancePercent);
+};
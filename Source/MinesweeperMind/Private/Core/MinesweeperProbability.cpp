@@ -0,0 +1,645 @@
+#include "Core/MinesweeperProbability.h"
+
+#include "Core/IMinesweeperBoard.h"
+#include "Core/MinesweeperRandom.h"
+#include "Core/MinesweeperSolver.h"
+#include "Async/ParallelFor.h"
+#include "HAL/PlatformTime.h"
+#include "Math/UnrealMathUtility.h"
+
+namespace
+{
+    /** Inverse temperature of the sampling walk. Higher stays closer to valid layouts, lower mixes faster. */
+    constexpr double SamplingBeta = 1.5;
+    /** Mine counts tracked around the first valid layout of a sampled component. */
+    constexpr int32 SampledMineCountWindow = 128;
+    /** Enumeration nodes or sampling steps between two deadline checks. */
+    constexpr int32 DeadlineCheckInterval = 1024;
+
+    /** Connected group of frontier cells, cells are in enumeration order. */
+    struct FComponent
+    {
+        TArray<FIntPoint> Cells;
+        TArray<TArray<int32, TInlineAllocator<4>>> CellConstraints;
+        TArray<TArray<int32, TInlineAllocator<8>>> ConstraintCells;
+        TArray<int32> ConstraintMines;
+
+        /** Solutions per mine count MinMines + Index, and the same split per cell in CellMines[Cell * NumMineCounts + Index]. */
+        int32 MinMines = 0;
+        int32 NumMineCounts = 0;
+        TArray<double> Solutions;
+        TArray<double> CellMines;
+        bool bSampled = false;
+
+        int32 Num() const { return Cells.Num(); }
+
+        void InitCounts(int32 InMinMines, int32 InNumMineCounts)
+        {
+            MinMines = InMinMines;
+            NumMineCounts = InNumMineCounts;
+            Solutions.Init(0.0, NumMineCounts);
+            CellMines.Init(0.0, Num() * NumMineCounts);
+        }
+
+        void Record(const TArray<uint8>& Values, int32 NumMines)
+        {
+            const int32 CountIndex = NumMines - MinMines;
+            if (CountIndex < 0 || CountIndex >= NumMineCounts)
+            {
+                return;
+            }
+
+            Solutions[CountIndex] += 1.0;
+            for (int32 Cell = 0; Cell < Num(); ++Cell)
+            {
+                if (Values[Cell])
+                {
+                    CellMines[Cell * NumMineCounts + CountIndex] += 1.0;
+                }
+            }
+        }
+    };
+
+    /** Depth-first enumeration with partial-sum pruning. Aborts once the deadline passes. */
+    class FComponentEnumerator
+    {
+    public:
+        FComponentEnumerator(FComponent& InComponent, double InDeadline, bool bInStopAtFirst)
+            : Component(InComponent)
+            , Deadline(InDeadline)
+            , bStopAtFirst(bInStopAtFirst)
+        {
+            Values.Init(0, Component.Num());
+            Assigned.Init(0, Component.ConstraintMines.Num());
+            Unassigned.SetNumUninitialized(Component.ConstraintMines.Num());
+            for (int32 Constraint = 0; Constraint < Component.ConstraintMines.Num(); ++Constraint)
+            {
+                Unassigned[Constraint] = Component.ConstraintCells[Constraint].Num();
+            }
+        }
+
+        /** Returns false if the deadline cut the enumeration short. */
+        bool Run()
+        {
+            Enumerate(0, 0);
+            return !bAborted;
+        }
+
+        bool FoundAny() const { return bFoundAny; }
+        const TArray<uint8>& GetFirstSolution() const { return FirstSolution; }
+
+    private:
+        void Enumerate(int32 Depth, int32 NumMines)
+        {
+            if (bAborted || (bStopAtFirst && bFoundAny))
+            {
+                return;
+            }
+
+            if (++NumNodes % DeadlineCheckInterval == 0 && FPlatformTime::Seconds() > Deadline)
+            {
+                bAborted = true;
+                return;
+            }
+
+            if (Depth == Component.Num())
+            {
+                if (!bFoundAny)
+                {
+                    FirstSolution = Values;
+                    bFoundAny = true;
+                }
+                if (!bStopAtFirst)
+                {
+                    Component.Record(Values, NumMines);
+                }
+                return;
+            }
+
+            for (uint8 Value = 0; Value <= 1; ++Value)
+            {
+                bool bConsistent = true;
+                for (const int32 Constraint : Component.CellConstraints[Depth])
+                {
+                    Assigned[Constraint] += Value;
+                    --Unassigned[Constraint];
+                    const int32 Mines = Component.ConstraintMines[Constraint];
+                    bConsistent &= Assigned[Constraint] <= Mines && Assigned[Constraint] + Unassigned[Constraint] >= Mines;
+                }
+
+                if (bConsistent)
+                {
+                    Values[Depth] = Value;
+                    Enumerate(Depth + 1, NumMines + Value);
+                    Values[Depth] = 0;
+                }
+
+                for (const int32 Constraint : Component.CellConstraints[Depth])
+                {
+                    Assigned[Constraint] -= Value;
+                    ++Unassigned[Constraint];
+                }
+            }
+        }
+
+        FComponent& Component;
+        const double Deadline;
+        const bool bStopAtFirst;
+
+        TArray<uint8> Values;
+        TArray<int32> Assigned;
+        TArray<int32> Unassigned;
+        TArray<uint8> FirstSolution;
+
+        int64 NumNodes = 0;
+        bool bAborted = false;
+        bool bFoundAny = false;
+    };
+
+    /**
+     * Metropolis walk over all layouts of the component with energy = total constraint violation, flipping one cell
+     * per step. Its stationary distribution is uniform over the valid layouts, so the valid ones it passes through
+     * are an unbiased sample of them.
+     */
+    void SampleComponent(FComponent& Component, const TArray<uint8>& StartLayout, double Deadline, int32 MaxSteps, uint64 Seed, uint64 StreamId)
+    {
+        const int32 NumCells = Component.Num();
+        const int32 NumConstraints = Component.ConstraintMines.Num();
+
+        TArray<uint8> Values = StartLayout;
+        TArray<int32> Sums;
+        Sums.Init(0, NumConstraints);
+        int32 NumMines = 0;
+        for (int32 Cell = 0; Cell < NumCells; ++Cell)
+        {
+            NumMines += Values[Cell];
+            for (const int32 Constraint : Component.CellConstraints[Cell])
+            {
+                Sums[Constraint] += Values[Cell];
+            }
+        }
+
+        const int32 HalfWindow = SampledMineCountWindow / 2;
+        const int32 MinMines = FMath::Max(0, NumMines - HalfWindow);
+        Component.InitCounts(MinMines, FMath::Min(NumCells + 1, NumMines + HalfWindow + 1) - MinMines);
+        Component.bSampled = true;
+
+        // A flip changes each constraint of the cell by one, so the energy delta is bounded by twice its constraint count.
+        TArray<double> Acceptance;
+        Acceptance.SetNumUninitialized(32);
+        for (int32 Delta = 0; Delta < Acceptance.Num(); ++Delta)
+        {
+            Acceptance[Delta] = FMath::Exp(-SamplingBeta * Delta);
+        }
+
+        // Recording costs one pass over the component, thin it out so the walk dominates.
+        const int32 RecordInterval = FMath::Max(1, NumCells / 4);
+
+        FMinesweeperRandom Random(Seed, StreamId);
+        int32 Energy = 0;
+        for (int32 Step = 1; Step <= MaxSteps; ++Step)
+        {
+            if (Step % DeadlineCheckInterval == 0 && FPlatformTime::Seconds() > Deadline)
+            {
+                break;
+            }
+
+            const int32 Cell = static_cast<int32>(Random.NextBounded(static_cast<uint32>(NumCells)));
+            const int32 Change = Values[Cell] ? -1 : 1;
+
+            int32 EnergyDelta = 0;
+            for (const int32 Constraint : Component.CellConstraints[Cell])
+            {
+                const int32 Mines = Component.ConstraintMines[Constraint];
+                EnergyDelta += FMath::Abs(Sums[Constraint] + Change - Mines) - FMath::Abs(Sums[Constraint] - Mines);
+            }
+
+            if (EnergyDelta <= 0 || Random.NextFraction() < Acceptance[FMath::Min(EnergyDelta, Acceptance.Num() - 1)])
+            {
+                Values[Cell] ^= 1;
+                NumMines += Change;
+                Energy += EnergyDelta;
+                for (const int32 Constraint : Component.CellConstraints[Cell])
+                {
+                    Sums[Constraint] += Change;
+                }
+            }
+
+            if (Energy == 0 && Step % RecordInterval == 0)
+            {
+                Component.Record(Values, NumMines);
+            }
+        }
+    }
+
+    /** Plain convolution of two mine count distributions, truncated to MaxLength. */
+    void Convolve(const TArray<double>& A, const TArray<double>& B, int32 MaxLength, TArray<double>& Out)
+    {
+        Out.Init(0.0, FMath::Min(A.Num() + B.Num() - 1, MaxLength));
+        for (int32 IndexA = 0; IndexA < A.Num(); ++IndexA)
+        {
+            if (A[IndexA] == 0.0)
+            {
+                continue;
+            }
+            for (int32 IndexB = 0; IndexB < B.Num() && IndexA + IndexB < Out.Num(); ++IndexB)
+            {
+                Out[IndexA + IndexB] += A[IndexA] * B[IndexB];
+            }
+        }
+    }
+
+    int32 FindRoot(TArray<int32>& Parents, int32 Index)
+    {
+        while (Parents[Index] != Index)
+        {
+            Parents[Index] = Parents[Parents[Index]];
+            Index = Parents[Index];
+        }
+        return Index;
+    }
+}
+
+TSharedRef<const FMinesweeperProbabilityResult> FMinesweeperProbability::Calculate(const IMinesweeperBoard& Board,
+    const FMinesweeperSolver* Solver, const FMinesweeperProbabilitySettings& Settings)
+{
+    const double StartTime = FPlatformTime::Seconds();
+    const double Deadline = StartTime + Settings.TimeBudgetSeconds;
+
+    TSharedRef<FMinesweeperProbabilityResult> Result = MakeShared<FMinesweeperProbabilityResult>();
+
+    auto IsKnownMine = [Solver](int32 Row, int32 Column) { return Solver && Solver->IsKnownMine(Row, Column); };
+    auto IsKnownSafe = [Solver](int32 Row, int32 Column) { return Solver && Solver->IsKnownSafe(Row, Column); };
+
+    // Gather the frontier and its constraints in one pass over the board.
+    TMap<FIntPoint, int32> FrontierIndices;
+    TArray<FIntPoint> FrontierCells;
+    TArray<TArray<int32, TInlineAllocator<8>>> ConstraintCells;
+    TArray<int32> ConstraintMines;
+
+    int64 NumUnknown = 0;
+    int64 NumKnownMines = 0;
+    FIntPoint FirstUnknownCell(INDEX_NONE, INDEX_NONE);
+
+    for (int32 Row = 0; Row < Board.GetNumRows(); ++Row)
+    {
+        for (int32 Column = 0; Column < Board.GetNumColumns(); ++Column)
+        {
+            const uint8 Cell = Board.GetCell(Row, Column);
+            if ((Cell & MinesweeperCell::Revealed) == 0)
+            {
+                if (IsKnownMine(Row, Column))
+                {
+                    ++NumKnownMines;
+                    Result->CellProbabilities.Add(FIntPoint(Row, Column), 1.f);
+                }
+                else if (IsKnownSafe(Row, Column))
+                {
+                    Result->CellProbabilities.Add(FIntPoint(Row, Column), 0.f);
+                }
+                else
+                {
+                    ++NumUnknown;
+                }
+                continue;
+            }
+
+            if ((Cell & MinesweeperCell::AdjacencyMask) == 0)
+            {
+                continue;
+            }
+
+            TArray<int32, TInlineAllocator<8>> Cells;
+            int32 Mines = Cell & MinesweeperCell::AdjacencyMask;
+            for (int32 NeighborRow = Row - 1; NeighborRow <= Row + 1; ++NeighborRow)
+            {
+                for (int32 NeighborCol = Column - 1; NeighborCol <= Column + 1; ++NeighborCol)
+                {
+                    if (!Board.IsValidCell(NeighborRow, NeighborCol) || Board.IsRevealed(NeighborRow, NeighborCol))
+                    {
+                        continue;
+                    }
+
+                    if (IsKnownMine(NeighborRow, NeighborCol))
+                    {
+                        --Mines;
+                    }
+                    else if (!IsKnownSafe(NeighborRow, NeighborCol))
+                    {
+                        const FIntPoint Neighbor(NeighborRow, NeighborCol);
+                        int32& FrontierIndex = FrontierIndices.FindOrAdd(Neighbor, INDEX_NONE);
+                        if (FrontierIndex == INDEX_NONE)
+                        {
+                            FrontierIndex = FrontierCells.Add(Neighbor);
+                        }
+                        Cells.Add(FrontierIndex);
+                    }
+                }
+            }
+
+            if (!Cells.IsEmpty())
+            {
+                ConstraintCells.Add(MoveTemp(Cells));
+                ConstraintMines.Add(Mines);
+            }
+        }
+    }
+
+    // Any hidden unknown cell that isn't on the frontier is interior. The first one stands in for all of them.
+    for (int32 Row = 0; Row < Board.GetNumRows() && FirstUnknownCell.X == INDEX_NONE; ++Row)
+    {
+        for (int32 Column = 0; Column < Board.GetNumColumns(); ++Column)
+        {
+            if (!Board.IsRevealed(Row, Column) && !IsKnownMine(Row, Column) && !IsKnownSafe(Row, Column) && !FrontierIndices.Contains(FIntPoint(Row, Column)))
+            {
+                FirstUnknownCell = FIntPoint(Row, Column);
+                break;
+            }
+        }
+    }
+
+    // Union-find over constraints splits the frontier into independent components.
+    TArray<int32> Parents;
+    Parents.SetNumUninitialized(FrontierCells.Num());
+    for (int32 Index = 0; Index < Parents.Num(); ++Index)
+    {
+        Parents[Index] = Index;
+    }
+    for (const TArray<int32, TInlineAllocator<8>>& Cells : ConstraintCells)
+    {
+        for (int32 Index = 1; Index < Cells.Num(); ++Index)
+        {
+            Parents[FindRoot(Parents, Cells[Index])] = FindRoot(Parents, Cells[0]);
+        }
+    }
+
+    TArray<TArray<int32>> ComponentConstraints;
+    TArray<int32> RootToComponent;
+    RootToComponent.Init(INDEX_NONE, FrontierCells.Num());
+    for (int32 Constraint = 0; Constraint < ConstraintCells.Num(); ++Constraint)
+    {
+        int32& ComponentIndex = RootToComponent[FindRoot(Parents, ConstraintCells[Constraint][0])];
+        if (ComponentIndex == INDEX_NONE)
+        {
+            ComponentIndex = ComponentConstraints.AddDefaulted();
+        }
+        ComponentConstraints[ComponentIndex].Add(Constraint);
+    }
+
+    // Renumber each component's cells breadth first, so enumeration closes constraints early and prunes sooner.
+    TArray<FComponent> Components;
+    Components.SetNum(ComponentConstraints.Num());
+    TArray<int32> FrontierToLocal;
+    FrontierToLocal.Init(INDEX_NONE, FrontierCells.Num());
+    TArray<TArray<int32, TInlineAllocator<4>>> FrontierConstraints;
+    FrontierConstraints.SetNum(FrontierCells.Num());
+    for (int32 Constraint = 0; Constraint < ConstraintCells.Num(); ++Constraint)
+    {
+        for (const int32 FrontierIndex : ConstraintCells[Constraint])
+        {
+            FrontierConstraints[FrontierIndex].Add(Constraint);
+        }
+    }
+
+    for (int32 ComponentIndex = 0; ComponentIndex < Components.Num(); ++ComponentIndex)
+    {
+        FComponent& Component = Components[ComponentIndex];
+        TMap<int32, int32> ConstraintToLocal;
+        for (const int32 Constraint : ComponentConstraints[ComponentIndex])
+        {
+            ConstraintToLocal.Add(Constraint, Component.ConstraintMines.Add(ConstraintMines[Constraint]));
+            Component.ConstraintCells.AddDefaulted();
+        }
+
+        TArray<int32> Order;
+        const int32 Seed = ConstraintCells[ComponentConstraints[ComponentIndex][0]][0];
+        FrontierToLocal[Seed] = 0;
+        Order.Add(Seed);
+        for (int32 Visit = 0; Visit < Order.Num(); ++Visit)
+        {
+            for (const int32 Constraint : FrontierConstraints[Order[Visit]])
+            {
+                for (const int32 FrontierIndex : ConstraintCells[Constraint])
+                {
+                    if (FrontierToLocal[FrontierIndex] == INDEX_NONE)
+                    {
+                        FrontierToLocal[FrontierIndex] = Order.Add(FrontierIndex);
+                    }
+                }
+            }
+        }
+
+        Component.CellConstraints.SetNum(Order.Num());
+        for (int32 Local = 0; Local < Order.Num(); ++Local)
+        {
+            Component.Cells.Add(FrontierCells[Order[Local]]);
+            for (const int32 Constraint : FrontierConstraints[Order[Local]])
+            {
+                const int32 LocalConstraint = ConstraintToLocal[Constraint];
+                Component.CellConstraints[Local].Add(LocalConstraint);
+                Component.ConstraintCells[LocalConstraint].Add(Local);
+            }
+        }
+    }
+
+    // Largest first so the long enumerations start while the small ones fill the gaps.
+    Components.Sort([](const FComponent& A, const FComponent& B) { return A.Num() > B.Num(); });
+
+    // Exact enumeration stops at the budget. Finding a first layout and sampling from it gets half the budget again
+    // once, shared by every component, so a call never runs past one and a half budgets however many components it has.
+    const double SamplingDeadline = Deadline + Settings.TimeBudgetSeconds * 0.5;
+
+    ParallelFor(Components.Num(), [&Components, &Settings, Deadline, SamplingDeadline](int32 ComponentIndex)
+    {
+        FComponent& Component = Components[ComponentIndex];
+
+        if (Component.Num() <= Settings.MaxExactComponentSize)
+        {
+            Component.InitCounts(0, Component.Num() + 1);
+            FComponentEnumerator Enumerator(Component, Deadline, false);
+            if (Enumerator.Run())
+            {
+                return;
+            }
+        }
+
+        // Too large or out of time. Find one valid layout and walk from it.
+        FComponentEnumerator FirstLayout(Component, SamplingDeadline, true);
+        FirstLayout.Run();
+        if (FirstLayout.FoundAny())
+        {
+            SampleComponent(Component, FirstLayout.GetFirstSolution(), SamplingDeadline, Settings.MaxSampleSteps, Settings.Seed,
+                static_cast<uint64>(ComponentIndex));
+        }
+        else
+        {
+            Component.InitCounts(0, 0);
+            Component.bSampled = true;
+        }
+    });
+
+    // Combine. With R mines left outside the known ones and I interior cells, a frontier total of m mines leaves
+    // C(I, R - m) interior layouts. Everything is scaled relative to the largest term, so only ratios matter.
+    const int64 RemainingMines = Board.GetNumMines() - NumKnownMines;
+    const int64 NumInterior = NumUnknown - FrontierCells.Num();
+
+    int32 MaxFrontierMines = 0;
+    for (const FComponent& Component : Components)
+    {
+        MaxFrontierMines += Component.MinMines + FMath::Max(Component.NumMineCounts - 1, 0);
+    }
+
+    TArray<double> InteriorWeights;
+    InteriorWeights.Init(0.0, MaxFrontierMines + 1);
+    {
+        TArray<double> LogWeights;
+        LogWeights.Init(0.0, MaxFrontierMines + 1);
+
+        // log C(I, r) relative to the largest feasible r, stepping down with C(I, r - 1) = C(I, r) * r / (I - r + 1).
+        double LogChoose = 0.0;
+        double MaxLog = TNumericLimits<double>::Lowest();
+        int32 FirstFeasible = INDEX_NONE;
+        int32 LastFeasible = INDEX_NONE;
+        for (int32 FrontierMines = 0; FrontierMines <= MaxFrontierMines; ++FrontierMines)
+        {
+            const int64 InteriorMines = RemainingMines - FrontierMines;
+            if (InteriorMines < 0)
+            {
+                break;
+            }
+            if (InteriorMines > NumInterior)
+            {
+                continue;
+            }
+
+            if (FirstFeasible != INDEX_NONE)
+            {
+                LogChoose += FMath::Loge(double(InteriorMines + 1)) - FMath::Loge(double(NumInterior - InteriorMines));
+            }
+            else
+            {
+                FirstFeasible = FrontierMines;
+            }
+            LastFeasible = FrontierMines;
+            LogWeights[FrontierMines] = LogChoose;
+            MaxLog = FMath::Max(MaxLog, LogChoose);
+        }
+
+        for (int32 FrontierMines = FirstFeasible; FrontierMines != INDEX_NONE && FrontierMines <= LastFeasible; ++FrontierMines)
+        {
+            InteriorWeights[FrontierMines] = FMath::Exp(LogWeights[FrontierMines] - MaxLog);
+        }
+    }
+
+    // Normalized per-component distributions over absolute mine counts, then prefix and suffix convolutions so each
+    // component can be weighed against all the others in one pass.
+    const int32 NumComponents = Components.Num();
+    TArray<TArray<double>> Distributions;
+    Distributions.SetNum(NumComponents);
+    for (int32 ComponentIndex = 0; ComponentIndex < NumComponents; ++ComponentIndex)
+    {
+        const FComponent& Component = Components[ComponentIndex];
+        double Total = 0.0;
+        for (const double Count : Component.Solutions)
+        {
+            Total += Count;
+        }
+
+        TArray<double>& Distribution = Distributions[ComponentIndex];
+        Distribution.Init(0.0, Component.MinMines + Component.NumMineCounts);
+        for (int32 CountIndex = 0; CountIndex < Component.NumMineCounts && Total > 0.0; ++CountIndex)
+        {
+            Distribution[Component.MinMines + CountIndex] = Component.Solutions[CountIndex] / Total;
+        }
+        if (Total == 0.0)
+        {
+            Distribution.Init(0.0, 1);
+            Distribution[0] = 1.0;
+        }
+    }
+
+    const int32 MaxLength = MaxFrontierMines + 1;
+    TArray<TArray<double>> Prefix;
+    TArray<TArray<double>> Suffix;
+    Prefix.SetNum(NumComponents + 1);
+    Suffix.SetNum(NumComponents + 1);
+    Prefix[0] = { 1.0 };
+    Suffix[NumComponents] = { 1.0 };
+    for (int32 ComponentIndex = 0; ComponentIndex < NumComponents; ++ComponentIndex)
+    {
+        Convolve(Prefix[ComponentIndex], Distributions[ComponentIndex], MaxLength, Prefix[ComponentIndex + 1]);
+    }
+    for (int32 ComponentIndex = NumComponents - 1; ComponentIndex >= 0; --ComponentIndex)
+    {
+        Convolve(Suffix[ComponentIndex + 1], Distributions[ComponentIndex], MaxLength, Suffix[ComponentIndex]);
+    }
+
+    // Interior probability is the expected share of the leftover mines per interior cell.
+    {
+        const TArray<double>& All = Prefix[NumComponents];
+        double Normalizer = 0.0;
+        double ExpectedInteriorMines = 0.0;
+        for (int32 FrontierMines = 0; FrontierMines < All.Num(); ++FrontierMines)
+        {
+            const double Weight = All[FrontierMines] * InteriorWeights[FrontierMines];
+            Normalizer += Weight;
+            ExpectedInteriorMines += Weight * double(RemainingMines - FrontierMines);
+        }
+        Result->InteriorProbability = (NumInterior > 0 && Normalizer > 0.0) ? float(ExpectedInteriorMines / Normalizer / double(NumInterior)) : 0.f;
+    }
+
+    TArray<double> Others;
+    TArray<double> CountWeights;
+    for (int32 ComponentIndex = 0; ComponentIndex < NumComponents; ++ComponentIndex)
+    {
+        const FComponent& Component = Components[ComponentIndex];
+        Convolve(Prefix[ComponentIndex], Suffix[ComponentIndex + 1], MaxLength, Others);
+
+        // Weight of this component having MinMines + CountIndex mines, summed over every total of the others.
+        CountWeights.Init(0.0, Component.NumMineCounts);
+        double Normalizer = 0.0;
+        for (int32 CountIndex = 0; CountIndex < Component.NumMineCounts; ++CountIndex)
+        {
+            const int32 Mines = Component.MinMines + CountIndex;
+            for (int32 OtherMines = 0; OtherMines < Others.Num() && Mines + OtherMines < InteriorWeights.Num(); ++OtherMines)
+            {
+                CountWeights[CountIndex] += Others[OtherMines] * InteriorWeights[Mines + OtherMines];
+            }
+            Normalizer += Component.Solutions[CountIndex] * CountWeights[CountIndex];
+        }
+
+        Result->bExact &= !Component.bSampled;
+        Result->NumSampledComponents += Component.bSampled ? 1 : 0;
+
+        for (int32 Cell = 0; Cell < Component.Num(); ++Cell)
+        {
+            double Weighted = 0.0;
+            for (int32 CountIndex = 0; CountIndex < Component.NumMineCounts; ++CountIndex)
+            {
+                Weighted += Component.CellMines[Cell * Component.NumMineCounts + CountIndex] * CountWeights[CountIndex];
+            }
+
+            // A component the sampler never saw in a valid layout falls back to the interior estimate.
+            const float Probability = Normalizer > 0.0 ? float(Weighted / Normalizer) : Result->InteriorProbability;
+            Result->CellProbabilities.Add(Component.Cells[Cell], Probability);
+        }
+    }
+
+    float SafestProbability = 2.f;
+    for (const TPair<FIntPoint, float>& Pair : Result->CellProbabilities)
+    {
+        if (Pair.Value < SafestProbability)
+        {
+            SafestProbability = Pair.Value;
+            Result->SafestCell = Pair.Key;
+        }
+    }
+    if (FirstUnknownCell.X != INDEX_NONE && Result->InteriorProbability < SafestProbability)
+    {
+        Result->SafestCell = FirstUnknownCell;
+    }
+
+    Result->NumComponents = NumComponents;
+    Result->ElapsedSeconds = FPlatformTime::Seconds() - StartTime;
+    return Result;
+}
@@ -0,0 +1,247 @@
+#include "Core/MinesweeperPromptEncoder.h"
+
+#include "Core/IMinesweeperBoard.h"
+#include "Core/MinesweeperModelReplies.h"
+
+namespace
+{
+    const TCHAR* const AssistantTurn = TEXT("<|assistant|>\n");
+
+    const TCHAR* const SystemFormat = TEXT(
+        "<|system|>\nYou are playing Minesweeper on a %d by %d board with %lld mines, rows and columns count from 0. "
+        "You are shown the frontier, the revealed numbers that touch hidden cells and your flags (F). It is listed one "
+        "row per line as row: column=cells, where cells are the entries from that column rightwards, so 3: 4=12F is "
+        "3,4=1 3,5=2 3,6=F. After each move you are shown what changed, +row,column=entry for new entries and "
+        "-row,column for entries that left. Answer with one move as JSON, for example "
+        "{\"action\":\"reveal\",\"row\":3,\"column\":4}, the action being reveal, flag or chord.</s>\n");
+
+    FORCEINLINE bool IsLetter(TCHAR Character)
+    {
+        return (Character >= TEXT('a') && Character <= TEXT('z')) || (Character >= TEXT('A') && Character <= TEXT('Z'));
+    }
+}
+
+FMinesweeperPromptEncoder::FMinesweeperPromptEncoder(int32 InTokenBudget)
+    : TokenBudget(InTokenBudget)
+{
+}
+
+void FMinesweeperPromptEncoder::BeginGame(const IMinesweeperBoard& Board)
+{
+    Stats = FMinesweeperPromptStats();
+    Rebaseline(Board);
+    Stats.SentTokens += Stats.PromptTokens;
+}
+
+void FMinesweeperPromptEncoder::AddMove(const IMinesweeperBoard& Board, const FMinesweeperMove& Move, TArrayView<const FIntPoint> RevealedCells)
+{
+    ++Stats.NumMoves;
+
+    // A cell's entry only changes when it or one of its neighbours was revealed or flagged.
+    TArray<FIntPoint> Candidates;
+    Candidates.Reserve((RevealedCells.Num() + 1) * 9);
+    auto AddNeighbourhood = [&Board, &Candidates](const FIntPoint& Cell)
+    {
+        for (int32 Row = Cell.X - 1; Row <= Cell.X + 1; ++Row)
+        {
+            for (int32 Column = Cell.Y - 1; Column <= Cell.Y + 1; ++Column)
+            {
+                if (Board.IsValidCell(Row, Column))
+                {
+                    Candidates.Add(FIntPoint(Row, Column));
+                }
+            }
+        }
+    };
+    AddNeighbourhood(Move.Cell);
+    for (const FIntPoint& Cell : RevealedCells)
+    {
+        AddNeighbourhood(Cell);
+    }
+
+    // Row major, so the same board state always produces the same diff text.
+    Candidates.Sort([](const FIntPoint& A, const FIntPoint& B) { return A.X != B.X ? A.X < B.X : A.Y < B.Y; });
+
+    FString Diff;
+    for (int32 Index = 0; Index < Candidates.Num(); ++Index)
+    {
+        const FIntPoint& Cell = Candidates[Index];
+        if (Index > 0 && Cell == Candidates[Index - 1])
+        {
+            continue;
+        }
+
+        const uint8 Entry = GetEntry(Board, Cell.X, Cell.Y);
+        const uint8* OldEntry = Frontier.Find(Cell);
+        if (Entry == (OldEntry ? *OldEntry : NoEntry))
+        {
+            continue;
+        }
+
+        Diff += Diff.IsEmpty() ? TEXT("") : TEXT(" ");
+        if (Entry == NoEntry)
+        {
+            Diff += FString::Printf(TEXT("-%d,%d"), Cell.X, Cell.Y);
+            Frontier.Remove(Cell);
+        }
+        else
+        {
+            Diff += TEXT("+");
+            AppendEntry(Diff, Cell, Entry);
+            Frontier.Add(Cell, Entry);
+        }
+    }
+
+    const FString Text = FString::Printf(TEXT("%s%s</s>\n<|user|>\n%s</s>\n"), AssistantTurn, *FMinesweeperMoveReply::ToJson(Move),
+        Diff.IsEmpty() ? TEXT("no change") : *Diff);
+    if (Stats.PromptTokens + EstimateTokens(Text) > TokenBudget)
+    {
+        ++Stats.NumRebaselines;
+        Rebaseline(Board);
+    }
+    else
+    {
+        Append(Text);
+    }
+    Stats.SentTokens += Stats.PromptTokens;
+}
+
+FString FMinesweeperPromptEncoder::GetPrompt() const
+{
+    return Transcript + AssistantTurn;
+}
+
+int32 FMinesweeperPromptEncoder::EstimateTokens(FStringView Text)
+{
+    int32 NumTokens = 0;
+    const TCHAR* Data = Text.GetData();
+    for (int32 Index = 0; Index < Text.Len(); ++Index)
+    {
+        const TCHAR Character = Data[Index];
+        if (IsLetter(Character))
+        {
+            // Words are mostly single tokens, count a run of letters once.
+            if (Index == 0 || !IsLetter(Data[Index - 1]))
+            {
+                ++NumTokens;
+            }
+        }
+        else if (Character != TEXT(' '))
+        {
+            // Llama splits numbers into digits, newlines and punctuation are tokens of their own.
+            ++NumTokens;
+        }
+    }
+    return NumTokens;
+}
+
+FString FMinesweeperPromptEncoder::EncodeGrid(const IMinesweeperBoard& Board)
+{
+    FString Grid;
+    Grid.Reserve(static_cast<int32>(Board.GetNumRows() * (Board.GetNumColumns() + 1)));
+    for (int32 Row = 0; Row < Board.GetNumRows(); ++Row)
+    {
+        for (int32 Column = 0; Column < Board.GetNumColumns(); ++Column)
+        {
+            if (Board.IsRevealed(Row, Column))
+            {
+                const int32 AdjacentMines = Board.GetAdjacentMines(Row, Column);
+                Grid += AdjacentMines > 0 ? TCHAR(TEXT('0') + AdjacentMines) : TEXT('.');
+            }
+            else
+            {
+                Grid += Board.IsFlagged(Row, Column) ? TEXT('F') : TEXT('#');
+            }
+        }
+        Grid += TEXT('\n');
+    }
+    return Grid;
+}
+
+uint8 FMinesweeperPromptEncoder::GetEntry(const IMinesweeperBoard& Board, int32 Row, int32 Column)
+{
+    if (!Board.IsRevealed(Row, Column))
+    {
+        return Board.IsFlagged(Row, Column) ? FlagEntry : NoEntry;
+    }
+
+    const int32 AdjacentMines = Board.GetAdjacentMines(Row, Column);
+    if (AdjacentMines == 0)
+    {
+        return NoEntry;
+    }
+
+    // A number whose hidden neighbours are all flagged has nothing left to tell.
+    for (int32 NeighborRow = Row - 1; NeighborRow <= Row + 1; ++NeighborRow)
+    {
+        for (int32 NeighborCol = Column - 1; NeighborCol <= Column + 1; ++NeighborCol)
+        {
+            if (Board.IsValidCell(NeighborRow, NeighborCol) && !Board.IsRevealed(NeighborRow, NeighborCol) && !Board.IsFlagged(NeighborRow, NeighborCol))
+            {
+                return static_cast<uint8>(AdjacentMines);
+            }
+        }
+    }
+    return NoEntry;
+}
+
+void FMinesweeperPromptEncoder::AppendEntry(FString& Out, const FIntPoint& Cell, uint8 Entry)
+{
+    if (Entry == FlagEntry)
+    {
+        Out += FString::Printf(TEXT("%d,%d=F"), Cell.X, Cell.Y);
+    }
+    else
+    {
+        Out += FString::Printf(TEXT("%d,%d=%d"), Cell.X, Cell.Y, Entry);
+    }
+}
+
+void FMinesweeperPromptEncoder::Rebaseline(const IMinesweeperBoard& Board)
+{
+    Frontier.Reset();
+
+    // One line per row, each run of adjacent entries written as its first column and one character per cell. The
+    // frontier is mostly unbroken along rows, so this is a fraction of the tokens of row,column=n for every entry.
+    FString Rows;
+    for (int32 Row = 0; Row < Board.GetNumRows(); ++Row)
+    {
+        FString Line;
+        int32 PreviousColumn = INDEX_NONE;
+        for (int32 Column = 0; Column < Board.GetNumColumns(); ++Column)
+        {
+            const uint8 Entry = GetEntry(Board, Row, Column);
+            if (Entry == NoEntry)
+            {
+                continue;
+            }
+
+            if (Column != PreviousColumn + 1 || Line.IsEmpty())
+            {
+                Line += FString::Printf(TEXT(" %d="), Column);
+            }
+            Line += Entry == FlagEntry ? TEXT('F') : TCHAR(TEXT('0') + Entry);
+            PreviousColumn = Column;
+            Frontier.Add(FIntPoint(Row, Column), Entry);
+        }
+
+        if (!Line.IsEmpty())
+        {
+            Rows += FString::Printf(TEXT("\n%d:%s"), Row, *Line);
+        }
+    }
+
+    Transcript.Reset();
+    Stats.PromptTokens = EstimateTokens(AssistantTurn);
+    Append(FString::Printf(SystemFormat, Board.GetNumRows(), Board.GetNumColumns(), Board.GetNumMines()));
+    Append(FString::Printf(TEXT("<|user|>\nFrontier:%s</s>\n"), Rows.IsEmpty() ? TEXT(" none, nothing is revealed yet") : *Rows));
+}
+
+void FMinesweeperPromptEncoder::Append(const FString& Text)
+{
+    // Every piece starts with markup or a sign, so counting pieces separately matches counting the whole.
+    const int32 NumTokens = EstimateTokens(Text);
+    Transcript += Text;
+    Stats.PromptTokens += NumTokens;
+    Stats.AppendedTokens += NumTokens;
+}
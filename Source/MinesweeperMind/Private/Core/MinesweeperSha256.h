@@ -0,0 +1,26 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+ * Incremental SHA-256 (FIPS 180-4). The engine only exposes SHA-1 and one-shot platform hashes, verifying a model of
+ * several hundred megabytes needs to feed it block by block.
+ */
+class FMinesweeperSha256
+{
+public:
+	FMinesweeperSha256();
+
+	void Update(const uint8* Data, int64 NumBytes);
+
+	/** Lowercase hex digest. The hasher must not be updated afterwards. */
+	FString Finalize();
+
+private:
+	void ProcessBlock(const uint8* Block);
+
+	uint32 State[8];
+	uint8 Buffer[64];
+	int32 BufferedBytes = 0;
+	uint64 TotalBytes = 0;
+};
@@ -0,0 +1,354 @@
+#include "Core/MinesweeperSimulation.h"
+
+#include "Core/MinesweeperBoard.h"
+#include "Core/MinesweeperInferenceClient.h"
+#include "Core/MinesweeperModelReplies.h"
+#include "Core/MinesweeperNoGuessGenerator.h"
+#include "Core/MinesweeperProbability.h"
+#include "Core/MinesweeperPromptEncoder.h"
+#include "Core/MinesweeperRandom.h"
+#include "Core/MinesweeperSnapshot.h"
+#include "Core/MinesweeperSolver.h"
+#include "Async/ParallelFor.h"
+#include "Dom/JsonObject.h"
+#include "HAL/PlatformMemory.h"
+#include "HAL/PlatformTime.h"
+#include "Misc/Paths.h"
+#include "Serialization/JsonSerializer.h"
+#include "Serialization/JsonWriter.h"
+
+namespace
+{
+    /** Guesses happen on the game loop, keep them bounded like the widget overlay does. */
+    constexpr double PolicyProbabilityBudgetSeconds = 0.004;
+
+    FORCEINLINE FIntPoint GetOpeningCell(const IMinesweeperBoard& Board)
+    {
+        return FIntPoint(Board.GetNumRows() / 2, Board.GetNumColumns() / 2);
+    }
+
+    /** Plays every deduction, falls back to the cell with the lowest mine probability when logic runs out. */
+    class FSolverPolicy final : public IMinesweeperMovePolicy
+    {
+    public:
+        FSolverPolicy(uint64 InSeed, bool bInDeterministic)
+            : Seed(InSeed)
+            , bDeterministic(bInDeterministic)
+        {}
+
+        virtual void BeginGame(const IMinesweeperBoard& Board) override
+        {
+            Solver.Reset(Board);
+            PendingSafeCells.Reset();
+        }
+
+        virtual FMinesweeperMove ChooseMove(const IMinesweeperBoard& Board) override
+        {
+            if (Board.GetSafeCellsRevealed() == 0)
+            {
+                return FMinesweeperMove(GetOpeningCell(Board), EMinesweeperMoveType::Reveal);
+            }
+
+            while (!PendingSafeCells.IsEmpty())
+            {
+                const FIntPoint Cell = PendingSafeCells.Pop(EAllowShrinking::No);
+                if (!Board.IsRevealed(Cell.X, Cell.Y))
+                {
+                    return FMinesweeperMove(Cell, EMinesweeperMoveType::Reveal);
+                }
+            }
+
+            Solver.Solve();
+            if (!Solver.GetSafeCells().IsEmpty())
+            {
+                PendingSafeCells = Solver.GetSafeCells();
+                return FMinesweeperMove(PendingSafeCells.Pop(EAllowShrinking::No), EMinesweeperMoveType::Reveal);
+            }
+
+            FMinesweeperProbabilitySettings Settings;
+            Settings.TimeBudgetSeconds = bDeterministic ? TNumericLimits<double>::Max() : PolicyProbabilityBudgetSeconds;
+            Settings.Seed = Seed;
+            const TSharedRef<const FMinesweeperProbabilityResult> Probabilities = FMinesweeperProbability::Calculate(Board, &Solver, Settings);
+            return FMinesweeperMove(Probabilities->GetSafestCell(), EMinesweeperMoveType::Reveal);
+        }
+
+        virtual void OnMoveApplied(const FMinesweeperMove& Move, TArrayView<const FIntPoint> RevealedCells) override
+        {
+            Solver.AddRevealedCells(RevealedCells);
+        }
+
+    private:
+        FMinesweeperSolver Solver;
+        TArray<FIntPoint> PendingSafeCells;
+        uint64 Seed = 0;
+        bool bDeterministic = false;
+    };
+
+    /** Reveals uniformly random hidden cells, a floor for every other policy. */
+    class FRandomPolicy final : public IMinesweeperMovePolicy
+    {
+    public:
+        explicit FRandomPolicy(uint64 InSeed)
+            : Random(InSeed)
+        {}
+
+        virtual FMinesweeperMove ChooseMove(const IMinesweeperBoard& Board) override
+        {
+            for (;;)
+            {
+                const int32 Row = static_cast<int32>(Random.NextBounded(static_cast<uint32>(Board.GetNumRows())));
+                const int32 Column = static_cast<int32>(Random.NextBounded(static_cast<uint32>(Board.GetNumColumns())));
+                if (!Board.IsRevealed(Row, Column))
+                {
+                    return FMinesweeperMove(FIntPoint(Row, Column), EMinesweeperMoveType::Reveal);
+                }
+            }
+        }
+
+    private:
+        FMinesweeperRandom Random;
+    };
+
+    /**
+     * Asks the model for every move through the inference worker, with prompts from FMinesweeperPromptEncoder. Far
+     * slower than the other policies and it shares one worker, run it single-threaded to keep the worker's cache warm.
+     */
+    class FAgentPolicy final : public IMinesweeperMovePolicy
+    {
+    public:
+        virtual ~FAgentPolicy() override
+        {
+            const FMinesweeperPromptStats& Stats = Encoder.GetStats();
+            if (Stats.NumMoves == 0)
+            {
+                return;
+            }
+
+            // Whatever the worker spent per token it did evaluate is what the reused ones would have cost.
+            const double SecondsPerToken = TotalSeconds / FMath::Max<int64>(1, TotalPromptTokens - ReusedTokens + CompletionTokens);
+            UE_LOG(LogTemp, Log, TEXT("Agent game: %d moves, %.0f prompt tokens/move of which %.0f new (estimated), %d rebaselines. ")
+                TEXT("The model reused %lld of %lld prompt tokens, about %.2f s of prompt evaluation saved."),
+                Stats.NumMoves, Stats.GetSentTokensPerMove(), Stats.GetAppendedTokensPerMove(), Stats.NumRebaselines,
+                ReusedTokens, TotalPromptTokens, ReusedTokens * SecondsPerToken);
+        }
+
+        virtual void BeginGame(const IMinesweeperBoard& InBoard) override
+        {
+            Board = &InBoard;
+            Encoder.BeginGame(InBoard);
+        }
+
+        virtual FMinesweeperMove ChooseMove(const IMinesweeperBoard& InBoard) override
+        {
+            TSharedRef<FJsonObject> Params = MakeShared<FJsonObject>();
+            Params->SetStringField(TEXT("prompt"), Encoder.GetPrompt());
+
+            TSharedPtr<FJsonObject> Result;
+            FString Error;
+            if (!FMinesweeperInferenceClient::Get()->Call(TEXT("agent_move"), Params, Result, Error))
+            {
+                UE_LOG(LogTemp, Warning, TEXT("Agent move failed: %s"), *Error);
+                return FMinesweeperMove();
+            }
+
+            TotalPromptTokens += static_cast<int64>(Result->GetNumberField(TEXT("prompt_tokens")));
+            ReusedTokens += static_cast<int64>(Result->GetNumberField(TEXT("reused_tokens")));
+            CompletionTokens += static_cast<int64>(Result->GetNumberField(TEXT("completion_tokens")));
+            TotalSeconds += Result->GetNumberField(TEXT("seconds"));
+
+            FMinesweeperMoveReply Reply;
+            if (!FMinesweeperMoveReply::ParseResult(Result, Reply) || !InBoard.IsValidCell(Reply.Move.Cell.X, Reply.Move.Cell.Y))
+            {
+                return FMinesweeperMove();
+            }
+            return Reply.Move;
+        }
+
+        virtual void OnMoveApplied(const FMinesweeperMove& Move, TArrayView<const FIntPoint> RevealedCells) override
+        {
+            Encoder.AddMove(*Board, Move, RevealedCells);
+        }
+
+    private:
+        FMinesweeperPromptEncoder Encoder;
+        const IMinesweeperBoard* Board = nullptr;
+
+        int64 TotalPromptTokens = 0;
+        int64 ReusedTokens = 0;
+        int64 CompletionTokens = 0;
+        double TotalSeconds = 0.0;
+    };
+
+    struct FGameResult
+    {
+        TArray<float> MoveMicroseconds;
+        bool bWon = false;
+        bool bNoGuessFailed = false;
+    };
+}
+
+FString FMinesweeperSimulationReport::ToJson() const
+{
+    TSharedRef<FJsonObject> Object = MakeShared<FJsonObject>();
+    Object->SetStringField(TEXT("policy"), PolicyName);
+    Object->SetNumberField(TEXT("rows"), Settings.NumRows);
+    Object->SetNumberField(TEXT("columns"), Settings.NumColumns);
+    Object->SetNumberField(TEXT("mine_density"), Settings.MineDensity);
+    Object->SetNumberField(TEXT("base_seed"), double(Settings.BaseSeed));
+    Object->SetBoolField(TEXT("no_guess"), Settings.bNoGuess);
+    Object->SetBoolField(TEXT("parallel"), Settings.bParallel);
+    Object->SetBoolField(TEXT("deterministic"), Settings.bDeterministic);
+    Object->SetNumberField(TEXT("games"), NumGames);
+    Object->SetNumberField(TEXT("wins"), NumWins);
+    Object->SetNumberField(TEXT("no_guess_failures"), NumNoGuessFailures);
+    Object->SetNumberField(TEXT("win_rate"), GetWinRate());
+    Object->SetNumberField(TEXT("moves"), double(NumMoves));
+    Object->SetNumberField(TEXT("elapsed_seconds"), ElapsedSeconds);
+    Object->SetNumberField(TEXT("games_per_second"), GamesPerSecond);
+    Object->SetNumberField(TEXT("moves_per_second"), MovesPerSecond);
+    Object->SetNumberField(TEXT("move_us_p50"), MoveMicrosecondsP50);
+    Object->SetNumberField(TEXT("move_us_p99"), MoveMicrosecondsP99);
+    Object->SetNumberField(TEXT("peak_used_physical_bytes"), double(PeakUsedPhysicalBytes));
+
+    FString Json;
+    const TSharedRef<TJsonWriter<>> Writer = TJsonWriterFactory<>::Create(&Json);
+    FJsonSerializer::Serialize(Object, Writer);
+    return Json;
+}
+
+FMinesweeperSimulationReport FMinesweeperSimulation::Run(const FMinesweeperSimulationSettings& Settings, const FString& PolicyName,
+    const FMinesweeperMovePolicyFactory& PolicyFactory)
+{
+    const int64 NumMines = static_cast<int64>(double(Settings.NumRows) * Settings.NumColumns * Settings.MineDensity);
+
+    TArray<FGameResult> Games;
+    Games.SetNum(Settings.NumGames);
+
+    const double StartTime = FPlatformTime::Seconds();
+
+    ParallelFor(Settings.NumGames, [&](int32 GameIndex)
+    {
+        const uint64 GameSeed = FMinesweeperRandom::MixSeed(Settings.BaseSeed, GameIndex);
+        FGameResult& Game = Games[GameIndex];
+
+        FMinesweeperBoard Board;
+        Board.Initialize(Settings.NumRows, Settings.NumColumns, NumMines);
+
+        FMinesweeperGameSetup Setup;
+        Setup.NumRows = Settings.NumRows;
+        Setup.NumColumns = Settings.NumColumns;
+        Setup.NumMines = NumMines;
+        Setup.Seed = GameSeed;
+        if (Settings.bNoGuess)
+        {
+            // Policies open in the middle, which is also where the generator guarantees the opening. The games already
+            // keep every core busy, so each search checks one candidate at a time.
+            FMinesweeperNoGuessSettings NoGuessSettings;
+            NoGuessSettings.BatchSize = 1;
+            if (Settings.bDeterministic)
+            {
+                NoGuessSettings.TimeBudgetSeconds = TNumericLimits<double>::Max();
+                NoGuessSettings.MaxAttempts = DeterministicNoGuessMaxAttempts;
+            }
+            const FMinesweeperNoGuessResult Generated = FMinesweeperNoGuessGenerator::Generate(
+                Settings.NumRows, Settings.NumColumns, NumMines, GetOpeningCell(Board), GameSeed, NoGuessSettings);
+            // Still played, a board that may need a guess is a fair game, but reported apart so the win rate can be read.
+            Game.bNoGuessFailed = !Generated.bFound;
+            Board.PlaceMines(Generated.Seed, GetOpeningCell(Board));
+            Setup.Seed = Generated.Seed;
+            Setup.bMinesPlaced = true;
+            Setup.SafeCell = GetOpeningCell(Board);
+        }
+        else
+        {
+            Board.DeferMinePlacement(GameSeed);
+        }
+
+        TUniquePtr<IMinesweeperMovePolicy> Policy = PolicyFactory(GameSeed);
+        if (!Policy.IsValid())
+        {
+            return;
+        }
+        Policy->BeginGame(Board);
+
+        // Only kept when failures are saved, a move is cheap enough that the extra Add would show in the timings.
+        const bool bRecordMoves = !Settings.FailureSnapshotDir.IsEmpty();
+        TArray<FMinesweeperMove> Moves;
+
+        TArray<FIntPoint> Revealed;
+        Game.MoveMicroseconds.Reserve(Board.GetNumCells() / 4);
+        while (!Board.IsGameOver() && Game.MoveMicroseconds.Num() < Settings.MaxMovesPerGame)
+        {
+            const uint64 StartCycles = FPlatformTime::Cycles64();
+
+            const FMinesweeperMove Move = Policy->ChooseMove(Board);
+            if (!Move.IsValid())
+            {
+                break;
+            }
+            Board.ApplyMove(Move, Revealed);
+            Policy->OnMoveApplied(Move, Revealed);
+
+            Game.MoveMicroseconds.Add(static_cast<float>(FPlatformTime::ToMilliseconds64(FPlatformTime::Cycles64() - StartCycles) * 1000.0));
+            if (bRecordMoves)
+            {
+                Moves.Add(Move);
+            }
+        }
+
+        Game.bWon = Board.IsGameWon();
+        if (bRecordMoves && !Game.bWon)
+        {
+            const FString Path = Settings.FailureSnapshotDir / FString::Printf(TEXT("Game-%d.msgame"), GameIndex);
+            if (!FMinesweeperSnapshot::WriteToFile(Path, Setup, Moves))
+            {
+                UE_LOG(LogTemp, Warning, TEXT("Failed to write %s"), *Path);
+            }
+        }
+    }, Settings.bParallel ? EParallelForFlags::None : EParallelForFlags::ForceSingleThread);
+
+    FMinesweeperSimulationReport Report;
+    Report.PolicyName = PolicyName;
+    Report.Settings = Settings;
+    Report.ElapsedSeconds = FPlatformTime::Seconds() - StartTime;
+    Report.NumGames = Settings.NumGames;
+
+    TArray<float> MoveMicroseconds;
+    for (const FGameResult& Game : Games)
+    {
+        Report.NumWins += Game.bWon ? 1 : 0;
+        Report.NumNoGuessFailures += Game.bNoGuessFailed ? 1 : 0;
+        MoveMicroseconds.Append(Game.MoveMicroseconds);
+    }
+    Report.NumMoves = MoveMicroseconds.Num();
+
+    if (!MoveMicroseconds.IsEmpty())
+    {
+        MoveMicroseconds.Sort();
+        Report.MoveMicrosecondsP50 = MoveMicroseconds[(MoveMicroseconds.Num() - 1) / 2];
+        Report.MoveMicrosecondsP99 = MoveMicroseconds[FMath::Min(MoveMicroseconds.Num() - 1, int32(MoveMicroseconds.Num() * 0.99))];
+    }
+
+    const double Elapsed = FMath::Max(Report.ElapsedSeconds, 0.000001);
+    Report.GamesPerSecond = Report.NumGames / Elapsed;
+    Report.MovesPerSecond = Report.NumMoves / Elapsed;
+    Report.PeakUsedPhysicalBytes = FPlatformMemory::GetStats().PeakUsedPhysical;
+    return Report;
+}
+
+TUniquePtr<IMinesweeperMovePolicy> FMinesweeperSimulation::CreatePolicy(const FString& PolicyName, uint64 GameSeed, bool bDeterministic)
+{
+    if (PolicyName.Equals(TEXT("Solver"), ESearchCase::IgnoreCase))
+    {
+        return MakeUnique<FSolverPolicy>(GameSeed, bDeterministic);
+    }
+    if (PolicyName.Equals(TEXT("Random"), ESearchCase::IgnoreCase))
+    {
+        return MakeUnique<FRandomPolicy>(GameSeed);
+    }
+    if (PolicyName.Equals(TEXT("Agent"), ESearchCase::IgnoreCase))
+    {
+        return MakeUnique<FAgentPolicy>();
+    }
+    return nullptr;
+}
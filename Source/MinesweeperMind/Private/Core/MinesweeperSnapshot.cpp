@@ -0,0 +1,373 @@
+#include "Core/MinesweeperSnapshot.h"
+
+#include "Core/MinesweeperBoard.h"
+#include "Core/MinesweeperChunkedBoard.h"
+#include "Async/MappedFileHandle.h"
+#include "HAL/IConsoleManager.h"
+#include "HAL/PlatformFileManager.h"
+#include "HAL/PlatformTime.h"
+#include "Misc/FileHelper.h"
+
+static_assert(PLATFORM_LITTLE_ENDIAN, "Snapshots are read in place and stored little-endian.");
+
+namespace
+{
+    constexpr uint32 SnapshotMagic = 'M' | ('S' << 8) | ('G' << 16) | ('S' << 24);
+
+    enum ESnapshotFlags : uint8
+    {
+        MinesPlaced = 1 << 0,
+        MineLayout = 1 << 1,
+    };
+
+    /** On-disk header, read and written with a single copy. */
+    struct FSnapshotHeader
+    {
+        uint32 Magic;
+        uint16 Version;
+        uint8 BoardKind;
+        uint8 Flags;
+        int32 NumRows;
+        int32 NumColumns;
+        int64 NumMines;
+        uint64 Seed;
+        int32 SafeRow;
+        int32 SafeColumn;
+        int32 NumMoves;
+        uint32 Reserved;
+        uint64 MoveLogBytes;
+    };
+    static_assert(sizeof(FSnapshotHeader) == 56, "The header layout is part of the file format.");
+
+    constexpr int32 MoveTypeBits = 2;
+
+    FORCEINLINE uint64 ZigZagEncode(int64 Value)
+    {
+        return (uint64(Value) << 1) ^ uint64(Value >> 63);
+    }
+
+    FORCEINLINE int64 ZigZagDecode(uint64 Value)
+    {
+        return int64(Value >> 1) ^ -int64(Value & 1);
+    }
+
+    void WriteVarint(uint64 Value, TArray<uint8>& OutData)
+    {
+        while (Value >= 0x80)
+        {
+            OutData.Add(static_cast<uint8>(Value | 0x80));
+            Value >>= 7;
+        }
+        OutData.Add(static_cast<uint8>(Value));
+    }
+
+    /** Advances Offset past one varint. False if it runs off the end or is longer than 64 bits. */
+    FORCEINLINE bool ReadVarint(const TArrayView<const uint8>& Data, int64& Offset, uint64& OutValue)
+    {
+        OutValue = 0;
+        for (int32 Shift = 0; Shift < 64 && Offset < Data.Num(); Shift += 7)
+        {
+            const uint8 Byte = Data[Offset++];
+            OutValue |= uint64(Byte & 0x7F) << Shift;
+            if (!(Byte & 0x80))
+            {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    /** Decodes the move at Offset relative to PreviousCell, the cell index of the previous move. */
+    FORCEINLINE bool ReadMove(const TArrayView<const uint8>& MoveLog, int64& Offset, int64 NumColumns, int64& PreviousCell, FMinesweeperMove& OutMove)
+    {
+        uint64 Value = 0;
+        if (!ReadVarint(MoveLog, Offset, Value))
+        {
+            return false;
+        }
+        PreviousCell += ZigZagDecode(Value >> MoveTypeBits);
+        OutMove.Cell = FIntPoint(static_cast<int32>(PreviousCell / NumColumns), static_cast<int32>(PreviousCell % NumColumns));
+        OutMove.Type = static_cast<EMinesweeperMoveType>(Value & ((1 << MoveTypeBits) - 1));
+        return true;
+    }
+
+    FAutoConsoleCommand SnapshotReplayCommand(
+        TEXT("MinesweeperMind.Snapshot.Replay"),
+        TEXT("Loads a game snapshot and replays it, logging the board state. Args: Path [MoveIndex=all]"),
+        FConsoleCommandWithArgsDelegate::CreateLambda([](const TArray<FString>& Args)
+        {
+            if (Args.IsEmpty())
+            {
+                UE_LOG(LogTemp, Error, TEXT("Usage: MinesweeperMind.Snapshot.Replay Path [MoveIndex]"));
+                return;
+            }
+
+            const double StartTime = FPlatformTime::Seconds();
+            FString Error;
+            const TUniquePtr<FMinesweeperSnapshotFile> File = FMinesweeperSnapshotFile::Open(Args[0], Error);
+            if (!File)
+            {
+                UE_LOG(LogTemp, Error, TEXT("%s"), *Error);
+                return;
+            }
+            const double OpenTime = FPlatformTime::Seconds();
+
+            const FMinesweeperSnapshotView& View = File->GetView();
+            const int32 NumMovesToApply = Args.Num() > 1 ? FMath::Clamp(FCString::Atoi(*Args[1]), 0, View.GetNumMoves()) : View.GetNumMoves();
+            const TUniquePtr<IMinesweeperBoard> Board = View.Replay(NumMovesToApply);
+            const double EndTime = FPlatformTime::Seconds();
+
+            const FMinesweeperGameSetup& Setup = View.GetSetup();
+            UE_LOG(LogTemp, Log, TEXT("%s: %dx%d, %lld mines, seed %llu, %s layout, %s"), *Args[0], Setup.NumRows, Setup.NumColumns,
+                Setup.NumMines, Setup.Seed, View.HasMineLayout() ? TEXT("embedded") : TEXT("seeded"), File->IsMapped() ? TEXT("mapped") : TEXT("loaded"));
+            UE_LOG(LogTemp, Log, TEXT("After move %d of %d: %lld safe cells revealed, %s. Opened in %.3f ms, replayed in %.3f ms."),
+                NumMovesToApply, View.GetNumMoves(), Board->GetSafeCellsRevealed(),
+                Board->IsGameWon() ? TEXT("won") : (Board->IsGameOver() ? TEXT("lost") : TEXT("in progress")),
+                (OpenTime - StartTime) * 1000.0, (EndTime - OpenTime) * 1000.0);
+        }));
+}
+
+TUniquePtr<IMinesweeperBoard> FMinesweeperGameSetup::CreateBoard() const
+{
+    TUniquePtr<IMinesweeperBoard> Board;
+    if (BoardKind == EMinesweeperBoardKind::Chunked)
+    {
+        Board = MakeUnique<FMinesweeperChunkedBoard>();
+    }
+    else
+    {
+        Board = MakeUnique<FMinesweeperBoard>();
+    }
+
+    Board->Initialize(NumRows, NumColumns, NumMines);
+    if (bMinesPlaced)
+    {
+        Board->PlaceMines(Seed, SafeCell);
+    }
+    else
+    {
+        Board->DeferMinePlacement(Seed);
+    }
+    return Board;
+}
+
+void FMinesweeperSnapshot::Write(const FMinesweeperGameSetup& Setup, TArrayView<const FMinesweeperMove> Moves, TArray<uint8>& OutData,
+    const FMinesweeperBoard* MineLayoutBoard)
+{
+    check(!MineLayoutBoard || (Setup.BoardKind == EMinesweeperBoardKind::Dense && MineLayoutBoard->GetNumRows() == Setup.NumRows
+        && MineLayoutBoard->GetNumColumns() == Setup.NumColumns));
+
+    FSnapshotHeader Header = {};
+    Header.Magic = SnapshotMagic;
+    Header.Version = Version;
+    Header.BoardKind = static_cast<uint8>(Setup.BoardKind);
+    Header.Flags = (Setup.bMinesPlaced ? MinesPlaced : 0) | (MineLayoutBoard ? MineLayout : 0);
+    Header.NumRows = Setup.NumRows;
+    Header.NumColumns = Setup.NumColumns;
+    Header.NumMines = Setup.NumMines;
+    Header.Seed = Setup.Seed;
+    Header.SafeRow = Setup.SafeCell.X;
+    Header.SafeColumn = Setup.SafeCell.Y;
+    Header.NumMoves = Moves.Num();
+
+    const int64 NumCells = int64(Setup.NumRows) * Setup.NumColumns;
+    const int64 MineBitsBytes = MineLayoutBoard ? (NumCells + 7) / 8 : 0;
+
+    OutData.Reset();
+    // Most moves land near the previous one and fit in one or two bytes.
+    OutData.Reserve(sizeof(FSnapshotHeader) + MineBitsBytes + Moves.Num() * 2);
+    OutData.AddZeroed(sizeof(FSnapshotHeader) + MineBitsBytes);
+
+    if (MineLayoutBoard)
+    {
+        uint8* MineBits = OutData.GetData() + sizeof(FSnapshotHeader);
+        const uint8* Cells = MineLayoutBoard->GetCellData();
+        for (int64 CellIndex = 0; CellIndex < NumCells; ++CellIndex)
+        {
+            MineBits[CellIndex >> 3] |= ((Cells[CellIndex] & MinesweeperCell::Mine) ? 1 : 0) << (CellIndex & 7);
+        }
+    }
+
+    int64 PreviousCell = 0;
+    for (const FMinesweeperMove& Move : Moves)
+    {
+        const int64 Cell = int64(Move.Cell.X) * Setup.NumColumns + Move.Cell.Y;
+        WriteVarint((ZigZagEncode(Cell - PreviousCell) << MoveTypeBits) | static_cast<uint8>(Move.Type), OutData);
+        PreviousCell = Cell;
+    }
+
+    Header.MoveLogBytes = OutData.Num() - sizeof(FSnapshotHeader) - MineBitsBytes;
+    FMemory::Memcpy(OutData.GetData(), &Header, sizeof(Header));
+}
+
+bool FMinesweeperSnapshot::WriteToFile(const FString& Path, const FMinesweeperGameSetup& Setup, TArrayView<const FMinesweeperMove> Moves,
+    const FMinesweeperBoard* MineLayoutBoard)
+{
+    TArray<uint8> Data;
+    Write(Setup, Moves, Data, MineLayoutBoard);
+    return FFileHelper::SaveArrayToFile(Data, *Path);
+}
+
+bool FMinesweeperSnapshotView::Initialize(TArrayView<const uint8> InData, FString& OutError)
+{
+    *this = FMinesweeperSnapshotView();
+
+    FSnapshotHeader Header;
+    if (InData.Num() < int64(sizeof(Header)))
+    {
+        OutError = TEXT("Not a snapshot, the file is shorter than the header.");
+        return false;
+    }
+    FMemory::Memcpy(&Header, InData.GetData(), sizeof(Header));
+
+    if (Header.Magic != SnapshotMagic)
+    {
+        OutError = TEXT("Not a snapshot, the magic number does not match.");
+        return false;
+    }
+    if (Header.Version != FMinesweeperSnapshot::Version)
+    {
+        OutError = FString::Printf(TEXT("Snapshot version %d, this build reads version %d."), Header.Version, FMinesweeperSnapshot::Version);
+        return false;
+    }
+    if (Header.BoardKind > uint8(EMinesweeperBoardKind::Chunked) || Header.NumRows <= 0 || Header.NumColumns <= 0 || Header.NumMoves < 0
+        || ((Header.Flags & MineLayout) && Header.BoardKind != uint8(EMinesweeperBoardKind::Dense)))
+    {
+        OutError = TEXT("Corrupt snapshot header.");
+        return false;
+    }
+
+    const int64 NumCells = int64(Header.NumRows) * Header.NumColumns;
+    const int64 MineBitsBytes = (Header.Flags & MineLayout) ? (NumCells + 7) / 8 : 0;
+    if (uint64(InData.Num()) != sizeof(Header) + MineBitsBytes + Header.MoveLogBytes)
+    {
+        OutError = FString::Printf(TEXT("Snapshot is %lld bytes, its header describes %llu."), int64(InData.Num()),
+            uint64(sizeof(Header) + MineBitsBytes + Header.MoveLogBytes));
+        return false;
+    }
+
+    FMinesweeperSnapshotView Result;
+    Result.Setup.BoardKind = static_cast<EMinesweeperBoardKind>(Header.BoardKind);
+    Result.Setup.NumRows = Header.NumRows;
+    Result.Setup.NumColumns = Header.NumColumns;
+    Result.Setup.NumMines = Header.NumMines;
+    Result.Setup.Seed = Header.Seed;
+    Result.Setup.bMinesPlaced = (Header.Flags & MinesPlaced) != 0;
+    Result.Setup.SafeCell = FIntPoint(Header.SafeRow, Header.SafeColumn);
+    Result.MineBits = InData.Slice(sizeof(Header), MineBitsBytes);
+    Result.MoveLog = InData.Slice(sizeof(Header) + MineBitsBytes, Header.MoveLogBytes);
+    Result.NumMoves = Header.NumMoves;
+
+    // One pass over the log now means replaying never meets a broken move.
+    int64 Offset = 0;
+    int64 PreviousCell = 0;
+    FMinesweeperMove Move;
+    for (int32 MoveIndex = 0; MoveIndex < Result.NumMoves; ++MoveIndex)
+    {
+        if (!ReadMove(Result.MoveLog, Offset, Header.NumColumns, PreviousCell, Move) || PreviousCell < 0 || PreviousCell >= NumCells
+            || Move.Type > EMinesweeperMoveType::Chord)
+        {
+            OutError = FString::Printf(TEXT("Move %d of the snapshot is corrupt."), MoveIndex);
+            return false;
+        }
+    }
+    if (Offset != Result.MoveLog.Num())
+    {
+        OutError = TEXT("Snapshot move log is longer than its move count.");
+        return false;
+    }
+
+    *this = Result;
+    return true;
+}
+
+void FMinesweeperSnapshotView::ForEachMove(TFunctionRef<bool(const FMinesweeperMove&)> Visitor) const
+{
+    int64 Offset = 0;
+    int64 PreviousCell = 0;
+    FMinesweeperMove Move;
+    for (int32 MoveIndex = 0; MoveIndex < NumMoves && ReadMove(MoveLog, Offset, Setup.NumColumns, PreviousCell, Move); ++MoveIndex)
+    {
+        if (!Visitor(Move))
+        {
+            return;
+        }
+    }
+}
+
+TUniquePtr<IMinesweeperBoard> FMinesweeperSnapshotView::Replay(int32 NumMovesToApply) const
+{
+    if (Setup.NumRows <= 0)
+    {
+        return nullptr;
+    }
+
+    TUniquePtr<IMinesweeperBoard> Board;
+    if (HasMineLayout())
+    {
+        TUniquePtr<FMinesweeperBoard> DenseBoard = MakeUnique<FMinesweeperBoard>();
+        DenseBoard->Initialize(Setup.NumRows, Setup.NumColumns, Setup.NumMines);
+        DenseBoard->PlaceMinesFromLayout(MineBits, Setup.Seed, Setup.SafeCell);
+        Board = MoveTemp(DenseBoard);
+    }
+    else
+    {
+        Board = Setup.CreateBoard();
+    }
+
+    int32 NumApplied = 0;
+    TArray<FIntPoint> Revealed;
+    ForEachMove([&Board, &NumApplied, &Revealed, NumMovesToApply](const FMinesweeperMove& Move)
+    {
+        if (NumApplied >= NumMovesToApply)
+        {
+            return false;
+        }
+        Board->ApplyMove(Move, Revealed);
+        ++NumApplied;
+        return true;
+    });
+    return Board;
+}
+
+FMinesweeperSnapshotFile::~FMinesweeperSnapshotFile()
+{
+    // The region has to go before the handle it was mapped from.
+    MappedRegion.Reset();
+    MappedFile.Reset();
+}
+
+TUniquePtr<FMinesweeperSnapshotFile> FMinesweeperSnapshotFile::Open(const FString& Path, FString& OutError)
+{
+    TUniquePtr<FMinesweeperSnapshotFile> File(new FMinesweeperSnapshotFile());
+
+    TArrayView<const uint8> Data;
+    FOpenMappedResult Mapped = FPlatformFileManager::Get().GetPlatformFile().OpenMappedEx(*Path);
+    if (Mapped.HasValue())
+    {
+        File->MappedFile = Mapped.StealValue();
+        File->MappedRegion.Reset(File->MappedFile->MapRegion());
+    }
+
+    if (File->MappedRegion.IsValid())
+    {
+        Data = TArrayView<const uint8>(File->MappedRegion->GetMappedPtr(), File->MappedRegion->GetMappedSize());
+    }
+    else if (FFileHelper::LoadFileToArray(File->LoadedData, *Path))
+    {
+        // Platforms without mapping, or an empty file which cannot be mapped.
+        Data = File->LoadedData;
+    }
+    else
+    {
+        OutError = FString::Printf(TEXT("Could not open %s"), *Path);
+        return nullptr;
+    }
+
+    if (!File->View.Initialize(Data, OutError))
+    {
+        OutError = FString::Printf(TEXT("%s: %s"), *Path, *OutError);
+        return nullptr;
+    }
+    return File;
+}
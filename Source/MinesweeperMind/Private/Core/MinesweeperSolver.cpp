@@ -0,0 +1,269 @@
+#include "Core/MinesweeperSolver.h"
+
+#include "Core/IMinesweeperBoard.h"
+#include "Math/UnrealMathUtility.h"
+
+namespace
+{
+    /** Per-cell knowledge bits. */
+    constexpr uint8 KnownSafe = 0x01;
+    constexpr uint8 KnownMine = 0x02;
+    constexpr uint8 Queued = 0x04;
+
+    /** Two constraints interact when their cells are at most two apart, their unknowns then fit a 7x7 window. */
+    constexpr int32 WindowRadius = 3;
+    constexpr int32 WindowSize = WindowRadius * 2 + 1;
+
+    FORCEINLINE int32 WindowBit(int32 RowOffset, int32 ColumnOffset)
+    {
+        return (RowOffset + WindowRadius) * WindowSize + (ColumnOffset + WindowRadius);
+    }
+
+    FORCEINLINE uint64 MakeTileKey(int32 Row, int32 Column, int32 Shift)
+    {
+        return (uint64(uint32(Row >> Shift)) << 32) | uint32(Column >> Shift);
+    }
+}
+
+void FMinesweeperSolver::Reset(const IMinesweeperBoard& InBoard)
+{
+    Board = &InBoard;
+    KnowledgeTiles.Reset();
+    CachedTileKey = MAX_uint64;
+    CachedTile = nullptr;
+    WorkQueue.Reset();
+    SafeCells.Reset();
+    MineCells.Reset();
+    NumConstraintsVisited = 0;
+}
+
+void FMinesweeperSolver::ScanBoard(const IMinesweeperBoard& InBoard)
+{
+    Reset(InBoard);
+
+    for (int32 Row = 0; Row < InBoard.GetNumRows(); ++Row)
+    {
+        for (int32 Column = 0; Column < InBoard.GetNumColumns(); ++Column)
+        {
+            const uint8 Cell = InBoard.GetCell(Row, Column);
+            if ((Cell & MinesweeperCell::Revealed) && (Cell & MinesweeperCell::AdjacencyMask))
+            {
+                QueueConstraint(FIntPoint(Row, Column));
+            }
+        }
+    }
+}
+
+void FMinesweeperSolver::AddRevealedCells(TArrayView<const FIntPoint> RevealedCells)
+{
+    check(Board);
+
+    // A reveal turns the cell itself into a constraint and shrinks the unknowns of the numbers around it.
+    for (const FIntPoint& Cell : RevealedCells)
+    {
+        QueueConstraintsAround(Cell);
+    }
+}
+
+bool FMinesweeperSolver::Solve()
+{
+    check(Board);
+
+    NumConstraintsVisited = 0;
+    const int32 NumKnownBefore = SafeCells.Num() + MineCells.Num();
+
+    while (!WorkQueue.IsEmpty())
+    {
+        const FIntPoint Cell = WorkQueue.Pop(EAllowShrinking::No);
+        GetMutableKnowledge(Cell.X, Cell.Y) &= ~Queued;
+        ++NumConstraintsVisited;
+        ApplyRules(Cell);
+    }
+
+    // Callers act on the safe list, drop the cells that have been revealed since they were deduced.
+    SafeCells.RemoveAll([this](const FIntPoint& Cell)
+    {
+        return Board->IsRevealed(Cell.X, Cell.Y);
+    });
+
+    return SafeCells.Num() + MineCells.Num() != NumKnownBefore;
+}
+
+bool FMinesweeperSolver::IsKnownSafe(int32 Row, int32 Column) const
+{
+    return (GetKnowledge(Row, Column) & KnownSafe) != 0;
+}
+
+bool FMinesweeperSolver::IsKnownMine(int32 Row, int32 Column) const
+{
+    return (GetKnowledge(Row, Column) & KnownMine) != 0;
+}
+
+bool FMinesweeperSolver::ReadConstraint(const FIntPoint& Cell, const FIntPoint& Origin, FConstraint& OutConstraint) const
+{
+    const uint8 BoardCell = Board->GetCell(Cell.X, Cell.Y);
+    if ((BoardCell & MinesweeperCell::Revealed) == 0 || (BoardCell & MinesweeperCell::AdjacencyMask) == 0)
+    {
+        return false;
+    }
+
+    OutConstraint.UnknownMask = 0;
+    OutConstraint.RemainingMines = BoardCell & MinesweeperCell::AdjacencyMask;
+
+    for (int32 RowOffset = -1; RowOffset <= 1; ++RowOffset)
+    {
+        for (int32 ColumnOffset = -1; ColumnOffset <= 1; ++ColumnOffset)
+        {
+            const int32 NeighborRow = Cell.X + RowOffset;
+            const int32 NeighborCol = Cell.Y + ColumnOffset;
+            if ((RowOffset == 0 && ColumnOffset == 0) || !Board->IsValidCell(NeighborRow, NeighborCol))
+            {
+                continue;
+            }
+
+            const uint8 Knowledge = GetKnowledge(NeighborRow, NeighborCol);
+            if (Knowledge & KnownMine)
+            {
+                --OutConstraint.RemainingMines;
+            }
+            else if ((Knowledge & KnownSafe) == 0 && !Board->IsRevealed(NeighborRow, NeighborCol))
+            {
+                OutConstraint.UnknownMask |= 1ull << WindowBit(NeighborRow - Origin.X, NeighborCol - Origin.Y);
+            }
+        }
+    }
+
+    return OutConstraint.UnknownMask != 0;
+}
+
+bool FMinesweeperSolver::ApplyRules(const FIntPoint& Cell)
+{
+    FConstraint Constraint;
+    if (!ReadConstraint(Cell, Cell, Constraint))
+    {
+        return false;
+    }
+
+    // Single-cell rules.
+    const int32 NumUnknown = FMath::CountBits(Constraint.UnknownMask);
+    if (Constraint.RemainingMines == 0 || Constraint.RemainingMines == NumUnknown)
+    {
+        MarkCells(Cell, Constraint.UnknownMask, Constraint.RemainingMines != 0);
+        return true;
+    }
+
+    // Pair rule against every constraint close enough to share an unknown. If the other constraint needs more mines
+    // than this one by exactly the number of unknowns only it has, those are all mines and the unknowns only this one
+    // has are all safe. Subset and superset are the cases where one side of the difference is empty.
+    for (int32 RowOffset = -2; RowOffset <= 2; ++RowOffset)
+    {
+        for (int32 ColumnOffset = -2; ColumnOffset <= 2; ++ColumnOffset)
+        {
+            const FIntPoint Other(Cell.X + RowOffset, Cell.Y + ColumnOffset);
+            if ((RowOffset == 0 && ColumnOffset == 0) || !Board->IsValidCell(Other.X, Other.Y))
+            {
+                continue;
+            }
+
+            FConstraint OtherConstraint;
+            if (!ReadConstraint(Other, Cell, OtherConstraint) || (OtherConstraint.UnknownMask & Constraint.UnknownMask) == 0)
+            {
+                continue;
+            }
+
+            const uint64 OnlyOther = OtherConstraint.UnknownMask & ~Constraint.UnknownMask;
+            const uint64 OnlyThis = Constraint.UnknownMask & ~OtherConstraint.UnknownMask;
+
+            if (OtherConstraint.RemainingMines - Constraint.RemainingMines == FMath::CountBits(OnlyOther) && (OnlyOther | OnlyThis) != 0)
+            {
+                MarkCells(Cell, OnlyOther, true);
+                MarkCells(Cell, OnlyThis, false);
+                return true;
+            }
+
+            if (Constraint.RemainingMines - OtherConstraint.RemainingMines == FMath::CountBits(OnlyThis) && (OnlyOther | OnlyThis) != 0)
+            {
+                MarkCells(Cell, OnlyThis, true);
+                MarkCells(Cell, OnlyOther, false);
+                return true;
+            }
+        }
+    }
+
+    return false;
+}
+
+void FMinesweeperSolver::MarkCells(const FIntPoint& Origin, uint64 Mask, bool bMines)
+{
+    for (; Mask != 0; Mask &= Mask - 1)
+    {
+        const int32 Bit = static_cast<int32>(FMath::CountTrailingZeros64(Mask));
+        const FIntPoint Cell(Origin.X + Bit / WindowSize - WindowRadius, Origin.Y + Bit % WindowSize - WindowRadius);
+
+        GetMutableKnowledge(Cell.X, Cell.Y) |= bMines ? KnownMine : KnownSafe;
+        (bMines ? MineCells : SafeCells).Add(Cell);
+
+        // Every number around a newly known cell lost an unknown, including the one that deduced it.
+        QueueConstraintsAround(Cell);
+    }
+}
+
+void FMinesweeperSolver::QueueConstraintsAround(const FIntPoint& Cell)
+{
+    for (int32 NeighborRow = Cell.X - 1; NeighborRow <= Cell.X + 1; ++NeighborRow)
+    {
+        for (int32 NeighborCol = Cell.Y - 1; NeighborCol <= Cell.Y + 1; ++NeighborCol)
+        {
+            if (Board->IsValidCell(NeighborRow, NeighborCol))
+            {
+                const uint8 BoardCell = Board->GetCell(NeighborRow, NeighborCol);
+                if ((BoardCell & MinesweeperCell::Revealed) && (BoardCell & MinesweeperCell::AdjacencyMask))
+                {
+                    QueueConstraint(FIntPoint(NeighborRow, NeighborCol));
+                }
+            }
+        }
+    }
+}
+
+void FMinesweeperSolver::QueueConstraint(const FIntPoint& Cell)
+{
+    uint8& Knowledge = GetMutableKnowledge(Cell.X, Cell.Y);
+    if ((Knowledge & Queued) == 0)
+    {
+        Knowledge |= Queued;
+        WorkQueue.Add(Cell);
+    }
+}
+
+uint8 FMinesweeperSolver::GetKnowledge(int32 Row, int32 Column) const
+{
+    const uint64 Key = MakeTileKey(Row, Column, TileShift);
+    const uint8* Tile = (Key == CachedTileKey) ? CachedTile : nullptr;
+    if (!Tile)
+    {
+        const TArray<uint8>* FoundTile = KnowledgeTiles.Find(Key);
+        if (!FoundTile)
+        {
+            return 0;
+        }
+        Tile = FoundTile->GetData();
+    }
+    return Tile[((Row & TileMask) << TileShift) | (Column & TileMask)];
+}
+
+uint8& FMinesweeperSolver::GetMutableKnowledge(int32 Row, int32 Column)
+{
+    const uint64 Key = MakeTileKey(Row, Column, TileShift);
+    if (Key != CachedTileKey)
+    {
+        TArray<uint8>& Tile = KnowledgeTiles.FindOrAdd(Key);
+        if (Tile.IsEmpty())
+        {
+            Tile.SetNumZeroed(1 << (TileShift * 2));
+        }
+        CachedTileKey = Key;
+        CachedTile = Tile.GetData();
+    }
+    return CachedTile[((Row & TileMask) << TileShift) | (Column & TileMask)];
+}
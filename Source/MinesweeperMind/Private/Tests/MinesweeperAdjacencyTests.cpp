@@ -0,0 +1,95 @@
+#include "MinesweeperAdjacency.h"
+#include "Core/IMinesweeperBoard.h"
+#include "Math/RandomStream.h"
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+namespace
+{
+    /**
+     * Mines at the given density, everything else random garbage: stale counts and revealed or flagged bits, which
+     * both kernels must treat the same way.
+     */
+    TArray<uint8> MakeCells(int32 NumRows, int32 NumColumns, float MineDensity, FRandomStream& Random)
+    {
+        TArray<uint8> Cells;
+        Cells.SetNumUninitialized(NumRows * NumColumns);
+        for (uint8& Cell : Cells)
+        {
+            Cell = static_cast<uint8>(Random.RandHelper(256)) & ~MinesweeperCell::Mine;
+            if (Random.GetFraction() < MineDensity)
+            {
+                Cell |= MinesweeperCell::Mine;
+            }
+        }
+        return Cells;
+    }
+
+    /** Index of the first cell the kernels disagree on, INDEX_NONE if they match byte for byte. */
+    int32 FindMismatch(const TArray<uint8>& Source, int32 NumRows, int32 NumColumns)
+    {
+        TArray<uint8> Reference = Source;
+        TArray<uint8> Kernel = Source;
+        FMinesweeperAdjacency::CalculateReference(Reference.GetData(), NumRows, NumColumns);
+        FMinesweeperAdjacency::Calculate(Kernel.GetData(), NumRows, NumColumns);
+        for (int32 CellIndex = 0; CellIndex < Source.Num(); ++CellIndex)
+        {
+            if (Reference[CellIndex] != Kernel[CellIndex])
+            {
+                return CellIndex;
+            }
+        }
+        return INDEX_NONE;
+    }
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FMinesweeperAdjacencyMatchesReferenceTest, "MinesweeperMind.Adjacency.MatchesReference",
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool FMinesweeperAdjacencyMatchesReferenceTest::RunTest(const FString& Parameters)
+{
+    // Widths around the 64-cell word and the 256-cell AVX2 vector, single rows and columns, heights around the 64-row
+    // bands, and boards past the size that runs the bands in parallel.
+    static const FIntPoint BoardSizes[] =
+    {
+        FIntPoint(1, 1), FIntPoint(1, 2), FIntPoint(2, 1), FIntPoint(1, 1000), FIntPoint(1000, 1),
+        FIntPoint(3, 63), FIntPoint(3, 64), FIntPoint(3, 65), FIntPoint(5, 127), FIntPoint(5, 129),
+        FIntPoint(9, 255), FIntPoint(9, 256), FIntPoint(9, 257), FIntPoint(16, 30), FIntPoint(63, 100),
+        FIntPoint(64, 100), FIntPoint(65, 100), FIntPoint(129, 513), FIntPoint(300, 300), FIntPoint(257, 1031),
+    };
+    static const float MineDensities[] = { 0.f, 0.2f, 0.8f, 1.f };
+
+    FRandomStream Random(3);
+    int32 NumMismatches = 0;
+    for (const FIntPoint& BoardSize : BoardSizes)
+    {
+        for (const float MineDensity : MineDensities)
+        {
+            const TArray<uint8> Cells = MakeCells(BoardSize.X, BoardSize.Y, MineDensity, Random);
+            const int32 Mismatch = FindMismatch(Cells, BoardSize.X, BoardSize.Y);
+            if (Mismatch != INDEX_NONE)
+            {
+                AddError(FString::Printf(TEXT("%dx%d at density %.1f differs from the reference at (%d, %d)"),
+                    BoardSize.X, BoardSize.Y, MineDensity, Mismatch / BoardSize.Y, Mismatch % BoardSize.Y));
+                ++NumMismatches;
+            }
+        }
+    }
+    TestEqual(TEXT("Boards that differ from the reference"), NumMismatches, 0);
+
+    // All mines: every count is cleared. No mines: every count is zero. Other bits survive either way.
+    const uint8 Flags = MinesweeperCell::Revealed | MinesweeperCell::Flagged;
+    for (const uint8 Fill : { uint8(MinesweeperCell::Mine | Flags | 0x0F), uint8(Flags | 0x0F) })
+    {
+        TArray<uint8> Cells;
+        Cells.Init(Fill, 70 * 300);
+        FMinesweeperAdjacency::Calculate(Cells.GetData(), 70, 300);
+        const uint8 Expected = Fill & ~MinesweeperCell::AdjacencyMask;
+        TestFalse(FString::Printf(TEXT("Every cell of a uniform board becomes 0x%02x"), Expected),
+            Cells.ContainsByPredicate([Expected](uint8 Cell) { return Cell != Expected; }));
+    }
+    return true;
+}
+
+#endif
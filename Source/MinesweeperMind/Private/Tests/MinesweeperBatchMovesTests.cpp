@@ -0,0 +1,144 @@
+#include "Core/MinesweeperBoard.h"
+#include "Math/RandomStream.h"
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+namespace
+{
+    /** How often each cell appears in a change list, so lists can be compared regardless of order. */
+    TArray<int32> CountPerCell(TArrayView<const FIntPoint> Cells, const IMinesweeperBoard& Board)
+    {
+        TArray<int32> Counts;
+        Counts.SetNumZeroed(Board.GetNumRows() * Board.GetNumColumns());
+        for (const FIntPoint& Cell : Cells)
+        {
+            ++Counts[Cell.X * Board.GetNumColumns() + Cell.Y];
+        }
+        return Counts;
+    }
+
+    bool HaveSameState(const IMinesweeperBoard& Board, const IMinesweeperBoard& Other)
+    {
+        if (Board.GetSafeCellsRevealed() != Other.GetSafeCellsRevealed() || Board.IsGameOver() != Other.IsGameOver()
+            || Board.IsGameWon() != Other.IsGameWon() || Board.GetExplodedCell() != Other.GetExplodedCell())
+        {
+            return false;
+        }
+        for (int32 Row = 0; Row < Board.GetNumRows(); ++Row)
+        {
+            for (int32 Column = 0; Column < Board.GetNumColumns(); ++Column)
+            {
+                if (Board.GetCell(Row, Column) != Other.GetCell(Row, Column))
+                {
+                    return false;
+                }
+            }
+        }
+        return true;
+    }
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FMinesweeperBatchMovesTest, "MinesweeperMind.Board.BatchMoves",
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool FMinesweeperBatchMovesTest::RunTest(const FString& Parameters)
+{
+    // Random batches of reveals, flags and chords, out-of-range cells included, applied in one pass to one board and a
+    // move at a time to the other. Both boards and both change sets must agree after every batch.
+    int32 NumMismatchedGames = 0;
+    int32 NumWon = 0;
+    for (int32 Game = 0; Game < 300; ++Game)
+    {
+        FRandomStream Random(Game);
+        const int32 NumRows = 5 + Random.RandHelper(20);
+        const int32 NumColumns = 5 + Random.RandHelper(20);
+        const int64 NumMines = Random.RandHelper(NumRows * NumColumns / 4 + 1);
+
+        FMinesweeperBoard Sequential;
+        FMinesweeperBoard Batched;
+        Sequential.Initialize(NumRows, NumColumns, NumMines);
+        Batched.Initialize(NumRows, NumColumns, NumMines);
+        Sequential.DeferMinePlacement(Game);
+        Batched.DeferMinePlacement(Game);
+
+        TArray<FIntPoint> Revealed;
+        TArray<FIntPoint> SequentialRevealed;
+        TArray<FIntPoint> SequentialFlagged;
+        FMinesweeperChangeSet Changes;
+        TArray<FMinesweeperMove> Moves;
+        bool bSame = true;
+        while (bSame && !Sequential.IsGameOver())
+        {
+            Moves.Reset();
+            const int32 NumMoves = 1 + Random.RandHelper(12);
+            for (int32 MoveIndex = 0; MoveIndex < NumMoves; ++MoveIndex)
+            {
+                FMinesweeperMove Move(FIntPoint(Random.RandHelper(NumRows + 1), Random.RandHelper(NumColumns)),
+                    static_cast<EMinesweeperMoveType>(Random.RandHelper(3)));
+                if (Move.Type == EMinesweeperMoveType::Reveal && Sequential.AreMinesPlaced() && Move.Cell.X < NumRows
+                    && Sequential.IsMine(Move.Cell.X, Move.Cell.Y) && Random.RandHelper(20) != 0)
+                {
+                    Move.Type = EMinesweeperMoveType::Flag;
+                }
+                Moves.Add(Move);
+            }
+
+            SequentialRevealed.Reset();
+            SequentialFlagged.Reset();
+            for (const FMinesweeperMove& Move : Moves)
+            {
+                if (!Sequential.IsGameOver() && Sequential.ApplyMove(Move, Revealed))
+                {
+                    SequentialRevealed.Append(Revealed);
+                    if (Move.Type == EMinesweeperMoveType::Flag)
+                    {
+                        SequentialFlagged.Add(Move.Cell);
+                    }
+                }
+            }
+            Batched.ApplyMoves(Moves, Changes);
+
+            bSame = HaveSameState(Sequential, Batched)
+                && CountPerCell(SequentialRevealed, Sequential) == CountPerCell(Changes.Revealed, Batched)
+                && CountPerCell(SequentialFlagged, Sequential) == CountPerCell(Changes.Flagged, Batched);
+        }
+        NumMismatchedGames += bSame ? 0 : 1;
+        NumWon += Sequential.IsGameWon() ? 1 : 0;
+    }
+    TestEqual(TEXT("Games where a batch differed from its moves one at a time"), NumMismatchedGames, 0);
+    TestTrue(FString::Printf(TEXT("Some games were won (%d)"), NumWon), NumWon > 0);
+    return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FMinesweeperBatchMergedFloodTest, "MinesweeperMind.Board.BatchMergedFlood",
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool FMinesweeperBatchMergedFloodTest::RunTest(const FString& Parameters)
+{
+    // 5x5 with mines in two opposite corners, the whole board is one opening.
+    const uint8 MineBits[] = { 0x01, 0x00, 0x00, 0x01 };
+    FMinesweeperBoard Board;
+    Board.Initialize(5, 5, 2);
+    Board.PlaceMinesFromLayout(MineBits, 0, FIntPoint(2, 2));
+    Board.ToggleFlag(1, 3);
+
+    // Reveals of cells the first flood already opened add nothing, the flag is cleared and reported once.
+    const FMinesweeperMove Moves[] =
+    {
+        FMinesweeperMove(FIntPoint(2, 2), EMinesweeperMoveType::Reveal),
+        FMinesweeperMove(FIntPoint(2, 3), EMinesweeperMoveType::Reveal),
+        FMinesweeperMove(FIntPoint(1, 3), EMinesweeperMoveType::Reveal),
+        FMinesweeperMove(FIntPoint(4, 0), EMinesweeperMoveType::Reveal),
+    };
+    FMinesweeperChangeSet Changes;
+    Board.ApplyMoves(Moves, Changes);
+    TestEqual(TEXT("Every safe cell reported once"), Changes.Revealed.Num(), 23);
+    TestTrue(TEXT("No cell reported twice"), !CountPerCell(Changes.Revealed, Board).Contains(2));
+    TestEqual(TEXT("Flag cleared by the flood"), Changes.Unflagged.Num(), 1);
+    TestFalse(TEXT("Flag gone"), Board.IsFlagged(1, 3));
+    TestTrue(TEXT("Batch won"), Board.IsGameWon());
+    return true;
+}
+
+#endif
@@ -0,0 +1,173 @@
+#include "Core/MinesweeperBoard.h"
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+namespace
+{
+    /**
+     * 5x5 with mines in two opposite corners:
+     *
+     *   * 1 . . .
+     *   1 1 . . .
+     *   . . . . .
+     *   . . . 1 1
+     *   . . . 1 *
+     */
+    void InitializeCornerBoard(FMinesweeperBoard& Board)
+    {
+        const uint8 MineBits[] = { 0x01, 0x00, 0x00, 0x01 };
+        Board.Initialize(5, 5, 2);
+        Board.PlaceMinesFromLayout(MineBits, 0, FIntPoint(2, 2));
+    }
+
+    int32 CountMines(const IMinesweeperBoard& Board)
+    {
+        int32 NumMines = 0;
+        for (int32 Row = 0; Row < Board.GetNumRows(); ++Row)
+        {
+            for (int32 Column = 0; Column < Board.GetNumColumns(); ++Column)
+            {
+                NumMines += Board.IsMine(Row, Column) ? 1 : 0;
+            }
+        }
+        return NumMines;
+    }
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FMinesweeperBoardRevealTest, "MinesweeperMind.Board.RevealFlagWin",
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool FMinesweeperBoardRevealTest::RunTest(const FString& Parameters)
+{
+    FMinesweeperBoard Board;
+    InitializeCornerBoard(Board);
+    TestEqual(TEXT("Mines in the layout"), Board.GetNumMines(), int64(2));
+    TestEqual(TEXT("Adjacency next to a mine"), Board.GetAdjacentMines(0, 1), 1);
+    TestEqual(TEXT("Adjacency diagonal to a mine"), Board.GetAdjacentMines(1, 1), 1);
+    TestEqual(TEXT("Adjacency of the centre"), Board.GetAdjacentMines(2, 2), 0);
+    TestEqual(TEXT("Adjacency of a mine's other neighbour"), Board.GetAdjacentMines(3, 3), 1);
+
+    // A number opens only itself.
+    TArray<FIntPoint> Revealed;
+    TestEqual(TEXT("Reveal a number"), Board.Reveal(0, 1, Revealed), EMinesweeperRevealResult::Revealed);
+    TestEqual(TEXT("Cells opened by a number"), Revealed.Num(), 1);
+    TestEqual(TEXT("Safe cells after a number"), Board.GetSafeCellsRevealed(), int64(1));
+    TestEqual(TEXT("Reveal a revealed cell"), Board.Reveal(0, 1, Revealed), EMinesweeperRevealResult::Ignored);
+    TestTrue(TEXT("Ignored reveal reports nothing"), Revealed.IsEmpty());
+
+    // Flags toggle on hidden cells only.
+    TestTrue(TEXT("Flag a hidden cell"), Board.ToggleFlag(1, 2));
+    TestTrue(TEXT("Cell flagged"), Board.IsFlagged(1, 2));
+    TestFalse(TEXT("Flag a revealed cell"), Board.ToggleFlag(0, 1));
+    TestTrue(TEXT("Flag a mine"), Board.ToggleFlag(4, 4));
+    TestTrue(TEXT("Unflag the mine"), Board.ToggleFlag(4, 4));
+    TestFalse(TEXT("Mine unflagged"), Board.IsFlagged(4, 4));
+
+    // The centre floods every other safe cell, clearing the wrong flag on the way, and that wins.
+    TestEqual(TEXT("Reveal the centre"), Board.Reveal(2, 2, Revealed), EMinesweeperRevealResult::Revealed);
+    TestEqual(TEXT("Cells opened by the flood"), Revealed.Num(), 22);
+    TestFalse(TEXT("Flood cleared the flag"), Board.IsFlagged(1, 2));
+    TestTrue(TEXT("Flood revealed the flagged cell"), Board.IsRevealed(1, 2));
+    TestFalse(TEXT("Mines stay hidden"), Board.IsRevealed(0, 0) || Board.IsRevealed(4, 4));
+    TestEqual(TEXT("Safe cells after the flood"), Board.GetSafeCellsRevealed(), int64(23));
+    TestTrue(TEXT("Game won"), Board.IsGameWon());
+    TestTrue(TEXT("Game over"), Board.IsGameOver());
+    TestEqual(TEXT("No exploded cell"), Board.GetExplodedCell(), FIntPoint(INDEX_NONE, INDEX_NONE));
+
+    // Nothing moves once the game is over.
+    TestEqual(TEXT("Reveal after the win"), Board.Reveal(0, 0, Revealed), EMinesweeperRevealResult::Ignored);
+    TestFalse(TEXT("Flag after the win"), Board.ToggleFlag(0, 0));
+    return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FMinesweeperBoardLoseTest, "MinesweeperMind.Board.HitMine",
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool FMinesweeperBoardLoseTest::RunTest(const FString& Parameters)
+{
+    FMinesweeperBoard Board;
+    InitializeCornerBoard(Board);
+    TArray<FIntPoint> Revealed;
+    TestTrue(TEXT("Flag the mine"), Board.ToggleFlag(4, 4));
+    TestEqual(TEXT("Reveal a flagged mine"), Board.Reveal(4, 4, Revealed), EMinesweeperRevealResult::HitMine);
+    TestEqual(TEXT("Only the mine is reported"), Revealed.Num(), 1);
+    TestEqual(TEXT("Exploded cell"), Board.GetExplodedCell(), FIntPoint(4, 4));
+    TestTrue(TEXT("Mine revealed"), Board.IsRevealed(4, 4));
+    TestFalse(TEXT("Mine unflagged"), Board.IsFlagged(4, 4));
+    TestTrue(TEXT("Game over"), Board.IsGameOver());
+    TestFalse(TEXT("Game lost"), Board.IsGameWon());
+    TestEqual(TEXT("Reveal after the loss"), Board.Reveal(2, 2, Revealed), EMinesweeperRevealResult::Ignored);
+    TestEqual(TEXT("No safe cells revealed"), Board.GetSafeCellsRevealed(), int64(0));
+    return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FMinesweeperBoardChordTest, "MinesweeperMind.Board.Chord",
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool FMinesweeperBoardChordTest::RunTest(const FString& Parameters)
+{
+    TArray<FIntPoint> Revealed;
+    {
+        FMinesweeperBoard Board;
+        InitializeCornerBoard(Board);
+        Board.Reveal(1, 1, Revealed);
+        TestFalse(TEXT("No chord without its flag"), Board.CanChord(1, 1));
+        TestFalse(TEXT("No chord on a hidden cell"), Board.CanChord(2, 2));
+
+        Board.ToggleFlag(0, 0);
+        TestTrue(TEXT("Chord once the flags match"), Board.CanChord(1, 1));
+        const bool bChorded = Board.ApplyMove(FMinesweeperMove(FIntPoint(1, 1), EMinesweeperMoveType::Chord), Revealed);
+        TestTrue(TEXT("Chord applied"), bChorded);
+        TestTrue(TEXT("Chord opened the empty neighbour"), Board.IsRevealed(1, 2) && Board.IsRevealed(2, 2));
+        TestTrue(TEXT("Flagged mine untouched"), Board.IsFlagged(0, 0) && !Board.IsRevealed(0, 0));
+        TestTrue(TEXT("Chord flood won"), Board.IsGameWon());
+    }
+    {
+        // A wrong flag makes the chord open the real mine.
+        FMinesweeperBoard Board;
+        InitializeCornerBoard(Board);
+        Board.Reveal(1, 1, Revealed);
+        Board.ToggleFlag(1, 0);
+        Board.ApplyMove(FMinesweeperMove(FIntPoint(1, 1), EMinesweeperMoveType::Chord), Revealed);
+        TestTrue(TEXT("Wrong chord ends the game"), Board.IsGameOver());
+        TestFalse(TEXT("Wrong chord loses"), Board.IsGameWon());
+        TestEqual(TEXT("Wrong chord exploded cell"), Board.GetExplodedCell(), FIntPoint(0, 0));
+    }
+    return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FMinesweeperBoardPlacementTest, "MinesweeperMind.Board.Placement",
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool FMinesweeperBoardPlacementTest::RunTest(const FString& Parameters)
+{
+    // The first reveal places the mines around it and always opens.
+    for (uint64 Seed = 1; Seed <= 20; ++Seed)
+    {
+        FMinesweeperBoard Board;
+        Board.Initialize(9, 9, 10);
+        Board.DeferMinePlacement(Seed);
+        TArray<FIntPoint> Revealed;
+        const EMinesweeperRevealResult Result = Board.Reveal(4, 4, Revealed);
+        TestEqual(FString::Printf(TEXT("First reveal with seed %llu"), Seed), Result, EMinesweeperRevealResult::Revealed);
+        TestTrue(TEXT("Mines placed by the first reveal"), Board.AreMinesPlaced());
+        TestEqual(TEXT("Opening recorded"), Board.GetSafeCell(), FIntPoint(4, 4));
+        TestEqual(TEXT("Mines placed"), CountMines(Board), 10);
+        TestEqual(TEXT("Opening is empty"), Board.GetAdjacentMines(4, 4), 0);
+        TestTrue(TEXT("Opening floods"), Revealed.Num() >= 9);
+    }
+
+    // More mines than fit around an opening are clamped, and still all placed.
+    FMinesweeperBoard Board;
+    AddExpectedError(TEXT("holds 16 mines at most"), EAutomationExpectedErrorFlags::Contains, 1);
+    Board.Initialize(5, 5, 100);
+    TestEqual(TEXT("Clamped mine count"), Board.GetNumMines(), int64(16));
+    Board.PlaceMines(7, FIntPoint(0, 0));
+    TestEqual(TEXT("Clamped mines placed"), CountMines(Board), 16);
+    TestEqual(TEXT("Corner opening is empty"), Board.GetAdjacentMines(0, 0), 0);
+    TestFalse(TEXT("Corner opening is safe"), Board.IsMine(0, 0));
+    return true;
+}
+
+#endif
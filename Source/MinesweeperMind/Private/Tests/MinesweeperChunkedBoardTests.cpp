@@ -0,0 +1,96 @@
+#include "Core/MinesweeperChunkedBoard.h"
+#include "Math/RandomStream.h"
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+/**
+ * Reads of cells in chunks that don't exist or are compressed must create nothing and agree with what the chunk holds
+ * once a move warms it.
+ */
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FMinesweeperChunkedBoardReadTest, "MinesweeperMind.ChunkedBoard.Reads",
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool FMinesweeperChunkedBoardReadTest::RunTest(const FString& Parameters)
+{
+    constexpr int32 NumRows = 600;
+    constexpr int32 NumColumns = 700;
+    constexpr int32 ChunkSize = FMinesweeperChunkedBoard::ChunkSize;
+
+    for (int32 NumMoves : { 100, 800 })
+    {
+        FMinesweeperChunkedBoard Board;
+        Board.Initialize(NumRows, NumColumns, static_cast<int64>(NumRows * NumColumns * 0.18));
+        Board.DeferMinePlacement(NumMoves);
+
+        TArray<FIntPoint> Revealed;
+        Board.Reveal(NumRows / 2, NumColumns / 2, Revealed);
+
+        // Scattered flags and reveals leave some chunks hot, some compressed and some never created.
+        FRandomStream Random(NumMoves);
+        for (int32 Move = 0; Move < NumMoves && !Board.IsGameOver(); ++Move)
+        {
+            const int32 Row = Random.RandHelper(NumRows);
+            const int32 Column = Random.RandHelper(NumColumns);
+            if (Board.IsRevealed(Row, Column))
+            {
+                continue;
+            }
+            if (Board.IsMine(Row, Column) || Move % 3 == 0)
+            {
+                Board.ToggleFlag(Row, Column);
+            }
+            else
+            {
+                if (Board.IsFlagged(Row, Column))
+                {
+                    Board.ToggleFlag(Row, Column);
+                }
+                Board.Reveal(Row, Column, Revealed);
+            }
+        }
+
+        const int32 NumChunks = Board.GetNumChunks();
+        TArray<uint8> Cells;
+        Cells.Reserve(NumRows * NumColumns);
+        for (int32 Row = 0; Row < NumRows; ++Row)
+        {
+            for (int32 Column = 0; Column < NumColumns; ++Column)
+            {
+                Cells.Add(Board.GetCell(Row, Column));
+            }
+        }
+        TestEqual(TEXT("Reading every cell creates no chunk"), Board.GetNumChunks(), NumChunks);
+
+        // Flagging and unflagging a hidden cell warms its chunk without changing it.
+        int32 NumMismatches = 0;
+        for (int32 FirstRow = 0; FirstRow < NumRows; FirstRow += ChunkSize)
+        {
+            for (int32 FirstColumn = 0; FirstColumn < NumColumns; FirstColumn += ChunkSize)
+            {
+                const int32 EndRow = FMath::Min(FirstRow + ChunkSize, NumRows);
+                const int32 EndColumn = FMath::Min(FirstColumn + ChunkSize, NumColumns);
+                bool bWarmed = false;
+                for (int32 Row = FirstRow; Row < EndRow && !bWarmed; ++Row)
+                {
+                    for (int32 Column = FirstColumn; Column < EndColumn && !bWarmed; ++Column)
+                    {
+                        bWarmed = Board.ToggleFlag(Row, Column) && Board.ToggleFlag(Row, Column);
+                    }
+                }
+
+                for (int32 Row = FirstRow; Row < EndRow; ++Row)
+                {
+                    for (int32 Column = FirstColumn; Column < EndColumn; ++Column)
+                    {
+                        NumMismatches += Board.GetCell(Row, Column) != Cells[Row * NumColumns + Column] ? 1 : 0;
+                    }
+                }
+            }
+        }
+        TestEqual(FString::Printf(TEXT("Cells that changed when their chunk warmed after %d moves"), NumMoves), NumMismatches, 0);
+    }
+    return true;
+}
+
+#endif
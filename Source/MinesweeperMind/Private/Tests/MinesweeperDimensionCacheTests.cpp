@@ -0,0 +1,151 @@
+#include "Core/MinesweeperDimensionCache.h"
+#include "Dom/JsonObject.h"
+#include "HAL/FileManager.h"
+#include "Misc/AutomationTest.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+namespace
+{
+    /** A generate_dimensions answer the cache can tell apart from the others. */
+    TSharedRef<FJsonObject> MakeAnswer(int32 NumRows)
+    {
+        TSharedRef<FJsonObject> Answer = MakeShared<FJsonObject>();
+        Answer->SetStringField(TEXT("text"), FString::Printf(TEXT("{\"rows\":%d,\"columns\":%d,\"mines\":10}"), NumRows, NumRows));
+        return Answer;
+    }
+
+    FString GetAnswerText(const TSharedPtr<FJsonObject>& Answer)
+    {
+        return Answer.IsValid() ? Answer->GetStringField(TEXT("text")) : FString();
+    }
+
+    /** A stand-in for the plugin's Content: one model and the two scripts the fingerprint covers. */
+    FString MakeContentDir(const FString& Directory)
+    {
+        const FString ContentDir = Directory / TEXT("Content");
+        IFileManager::Get().DeleteDirectory(*Directory, false, true);
+        FFileHelper::SaveStringToFile(TEXT("model"), *(ContentDir / TEXT("LargeLanguageModels/model.gguf")));
+        FFileHelper::SaveStringToFile(TEXT("PROMPT = \"rows and columns\"\n"), *(ContentDir / TEXT("Scripts/game_dimension_generator.py")));
+        FFileHelper::SaveStringToFile(TEXT("MAX_ROWS = 10000\n"), *(ContentDir / TEXT("Scripts/reply_grammars.py")));
+        return ContentDir;
+    }
+
+    int32 CountFingerprintDirs(const FString& CacheDir)
+    {
+        TArray<FString> FingerprintDirs;
+        IFileManager::Get().FindFiles(FingerprintDirs, *(CacheDir / TEXT("*")), false, true);
+        return FingerprintDirs.Num();
+    }
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FMinesweeperDimensionCacheLruTest, "MinesweeperMind.DimensionCache.Lru",
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool FMinesweeperDimensionCacheLruTest::RunTest(const FString& Parameters)
+{
+    const FString Directory = FPaths::ConvertRelativePathToFull(FPaths::AutomationTransientDir() / TEXT("MinesweeperMind/DimensionCacheLru"));
+    const FString ContentDir = MakeContentDir(Directory);
+
+    // Memory only, room for two.
+    FMinesweeperDimensionCache Cache(FString(), 2, ContentDir);
+    Cache.Add(TEXT("8x8"), MakeAnswer(8), 1.0);
+    Cache.Add(TEXT("9x9"), MakeAnswer(9), 1.0);
+
+    // Touching 8x8 leaves 9x9 the least recently used, the third answer pushes it out.
+    TestEqual(TEXT("8x8 before the eviction"), GetAnswerText(Cache.Find(TEXT("8 by 8"))), GetAnswerText(MakeAnswer(8)));
+    Cache.Add(TEXT("10x10"), MakeAnswer(10), 1.0);
+    TestFalse(TEXT("Least recently used entry evicted"), Cache.Find(TEXT("9x9")).IsValid());
+    TestEqual(TEXT("Touched entry kept"), GetAnswerText(Cache.Find(TEXT("8x8"))), GetAnswerText(MakeAnswer(8)));
+    TestEqual(TEXT("Newest entry kept"), GetAnswerText(Cache.Find(TEXT("10x10"))), GetAnswerText(MakeAnswer(10)));
+
+    // The lookups above touched 8x8 before 10x10, so 8x8 goes next.
+    Cache.Add(TEXT("9x9"), MakeAnswer(9), 1.0);
+    TestFalse(TEXT("Next least recently used entry evicted"), Cache.Find(TEXT("8x8")).IsValid());
+    TestTrue(TEXT("Re-added entry found"), Cache.Find(TEXT("9x9")).IsValid());
+
+    const FMinesweeperDimensionCacheStats Stats = Cache.GetStats();
+    TestEqual(TEXT("Memory hits"), Stats.NumMemoryHits, 4);
+    TestEqual(TEXT("Misses"), Stats.NumMisses, 2);
+    TestEqual(TEXT("No disk tier"), Stats.NumDiskHits, 0);
+    TestEqual(TEXT("Stores"), Stats.NumStores, 4);
+
+    IFileManager::Get().DeleteDirectory(*Directory, false, true);
+    return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FMinesweeperDimensionCacheDiskTest, "MinesweeperMind.DimensionCache.Disk",
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool FMinesweeperDimensionCacheDiskTest::RunTest(const FString& Parameters)
+{
+    const FString Directory = FPaths::ConvertRelativePathToFull(FPaths::AutomationTransientDir() / TEXT("MinesweeperMind/DimensionCacheDisk"));
+    const FString ContentDir = MakeContentDir(Directory);
+    const FString CacheDir = Directory / TEXT("QueryCache");
+
+    {
+        FMinesweeperDimensionCache Cache(CacheDir, 1, ContentDir);
+        Cache.Add(TEXT("8x8"), MakeAnswer(8), 1.0);
+        Cache.Add(TEXT("9x9"), MakeAnswer(9), 1.0);
+
+        // 8x8 fell out of memory but is still on disk.
+        TestEqual(TEXT("Evicted entry read back from disk"), GetAnswerText(Cache.Find(TEXT("8x8"))), GetAnswerText(MakeAnswer(8)));
+        TestEqual(TEXT("Disk hits"), Cache.GetStats().NumDiskHits, 1);
+    }
+
+    // A fresh instance, as after an editor restart, starts with an empty memory tier.
+    FMinesweeperDimensionCache Restarted(CacheDir, 4, ContentDir);
+    TestEqual(TEXT("8x8 after the restart"), GetAnswerText(Restarted.Find(TEXT("8x8"))), GetAnswerText(MakeAnswer(8)));
+    TestEqual(TEXT("9x9 after the restart"), GetAnswerText(Restarted.Find(TEXT("9 by 9"))), GetAnswerText(MakeAnswer(9)));
+    TestFalse(TEXT("Never stored"), Restarted.Find(TEXT("10x10")).IsValid());
+    TestEqual(TEXT("8x8 again comes from memory"), GetAnswerText(Restarted.Find(TEXT("8x8"))), GetAnswerText(MakeAnswer(8)));
+
+    const FMinesweeperDimensionCacheStats Stats = Restarted.GetStats();
+    TestEqual(TEXT("Disk hits after the restart"), Stats.NumDiskHits, 2);
+    TestEqual(TEXT("Memory hits after the restart"), Stats.NumMemoryHits, 1);
+    TestEqual(TEXT("Misses after the restart"), Stats.NumMisses, 1);
+
+    Restarted.Clear();
+    TestFalse(TEXT("Clear drops the disk tier"), FMinesweeperDimensionCache(CacheDir, 4, ContentDir).Find(TEXT("8x8")).IsValid());
+
+    IFileManager::Get().DeleteDirectory(*Directory, false, true);
+    return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FMinesweeperDimensionCacheFingerprintTest, "MinesweeperMind.DimensionCache.Fingerprint",
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool FMinesweeperDimensionCacheFingerprintTest::RunTest(const FString& Parameters)
+{
+    const FString Directory = FPaths::ConvertRelativePathToFull(FPaths::AutomationTransientDir() / TEXT("MinesweeperMind/DimensionCacheFingerprint"));
+    const FString ContentDir = MakeContentDir(Directory);
+    const FString CacheDir = Directory / TEXT("QueryCache");
+
+    FMinesweeperDimensionCache Cache(CacheDir, 4, ContentDir);
+    Cache.Add(TEXT("8x8"), MakeAnswer(8), 1.0);
+    TestEqual(TEXT("One fingerprint on disk"), CountFingerprintDirs(CacheDir), 1);
+
+    // An edited prompt script is only noticed once the fingerprint is taken again.
+    FFileHelper::SaveStringToFile(TEXT("PROMPT = \"rows, columns and mines\"\n"), *(ContentDir / TEXT("Scripts/game_dimension_generator.py")));
+    TestTrue(TEXT("Lookups don't read the scripts"), Cache.Find(TEXT("8x8")).IsValid());
+    Cache.InvalidateFingerprint();
+    TestFalse(TEXT("Edited script invalidates the entry"), Cache.Find(TEXT("8x8")).IsValid());
+    TestEqual(TEXT("Stale fingerprint removed from disk"), CountFingerprintDirs(CacheDir), 0);
+    TestFalse(TEXT("Fresh instance misses too"), FMinesweeperDimensionCache(CacheDir, 4, ContentDir).Find(TEXT("8x8")).IsValid());
+
+    // A re-downloaded model keeps its name and size, only its time moves.
+    Cache.Add(TEXT("8x8"), MakeAnswer(8), 1.0);
+    TestTrue(TEXT("Stored under the new fingerprint"), Cache.Find(TEXT("8x8")).IsValid());
+    const FString ModelPath = ContentDir / TEXT("LargeLanguageModels/model.gguf");
+    IFileManager::Get().SetTimeStamp(*ModelPath, IFileManager::Get().GetTimeStamp(*ModelPath) + FTimespan::FromSeconds(10.0));
+    Cache.InvalidateFingerprint();
+    TestFalse(TEXT("Touched model invalidates the entry"), Cache.Find(TEXT("8x8")).IsValid());
+    TestEqual(TEXT("Misses"), Cache.GetStats().NumMisses, 2);
+
+    IFileManager::Get().DeleteDirectory(*Directory, false, true);
+    return true;
+}
+
+#endif
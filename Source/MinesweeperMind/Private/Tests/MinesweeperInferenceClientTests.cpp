@@ -0,0 +1,198 @@
+#include "Core/MinesweeperInferenceClient.h"
+#include "Async/Async.h"
+#include "Dom/JsonObject.h"
+#include "HAL/IConsoleManager.h"
+#include "HAL/PlatformTime.h"
+#include "Interfaces/IPluginManager.h"
+#include "Misc/AutomationTest.h"
+#include "Misc/Paths.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+namespace
+{
+    /** A client for inference_worker.py --stub, run with the configured Python. */
+    FMinesweeperInferenceWorkerSettings MakeStubSettings(double StubDelaySeconds, double TimeoutSeconds)
+    {
+        FMinesweeperInferenceWorkerSettings Settings;
+        if (const IConsoleVariable* Executable = IConsoleManager::Get().FindConsoleVariable(TEXT("MinesweeperMind.Inference.WorkerExecutable")))
+        {
+            Settings.Executable = Executable->GetString();
+        }
+
+        const TSharedPtr<IPlugin> Plugin = IPluginManager::Get().FindPlugin(TEXT("MinesweeperMind"));
+        const FString Script = Plugin.IsValid() ? FPaths::ConvertRelativePathToFull(Plugin->GetBaseDir() / TEXT("Content/Scripts/inference_worker.py")) : FString();
+        Settings.Arguments = FString::Printf(TEXT("\"%s\" --stub --stub-delay %.2f"), *Script, StubDelaySeconds);
+        Settings.TimeoutSeconds = TimeoutSeconds;
+        return Settings;
+    }
+
+    bool Ping(FMinesweeperInferenceClient& Client, int32& OutPid, FString& OutError)
+    {
+        TSharedPtr<FJsonObject> Result;
+        OutPid = 0;
+        return Client.Call(TEXT("ping"), MakeShared<FJsonObject>(), Result, OutError) && Result->TryGetNumberField(TEXT("pid"), OutPid);
+    }
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FMinesweeperInferenceClientRoundTripTest, "MinesweeperMind.InferenceClient.RoundTrip",
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool FMinesweeperInferenceClientRoundTripTest::RunTest(const FString& Parameters)
+{
+    FMinesweeperInferenceClient Client(MakeStubSettings(0.0, 30.0));
+
+    TSharedRef<FJsonObject> Params = MakeShared<FJsonObject>();
+    Params->SetStringField(TEXT("query"), TEXT("expert board"));
+    TSharedPtr<FJsonObject> Result;
+    FString Error;
+    const bool bAnswered = Client.Call(TEXT("generate_dimensions"), Params, Result, Error);
+    if (!TestTrue(FString::Printf(TEXT("generate_dimensions answered (%s)"), *Error), bAnswered))
+    {
+        return false;
+    }
+    TestEqual(TEXT("Stub dimensions"), Result->GetStringField(TEXT("text")), FString(TEXT("{\"rows\":16,\"columns\":30,\"mines\":99}")));
+    TestEqual(TEXT("Prompt tokens"), int32(Result->GetNumberField(TEXT("prompt_tokens"))), 2);
+
+    TSharedRef<FJsonObject> ChatParams = MakeShared<FJsonObject>();
+    ChatParams->SetStringField(TEXT("message"), TEXT("hello there"));
+    FString Streamed;
+    int32 NumTokens = 0;
+    const std::atomic<bool> bCancelRequested(false);
+    TestTrue(TEXT("chat answered"), Client.CallStreaming(TEXT("chat"), ChatParams,
+        [&Streamed, &NumTokens](const FString& Token) { Streamed += Token; ++NumTokens; }, bCancelRequested, Result, Error));
+    TestEqual(TEXT("Streamed tokens"), NumTokens, 4);
+    TestEqual(TEXT("Streamed text"), Streamed, FString(TEXT("You said: hello there")));
+    TestEqual(TEXT("Final text"), Result.IsValid() ? Result->GetStringField(TEXT("text")) : FString(), Streamed);
+
+    TestFalse(TEXT("Unknown method fails"), Client.Call(TEXT("no_such_method"), MakeShared<FJsonObject>(), Result, Error));
+    TestTrue(TEXT("Unknown method error"), Error.Contains(TEXT("Unknown method")));
+    TestEqual(TEXT("Worker starts"), Client.GetNumWorkerStarts(), 1);
+
+    Client.Stop();
+    TestFalse(TEXT("Worker stopped"), Client.IsWorkerRunning());
+    return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FMinesweeperInferenceClientStaleIdTest, "MinesweeperMind.InferenceClient.StaleId",
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool FMinesweeperInferenceClientStaleIdTest::RunTest(const FString& Parameters)
+{
+    FMinesweeperInferenceClient Client(MakeStubSettings(0.2, 30.0));
+
+    // Cancelling after the first token returns at once, the worker answers that id with an error at its next token.
+    TSharedRef<FJsonObject> ChatParams = MakeShared<FJsonObject>();
+    ChatParams->SetStringField(TEXT("message"), TEXT("one two three four five"));
+    std::atomic<bool> bCancelRequested(false);
+    TSharedPtr<FJsonObject> Result;
+    FString Error;
+    TestFalse(TEXT("Cancelled chat fails"), Client.CallStreaming(TEXT("chat"), ChatParams,
+        [&bCancelRequested](const FString&) { bCancelRequested = true; }, bCancelRequested, Result, Error));
+    TestEqual(TEXT("Cancel error"), Error, FString(TEXT("Cancelled")));
+
+    // The cancelled answer arrives ahead of this one and must not be taken for it.
+    int32 Pid = 0;
+    const bool bPinged = Ping(Client, Pid, Error);
+    TestTrue(FString::Printf(TEXT("Ping after the cancel answered (%s)"), *Error), bPinged);
+    TestTrue(TEXT("Ping result"), Pid > 0);
+    TestEqual(TEXT("Worker starts"), Client.GetNumWorkerStarts(), 1);
+    return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FMinesweeperInferenceClientTimeoutTest, "MinesweeperMind.InferenceClient.Timeout",
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool FMinesweeperInferenceClientTimeoutTest::RunTest(const FString& Parameters)
+{
+    FMinesweeperInferenceClient Client(MakeStubSettings(1.0, 0.7));
+
+    // ping doesn't wait on the stub delay, it gets the worker running so its startup isn't part of the timings below.
+    int32 Pid = 0;
+    FString Error;
+    const bool bWarmedUp = Ping(Client, Pid, Error);
+    if (!TestTrue(FString::Printf(TEXT("Warm-up ping answered (%s)"), *Error), bWarmedUp))
+    {
+        return false;
+    }
+
+    TSharedRef<FJsonObject> Params = MakeShared<FJsonObject>();
+    Params->SetStringField(TEXT("query"), TEXT("expert board"));
+    TSharedPtr<FJsonObject> Result;
+    const double StartTime = FPlatformTime::Seconds();
+    TestFalse(TEXT("Slow request times out"), Client.Call(TEXT("generate_dimensions"), Params, Result, Error));
+    const double Seconds = FPlatformTime::Seconds() - StartTime;
+    TestTrue(FString::Printf(TEXT("Timeout error (%s)"), *Error), Error.StartsWith(TEXT("No answer")));
+    // Only the lower bound, a loaded machine may well take longer to notice.
+    TestTrue(FString::Printf(TEXT("Returned after the timeout (%.2f s)"), Seconds), Seconds >= 0.65);
+    TestFalse(TEXT("No result"), Result.IsValid());
+    TestTrue(TEXT("Worker kept running"), Client.IsWorkerRunning());
+
+    // The timed-out answer lands during this call and is dropped by id.
+    int32 NextPid = 0;
+    const bool bPinged = Ping(Client, NextPid, Error);
+    TestTrue(FString::Printf(TEXT("Ping after the timeout answered (%s)"), *Error), bPinged);
+    TestEqual(TEXT("Same worker"), NextPid, Pid);
+    TestEqual(TEXT("Worker starts"), Client.GetNumWorkerStarts(), 1);
+    return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FMinesweeperInferenceClientRestartTest, "MinesweeperMind.InferenceClient.Restart",
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool FMinesweeperInferenceClientRestartTest::RunTest(const FString& Parameters)
+{
+    // Without restarts a request fails with the worker instead of being sent again to the next one.
+    FMinesweeperInferenceWorkerSettings Settings = MakeStubSettings(0.0, 30.0);
+    Settings.MaxRestarts = 0;
+    FMinesweeperInferenceClient Client(Settings);
+
+    int32 Pid = 0;
+    FString Error;
+    const bool bPinged = Ping(Client, Pid, Error);
+    if (!TestTrue(FString::Printf(TEXT("First ping answered (%s)"), *Error), bPinged))
+    {
+        return false;
+    }
+
+    // A request the worker sits on far longer than the test waits, killed while it is being handled.
+    TSharedRef<FJsonObject> SleepParams = MakeShared<FJsonObject>();
+    SleepParams->SetNumberField(TEXT("seconds"), 20.0);
+    FString SleepError;
+    TFuture<bool> Sleep = Async(EAsyncExecution::Thread, [&Client, SleepParams, &SleepError]()
+    {
+        TSharedPtr<FJsonObject> Result;
+        return Client.Call(TEXT("sleep"), SleepParams, Result, SleepError);
+    });
+    FPlatformProcess::Sleep(0.5f);
+
+    FProcHandle Worker = FPlatformProcess::OpenProcess(uint32(Pid));
+    if (!TestTrue(TEXT("Opened the worker process"), Worker.IsValid()))
+    {
+        Sleep.Wait();
+        return false;
+    }
+    FPlatformProcess::TerminateProc(Worker, true);
+    FPlatformProcess::CloseProc(Worker);
+
+    // The call gives up as soon as the worker is gone, not when the sleep or the timeout would have ended. The next one
+    // starts a new worker.
+    if (!TestTrue(TEXT("Interrupted call returned"), Sleep.WaitFor(FTimespan::FromSeconds(10.0))))
+    {
+        Sleep.Wait();
+        return false;
+    }
+    TestFalse(TEXT("Interrupted call fails"), Sleep.Get());
+    TestTrue(FString::Printf(TEXT("Interrupted call says why (%s)"), *SleepError), SleepError.Contains(TEXT("exited while handling 'sleep'")));
+    TestFalse(TEXT("Worker killed"), Client.IsWorkerRunning());
+
+    int32 NextPid = 0;
+    const bool bRestarted = Ping(Client, NextPid, Error);
+    TestTrue(FString::Printf(TEXT("Ping after the kill answered (%s)"), *Error), bRestarted);
+    TestNotEqual(TEXT("New worker"), NextPid, Pid);
+    TestEqual(TEXT("Worker starts"), Client.GetNumWorkerStarts(), 2);
+    TestTrue(TEXT("Worker running again"), Client.IsWorkerRunning());
+    return true;
+}
+
+#endif
@@ -0,0 +1,111 @@
+#include "Core/MinesweeperIntentParser.h"
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+namespace
+{
+    struct FParseCase
+    {
+        const TCHAR* Text;
+        EMinesweeperIntentMatch Match;
+        int32 NumRows;
+        int32 NumColumns;
+        int64 NumMines;
+    };
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FMinesweeperIntentParserParseTest, "MinesweeperMind.IntentParser.Parse",
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool FMinesweeperIntentParserParseTest::RunTest(const FString& Parameters)
+{
+    const FParseCase Cases[] =
+    {
+        // The forms the parser was written for.
+        { TEXT("10 10 15"), EMinesweeperIntentMatch::Parsed, 10, 10, 15 },
+        { TEXT("3x3 with 2 mines"), EMinesweeperIntentMatch::Parsed, 3, 3, 2 },
+        { TEXT("expert"), EMinesweeperIntentMatch::Parsed, 16, 30, 99 },
+        { TEXT("16 by 30, 99 mines"), EMinesweeperIntentMatch::Parsed, 16, 30, 99 },
+
+        // Presets, and explicit numbers overriding them.
+        { TEXT("Beginner"), EMinesweeperIntentMatch::Parsed, 9, 9, 10 },
+        { TEXT("intermediate please"), EMinesweeperIntentMatch::Parsed, 16, 16, 40 },
+        { TEXT("I want an expert board with 120 mines"), EMinesweeperIntentMatch::Parsed, 16, 30, 120 },
+        { TEXT("expert 30x30"), EMinesweeperIntentMatch::Parsed, 30, 30, 135 },
+
+        // Sizes without a mine count get 15%, labelled numbers may come in any form.
+        { TEXT("make a 20x20 grid"), EMinesweeperIntentMatch::Parsed, 20, 20, 60 },
+        { TEXT("16 rows 30 columns"), EMinesweeperIntentMatch::Parsed, 16, 30, 72 },
+        { TEXT("rows: 12 columns 8 mines=20"), EMinesweeperIntentMatch::Parsed, 12, 8, 20 },
+        { TEXT("30 x 16 x 99"), EMinesweeperIntentMatch::Parsed, 30, 16, 99 },
+
+        // Board requests the parser can't fully account for go to the model.
+        { TEXT("10 x 10 with lots of mines"), EMinesweeperIntentMatch::NeedsModel, 0, 0, 0 },
+        { TEXT("3x3 with 20 mines"), EMinesweeperIntentMatch::NeedsModel, 0, 0, 0 },
+        { TEXT("easy hard"), EMinesweeperIntentMatch::NeedsModel, 0, 0, 0 },
+
+        // Conversation, including numbers and game words that aren't a board.
+        { TEXT("hello there"), EMinesweeperIntentMatch::NotABoard, 0, 0, 0 },
+        { TEXT("how many mines are left?"), EMinesweeperIntentMatch::NotABoard, 0, 0, 0 },
+        { TEXT("I am 25 years old"), EMinesweeperIntentMatch::NotABoard, 0, 0, 0 },
+        { TEXT("5"), EMinesweeperIntentMatch::NotABoard, 0, 0, 0 },
+    };
+
+    for (const FParseCase& Case : Cases)
+    {
+        FMinesweeperBoardRequest Request;
+        const EMinesweeperIntentMatch Match = FMinesweeperIntentParser::Parse(Case.Text, Request);
+        TestEqual(FString::Printf(TEXT("Match for \"%s\""), Case.Text), Match, Case.Match);
+        if (Match != EMinesweeperIntentMatch::Parsed)
+        {
+            continue;
+        }
+        TestEqual(FString::Printf(TEXT("Rows for \"%s\""), Case.Text), Request.NumRows, Case.NumRows);
+        TestEqual(FString::Printf(TEXT("Columns for \"%s\""), Case.Text), Request.NumColumns, Case.NumColumns);
+        TestEqual(FString::Printf(TEXT("Mines for \"%s\""), Case.Text), Request.NumMines, Case.NumMines);
+        TestEqual(FString::Printf(TEXT("Source for \"%s\""), Case.Text), Request.Source, EMinesweeperBoardRequestSource::Parser);
+    }
+    return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FMinesweeperIntentParserNormalizeTest, "MinesweeperMind.IntentParser.Normalize",
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool FMinesweeperIntentParserNormalizeTest::RunTest(const FString& Parameters)
+{
+    TestEqual(TEXT("Preset"), FMinesweeperIntentParser::Normalize(TEXT("expert")), FString(TEXT("expert")));
+    TestEqual(TEXT("Preset synonym"), FMinesweeperIntentParser::Normalize(TEXT("hard level")), FString(TEXT("expert")));
+    TestEqual(TEXT("Case and filler"), FMinesweeperIntentParser::Normalize(TEXT("Make an EXPERT game!")), FString(TEXT("expert")));
+    TestEqual(TEXT("Size separators and synonyms"), FMinesweeperIntentParser::Normalize(TEXT("16 * 30, 99 Mines")), FString(TEXT("16 x 30 99 mines")));
+    TestEqual(TEXT("Words the parser can't use are kept"), FMinesweeperIntentParser::Normalize(TEXT("10x10 with lots of bombs")),
+        FString(TEXT("10 x 10 lots mines")));
+    TestEqual(TEXT("Labels"), FMinesweeperIntentParser::Normalize(TEXT("rows: 12 columns 8")), FString(TEXT("rows 12 columns 8")));
+    return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FMinesweeperIntentParserBypassTest, "MinesweeperMind.IntentParser.BypassRate",
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool FMinesweeperIntentParserBypassTest::RunTest(const FString& Parameters)
+{
+    // The counters are global, only what this test adds is checked.
+    const int32 NumParser = FMinesweeperIntentParser::GetNumParserAnswers();
+    const int32 NumModel = FMinesweeperIntentParser::GetNumModelAnswers();
+    const int32 NumCache = FMinesweeperIntentParser::GetNumCacheAnswers();
+
+    FMinesweeperIntentParser::RecordAnswer(EMinesweeperBoardRequestSource::Parser);
+    FMinesweeperIntentParser::RecordAnswer(EMinesweeperBoardRequestSource::Parser);
+    FMinesweeperIntentParser::RecordAnswer(EMinesweeperBoardRequestSource::Model);
+    FMinesweeperIntentParser::RecordAnswer(EMinesweeperBoardRequestSource::Cache);
+    TestEqual(TEXT("Parser answers"), FMinesweeperIntentParser::GetNumParserAnswers(), NumParser + 2);
+    TestEqual(TEXT("Model answers"), FMinesweeperIntentParser::GetNumModelAnswers(), NumModel + 1);
+    TestEqual(TEXT("Cache answers"), FMinesweeperIntentParser::GetNumCacheAnswers(), NumCache + 1);
+
+    const int32 NumBypassed = NumParser + NumCache + 3;
+    const int32 NumAnswers = NumBypassed + NumModel + 1;
+    TestEqual(TEXT("Bypass rate"), FMinesweeperIntentParser::GetModelBypassRate(), double(NumBypassed) / NumAnswers);
+    return true;
+}
+
+#endif
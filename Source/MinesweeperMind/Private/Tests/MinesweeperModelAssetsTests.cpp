@@ -0,0 +1,288 @@
+#include "Core/MinesweeperModelAssets.h"
+#include "MinesweeperSha256.h"
+#include "Async/Async.h"
+#include "HAL/FileManager.h"
+#include "HAL/IConsoleManager.h"
+#include "HAL/PlatformProcess.h"
+#include "HAL/PlatformTime.h"
+#include "Interfaces/IPluginManager.h"
+#include "Math/RandomStream.h"
+#include "Misc/AutomationTest.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+namespace
+{
+    constexpr int32 ModelBytes = 1000 * 1000;
+
+    /** range_file_server.py on a free port, serving one directory until it goes out of scope. */
+    class FRangeFileServer
+    {
+    public:
+        bool Start(const FString& Directory, const FString& Options)
+        {
+            FString Executable = TEXT("python");
+            if (const IConsoleVariable* WorkerExecutable = IConsoleManager::Get().FindConsoleVariable(TEXT("MinesweeperMind.Inference.WorkerExecutable")))
+            {
+                Executable = WorkerExecutable->GetString();
+            }
+            const TSharedPtr<IPlugin> Plugin = IPluginManager::Get().FindPlugin(TEXT("MinesweeperMind"));
+            if (!Plugin.IsValid() || !FPlatformProcess::CreatePipe(StdOutRead, StdOutWrite))
+            {
+                return false;
+            }
+
+            const FString Script = FPaths::ConvertRelativePathToFull(Plugin->GetBaseDir() / TEXT("Content/Scripts/range_file_server.py"));
+            const FString Arguments = FString::Printf(TEXT("-u \"%s\" \"%s\" --port 0 %s"), *Script, *Directory, *Options);
+            Process = FPlatformProcess::CreateProc(*Executable, *Arguments, false, true, true, nullptr, 0, nullptr, StdOutWrite);
+
+            // The first line says which port it picked.
+            FString Output;
+            const double Deadline = FPlatformTime::Seconds() + 10.0;
+            while (Process.IsValid() && FPlatformProcess::IsProcRunning(Process) && FPlatformTime::Seconds() < Deadline)
+            {
+                Output += FPlatformProcess::ReadPipe(StdOutRead);
+                FString Address;
+                TArray<FString> Lines;
+                if (Output.Split(TEXT(" on http://"), nullptr, &Address, ESearchCase::CaseSensitive, ESearchDir::FromEnd)
+                    && Address.ParseIntoArrayLines(Lines) > 0 && Output.EndsWith(TEXT("\n")))
+                {
+                    BaseUrl = TEXT("http://") + Lines[0].TrimEnd().LeftChop(1);
+                    return true;
+                }
+                FPlatformProcess::Sleep(0.01f);
+            }
+            return false;
+        }
+
+        ~FRangeFileServer()
+        {
+            if (Process.IsValid())
+            {
+                FPlatformProcess::TerminateProc(Process, true);
+                FPlatformProcess::CloseProc(Process);
+            }
+            FPlatformProcess::ClosePipe(StdOutRead, StdOutWrite);
+        }
+
+        FString GetUrl(const FString& FileName) const { return BaseUrl / FileName; }
+
+    private:
+        FProcHandle Process;
+        void* StdOutRead = nullptr;
+        void* StdOutWrite = nullptr;
+        FString BaseUrl;
+    };
+
+    /** A fresh directory with a pseudo-random stand-in for the model in Served/, returns that file's bytes. */
+    TArray<uint8> MakeServedModel(const FString& Directory)
+    {
+        IFileManager::Get().DeleteDirectory(*Directory, false, true);
+
+        TArray<uint8> Bytes;
+        Bytes.SetNumUninitialized(ModelBytes);
+        FRandomStream Random(20240613);
+        for (uint8& Byte : Bytes)
+        {
+            Byte = static_cast<uint8>(Random.RandHelper(256));
+        }
+        FFileHelper::SaveArrayToFile(Bytes, *(Directory / TEXT("Served/model.gguf")));
+        return Bytes;
+    }
+
+    FString HashBytes(const uint8* Data, int64 NumBytes)
+    {
+        FMinesweeperSha256 Hasher;
+        Hasher.Update(Data, NumBytes);
+        return Hasher.Finalize();
+    }
+
+    /** Download runs off the game thread. */
+    bool DownloadOnWorkerThread(const FMinesweeperModelAsset& Asset, FString& OutError)
+    {
+        return Async(EAsyncExecution::Thread, [&Asset, &OutError]() { return FMinesweeperModelAssets::Download(Asset, OutError); }).Get();
+    }
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FMinesweeperModelAssetsResumeTest, "MinesweeperMind.ModelAssets.ResumedDownload",
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool FMinesweeperModelAssetsResumeTest::RunTest(const FString& Parameters)
+{
+    const FString Directory = FPaths::ConvertRelativePathToFull(FPaths::AutomationTransientDir() / TEXT("MinesweeperMind/ResumedDownload"));
+    const TArray<uint8> Model = MakeServedModel(Directory);
+
+    // Every GET is cut off after 300 KB, finishing a 1 MB file takes resuming more than once.
+    FRangeFileServer Server;
+    if (!TestTrue(TEXT("range_file_server.py started"), Server.Start(Directory / TEXT("Served"), TEXT("--drop-after 300000"))))
+    {
+        return false;
+    }
+
+    IConsoleVariable* ModelUrl = IConsoleManager::Get().FindConsoleVariable(TEXT("MinesweeperMind.Model.Url"));
+    if (!TestNotNull(TEXT("MinesweeperMind.Model.Url"), ModelUrl))
+    {
+        return false;
+    }
+    const FString PreviousUrl = ModelUrl->GetString();
+    ModelUrl->Set(*Server.GetUrl(TEXT("model.gguf")));
+    FMinesweeperModelAsset Asset = FMinesweeperModelAsset::GetDefault();
+    ModelUrl->Set(*PreviousUrl);
+    TestEqual(TEXT("URL override"), Asset.Url, Server.GetUrl(TEXT("model.gguf")));
+
+    Asset.Path = Directory / TEXT("model.gguf");
+    Asset.Sha256 = FMinesweeperModelAssets::HashFile(Directory / TEXT("Served/model.gguf"));
+    const FString PartPath = Asset.Path + TEXT(".part");
+
+    // A .part with the wrong leading bytes is kept and resumed after, so the result cannot match.
+    TArray<uint8> Prefix;
+    Prefix.SetNumZeroed(100 * 1000);
+    FFileHelper::SaveArrayToFile(Prefix, *PartPath);
+    FString Error;
+    TestFalse(TEXT("Resuming a corrupt .part fails"), DownloadOnWorkerThread(Asset, Error));
+    TestTrue(FString::Printf(TEXT("Hash mismatch reported (%s)"), *Error), Error.Contains(TEXT("SHA-256 mismatch")));
+    TestFalse(TEXT("Corrupt .part deleted"), IFileManager::Get().FileExists(*PartPath));
+
+    // The right leading bytes are kept and the rest is fetched in ranges.
+    FFileHelper::SaveArrayToFile(TArray<uint8>(Model.GetData(), Prefix.Num()), *PartPath);
+    const bool bResumed = DownloadOnWorkerThread(Asset, Error);
+    if (!TestTrue(FString::Printf(TEXT("Resumed download succeeded (%s)"), *Error), bResumed))
+    {
+        return false;
+    }
+
+    TArray<uint8> Downloaded;
+    TestTrue(TEXT("Model file written"), FFileHelper::LoadFileToArray(Downloaded, *Asset.Path));
+    TestTrue(TEXT("Downloaded bytes match"), Downloaded == Model);
+    TestFalse(TEXT(".part moved into place"), IFileManager::Get().FileExists(*PartPath));
+    TestTrue(TEXT("Stamp written"), IFileManager::Get().FileExists(*FMinesweeperModelAssets::GetStampPath(Asset.Path)));
+    TestTrue(TEXT("Stamp matches the file"), FMinesweeperModelAssets::HasValidStamp(Asset));
+    TestTrue(TEXT("Ensure trusts the stamp"), FMinesweeperModelAssets::Ensure(Asset, Error));
+    return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FMinesweeperModelAssetsUnrangedTest, "MinesweeperMind.ModelAssets.UnrangedDownload",
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool FMinesweeperModelAssetsUnrangedTest::RunTest(const FString& Parameters)
+{
+    const FString Directory = FPaths::ConvertRelativePathToFull(FPaths::AutomationTransientDir() / TEXT("MinesweeperMind/UnrangedDownload"));
+    const TArray<uint8> Model = MakeServedModel(Directory);
+
+    FRangeFileServer Server;
+    if (!TestTrue(TEXT("range_file_server.py started"), Server.Start(Directory / TEXT("Served"), TEXT("--no-ranges"))))
+    {
+        return false;
+    }
+
+    FMinesweeperModelAsset Asset;
+    Asset.Url = Server.GetUrl(TEXT("model.gguf"));
+    Asset.Path = Directory / TEXT("model.gguf");
+    Asset.Sha256 = FMinesweeperModelAssets::HashFile(Directory / TEXT("Served/model.gguf"));
+
+    // The server ignores the Range, so its whole-file answer replaces the stale .part instead of being appended.
+    TArray<uint8> Stale;
+    Stale.SetNumZeroed(5000);
+    FFileHelper::SaveArrayToFile(Stale, *(Asset.Path + TEXT(".part")));
+
+    FString Error;
+    const bool bDownloaded = DownloadOnWorkerThread(Asset, Error);
+    if (!TestTrue(FString::Printf(TEXT("Download succeeded (%s)"), *Error), bDownloaded))
+    {
+        return false;
+    }
+
+    TArray<uint8> Downloaded;
+    TestTrue(TEXT("Model file written"), FFileHelper::LoadFileToArray(Downloaded, *Asset.Path));
+    TestTrue(TEXT("Downloaded bytes match"), Downloaded == Model);
+    TestTrue(TEXT("Stamp matches the file"), FMinesweeperModelAssets::HasValidStamp(Asset));
+    return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FMinesweeperModelAssetsSha256Test, "MinesweeperMind.ModelAssets.Sha256",
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool FMinesweeperModelAssetsSha256Test::RunTest(const FString& Parameters)
+{
+    // FIPS 180-4 examples. The 448-bit message leaves no room for the length in its first block.
+    const ANSICHAR* const Abc = "abc";
+    const ANSICHAR* const TwoBlocks = "abcdbcdecdefdefgefghfghighijhijkijkljklmklmnlmnomnopnopq";
+    TestEqual(TEXT("Empty message"), HashBytes(nullptr, 0),
+        FString(TEXT("e3b0c44298fc1c149afbf4c8996fb92427ae41e4649b934ca495991b7852b855")));
+    TestEqual(TEXT("\"abc\""), HashBytes(reinterpret_cast<const uint8*>(Abc), FCStringAnsi::Strlen(Abc)),
+        FString(TEXT("ba7816bf8f01cfea414140de5dae2223b00361a396177a9cb410ff61f20015ad")));
+    TestEqual(TEXT("448-bit message"), HashBytes(reinterpret_cast<const uint8*>(TwoBlocks), FCStringAnsi::Strlen(TwoBlocks)),
+        FString(TEXT("248d6a61d20638b8e5c026930c3e6039a33ce45964ff2167f6ecedd419db06c1")));
+
+    // A million 'a' in one go, and in uneven pieces that straddle the 64-byte blocks.
+    const FString MillionA = TEXT("cdc76e5c9914fb9281a1c7e284d73e67f1809a48a497200e046d39ccc7112cd0");
+    TArray<uint8> Message;
+    Message.Init('a', 1000 * 1000);
+    TestEqual(TEXT("A million 'a'"), HashBytes(Message.GetData(), Message.Num()), MillionA);
+
+    FMinesweeperSha256 Hasher;
+    int64 Offset = 0;
+    for (int32 Piece = 0; Offset < Message.Num(); ++Piece)
+    {
+        const int64 NumBytes = FMath::Min<int64>(Piece % 131, Message.Num() - Offset);
+        Hasher.Update(Message.GetData() + Offset, NumBytes);
+        Offset += NumBytes;
+    }
+    TestEqual(TEXT("A million 'a' in pieces"), Hasher.Finalize(), MillionA);
+
+    // HashFile reads in its own blocks.
+    const FString Path = FPaths::ConvertRelativePathToFull(FPaths::AutomationTransientDir() / TEXT("MinesweeperMind/MillionA.bin"));
+    FFileHelper::SaveArrayToFile(Message, *Path);
+    TestEqual(TEXT("A million 'a' from a file"), FMinesweeperModelAssets::HashFile(Path), MillionA);
+    IFileManager::Get().Delete(*Path);
+    return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FMinesweeperModelAssetsStampTest, "MinesweeperMind.ModelAssets.Stamp",
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool FMinesweeperModelAssetsStampTest::RunTest(const FString& Parameters)
+{
+    const FString Directory = FPaths::ConvertRelativePathToFull(FPaths::AutomationTransientDir() / TEXT("MinesweeperMind/Stamp"));
+    IFileManager::Get().DeleteDirectory(*Directory, false, true);
+
+    TArray<uint8> Bytes;
+    Bytes.Init(7, 1000);
+    FMinesweeperModelAsset Asset;
+    Asset.Path = Directory / TEXT("model.gguf");
+    FFileHelper::SaveArrayToFile(Bytes, *Asset.Path);
+    Asset.Sha256 = FMinesweeperModelAssets::HashFile(Asset.Path);
+
+    TestFalse(TEXT("No stamp before verifying"), FMinesweeperModelAssets::HasValidStamp(Asset));
+    FString Error;
+    const bool bVerified = FMinesweeperModelAssets::Verify(Asset, Error);
+    if (!TestTrue(FString::Printf(TEXT("Verified (%s)"), *Error), bVerified))
+    {
+        return false;
+    }
+    TestTrue(TEXT("Stamp matches the file"), FMinesweeperModelAssets::HasValidStamp(Asset));
+
+    FMinesweeperModelAsset OtherHash = Asset;
+    OtherHash.Sha256 = HashBytes(Bytes.GetData(), Bytes.Num() - 1);
+    TestFalse(TEXT("Stamp is for another hash"), FMinesweeperModelAssets::HasValidStamp(OtherHash));
+
+    // The stamp keeps whole seconds, move the file well past that.
+    const FDateTime Stamped = IFileManager::Get().GetTimeStamp(*Asset.Path);
+    IFileManager::Get().SetTimeStamp(*Asset.Path, Stamped + FTimespan::FromSeconds(10.0));
+    TestFalse(TEXT("A new modification time invalidates the stamp"), FMinesweeperModelAssets::HasValidStamp(Asset));
+    IFileManager::Get().SetTimeStamp(*Asset.Path, Stamped);
+    TestTrue(TEXT("The stamped modification time is trusted again"), FMinesweeperModelAssets::HasValidStamp(Asset));
+
+    // Same time, different size.
+    Bytes.Add(7);
+    FFileHelper::SaveArrayToFile(Bytes, *Asset.Path);
+    IFileManager::Get().SetTimeStamp(*Asset.Path, Stamped);
+    TestFalse(TEXT("A new size invalidates the stamp"), FMinesweeperModelAssets::HasValidStamp(Asset));
+
+    IFileManager::Get().DeleteDirectory(*Directory, false, true);
+    return true;
+}
+
+#endif
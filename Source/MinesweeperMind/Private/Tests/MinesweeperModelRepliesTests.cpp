@@ -0,0 +1,155 @@
+#include "Core/MinesweeperModelReplies.h"
+#include "Dom/JsonObject.h"
+#include "Interfaces/IPluginManager.h"
+#include "Misc/AutomationTest.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+namespace
+{
+    bool ParseDimensions(const TCHAR* Json)
+    {
+        FMinesweeperDimensionReply Reply;
+        return FMinesweeperDimensionReply::Parse(Json, Reply);
+    }
+
+    bool ParseMove(const TCHAR* Json)
+    {
+        FMinesweeperMoveReply Reply;
+        return FMinesweeperMoveReply::Parse(Json, Reply);
+    }
+
+    /**
+     * Largest number a rule of reply_grammars.py allows, INDEX_NONE if the rule isn't found. The rules are a leading
+     * digit and optional [0-9]? digits after it.
+     */
+    int64 GetGrammarMax(const FString& Grammars, const TCHAR* Rule)
+    {
+        TArray<FString> Lines;
+        Grammars.ParseIntoArrayLines(Lines);
+        for (const FString& Line : Lines)
+        {
+            FString Name;
+            FString Definition;
+            if (Line.Split(TEXT("::="), &Name, &Definition) && Name.TrimStartAndEnd() == Rule)
+            {
+                int64 Max = 9;
+                int32 Start = Definition.Find(TEXT("[0-9]?"));
+                while (Start != INDEX_NONE)
+                {
+                    Max = Max * 10 + 9;
+                    Start = Definition.Find(TEXT("[0-9]?"), ESearchCase::CaseSensitive, ESearchDir::FromStart, Start + 1);
+                }
+                return Max;
+            }
+        }
+        return INDEX_NONE;
+    }
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FMinesweeperModelRepliesDimensionsTest, "MinesweeperMind.ModelReplies.Dimensions",
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool FMinesweeperModelRepliesDimensionsTest::RunTest(const FString& Parameters)
+{
+    FMinesweeperDimensionReply Reply;
+    TestTrue(TEXT("Grammar's shape"), FMinesweeperDimensionReply::Parse(TEXT("{\"rows\":16,\"columns\":30,\"mines\":99}"), Reply));
+    TestEqual(TEXT("Rows"), Reply.Rows, 16);
+    TestEqual(TEXT("Columns"), Reply.Columns, 30);
+    TestEqual(TEXT("Mines"), Reply.Mines, int64(99));
+
+    // A cached reply from before the grammar may be spaced and ordered differently.
+    TestTrue(TEXT("Whitespace and key order"), FMinesweeperDimensionReply::Parse(TEXT(" { \"mines\": 10, \"columns\": 9, \"rows\": 8 } "), Reply));
+    TestEqual(TEXT("Rows read by name"), Reply.Rows, 8);
+
+    TestTrue(TEXT("Largest counts"), ParseDimensions(TEXT("{\"rows\":99999,\"columns\":99999,\"mines\":99999}")));
+    TestTrue(TEXT("Smallest counts"), ParseDimensions(TEXT("{\"rows\":1,\"columns\":1,\"mines\":1}")));
+
+    TestFalse(TEXT("Missing mines"), ParseDimensions(TEXT("{\"rows\":16,\"columns\":30}")));
+    TestFalse(TEXT("Old mine_count key"), ParseDimensions(TEXT("{\"rows\":16,\"columns\":30,\"mine_count\":99}")));
+    TestFalse(TEXT("Extra field"), ParseDimensions(TEXT("{\"rows\":16,\"columns\":30,\"mines\":99,\"difficulty\":3}")));
+    TestFalse(TEXT("No rows"), ParseDimensions(TEXT("{\"rows\":0,\"columns\":30,\"mines\":99}")));
+    TestFalse(TEXT("No mines"), ParseDimensions(TEXT("{\"rows\":16,\"columns\":30,\"mines\":0}")));
+    TestFalse(TEXT("Six digit columns"), ParseDimensions(TEXT("{\"rows\":16,\"columns\":100000,\"mines\":99}")));
+    TestFalse(TEXT("Six digit mines"), ParseDimensions(TEXT("{\"rows\":16,\"columns\":30,\"mines\":100000}")));
+    TestFalse(TEXT("Negative"), ParseDimensions(TEXT("{\"rows\":-16,\"columns\":30,\"mines\":99}")));
+    TestFalse(TEXT("Fraction"), ParseDimensions(TEXT("{\"rows\":16.5,\"columns\":30,\"mines\":99}")));
+    TestFalse(TEXT("Prose"), ParseDimensions(TEXT("Sure! {\"rows\":16,\"columns\":30,\"mines\":99}")));
+    TestFalse(TEXT("Cut short"), ParseDimensions(TEXT("{\"rows\":16,\"columns\":30,\"mi")));
+    TestFalse(TEXT("Array"), ParseDimensions(TEXT("[16,30,99]")));
+
+    // Worker results carry the reply in "text".
+    TSharedPtr<FJsonObject> Result = MakeShared<FJsonObject>();
+    Result->SetStringField(TEXT("text"), TEXT("{\"rows\":9,\"columns\":9,\"mines\":10}"));
+    TestTrue(TEXT("Worker result"), FMinesweeperDimensionReply::ParseResult(Result, Reply));
+    TestEqual(TEXT("Mines from the result"), Reply.Mines, int64(10));
+    TestFalse(TEXT("No result"), FMinesweeperDimensionReply::ParseResult(nullptr, Reply));
+    Result->RemoveField(TEXT("text"));
+    TestFalse(TEXT("Result without text"), FMinesweeperDimensionReply::ParseResult(Result, Reply));
+    return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FMinesweeperModelRepliesMoveTest, "MinesweeperMind.ModelReplies.Move",
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool FMinesweeperModelRepliesMoveTest::RunTest(const FString& Parameters)
+{
+    // Every action reads back from the JSON the transcripts quote it as.
+    static const EMinesweeperMoveType Types[] = { EMinesweeperMoveType::Reveal, EMinesweeperMoveType::Flag, EMinesweeperMoveType::Chord };
+    for (const EMinesweeperMoveType Type : Types)
+    {
+        const FMinesweeperMove Move(FIntPoint(3, 4), Type);
+        const FString Json = FMinesweeperMoveReply::ToJson(Move);
+        FMinesweeperMoveReply Reply;
+        const bool bParsed = FMinesweeperMoveReply::Parse(Json, Reply);
+        TestTrue(FString::Printf(TEXT("%s parses"), *Json), bParsed && Reply.Move.Cell == Move.Cell && Reply.Move.Type == Type);
+    }
+    TestEqual(TEXT("Grammar's shape"), FMinesweeperMoveReply::ToJson(FMinesweeperMove(FIntPoint(3, 4), EMinesweeperMoveType::Reveal)),
+        FString(TEXT("{\"action\":\"reveal\",\"row\":3,\"column\":4}")));
+
+    TestTrue(TEXT("Corner"), ParseMove(TEXT("{\"action\":\"flag\",\"row\":0,\"column\":0}")));
+    TestTrue(TEXT("Largest indices"), ParseMove(TEXT("{\"action\":\"flag\",\"row\":9999,\"column\":9999}")));
+
+    TestFalse(TEXT("Missing column"), ParseMove(TEXT("{\"action\":\"reveal\",\"row\":3}")));
+    TestFalse(TEXT("Missing action"), ParseMove(TEXT("{\"row\":3,\"column\":4}")));
+    TestFalse(TEXT("Extra field"), ParseMove(TEXT("{\"action\":\"reveal\",\"row\":3,\"column\":4,\"reason\":\"safe\"}")));
+    TestFalse(TEXT("Unknown action"), ParseMove(TEXT("{\"action\":\"open\",\"row\":3,\"column\":4}")));
+    TestFalse(TEXT("Actions are lower case"), ParseMove(TEXT("{\"action\":\"Reveal\",\"row\":3,\"column\":4}")));
+    TestFalse(TEXT("Five digit row"), ParseMove(TEXT("{\"action\":\"reveal\",\"row\":10000,\"column\":4}")));
+    TestFalse(TEXT("Five digit column"), ParseMove(TEXT("{\"action\":\"reveal\",\"row\":3,\"column\":10000}")));
+    TestFalse(TEXT("Negative"), ParseMove(TEXT("{\"action\":\"reveal\",\"row\":-1,\"column\":4}")));
+    TestFalse(TEXT("Fraction"), ParseMove(TEXT("{\"action\":\"reveal\",\"row\":3,\"column\":4.5}")));
+    TestFalse(TEXT("Prose"), ParseMove(TEXT("I will reveal 3,4")));
+
+    FMinesweeperMoveReply Reply;
+    TSharedPtr<FJsonObject> Result = MakeShared<FJsonObject>();
+    Result->SetStringField(TEXT("text"), TEXT("{\"action\":\"chord\",\"row\":7,\"column\":2}"));
+    TestTrue(TEXT("Worker result"), FMinesweeperMoveReply::ParseResult(Result, Reply));
+    TestTrue(TEXT("Move from the result"), Reply.Move.Cell == FIntPoint(7, 2) && Reply.Move.Type == EMinesweeperMoveType::Chord);
+    TestFalse(TEXT("No result"), FMinesweeperMoveReply::ParseResult(nullptr, Reply));
+    return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FMinesweeperModelRepliesGrammarBoundsTest, "MinesweeperMind.ModelReplies.GrammarBounds",
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool FMinesweeperModelRepliesGrammarBoundsTest::RunTest(const FString& Parameters)
+{
+    // The parsers accept exactly the numbers the worker's grammars can write, no reply is thrown away that the model
+    // was allowed to give.
+    const TSharedPtr<IPlugin> Plugin = IPluginManager::Get().FindPlugin(TEXT("MinesweeperMind"));
+    const FString Path = Plugin.IsValid() ? Plugin->GetContentDir() / TEXT("Scripts/reply_grammars.py") : FString();
+    FString Grammars;
+    if (!TestTrue(FString::Printf(TEXT("Grammars read from %s"), *Path), FFileHelper::LoadFileToString(Grammars, *Path)))
+    {
+        return false;
+    }
+
+    TestEqual(TEXT("Dimension counts"), GetGrammarMax(Grammars, TEXT("count")), int64(FMinesweeperDimensionReply::MaxCount));
+    TestEqual(TEXT("Move indices"), GetGrammarMax(Grammars, TEXT("index")), int64(FMinesweeperMoveReply::MaxIndex));
+    return true;
+}
+
+#endif
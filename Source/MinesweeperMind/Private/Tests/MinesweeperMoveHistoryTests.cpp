@@ -0,0 +1,199 @@
+#include "Core/MinesweeperMoveHistory.h"
+#include "Core/MinesweeperBoard.h"
+#include "Core/MinesweeperSnapshot.h"
+#include "HAL/FileManager.h"
+#include "Math/RandomStream.h"
+#include "Misc/AutomationTest.h"
+#include "Misc/Paths.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+namespace
+{
+    /** Every cell byte followed by the game state, enough to tell any two positions apart. */
+    TArray<uint8> CaptureState(const IMinesweeperBoard& Board)
+    {
+        TArray<uint8> State;
+        for (int32 Row = 0; Row < Board.GetNumRows(); ++Row)
+        {
+            for (int32 Column = 0; Column < Board.GetNumColumns(); ++Column)
+            {
+                State.Add(Board.GetCell(Row, Column));
+            }
+        }
+        const int64 SafeCellsRevealed = Board.GetSafeCellsRevealed();
+        for (int32 Shift = 0; Shift < 64; Shift += 8)
+        {
+            State.Add(static_cast<uint8>(SafeCellsRevealed >> Shift));
+        }
+        State.Add(Board.IsGameOver() ? 1 : 0);
+        State.Add(Board.IsGameWon() ? 1 : 0);
+        return State;
+    }
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FMinesweeperMoveHistoryUndoRedoTest, "MinesweeperMind.MoveHistory.UndoRedo",
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool FMinesweeperMoveHistoryUndoRedoTest::RunTest(const FString& Parameters)
+{
+    // Random applies, undos and redos. After each one the board must hold exactly the bytes it held the last time
+    // that many steps were applied.
+    int32 NumMismatches = 0;
+    int32 NumUndos = 0;
+    int32 NumRedos = 0;
+    for (int32 Game = 0; Game < 200; ++Game)
+    {
+        FRandomStream Random(Game);
+        const int32 NumRows = 5 + Random.RandHelper(16);
+        const int32 NumColumns = 5 + Random.RandHelper(16);
+
+        FMinesweeperBoard Board;
+        Board.Initialize(NumRows, NumColumns, Random.RandHelper(NumRows * NumColumns / 4 + 1));
+        Board.PlaceMines(Game, FIntPoint(NumRows / 2, NumColumns / 2));
+        FMinesweeperMoveHistory History;
+        History.Reset(Board);
+
+        TArray<TArray<uint8>> StatesByNumApplied;
+        StatesByNumApplied.Add(CaptureState(Board));
+        TArray<FMinesweeperMove> Moves;
+        for (int32 Operation = 0; Operation < 60 && NumMismatches == 0; ++Operation)
+        {
+            switch (Random.RandHelper(5))
+            {
+            case 0:
+                NumUndos += History.Undo() ? 1 : 0;
+                break;
+            case 1:
+                NumRedos += History.Redo() ? 1 : 0;
+                break;
+            default:
+                {
+                    Moves.Reset();
+                    const int32 NumMoves = 1 + Random.RandHelper(5);
+                    for (int32 MoveIndex = 0; MoveIndex < NumMoves; ++MoveIndex)
+                    {
+                        FMinesweeperMove Move(FIntPoint(Random.RandHelper(NumRows), Random.RandHelper(NumColumns)),
+                            static_cast<EMinesweeperMoveType>(Random.RandHelper(3)));
+                        if (Move.Type == EMinesweeperMoveType::Reveal && Board.IsMine(Move.Cell.X, Move.Cell.Y) && Random.RandHelper(4) != 0)
+                        {
+                            Move.Type = EMinesweeperMoveType::Flag;
+                        }
+                        Moves.Add(Move);
+                    }
+
+                    const int32 NumAppliedBefore = History.GetNumApplied();
+                    History.Apply(Moves);
+                    if (History.GetNumApplied() != NumAppliedBefore)
+                    {
+                        TestFalse(TEXT("A new step drops the redo steps"), History.CanRedo());
+                        StatesByNumApplied.SetNum(NumAppliedBefore + 1);
+                        StatesByNumApplied.Add(CaptureState(Board));
+                    }
+                }
+                break;
+            }
+            NumMismatches += CaptureState(Board) == StatesByNumApplied[History.GetNumApplied()] ? 0 : 1;
+        }
+
+        // Back to the start, the mines were placed before the first step so every byte matches.
+        while (History.Undo())
+        {
+        }
+        NumMismatches += CaptureState(Board) == StatesByNumApplied[0] ? 0 : 1;
+        TestEqual(TEXT("Nothing revealed after undoing everything"), Board.GetSafeCellsRevealed(), int64(0));
+    }
+    TestEqual(TEXT("Positions that differ from the last time they were reached"), NumMismatches, 0);
+    TestTrue(FString::Printf(TEXT("Undos and redos were exercised (%d, %d)"), NumUndos, NumRedos), NumUndos > 0 && NumRedos > 0);
+    return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FMinesweeperMoveHistoryFloodTest, "MinesweeperMind.MoveHistory.Flood",
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool FMinesweeperMoveHistoryFloodTest::RunTest(const FString& Parameters)
+{
+    // 5x5 with mines in two opposite corners, one reveal floods the whole board and wins.
+    const uint8 MineBits[] = { 0x01, 0x00, 0x00, 0x01 };
+    FMinesweeperBoard Board;
+    Board.Initialize(5, 5, 2);
+    Board.PlaceMinesFromLayout(MineBits, 0, FIntPoint(2, 2));
+    FMinesweeperMoveHistory History;
+    History.Reset(Board);
+
+    History.Apply(FMinesweeperMove(FIntPoint(1, 3), EMinesweeperMoveType::Flag));
+    const TArray<uint8> Flagged = CaptureState(Board);
+    TestEqual(TEXT("Flag step reports its cell"), History.GetLastChanges().Flagged.Num(), 1);
+
+    History.Apply(FMinesweeperMove(FIntPoint(2, 2), EMinesweeperMoveType::Reveal));
+    const TArray<uint8> Won = CaptureState(Board);
+    TestTrue(TEXT("Flood won"), Board.IsGameWon());
+
+    // Undoing the flood hides exactly what it opened and puts the flag it cleared back.
+    TestTrue(TEXT("Undo the flood"), History.Undo());
+    TestEqual(TEXT("Undo reports the cells it hid"), History.GetLastChanges().Revealed.Num(), 23);
+    TestTrue(TEXT("Flag restored"), Board.IsFlagged(1, 3));
+    TestFalse(TEXT("Game no longer over"), Board.IsGameOver());
+    TestTrue(TEXT("Bytes match before the flood"), CaptureState(Board) == Flagged);
+
+    TestTrue(TEXT("Redo the flood"), History.Redo());
+    TestTrue(TEXT("Bytes match after the redo"), CaptureState(Board) == Won);
+    TestFalse(TEXT("Nothing left to redo"), History.Redo());
+
+    // A step that changes nothing isn't recorded.
+    History.Undo();
+    History.Apply(FMinesweeperMove(FIntPoint(0, 1), EMinesweeperMoveType::Chord));
+    TestTrue(TEXT("A no-op keeps the redo step"), History.CanRedo());
+    TestEqual(TEXT("Steps"), History.GetNumSteps(), 2);
+    return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FMinesweeperMoveHistorySnapshotTest, "MinesweeperMind.MoveHistory.Snapshot",
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool FMinesweeperMoveHistorySnapshotTest::RunTest(const FString& Parameters)
+{
+    const FString Path = FPaths::ConvertRelativePathToFull(FPaths::AutomationTransientDir() / TEXT("MinesweeperMind/MoveHistory.msgame"));
+
+    FMinesweeperBoard Board;
+    Board.Initialize(30, 40, 180);
+    Board.DeferMinePlacement(11);
+    FMinesweeperMoveHistory History;
+    History.Reset(Board);
+
+    FRandomStream Random(11);
+    History.Apply(FMinesweeperMove(FIntPoint(15, 20), EMinesweeperMoveType::Reveal));
+    for (int32 Step = 0; Step < 40 && !Board.IsGameOver(); ++Step)
+    {
+        const FIntPoint Cell(Random.RandHelper(30), Random.RandHelper(40));
+        History.Apply(FMinesweeperMove(Cell, Board.IsMine(Cell.X, Cell.Y) ? EMinesweeperMoveType::Flag : EMinesweeperMoveType::Reveal));
+    }
+    for (int32 Step = 0; Step < 10; ++Step)
+    {
+        History.Undo();
+    }
+
+    // The saved position is the one after the undos, replayed from the file byte for byte.
+    for (const bool bWithMineLayout : { false, true })
+    {
+        if (!TestTrue(TEXT("Snapshot saved"), History.SaveSnapshot(Path, bWithMineLayout)))
+        {
+            return false;
+        }
+        FString Error;
+        const TUniquePtr<FMinesweeperSnapshotFile> File = FMinesweeperSnapshotFile::Open(Path, Error);
+        if (!TestTrue(FString::Printf(TEXT("Snapshot opened (%s)"), *Error), File.IsValid()))
+        {
+            return false;
+        }
+        TestEqual(TEXT("Snapshot moves"), File->GetView().GetNumMoves(), History.GetAppliedMoves().Num());
+        const TUniquePtr<IMinesweeperBoard> Replayed = File->GetView().Replay();
+        TestTrue(FString::Printf(TEXT("Replay matches the board (%s layout)"), bWithMineLayout ? TEXT("embedded") : TEXT("seeded")),
+            CaptureState(*Replayed) == CaptureState(Board));
+    }
+
+    IFileManager::Get().Delete(*Path);
+    return true;
+}
+
+#endif
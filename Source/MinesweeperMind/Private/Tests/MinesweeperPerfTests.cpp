@@ -0,0 +1,67 @@
+#include "MinesweeperPerfSuite.h"
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+/**
+ * One test per board micro-benchmark, failing when it is slower than the checked-in baseline by more than
+ * MinesweeperMind.Perf.TolerancePercent, or when the baseline is missing. Timings are only comparable on the machine
+ * that measured the baseline, anywhere else the test warns instead of comparing.
+ */
+IMPLEMENT_COMPLEX_AUTOMATION_TEST(FMinesweeperPerfTest, "MinesweeperMind.Perf",
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::PerfFilter)
+
+void FMinesweeperPerfTest::GetTests(TArray<FString>& OutBeautifiedNames, TArray<FString>& OutTestCommands) const
+{
+    for (const FString& Name : FMinesweeperPerfSuite::GetNames())
+    {
+        OutBeautifiedNames.Add(Name);
+        OutTestCommands.Add(Name);
+    }
+}
+
+bool FMinesweeperPerfTest::RunTest(const FString& Parameters)
+{
+    FMinesweeperPerfResult Result;
+    if (!FMinesweeperPerfSuite::Run(Parameters, FMinesweeperPerfSuite::DefaultNumRepeats, Result))
+    {
+        AddError(FString::Printf(TEXT("No benchmark named %s"), *Parameters));
+        return false;
+    }
+
+    const FString BaselinePath = FMinesweeperPerfSuite::GetDefaultBaselinePath();
+    TMap<FString, double> Baseline;
+    FString Machine;
+    if (!FMinesweeperPerfSuite::LoadBaseline(BaselinePath, Baseline, &Machine))
+    {
+        AddError(FString::Printf(TEXT("%s: %.2f us, no baseline at %s. Run the MinesweeperMindPerf commandlet with -UpdateBaseline on the reference machine."),
+            *Result.Name, Result.Microseconds, *BaselinePath));
+        return false;
+    }
+
+    const double* BaselineMicroseconds = Baseline.Find(Result.Name);
+    if (!BaselineMicroseconds)
+    {
+        AddError(FString::Printf(TEXT("%s: %.2f us, missing from %s. Update the baseline on the reference machine."),
+            *Result.Name, Result.Microseconds, *BaselinePath));
+        return false;
+    }
+
+    if (Machine != FMinesweeperPerfSuite::GetMachineName())
+    {
+        AddWarning(FString::Printf(TEXT("%s: %.2f us, not compared against the %.2f us baseline measured on '%s', this is '%s'."),
+            *Result.Name, Result.Microseconds, *BaselineMicroseconds, *Machine, *FMinesweeperPerfSuite::GetMachineName()));
+        return true;
+    }
+
+    const double TolerancePercent = FMinesweeperPerfSuite::GetTolerancePercent();
+    AddInfo(FString::Printf(TEXT("%s: %.2f us, baseline %.2f us"), *Result.Name, Result.Microseconds, *BaselineMicroseconds));
+    if (FMinesweeperPerfSuite::IsRegression(Result.Microseconds, *BaselineMicroseconds, TolerancePercent))
+    {
+        AddError(FString::Printf(TEXT("%s regressed by more than %.0f%%: %.2f us against %.2f us"),
+            *Result.Name, TolerancePercent, Result.Microseconds, *BaselineMicroseconds));
+    }
+    return true;
+}
+
+#endif
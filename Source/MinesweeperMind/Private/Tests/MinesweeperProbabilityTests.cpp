@@ -0,0 +1,132 @@
+#include "Core/MinesweeperProbability.h"
+#include "Core/MinesweeperBoard.h"
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+namespace
+{
+    /** Probabilities are floats computed through log-space binomials, exact to well within this. */
+    constexpr float ProbabilityTolerance = 1.e-5f;
+
+    /** Reveals each cell, which must be a number so nothing floods. */
+    void RevealNumbers(FMinesweeperBoard& Board, TArrayView<const FIntPoint> Cells)
+    {
+        TArray<FIntPoint> Revealed;
+        for (const FIntPoint& Cell : Cells)
+        {
+            Board.Reveal(Cell.X, Cell.Y, Revealed);
+        }
+    }
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FMinesweeperProbabilityIsolatedOneTest, "MinesweeperMind.Probability.IsolatedOne",
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool FMinesweeperProbabilityIsolatedOneTest::RunTest(const FString& Parameters)
+{
+    // 5x5 with 3 mines and only the corner open, showing a 1:
+    //
+    //   1 . . . .
+    //   . * . . .
+    //   . . . . .
+    //   . . . . *
+    //   . . . . *
+    //
+    // One of the three frontier cells holds a mine in every layout, C(21, 2) ways to put the other two in the interior
+    // each time. So each frontier cell is 1/3 and each interior cell 2/21.
+    const uint8 MineBits[] = { 0x40, 0x00, 0x08, 0x01 };
+    FMinesweeperBoard Board;
+    Board.Initialize(5, 5, 3);
+    Board.PlaceMinesFromLayout(MineBits, 0, FIntPoint(0, 0));
+    const FIntPoint Opened[] = { FIntPoint(0, 0) };
+    RevealNumbers(Board, Opened);
+    TestEqual(TEXT("Corner shows a 1"), Board.GetAdjacentMines(0, 0), 1);
+
+    const TSharedRef<const FMinesweeperProbabilityResult> Result = FMinesweeperProbability::Calculate(Board);
+    TestTrue(TEXT("Enumerated exactly"), Result->IsExact());
+    TestEqual(TEXT("Components"), Result->GetNumComponents(), 1);
+    TestEqual(TEXT("Frontier cells"), Result->GetCellProbabilities().Num(), 3);
+    TestEqual(TEXT("Right of the 1"), Result->GetMineProbability(0, 1), 1.f / 3.f, ProbabilityTolerance);
+    TestEqual(TEXT("Below the 1"), Result->GetMineProbability(1, 0), 1.f / 3.f, ProbabilityTolerance);
+    TestEqual(TEXT("Diagonal to the 1"), Result->GetMineProbability(1, 1), 1.f / 3.f, ProbabilityTolerance);
+    TestEqual(TEXT("Interior"), Result->GetInteriorProbability(), 2.f / 21.f, ProbabilityTolerance);
+    TestEqual(TEXT("Far corner is interior"), Result->GetMineProbability(4, 4), 2.f / 21.f, ProbabilityTolerance);
+
+    // The interior is safer than the frontier, the safest cell is its first hidden cell.
+    TestEqual(TEXT("Safest cell"), Result->GetSafestCell(), FIntPoint(0, 2));
+    return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FMinesweeperProbabilityOneTwoOneTest, "MinesweeperMind.Probability.OneTwoOne",
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool FMinesweeperProbabilityOneTwoOneTest::RunTest(const FString& Parameters)
+{
+    // 3x3 with the bottom row open against a hidden wall, and a third mine somewhere in the top row:
+    //
+    //   . . *
+    //   * . *
+    //   1 2 1
+    //
+    // a + b = 1, a + b + c = 2 and b + c = 1 leave a = c = 1 and b = 0. The top row never touches a number, its one
+    // leftover mine is anywhere in it.
+    const uint8 MineBits[] = { 0x2C, 0x00 };
+    FMinesweeperBoard Board;
+    Board.Initialize(3, 3, 0);
+    Board.PlaceMinesFromLayout(MineBits, 0, FIntPoint(2, 1));
+    const FIntPoint BottomRow[] = { FIntPoint(2, 0), FIntPoint(2, 1), FIntPoint(2, 2) };
+    RevealNumbers(Board, BottomRow);
+    TestEqual(TEXT("Mines"), Board.GetNumMines(), int64(3));
+    TestEqual(TEXT("Middle shows a 2"), Board.GetAdjacentMines(2, 1), 2);
+
+    const TSharedRef<const FMinesweeperProbabilityResult> Result = FMinesweeperProbability::Calculate(Board);
+    TestTrue(TEXT("Enumerated exactly"), Result->IsExact());
+    TestEqual(TEXT("Above the left 1"), Result->GetMineProbability(1, 0), 1.f, ProbabilityTolerance);
+    TestEqual(TEXT("Above the 2"), Result->GetMineProbability(1, 1), 0.f, ProbabilityTolerance);
+    TestEqual(TEXT("Above the right 1"), Result->GetMineProbability(1, 2), 1.f, ProbabilityTolerance);
+    TestEqual(TEXT("Top row"), Result->GetInteriorProbability(), 1.f / 3.f, ProbabilityTolerance);
+    TestEqual(TEXT("Safest cell is the one above the 2"), Result->GetSafestCell(), FIntPoint(1, 1));
+    return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FMinesweeperProbabilityInteriorDensityTest, "MinesweeperMind.Probability.InteriorDensity",
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool FMinesweeperProbabilityInteriorDensityTest::RunTest(const FString& Parameters)
+{
+    // One row of 8 with 2 mines, two 1s sharing a neighbour:
+    //
+    //   a 1 b 1 c . * .
+    //
+    // Either b alone is the mine of both 1s, leaving one mine for the 3 interior cells (3 ways), or a and c are,
+    // leaving none (1 way). Weighted by the interior, b is 3/4, a and c 1/4 each, and the interior holds 3/4 of a
+    // mine over 3 cells. Counting the frontier layouts alone would wrongly give b 1/2.
+    const uint8 MineBits[] = { 0x44 };
+    FMinesweeperBoard Board;
+    Board.Initialize(1, 8, 2);
+    Board.PlaceMinesFromLayout(MineBits, 0, FIntPoint(0, 1));
+    const FIntPoint Ones[] = { FIntPoint(0, 1), FIntPoint(0, 3) };
+    RevealNumbers(Board, Ones);
+
+    const TSharedRef<const FMinesweeperProbabilityResult> Result = FMinesweeperProbability::Calculate(Board);
+    TestTrue(TEXT("Enumerated exactly"), Result->IsExact());
+    TestEqual(TEXT("Shared neighbour"), Result->GetMineProbability(0, 2), 3.f / 4.f, ProbabilityTolerance);
+    TestEqual(TEXT("Left end"), Result->GetMineProbability(0, 0), 1.f / 4.f, ProbabilityTolerance);
+    TestEqual(TEXT("Right of the second 1"), Result->GetMineProbability(0, 4), 1.f / 4.f, ProbabilityTolerance);
+    TestEqual(TEXT("Interior"), Result->GetInteriorProbability(), 1.f / 4.f, ProbabilityTolerance);
+
+    // A third mine leaves the interior two or one, 3 ways each, and everything evens out at 1/2.
+    const uint8 MoreMineBits[] = { 0xC4 };
+    Board.Initialize(1, 8, 3);
+    Board.PlaceMinesFromLayout(MoreMineBits, 0, FIntPoint(0, 1));
+    RevealNumbers(Board, Ones);
+    const TSharedRef<const FMinesweeperProbabilityResult> Denser = FMinesweeperProbability::Calculate(Board);
+    TestEqual(TEXT("Mines"), Board.GetNumMines(), int64(3));
+    TestEqual(TEXT("Denser shared neighbour"), Denser->GetMineProbability(0, 2), 1.f / 2.f, ProbabilityTolerance);
+    TestEqual(TEXT("Denser left end"), Denser->GetMineProbability(0, 0), 1.f / 2.f, ProbabilityTolerance);
+    TestEqual(TEXT("Denser interior"), Denser->GetInteriorProbability(), 1.f / 2.f, ProbabilityTolerance);
+    return true;
+}
+
+#endif
@@ -0,0 +1,174 @@
+#include "Core/MinesweeperPromptEncoder.h"
+#include "Core/MinesweeperBoard.h"
+#include "Core/MinesweeperMoveHistory.h"
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+namespace
+{
+    /** What every prompt ends with, the opening of the agent's turn. */
+    const TCHAR* const AssistantTurn = TEXT("<|assistant|>\n");
+
+    /**
+     * 4x7 with two mines in the bottom row. A reveal in the zeros opens everything but the mines and the cell walled
+     * off in the corner, so the game goes on:
+     *
+     *   . . . . . . .
+     *   . . . . . . .
+     *   1 1 . . 1 1 1
+     *   * 1 . . 1 * 1
+     */
+    void MakeCornerMinesBoard(FMinesweeperBoard& Board)
+    {
+        const uint8 MineBits[] = { 0x00, 0x00, 0x20, 0x04 };
+        Board.Initialize(4, 7, 2);
+        Board.PlaceMinesFromLayout(MineBits, 0, FIntPoint(0, 0));
+    }
+
+    /** The user turn of the last move, the diff or "no change". */
+    FString GetLastUserTurn(const FMinesweeperPromptEncoder& Encoder)
+    {
+        const FString Prompt = Encoder.GetPrompt();
+        const int32 Start = Prompt.Find(TEXT("<|user|>\n"), ESearchCase::CaseSensitive, ESearchDir::FromEnd) + 9;
+        const int32 End = Prompt.Find(TEXT("</s>"), ESearchCase::CaseSensitive, ESearchDir::FromStart, Start);
+        return Prompt.Mid(Start, End - Start);
+    }
+
+    /** Applies Move through the history and tells the encoder, as the simulation's model policy does. */
+    void ApplyMove(FMinesweeperMoveHistory& History, const IMinesweeperBoard& Board, FMinesweeperPromptEncoder& Encoder, const FMinesweeperMove& Move)
+    {
+        const FMinesweeperChangeSet& Changes = History.Apply(Move);
+        Encoder.AddMove(Board, Move, Changes.Revealed);
+    }
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FMinesweeperPromptEncoderFrontierTest, "MinesweeperMind.PromptEncoder.Frontier",
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool FMinesweeperPromptEncoderFrontierTest::RunTest(const FString& Parameters)
+{
+    FMinesweeperBoard Board;
+    MakeCornerMinesBoard(Board);
+    FMinesweeperPromptEncoder Encoder;
+    Encoder.BeginGame(Board);
+    TestTrue(TEXT("Nothing revealed yet"), Encoder.GetPrompt().Contains(TEXT("<|user|>\nFrontier: none, nothing is revealed yet</s>\n")));
+
+    // The zero in the top corner floods the board. Runs break where the zeros reach the bottom row.
+    TArray<FIntPoint> Revealed;
+    Board.Reveal(0, 0, Revealed);
+    TestEqual(TEXT("Flood"), Revealed.Num(), 25);
+    Encoder.BeginGame(Board);
+    const FString Prompt = Encoder.GetPrompt();
+    TestTrue(FString::Printf(TEXT("Row runs in\n%s"), *Prompt), Prompt.Contains(TEXT("<|user|>\nFrontier:\n2: 0=11 4=111\n3: 1=1 4=1</s>\n")));
+    TestTrue(TEXT("Open for the agent's answer"), Prompt.EndsWith(TEXT("</s>\n<|assistant|>\n")));
+
+    // Flagging the left mine settles the three numbers around it, the flag takes their place in the run.
+    Board.ToggleFlag(3, 0);
+    Encoder.BeginGame(Board);
+    TestTrue(TEXT("Flag in the run"), Encoder.GetPrompt().Contains(TEXT("Frontier:\n2: 4=111\n3: 0=F 4=1</s>\n")));
+
+    // Stats of a fresh transcript: everything it holds was appended and sent once.
+    const FMinesweeperPromptStats& Stats = Encoder.GetStats();
+    TestEqual(TEXT("Moves"), Stats.NumMoves, 0);
+    TestEqual(TEXT("Prompt tokens"), Stats.PromptTokens, FMinesweeperPromptEncoder::EstimateTokens(Encoder.GetPrompt()));
+    TestEqual(TEXT("Sent tokens"), Stats.SentTokens, int64(Stats.PromptTokens));
+    return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FMinesweeperPromptEncoderDiffTest, "MinesweeperMind.PromptEncoder.Diff",
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool FMinesweeperPromptEncoderDiffTest::RunTest(const FString& Parameters)
+{
+    FMinesweeperBoard Board;
+    MakeCornerMinesBoard(Board);
+    FMinesweeperMoveHistory History;
+    History.Reset(Board);
+
+    // Start from the lone 1 above the left mine.
+    History.Apply(FMinesweeperMove(FIntPoint(2, 0), EMinesweeperMoveType::Reveal));
+    FMinesweeperPromptEncoder Encoder;
+    Encoder.BeginGame(Board);
+    TestTrue(TEXT("Baseline"), Encoder.GetPrompt().Contains(TEXT("Frontier:\n2: 0=1</s>\n")));
+
+    // The flood adds every other number, the 1 already described isn't repeated.
+    const FString BeforeFlood = Encoder.GetPrompt();
+    const FMinesweeperMove Flood(FIntPoint(0, 3), EMinesweeperMoveType::Reveal);
+    ApplyMove(History, Board, Encoder, Flood);
+    TestEqual(TEXT("Reveal diff"), GetLastUserTurn(Encoder), FString(TEXT("+2,1=1 +2,4=1 +2,5=1 +2,6=1 +3,1=1 +3,4=1")));
+    TestTrue(TEXT("Answer quoted as the grammar's JSON"),
+        Encoder.GetPrompt().Contains(TEXT("<|assistant|>\n{\"action\":\"reveal\",\"row\":0,\"column\":3}</s>\n<|user|>\n+2,1=1")));
+    TestTrue(TEXT("Appended to the previous prompt"), Encoder.GetPrompt().StartsWith(BeforeFlood.LeftChop(FCString::Strlen(AssistantTurn))));
+
+    // The flag removes the numbers it settles and adds itself.
+    ApplyMove(History, Board, Encoder, FMinesweeperMove(FIntPoint(3, 0), EMinesweeperMoveType::Flag));
+    TestEqual(TEXT("Flag diff"), GetLastUserTurn(Encoder), FString(TEXT("-2,0 -2,1 +3,0=F -3,1")));
+
+    // Undoing the flag and then the flood puts the frontier back, reported with the cells each undo changed.
+    TestTrue(TEXT("Undo the flag"), History.Undo());
+    Encoder.AddMove(Board, FMinesweeperMove(FIntPoint(3, 0), EMinesweeperMoveType::Flag), History.GetLastChanges().Revealed);
+    TestEqual(TEXT("Unflag diff"), GetLastUserTurn(Encoder), FString(TEXT("+2,0=1 +2,1=1 -3,0 +3,1=1")));
+    TestTrue(TEXT("Undo the flood"), History.Undo());
+    Encoder.AddMove(Board, Flood, History.GetLastChanges().Revealed);
+    TestEqual(TEXT("Undo diff"), GetLastUserTurn(Encoder), FString(TEXT("-2,1 -2,4 -2,5 -2,6 -3,1 -3,4")));
+
+    // A reveal that doesn't touch the frontier still gets an answer.
+    ApplyMove(History, Board, Encoder, FMinesweeperMove(FIntPoint(2, 0), EMinesweeperMoveType::Reveal));
+    TestEqual(TEXT("No change"), GetLastUserTurn(Encoder), FString(TEXT("no change")));
+
+    const FMinesweeperPromptStats& Stats = Encoder.GetStats();
+    TestEqual(TEXT("Moves"), Stats.NumMoves, 5);
+    TestEqual(TEXT("No rebaseline within the default budget"), Stats.NumRebaselines, 0);
+    TestEqual(TEXT("Prompt tokens"), Stats.PromptTokens, FMinesweeperPromptEncoder::EstimateTokens(Encoder.GetPrompt()));
+    return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FMinesweeperPromptEncoderRebaselineTest, "MinesweeperMind.PromptEncoder.Rebaseline",
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool FMinesweeperPromptEncoderRebaselineTest::RunTest(const FString& Parameters)
+{
+    FMinesweeperBoard Board;
+    MakeCornerMinesBoard(Board);
+    FMinesweeperMoveHistory History;
+    History.Reset(Board);
+    History.Apply(FMinesweeperMove(FIntPoint(0, 0), EMinesweeperMoveType::Reveal));
+
+    // Room for the opening transcript and one flag toggle.
+    FMinesweeperPromptEncoder Probe;
+    Probe.BeginGame(Board);
+    const int32 BaselineTokens = Probe.GetStats().PromptTokens;
+    const FMinesweeperMove Flag(FIntPoint(3, 5), EMinesweeperMoveType::Flag);
+    ApplyMove(History, Board, Probe, Flag);
+    const int32 TokenBudget = Probe.GetStats().PromptTokens;
+    TestTrue(FString::Printf(TEXT("The toggle costs tokens (%d, %d)"), BaselineTokens, TokenBudget), TokenBudget > BaselineTokens);
+    History.Undo();
+
+    FMinesweeperPromptEncoder Encoder(TokenBudget);
+    Encoder.BeginGame(Board);
+
+    // The first toggle fits, the second would pass the budget and starts the transcript over.
+    ApplyMove(History, Board, Encoder, Flag);
+    TestEqual(TEXT("First toggle appended"), Encoder.GetStats().NumRebaselines, 0);
+    const FString BeforeRebaseline = Encoder.GetPrompt();
+    ApplyMove(History, Board, Encoder, Flag);
+    TestEqual(TEXT("Second toggle rebaselines"), Encoder.GetStats().NumRebaselines, 1);
+    TestFalse(TEXT("The old transcript is dropped"), Encoder.GetPrompt().StartsWith(BeforeRebaseline.LeftChop(FCString::Strlen(AssistantTurn))));
+
+    // Started over, the prompt is exactly the one a new game on this board opens with.
+    FMinesweeperPromptEncoder Fresh;
+    Fresh.BeginGame(Board);
+    TestEqual(TEXT("Rebaselined prompt"), Encoder.GetPrompt(), Fresh.GetPrompt());
+    TestTrue(TEXT("Current frontier"), Encoder.GetPrompt().Contains(TEXT("Frontier:\n2: 0=11 4=111\n3: 1=1 4=1</s>\n")));
+    TestTrue(TEXT("Within the budget"), Encoder.GetStats().PromptTokens <= TokenBudget);
+
+    // Appending resumes from the new transcript.
+    ApplyMove(History, Board, Encoder, Flag);
+    TestEqual(TEXT("Appended after the rebaseline"), Encoder.GetStats().NumRebaselines, 1);
+    TestEqual(TEXT("Diff against the rebaselined frontier"), GetLastUserTurn(Encoder), FString(TEXT("-2,4 -3,4 +3,5=F")));
+    TestEqual(TEXT("Moves"), Encoder.GetStats().NumMoves, 3);
+    return true;
+}
+
+#endif
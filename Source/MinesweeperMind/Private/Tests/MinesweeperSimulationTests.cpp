@@ -0,0 +1,97 @@
+#include "Core/MinesweeperSimulation.h"
+#include "Dom/JsonObject.h"
+#include "HAL/FileManager.h"
+#include "MinesweeperMindBenchCommandlet.h"
+#include "Misc/AutomationTest.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "Serialization/JsonReader.h"
+#include "Serialization/JsonSerializer.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+namespace
+{
+    /** 200 beginner games from seed 7, small enough to play without budgets in a fraction of a second. */
+    FMinesweeperSimulationSettings MakeBeginnerSettings(bool bNoGuess, bool bParallel)
+    {
+        FMinesweeperSimulationSettings Settings;
+        Settings.NumGames = 200;
+        Settings.NumRows = 9;
+        Settings.NumColumns = 9;
+        Settings.MineDensity = 10.f / 81.f;
+        Settings.BaseSeed = 7;
+        Settings.bNoGuess = bNoGuess;
+        Settings.bParallel = bParallel;
+        Settings.bDeterministic = true;
+        return Settings;
+    }
+
+    FMinesweeperSimulationReport RunSolver(const FMinesweeperSimulationSettings& Settings)
+    {
+        return FMinesweeperSimulation::Run(Settings, TEXT("Solver"), [](uint64 GameSeed)
+        {
+            return FMinesweeperSimulation::CreatePolicy(TEXT("Solver"), GameSeed, true);
+        });
+    }
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FMinesweeperSimulationSolverTest, "MinesweeperMind.Simulation.Solver",
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool FMinesweeperSimulationSolverTest::RunTest(const FString& Parameters)
+{
+    // Guesses take the safest cell, ties by the order the frontier was found, so the losses are fixed by the seed.
+    const FMinesweeperSimulationReport Parallel = RunSolver(MakeBeginnerSettings(false, true));
+    TestEqual(TEXT("Games"), Parallel.NumGames, 200);
+    TestEqual(TEXT("Wins"), Parallel.NumWins, 192);
+    TestEqual(TEXT("No no-guess failures without no-guess"), Parallel.NumNoGuessFailures, 0);
+
+    const FMinesweeperSimulationReport SingleThread = RunSolver(MakeBeginnerSettings(false, false));
+    TestEqual(TEXT("Single-threaded wins"), SingleThread.NumWins, Parallel.NumWins);
+    TestEqual(TEXT("Single-threaded moves"), SingleThread.NumMoves, Parallel.NumMoves);
+
+    // Every no-guess board is found within the attempt cap and the solver clears it without a single guess.
+    const FMinesweeperSimulationReport NoGuess = RunSolver(MakeBeginnerSettings(true, true));
+    TestEqual(TEXT("No-guess games"), NoGuess.NumGames, 200);
+    TestEqual(TEXT("No-guess wins"), NoGuess.NumWins, 200);
+    TestEqual(TEXT("No-guess failures"), NoGuess.NumNoGuessFailures, 0);
+    return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FMinesweeperSimulationBenchCommandletTest, "MinesweeperMind.Simulation.BenchCommandlet",
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool FMinesweeperSimulationBenchCommandletTest::RunTest(const FString& Parameters)
+{
+    const FString Path = FPaths::ConvertRelativePathToFull(FPaths::AutomationTransientDir() / TEXT("MinesweeperMind/Bench.json"));
+    const FString Params = FString::Printf(TEXT("-Games=200 -Rows=9 -Columns=9 -Density=%f -Seed=7 -Policy=Solver -Deterministic -Output=\"%s\""),
+        10.f / 81.f, *Path);
+
+    UMinesweeperMindBenchCommandlet* Commandlet = NewObject<UMinesweeperMindBenchCommandlet>();
+    TestEqual(TEXT("Commandlet succeeds"), Commandlet->Main(Params), 0);
+
+    FString Json;
+    TSharedPtr<FJsonObject> Report;
+    const bool bRead = FFileHelper::LoadFileToString(Json, *Path)
+        && FJsonSerializer::Deserialize(TJsonReaderFactory<>::Create(Json), Report) && Report.IsValid();
+    if (!TestTrue(FString::Printf(TEXT("Report read from %s"), *Path), bRead))
+    {
+        return false;
+    }
+
+    // The same games as the simulation run directly.
+    TestEqual(TEXT("Policy"), Report->GetStringField(TEXT("policy")), FString(TEXT("Solver")));
+    TestEqual(TEXT("Games"), static_cast<int32>(Report->GetNumberField(TEXT("games"))), 200);
+    TestEqual(TEXT("Wins"), static_cast<int32>(Report->GetNumberField(TEXT("wins"))), 192);
+    TestEqual(TEXT("No-guess failures"), static_cast<int32>(Report->GetNumberField(TEXT("no_guess_failures"))), 0);
+    TestTrue(TEXT("Deterministic"), Report->GetBoolField(TEXT("deterministic")));
+
+    AddExpectedError(TEXT("Unknown policy"), EAutomationExpectedErrorFlags::Contains, 1);
+    TestEqual(TEXT("Unknown policies are refused"), Commandlet->Main(TEXT("-Policy=Oracle")), 1);
+
+    IFileManager::Get().Delete(*Path);
+    return true;
+}
+
+#endif
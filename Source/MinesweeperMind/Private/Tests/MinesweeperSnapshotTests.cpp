@@ -0,0 +1,179 @@
+#include "Core/MinesweeperSnapshot.h"
+#include "Core/MinesweeperBoard.h"
+#include "HAL/FileManager.h"
+#include "Math/RandomStream.h"
+#include "Misc/AutomationTest.h"
+#include "Misc/Paths.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+namespace
+{
+    /** Random reveals, flags and chords from a central opening, steering clear of most mines so the game runs long. */
+    TArray<FMinesweeperMove> PlayRandomGame(IMinesweeperBoard& Board, int32 NumMoves, int32 RandomSeed)
+    {
+        TArray<FMinesweeperMove> Moves;
+        Moves.Add(FMinesweeperMove(FIntPoint(Board.GetNumRows() / 2, Board.GetNumColumns() / 2), EMinesweeperMoveType::Reveal));
+        TArray<FIntPoint> Revealed;
+        Board.ApplyMove(Moves[0], Revealed);
+
+        FRandomStream Random(RandomSeed);
+        while (Moves.Num() < NumMoves && !Board.IsGameOver())
+        {
+            const FIntPoint Cell(Random.RandHelper(Board.GetNumRows()), Random.RandHelper(Board.GetNumColumns()));
+            const EMinesweeperMoveType Type = static_cast<EMinesweeperMoveType>(Random.RandHelper(3));
+            if (Type == EMinesweeperMoveType::Reveal && Board.IsMine(Cell.X, Cell.Y) && Random.RandHelper(50) != 0)
+            {
+                continue;
+            }
+            Moves.Add(FMinesweeperMove(Cell, Type));
+            Board.ApplyMove(Moves.Last(), Revealed);
+        }
+        return Moves;
+    }
+
+    int32 CountDifferentCells(const IMinesweeperBoard& Board, const IMinesweeperBoard& Other)
+    {
+        int32 NumDifferent = 0;
+        for (int32 Row = 0; Row < Board.GetNumRows(); ++Row)
+        {
+            for (int32 Column = 0; Column < Board.GetNumColumns(); ++Column)
+            {
+                NumDifferent += Board.GetCell(Row, Column) != Other.GetCell(Row, Column) ? 1 : 0;
+            }
+        }
+        return NumDifferent;
+    }
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FMinesweeperSnapshotRoundTripTest, "MinesweeperMind.Snapshot.RoundTrip",
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool FMinesweeperSnapshotRoundTripTest::RunTest(const FString& Parameters)
+{
+    const FString Path = FPaths::ConvertRelativePathToFull(FPaths::AutomationTransientDir() / TEXT("MinesweeperMind/RoundTrip.msgame"));
+
+    for (const EMinesweeperBoardKind BoardKind : { EMinesweeperBoardKind::Dense, EMinesweeperBoardKind::Chunked })
+    {
+        FMinesweeperGameSetup Setup;
+        Setup.BoardKind = BoardKind;
+        Setup.NumRows = 90;
+        Setup.NumColumns = 140;
+        Setup.NumMines = 1800;
+        Setup.Seed = 42;
+
+        TUniquePtr<IMinesweeperBoard> Board = Setup.CreateBoard();
+        const TArray<FMinesweeperMove> Moves = PlayRandomGame(*Board, 3000, 7);
+        const int32 MidMove = Moves.Num() / 2;
+        TUniquePtr<IMinesweeperBoard> MidBoard = Setup.CreateBoard();
+        TArray<FIntPoint> Revealed;
+        for (int32 MoveIndex = 0; MoveIndex < MidMove; ++MoveIndex)
+        {
+            MidBoard->ApplyMove(Moves[MoveIndex], Revealed);
+        }
+
+        // Only a dense board can embed its mine layout.
+        const bool bDense = BoardKind == EMinesweeperBoardKind::Dense;
+        for (int32 Pass = 0; Pass < (bDense ? 2 : 1); ++Pass)
+        {
+            const bool bWithMineLayout = Pass == 1;
+            const FString Kind = FString::Printf(TEXT("%s board, %s"), bDense ? TEXT("Dense") : TEXT("Chunked"),
+                bWithMineLayout ? TEXT("embedded layout") : TEXT("seeded layout"));
+            const FMinesweeperBoard* MineLayoutBoard = bWithMineLayout ? static_cast<const FMinesweeperBoard*>(Board.Get()) : nullptr;
+            if (!TestTrue(FString::Printf(TEXT("%s: written"), *Kind), FMinesweeperSnapshot::WriteToFile(Path, Setup, Moves, MineLayoutBoard)))
+            {
+                return false;
+            }
+
+            FString Error;
+            const TUniquePtr<FMinesweeperSnapshotFile> File = FMinesweeperSnapshotFile::Open(Path, Error);
+            if (!TestTrue(FString::Printf(TEXT("%s: opened (%s)"), *Kind, *Error), File.IsValid()))
+            {
+                return false;
+            }
+
+            const FMinesweeperSnapshotView& View = File->GetView();
+            const FMinesweeperGameSetup& ReadSetup = View.GetSetup();
+            TestEqual(FString::Printf(TEXT("%s: board kind"), *Kind), ReadSetup.BoardKind, Setup.BoardKind);
+            TestEqual(FString::Printf(TEXT("%s: rows"), *Kind), ReadSetup.NumRows, Setup.NumRows);
+            TestEqual(FString::Printf(TEXT("%s: columns"), *Kind), ReadSetup.NumColumns, Setup.NumColumns);
+            TestEqual(FString::Printf(TEXT("%s: mines"), *Kind), ReadSetup.NumMines, Setup.NumMines);
+            TestEqual(FString::Printf(TEXT("%s: seed"), *Kind), ReadSetup.Seed, Setup.Seed);
+            TestEqual(FString::Printf(TEXT("%s: deferred placement"), *Kind), ReadSetup.bMinesPlaced, Setup.bMinesPlaced);
+            TestEqual(FString::Printf(TEXT("%s: mine layout"), *Kind), View.HasMineLayout(), bWithMineLayout);
+            TestEqual(FString::Printf(TEXT("%s: moves"), *Kind), View.GetNumMoves(), Moves.Num());
+
+            int32 NumMismatchedMoves = 0;
+            int32 MoveIndex = 0;
+            View.ForEachMove([&Moves, &NumMismatchedMoves, &MoveIndex](const FMinesweeperMove& Move)
+            {
+                const FMinesweeperMove& Expected = Moves[MoveIndex++];
+                NumMismatchedMoves += Move.Cell != Expected.Cell || Move.Type != Expected.Type ? 1 : 0;
+                return true;
+            });
+            TestEqual(FString::Printf(TEXT("%s: moves visited"), *Kind), MoveIndex, Moves.Num());
+            TestEqual(FString::Printf(TEXT("%s: moves that decoded differently"), *Kind), NumMismatchedMoves, 0);
+
+            const TUniquePtr<IMinesweeperBoard> Replayed = View.Replay();
+            TestEqual(FString::Printf(TEXT("%s: cells that differ after a full replay"), *Kind), CountDifferentCells(*Replayed, *Board), 0);
+            TestEqual(FString::Printf(TEXT("%s: safe cells after a full replay"), *Kind), Replayed->GetSafeCellsRevealed(), Board->GetSafeCellsRevealed());
+            TestEqual(FString::Printf(TEXT("%s: game over after a full replay"), *Kind), Replayed->IsGameOver(), Board->IsGameOver());
+
+            const TUniquePtr<IMinesweeperBoard> ReplayedToMid = View.Replay(MidMove);
+            TestEqual(FString::Printf(TEXT("%s: cells that differ after replaying %d moves"), *Kind, MidMove),
+                CountDifferentCells(*ReplayedToMid, *MidBoard), 0);
+        }
+    }
+
+    IFileManager::Get().Delete(*Path);
+    return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FMinesweeperSnapshotCorruptTest, "MinesweeperMind.Snapshot.Corrupt",
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool FMinesweeperSnapshotCorruptTest::RunTest(const FString& Parameters)
+{
+    FMinesweeperGameSetup Setup;
+    Setup.NumRows = 9;
+    Setup.NumColumns = 9;
+    Setup.NumMines = 10;
+    Setup.Seed = 3;
+    const FMinesweeperMove Moves[] = { FMinesweeperMove(FIntPoint(4, 4), EMinesweeperMoveType::Reveal), FMinesweeperMove(FIntPoint(0, 8), EMinesweeperMoveType::Flag) };
+    TArray<uint8> Data;
+    FMinesweeperSnapshot::Write(Setup, Moves, Data);
+
+    FMinesweeperSnapshotView View;
+    FString Error;
+    const bool bValid = View.Initialize(Data, Error);
+    TestTrue(FString::Printf(TEXT("Intact snapshot reads (%s)"), *Error), bValid);
+    TestEqual(TEXT("Intact snapshot moves"), View.GetNumMoves(), 2);
+
+    auto ExpectRejected = [this](const TCHAR* What, TArrayView<const uint8> Corrupt)
+    {
+        FMinesweeperSnapshotView CorruptView;
+        FString CorruptError;
+        TestFalse(FString::Printf(TEXT("%s is rejected"), What), CorruptView.Initialize(Corrupt, CorruptError));
+        TestFalse(FString::Printf(TEXT("%s says why"), What), CorruptError.IsEmpty());
+        TestEqual(FString::Printf(TEXT("%s leaves the view empty"), What), CorruptView.GetNumMoves(), 0);
+        TestFalse(FString::Printf(TEXT("%s replays nothing"), What), CorruptView.Replay().IsValid());
+    };
+
+    ExpectRejected(TEXT("A truncated header"), MakeArrayView(Data.GetData(), 20));
+    ExpectRejected(TEXT("A truncated move log"), MakeArrayView(Data.GetData(), Data.Num() - 1));
+
+    TArray<uint8> Trailing = Data;
+    Trailing.Add(0);
+    ExpectRejected(TEXT("A trailing byte"), Trailing);
+
+    TArray<uint8> WrongMagic = Data;
+    WrongMagic[0] ^= 0xFF;
+    ExpectRejected(TEXT("A wrong magic number"), WrongMagic);
+
+    TArray<uint8> NewerVersion = Data;
+    NewerVersion[4] = static_cast<uint8>(FMinesweeperSnapshot::Version + 1);
+    ExpectRejected(TEXT("A newer version"), NewerVersion);
+    return true;
+}
+
+#endif
@@ -0,0 +1,131 @@
+#include "Core/MinesweeperSolver.h"
+#include "Core/MinesweeperBoard.h"
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+namespace
+{
+    /** Reveals each cell, which must be a number so nothing floods, and returns everything revealed. */
+    TArray<FIntPoint> RevealNumbers(FMinesweeperBoard& Board, TArrayView<const FIntPoint> Cells)
+    {
+        TArray<FIntPoint> AllRevealed;
+        TArray<FIntPoint> Revealed;
+        for (const FIntPoint& Cell : Cells)
+        {
+            Board.Reveal(Cell.X, Cell.Y, Revealed);
+            AllRevealed.Append(Revealed);
+        }
+        return AllRevealed;
+    }
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FMinesweeperSolverSingleCellTest, "MinesweeperMind.Solver.SingleCell",
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool FMinesweeperSolverSingleCellTest::RunTest(const FString& Parameters)
+{
+    // 5x5 with mines in two opposite corners, opened from the centre: each mine is the only unknown of its numbers.
+    const uint8 MineBits[] = { 0x01, 0x00, 0x00, 0x01 };
+    FMinesweeperBoard Board;
+    Board.Initialize(5, 5, 2);
+    Board.PlaceMinesFromLayout(MineBits, 0, FIntPoint(2, 2));
+
+    // Flags are the player's guesses, the solver must not trust this one.
+    Board.ToggleFlag(0, 0);
+
+    TArray<FIntPoint> Revealed;
+    Board.Reveal(1, 1, Revealed);
+    FMinesweeperSolver Solver;
+    Solver.Reset(Board);
+    Solver.AddRevealedCells(Revealed);
+    TestFalse(TEXT("One number next to three unknowns"), Solver.Solve());
+
+    Board.Reveal(1, 0, Revealed);
+    Solver.AddRevealedCells(Revealed);
+    Board.Reveal(0, 1, Revealed);
+    Solver.AddRevealedCells(Revealed);
+    TestTrue(TEXT("Solved once a number has one unknown"), Solver.Solve());
+    TestTrue(TEXT("Corner mine deduced"), Solver.IsKnownMine(0, 0));
+    TestEqual(TEXT("Mines deduced"), Solver.GetMineCells().Num(), 1);
+    TestTrue(TEXT("Safe cells are the other neighbours of the numbers"), Solver.IsKnownSafe(0, 2) && Solver.IsKnownSafe(1, 2)
+        && Solver.IsKnownSafe(2, 0) && Solver.IsKnownSafe(2, 1) && Solver.IsKnownSafe(2, 2));
+    TestEqual(TEXT("Safe cells deduced"), Solver.GetSafeCells().Num(), 5);
+    TestFalse(TEXT("Far mine unknown"), Solver.IsKnownMine(4, 4) || Solver.IsKnownSafe(4, 4));
+
+    // Scanning the finished board from scratch finds both mines and nothing left to open.
+    Board.Reveal(2, 2, Revealed);
+    Solver.ScanBoard(Board);
+    Solver.Solve();
+    TestTrue(TEXT("Both mines after the scan"), Solver.IsKnownMine(0, 0) && Solver.IsKnownMine(4, 4));
+    TestEqual(TEXT("Mines after the scan"), Solver.GetMineCells().Num(), 2);
+    TestEqual(TEXT("No hidden safe cells after the win"), Solver.GetSafeCells().Num(), 0);
+    return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FMinesweeperSolverSubsetTest, "MinesweeperMind.Solver.Subset",
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool FMinesweeperSolverSubsetTest::RunTest(const FString& Parameters)
+{
+    // 2x5 with the bottom row open, no number alone decides anything:
+    //
+    //   . * . * .
+    //   1 1 2 1 1
+    //
+    // {(0,0),(0,1)} is a subset of {(0,0),(0,1),(0,2)} with the same count, so (0,2) is safe, the 2 then needs both
+    // remaining unknowns, and the end numbers are satisfied.
+    const uint8 MineBits[] = { 0x0A, 0x00 };
+    FMinesweeperBoard Board;
+    Board.Initialize(2, 5, 2);
+    Board.PlaceMinesFromLayout(MineBits, 0, FIntPoint(1, 2));
+
+    const FIntPoint BottomRow[] = { FIntPoint(1, 0), FIntPoint(1, 1), FIntPoint(1, 2), FIntPoint(1, 3), FIntPoint(1, 4) };
+    const TArray<FIntPoint> Revealed = RevealNumbers(Board, BottomRow);
+    TestEqual(TEXT("Bottom row revealed one cell at a time"), Revealed.Num(), 5);
+
+    FMinesweeperSolver Solver;
+    Solver.Reset(Board);
+    Solver.AddRevealedCells(Revealed);
+    TestTrue(TEXT("Subset rule deduces"), Solver.Solve());
+    TestTrue(TEXT("Mines"), Solver.IsKnownMine(0, 1) && Solver.IsKnownMine(0, 3));
+    TestTrue(TEXT("Safe cells"), Solver.IsKnownSafe(0, 0) && Solver.IsKnownSafe(0, 2) && Solver.IsKnownSafe(0, 4));
+    TestEqual(TEXT("Safe cell count"), Solver.GetSafeCells().Num(), 3);
+    TestEqual(TEXT("Mine count"), Solver.GetMineCells().Num(), 2);
+    for (const FIntPoint& Cell : Solver.GetSafeCells())
+    {
+        TestFalse(FString::Printf(TEXT("Deduced safe cell (%d, %d) is no mine"), Cell.X, Cell.Y), Board.IsMine(Cell.X, Cell.Y));
+    }
+
+    // A second Solve with nothing new queued has nothing to add.
+    TestFalse(TEXT("Nothing left to deduce"), Solver.Solve());
+    TestEqual(TEXT("No constraints visited"), Solver.GetNumConstraintsVisited(), 0);
+    return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FMinesweeperSolverGuessTest, "MinesweeperMind.Solver.Guess",
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool FMinesweeperSolverGuessTest::RunTest(const FString& Parameters)
+{
+    // 2x2 with the bottom row open, the mine is in either top cell:
+    //
+    //   * .
+    //   1 1
+    const uint8 MineBits[] = { 0x01 };
+    FMinesweeperBoard Board;
+    Board.Initialize(2, 2, 0);
+    Board.PlaceMinesFromLayout(MineBits, 0, FIntPoint(1, 0));
+
+    const FIntPoint BottomRow[] = { FIntPoint(1, 0), FIntPoint(1, 1) };
+    FMinesweeperSolver Solver;
+    Solver.Reset(Board);
+    Solver.AddRevealedCells(RevealNumbers(Board, BottomRow));
+    TestFalse(TEXT("A coin flip deduces nothing"), Solver.Solve());
+    TestTrue(TEXT("No safe cells"), Solver.GetSafeCells().IsEmpty());
+    TestTrue(TEXT("No mines"), Solver.GetMineCells().IsEmpty());
+    TestEqual(TEXT("Both numbers visited"), Solver.GetNumConstraintsVisited(), 2);
+    return true;
+}
+
+#endif
@@ -2,12 +2,20 @@
 
 #include "Widgets/Layout/SBox.h"
 
+#include "Core/MinesweeperIntentParser.h"
+#include "Core/MinesweeperModelHost.h"
 #include "Widgets/SMinesweeperWidget.h"
 #include "Widgets/SChatboxWidget.h"
 #include "Widgets/Layout/SScaleBox.h"
 
 void SMinesweeperMindWindow::Construct(const FArguments& InArgs)
 {
+	// Someone is about to chat, have the model ready by the time they finish typing.
+	if (const TSharedPtr<FMinesweeperModelHost, ESPMode::ThreadSafe> ModelHost = FMinesweeperModelHost::Get())
+	{
+		ModelHost->RequestWarmup();
+	}
+
 	ChildSlot
 	[
 		SNew(SVerticalBox)
@@ -20,7 +28,7 @@ void SMinesweeperMindWindow::Construct(const FArguments& InArgs)
 			SNew(SScaleBox)
 			.Stretch(EStretch::ScaleToFit)
 			[
-				SNew(SMinesweeperWidget)
+				SAssignNew(MinesweeperWidget, SMinesweeperWidget)
 			]
 		]
 		
@@ -32,7 +40,16 @@ void SMinesweeperMindWindow::Construct(const FArguments& InArgs)
 		.Padding(10.f)
 		[
 			SNew(SChatboxWidget)
+			.OnBoardRequested(this, &SMinesweeperMindWindow::OnBoardRequested)
 		]
 	];
 }
 
+void SMinesweeperMindWindow::OnBoardRequested(const FMinesweeperBoardRequest& Request)
+{
+	if (MinesweeperWidget.IsValid())
+	{
+		MinesweeperWidget->StartNewGame(Request.NumRows, Request.NumColumns, Request.NumMines);
+	}
+}
+
@@ -5,6 +5,7 @@
 class SMinesweeperRestartButton;
 class SMinesweeperWidget;
 class SChatboxWidget;
+struct FMinesweeperBoardRequest;
 
 class SMinesweeperMindWindow final : public SCompoundWidget
 {
@@ -13,4 +14,9 @@ public:
 	SLATE_END_ARGS()
 
 	void Construct(const FArguments& InArgs);
+
+private:
+	TSharedPtr<SMinesweeperWidget> MinesweeperWidget;
+
+	void OnBoardRequested(const FMinesweeperBoardRequest& Request);
 };
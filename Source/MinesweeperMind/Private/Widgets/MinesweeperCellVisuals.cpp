@@ -0,0 +1,65 @@
+#include "MinesweeperCellVisuals.h"
+
+#include "Fonts/FontMeasure.h"
+#include "Framework/Application/SlateApplication.h"
+#include "Styling/CoreStyle.h"
+
+TSharedRef<const FMinesweeperCellVisualTable> FMinesweeperCellVisualTable::Create(float CellSize)
+{
+    return MakeShareable(new FMinesweeperCellVisualTable(CellSize));
+}
+
+FMinesweeperCellVisualTable::FMinesweeperCellVisualTable(float InCellSize)
+    : CellSize(InCellSize)
+{
+    const FLinearColor HiddenColor(0.3f, 0.3f, 0.3f, 1.f);
+    const FLinearColor RevealedColor(0.8f, 0.8f, 0.8f, 1.f); // Light Gray
+
+    // Sized like the old 400px grid of 10 cells: 24pt digits and 12pt emoji in 40px cells.
+    const FSlateFontInfo NumberFont(FCoreStyle::GetDefaultFont(), FMath::Max(1, FMath::RoundToInt(CellSize * 0.6f)));
+    const FSlateFontInfo EmojiFont(FCoreStyle::GetDefaultFont(), FMath::Max(1, FMath::RoundToInt(CellSize * 0.3f)));
+
+    static const FLinearColor NumberColors[9] =
+    {
+        FLinearColor::Black,
+        FLinearColor::Blue,
+        FLinearColor::Green,
+        FLinearColor::Red,
+        FLinearColor(0.5f, 0.f, 0.5f),    // Purple
+        FLinearColor(0.5f, 0.f, 0.f),     // Maroon
+        FLinearColor(0.25f, 0.88f, 0.81f), // Turquoise
+        FLinearColor::Black,
+        FLinearColor::Gray
+    };
+
+    auto SetEntry = [this](EMinesweeperCellVisual Visual, const FText& Text, const FSlateFontInfo& Font, const FLinearColor& TextColor, const FLinearColor& BackgroundColor)
+    {
+        FEntry& Entry = Entries[static_cast<uint8>(Visual)];
+        Entry.Text = Text;
+        Entry.Font = Font;
+        Entry.TextColor = TextColor;
+        Entry.BackgroundColor = BackgroundColor;
+    };
+
+    SetEntry(EMinesweeperCellVisual::Hidden, FText::GetEmpty(), NumberFont, FLinearColor::White, HiddenColor);
+    SetEntry(EMinesweeperCellVisual::Flagged, FText::FromString(TEXT("🚩")), EmojiFont, FLinearColor::White, HiddenColor);
+    SetEntry(EMinesweeperCellVisual::Mine, FText::FromString(TEXT("💣")), EmojiFont, FLinearColor::Red, FLinearColor::Red);
+    SetEntry(EMinesweeperCellVisual::Blank, FText::GetEmpty(), NumberFont, FLinearColor::Black, RevealedColor);
+    for (int32 Number = 1; Number <= 8; ++Number)
+    {
+        const EMinesweeperCellVisual Visual = static_cast<EMinesweeperCellVisual>(static_cast<uint8>(EMinesweeperCellVisual::Blank) + Number);
+        SetEntry(Visual, FText::AsNumber(Number), NumberFont, NumberColors[Number], RevealedColor);
+    }
+
+    if (FSlateApplication::IsInitialized())
+    {
+        const TSharedRef<FSlateFontMeasure> FontMeasure = FSlateApplication::Get().GetRenderer()->GetFontMeasureService();
+        for (FEntry& Entry : Entries)
+        {
+            if (!Entry.Text.IsEmpty())
+            {
+                Entry.TextSize = FontMeasure->Measure(Entry.Text, Entry.Font);
+            }
+        }
+    }
+}
@@ -0,0 +1,66 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Fonts/SlateFontInfo.h"
+#include "Core/IMinesweeperBoard.h"
+
+/** Every way a single cell can look. Numbered cells follow Blank so the adjacency count is an offset. */
+enum class EMinesweeperCellVisual : uint8
+{
+	Hidden,
+	Flagged,
+	Mine,
+	Blank,
+	One,
+	Two,
+	Three,
+	Four,
+	Five,
+	Six,
+	Seven,
+	Eight,
+
+	Count
+};
+
+/**
+ * Immutable table of the prebuilt text, font and colours for each EMinesweeperCellVisual.
+ * Built once per board and cell size so painting a cell is a table lookup with no string or font work.
+ */
+class FMinesweeperCellVisualTable
+{
+public:
+	struct FEntry
+	{
+		FText Text;
+		FSlateFontInfo Font;
+		FLinearColor TextColor = FLinearColor::White;
+		FLinearColor BackgroundColor = FLinearColor::White;
+		FVector2D TextSize = FVector2D::ZeroVector;
+	};
+
+	static TSharedRef<const FMinesweeperCellVisualTable> Create(float CellSize);
+
+	FORCEINLINE const FEntry& Get(EMinesweeperCellVisual Visual) const { return Entries[static_cast<uint8>(Visual)]; }
+	float GetCellSize() const { return CellSize; }
+
+	/** Maps a packed board cell to its visual. bShowMines reveals hidden mines once the game is lost. */
+	static FORCEINLINE EMinesweeperCellVisual FromCell(uint8 Cell, bool bShowMines)
+	{
+		if ((Cell & MinesweeperCell::Mine) && ((Cell & MinesweeperCell::Revealed) || bShowMines))
+		{
+			return EMinesweeperCellVisual::Mine;
+		}
+		if (Cell & MinesweeperCell::Revealed)
+		{
+			return static_cast<EMinesweeperCellVisual>(static_cast<uint8>(EMinesweeperCellVisual::Blank) + (Cell & MinesweeperCell::AdjacencyMask));
+		}
+		return (Cell & MinesweeperCell::Flagged) ? EMinesweeperCellVisual::Flagged : EMinesweeperCellVisual::Hidden;
+	}
+
+private:
+	explicit FMinesweeperCellVisualTable(float InCellSize);
+
+	FEntry Entries[static_cast<uint8>(EMinesweeperCellVisual::Count)];
+	float CellSize = 0.f;
+};
@@ -1,12 +1,49 @@
 #include "SChatboxWidget.h"
+
+#include "Core/MinesweeperDimensionCache.h"
+#include "Core/MinesweeperModelReplies.h"
+#include "Dom/JsonObject.h"
+#include "HAL/PlatformTime.h"
 #include "Widgets/Layout/SBox.h"
 #include "Widgets/Input/SButton.h"
 #include "Widgets/Input/SEditableTextBox.h"
 #include "Widgets/Layout/SScrollBox.h"
 #include "Widgets/Text/STextBlock.h"
 
+namespace
+{
+	const TCHAR* ReplyPrefix = TEXT("Mind: ");
+
+	/** Reads a generate_dimensions answer, the grammar-constrained JSON in its "text". */
+	bool ReadBoardRequest(const TSharedPtr<FJsonObject>& Result, EMinesweeperBoardRequestSource Source, FMinesweeperBoardRequest& OutRequest)
+	{
+		FMinesweeperDimensionReply Reply;
+		if (!FMinesweeperDimensionReply::ParseResult(Result, Reply))
+		{
+			return false;
+		}
+
+		OutRequest.NumRows = Reply.Rows;
+		OutRequest.NumColumns = Reply.Columns;
+		OutRequest.NumMines = Reply.Mines;
+		OutRequest.Source = Source;
+		return OutRequest.IsValid();
+	}
+}
+
+SChatboxWidget::~SChatboxWidget()
+{
+	// Closing the window must not leave the worker generating for nobody.
+	if (ActiveRequest.IsValid())
+	{
+		ActiveRequest->Cancel();
+	}
+}
+
 void SChatboxWidget::Construct(const FArguments& InArgs)
 {
+	OnBoardRequested = InArgs._OnBoardRequested;
+
 	ChildSlot
 	[
 		SNew(SBox)
@@ -103,6 +140,22 @@ void SChatboxWidget::OnChatTextCommitted(const FText& InText, ETextCommit::Type
 		FString Message = InText.ToString();
 		AddChatMessage(Message);
 
+		// Board requests the parser fully understands never reach the model.
+		FMinesweeperBoardRequest BoardRequest;
+		switch (FMinesweeperIntentParser::Parse(Message, BoardRequest))
+		{
+		case EMinesweeperIntentMatch::Parsed:
+			CancelReply();
+			AnswerBoardRequest(BoardRequest);
+			break;
+		case EMinesweeperIntentMatch::NeedsModel:
+			RequestBoardFromModel(Message);
+			break;
+		default:
+			RequestReply(Message);
+			break;
+		}
+
 		if (ChatInput.IsValid())
 		{
 			ChatInput->SetText(FText::GetEmpty());
@@ -115,20 +168,154 @@ void SChatboxWidget::OnChatTextCommitted(const FText& InText, ETextCommit::Type
 	}
 }
 
-void SChatboxWidget::AddChatMessage(const FString& Message)
+TSharedRef<STextBlock> SChatboxWidget::AddChatMessage(const FString& Message)
 {
 	ChatMessages.Add(MakeShareable(new FString(Message)));
 
+	TSharedRef<STextBlock> MessageText = SNew(STextBlock)
+		.Text(FText::FromString(Message))
+		.AutoWrapText(true);
+
 	if (ChatScrollBox.IsValid())
 	{
 		ChatScrollBox->AddSlot()
 		             .Padding(2)
 		[
-			SNew(STextBlock)
-			.Text(FText::FromString(Message))
-			.AutoWrapText(true)
+			MessageText
 		];
 
 		ChatScrollBox->ScrollToEnd();
 	}
+
+	return MessageText;
+}
+
+void SChatboxWidget::RequestReply(const FString& Message)
+{
+	TSharedRef<FJsonObject> Params = MakeShared<FJsonObject>();
+	Params->SetStringField(TEXT("message"), Message);
+	StartReply(TEXT("chat"), Params, FMinesweeperAsyncInference::FOnFinished::CreateSP(this, &SChatboxWidget::OnReplyFinished));
+}
+
+void SChatboxWidget::RequestBoardFromModel(const FString& Message)
+{
+	FMinesweeperBoardRequest CachedRequest;
+	if (ReadBoardRequest(FMinesweeperDimensionCache::Get().Find(Message), EMinesweeperBoardRequestSource::Cache, CachedRequest))
+	{
+		CancelReply();
+		AnswerBoardRequest(CachedRequest);
+		return;
+	}
+
+	TSharedRef<FJsonObject> Params = MakeShared<FJsonObject>();
+	Params->SetStringField(TEXT("query"), Message);
+	StartReply(TEXT("generate_dimensions"), Params, FMinesweeperAsyncInference::FOnFinished::CreateSP(this, &SChatboxWidget::OnBoardReplyFinished));
+	ActiveBoardQuery = Message;
+	ActiveBoardStartTime = FPlatformTime::Seconds();
+}
+
+void SChatboxWidget::StartReply(const FString& Method, const TSharedRef<FJsonObject>& Params, FMinesweeperAsyncInference::FOnFinished OnFinished)
+{
+	// Only the latest message is worth answering.
+	CancelReply();
+
+	ActiveReply.Reset();
+	ActiveReplyText = AddChatMessage(FString(ReplyPrefix) + TEXT("..."));
+	ActiveReplyMessage = ChatMessages.Last();
+	ActiveRequest = FMinesweeperAsyncInference::Start(Method, Params,
+		FMinesweeperAsyncInference::FOnTokens::CreateSP(this, &SChatboxWidget::OnReplyTokens),
+		MoveTemp(OnFinished));
+}
+
+void SChatboxWidget::CancelReply()
+{
+	if (ActiveRequest.IsValid() && ActiveRequest->IsRunning())
+	{
+		ActiveRequest->Cancel();
+		SetReplyText(ActiveReply + TEXT(" [stopped]"));
+	}
+
+	ActiveRequest.Reset();
+	ActiveReplyText.Reset();
+	ActiveReplyMessage.Reset();
+}
+
+void SChatboxWidget::OnReplyTokens(const FString& NewText)
+{
+	ActiveReply += NewText;
+	SetReplyText(ActiveReply);
+}
+
+void SChatboxWidget::OnReplyFinished(bool bSucceeded, const TSharedPtr<FJsonObject>& Result, const FString& Error)
+{
+	FString Text;
+	if (bSucceeded && Result.IsValid() && Result->TryGetStringField(TEXT("text"), Text))
+	{
+		ActiveReply = Text;
+	}
+	SetReplyText(bSucceeded ? ActiveReply : FString::Printf(TEXT("Could not answer: %s"), *Error));
+
+	ActiveRequest.Reset();
+	ActiveReplyText.Reset();
+	ActiveReplyMessage.Reset();
+}
+
+void SChatboxWidget::OnBoardReplyFinished(bool bSucceeded, const TSharedPtr<FJsonObject>& Result, const FString& Error)
+{
+	FMinesweeperBoardRequest Request;
+	if (bSucceeded && ReadBoardRequest(Result, EMinesweeperBoardRequestSource::Model, Request))
+	{
+		FMinesweeperDimensionCache::Get().Add(ActiveBoardQuery, Result.ToSharedRef(), FPlatformTime::Seconds() - ActiveBoardStartTime);
+	}
+
+	if (Request.IsValid())
+	{
+		AnswerBoardRequest(Request);
+	}
+	else
+	{
+		SetReplyText(bSucceeded ? TEXT("Could not work out a board from that.") : FString::Printf(TEXT("Could not answer: %s"), *Error));
+	}
+
+	ActiveRequest.Reset();
+	ActiveReplyText.Reset();
+	ActiveReplyMessage.Reset();
+}
+
+void SChatboxWidget::AnswerBoardRequest(const FMinesweeperBoardRequest& Request)
+{
+	FMinesweeperIntentParser::RecordAnswer(Request.Source);
+	const TCHAR* SourceName = Request.Source == EMinesweeperBoardRequestSource::Parser ? TEXT("parser")
+		: (Request.Source == EMinesweeperBoardRequestSource::Cache ? TEXT("cache") : TEXT("model"));
+	UE_LOG(LogTemp, Log, TEXT("Board request answered by the %s: %dx%d with %lld mines. Model bypass rate %.0f%% (%d parsed, %d cached, %d model)."),
+		SourceName, Request.NumRows, Request.NumColumns, Request.NumMines, FMinesweeperIntentParser::GetModelBypassRate() * 100.0,
+		FMinesweeperIntentParser::GetNumParserAnswers(), FMinesweeperIntentParser::GetNumCacheAnswers(), FMinesweeperIntentParser::GetNumModelAnswers());
+
+	const FString Answer = FString::Printf(TEXT("Starting a %dx%d board with %lld mines."), Request.NumRows, Request.NumColumns, Request.NumMines);
+	if (ActiveReplyText.IsValid())
+	{
+		SetReplyText(Answer);
+	}
+	else
+	{
+		AddChatMessage(ReplyPrefix + Answer);
+	}
+
+	OnBoardRequested.ExecuteIfBound(Request);
+}
+
+void SChatboxWidget::SetReplyText(const FString& Text)
+{
+	if (!ActiveReplyText.IsValid())
+	{
+		return;
+	}
+
+	*ActiveReplyMessage = ReplyPrefix + Text;
+	ActiveReplyText->SetText(FText::FromString(*ActiveReplyMessage));
+
+	if (ChatScrollBox.IsValid())
+	{
+		ChatScrollBox->ScrollToEnd();
+	}
 }
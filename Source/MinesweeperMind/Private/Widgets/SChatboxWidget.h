@@ -1,6 +1,13 @@
 #pragma once
 
 #include "Widgets/SCompoundWidget.h"
+#include "Core/MinesweeperAsyncInference.h"
+#include "Core/MinesweeperIntentParser.h"
+
+class FJsonObject;
+class STextBlock;
+
+DECLARE_DELEGATE_OneParam(FOnMinesweeperBoardRequested, const FMinesweeperBoardRequest& /*Request*/);
 
 /**
  *  Large Language Model user-interaction chat.
@@ -9,8 +16,12 @@ class SChatboxWidget final : public SCompoundWidget
 {
 public:
 SLATE_BEGIN_ARGS(SChatboxWidget) {}
+	/** A message asked for a new board, answered by the intent parser or the model. */
+	SLATE_EVENT(FOnMinesweeperBoardRequested, OnBoardRequested)
 SLATE_END_ARGS()
 
+    virtual ~SChatboxWidget() override;
+
     void Construct(const FArguments& InArgs);
 
 private:
@@ -18,8 +29,28 @@ private:
     TSharedPtr<SEditableTextBox> ChatInput;
     TSharedPtr<SScrollBox> ChatScrollBox;
     TArray<TSharedPtr<FString>> ChatMessages;
+    FOnMinesweeperBoardRequested OnBoardRequested;
+
+    /** Reply being streamed in, cancelled by the next message or when the chat closes. */
+    TSharedPtr<FMinesweeperAsyncInference> ActiveRequest;
+    TSharedPtr<STextBlock> ActiveReplyText;
+    TSharedPtr<FString> ActiveReplyMessage;
+    FString ActiveReply;
+    /** generate_dimensions query being answered by the model, cached once it succeeds. */
+    FString ActiveBoardQuery;
+    double ActiveBoardStartTime = 0.0;
 
     void OnChatTextCommitted(const FText& InText, ETextCommit::Type CommitType);
     FReply OnSendButtonClicked();
-    void AddChatMessage(const FString& Message);
+    TSharedRef<STextBlock> AddChatMessage(const FString& Message);
+
+    void RequestReply(const FString& Message);
+    void RequestBoardFromModel(const FString& Message);
+    void StartReply(const FString& Method, const TSharedRef<FJsonObject>& Params, FMinesweeperAsyncInference::FOnFinished OnFinished);
+    void CancelReply();
+    void OnReplyTokens(const FString& NewText);
+    void OnReplyFinished(bool bSucceeded, const TSharedPtr<FJsonObject>& Result, const FString& Error);
+    void OnBoardReplyFinished(bool bSucceeded, const TSharedPtr<FJsonObject>& Result, const FString& Error);
+    void AnswerBoardRequest(const FMinesweeperBoardRequest& Request);
+    void SetReplyText(const FString& Text);
 };
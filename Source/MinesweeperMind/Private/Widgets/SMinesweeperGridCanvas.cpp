@@ -0,0 +1,240 @@
+#include "SMinesweeperGridCanvas.h"
+
+#include "MinesweeperCellVisuals.h"
+#include "MinesweeperMindStats.h"
+#include "Core/IMinesweeperBoard.h"
+#include "Core/MinesweeperProbability.h"
+#include "Rendering/DrawElements.h"
+#include "Styling/CoreStyle.h"
+
+namespace
+{
+    constexpr float MinCellSize = 16.f;
+    constexpr float DesiredCellSize = 40.f;
+    constexpr float MaxDesiredExtent = 800.f;
+    constexpr int32 WheelScrollCells = 3;
+
+    const FLinearColor SafeHeatColor(0.1f, 0.55f, 0.15f);
+    const FLinearColor MineHeatColor(0.75f, 0.1f, 0.1f);
+}
+
+void SMinesweeperGridCanvas::Construct(const FArguments& InArgs)
+{
+    Board = InArgs._Board;
+    OnCellClicked = InArgs._OnCellClicked;
+    OnCellRightClicked = InArgs._OnCellRightClicked;
+}
+
+void SMinesweeperGridCanvas::SetBoard(const IMinesweeperBoard* InBoard)
+{
+    Board = InBoard;
+    ViewOrigin = FIntPoint::ZeroValue;
+    VisibleCellRect = FIntRect();
+    Probabilities.Reset();
+    VisualTable.Reset();
+    Invalidate(EInvalidateWidget::LayoutAndVolatility);
+}
+
+void SMinesweeperGridCanvas::SetProbabilityOverlay(TSharedPtr<const FMinesweeperProbabilityResult> InProbabilities)
+{
+    Probabilities = MoveTemp(InProbabilities);
+}
+
+int32 SMinesweeperGridCanvas::OnPaint(const FPaintArgs& Args, const FGeometry& AllottedGeometry, const FSlateRect& MyCullingRect,
+    FSlateWindowElementList& OutDrawElements, int32 LayerId, const FWidgetStyle& InWidgetStyle, bool bParentEnabled) const
+{
+    MINESWEEPER_SCOPE_CYCLE_COUNTER(PaintGrid);
+
+    if (!Board || Board->GetNumCells() == 0)
+    {
+        return LayerId;
+    }
+
+    const FVector2D LocalSize = AllottedGeometry.GetLocalSize();
+    const float CellSize = GetCellSize(LocalSize);
+    ClampViewOrigin(LocalSize);
+    const FMinesweeperCellVisualTable& Visuals = GetVisualTable(CellSize);
+
+    // Only emit the cells that overlap the clip rect, the rest of the board costs nothing.
+    const FVector2D ClipTopLeft = AllottedGeometry.AbsoluteToLocal(MyCullingRect.GetTopLeft());
+    const FVector2D ClipBottomRight = AllottedGeometry.AbsoluteToLocal(MyCullingRect.GetBottomRight());
+    const FIntPoint VisibleCells = GetVisibleCellCount(LocalSize);
+
+    const int32 FirstRow = FMath::Max(0, FMath::FloorToInt(ClipTopLeft.Y / CellSize));
+    const int32 EndRow = FMath::Min(VisibleCells.X, FMath::CeilToInt(ClipBottomRight.Y / CellSize));
+    const int32 FirstColumn = FMath::Max(0, FMath::FloorToInt(ClipTopLeft.X / CellSize));
+    const int32 EndColumn = FMath::Min(VisibleCells.Y, FMath::CeilToInt(ClipBottomRight.X / CellSize));
+    VisibleCellRect = FIntRect(ViewOrigin + FIntPoint(FirstRow, FirstColumn), ViewOrigin + FIntPoint(EndRow, EndColumn));
+
+    const FSlateBrush* CellBrush = FCoreStyle::Get().GetBrush("GenericWhiteBox");
+    // One pixel of gap between cells, cells never get smaller than MinCellSize.
+    const FVector2D BoxSize(CellSize - 1.f, CellSize - 1.f);
+
+    const bool bGameLost = Board->IsGameOver() && !Board->IsGameWon();
+    const bool bGameWon = Board->IsGameWon();
+    const FMinesweeperProbabilityResult* Heatmap = Board->IsGameOver() ? nullptr : Probabilities.Get();
+
+    const int32 BoxLayer = LayerId;
+    const int32 TextLayer = LayerId + 1;
+
+    for (int32 ViewRow = FirstRow; ViewRow < EndRow; ++ViewRow)
+    {
+        const int32 Row = ViewOrigin.X + ViewRow;
+        for (int32 ViewColumn = FirstColumn; ViewColumn < EndColumn; ++ViewColumn)
+        {
+            const int32 Column = ViewOrigin.Y + ViewColumn;
+            const FVector2D CellPosition(ViewColumn * CellSize, ViewRow * CellSize);
+
+            const EMinesweeperCellVisual Visual = FMinesweeperCellVisualTable::FromCell(Board->GetCell(Row, Column), bGameLost);
+            const FMinesweeperCellVisualTable::FEntry& Entry = Visuals.Get(Visual);
+
+            // Game over tints the whole board: hidden cells turn red on a loss, revealed ones green on a win.
+            const bool bIsOpen = Visual >= EMinesweeperCellVisual::Blank;
+            FLinearColor BackgroundColor = Entry.BackgroundColor;
+            if (bGameLost && !bIsOpen)
+            {
+                BackgroundColor = FLinearColor::Red;
+            }
+            else if (bGameWon && bIsOpen)
+            {
+                BackgroundColor = FLinearColor::Green;
+            }
+            else if (Heatmap && Visual == EMinesweeperCellVisual::Hidden)
+            {
+                BackgroundColor = FMath::Lerp(SafeHeatColor, MineHeatColor, Heatmap->GetMineProbability(Row, Column));
+            }
+
+            FSlateDrawElement::MakeBox(
+                OutDrawElements,
+                BoxLayer,
+                AllottedGeometry.ToPaintGeometry(BoxSize, FSlateLayoutTransform(CellPosition)),
+                CellBrush,
+                ESlateDrawEffect::None,
+                BackgroundColor);
+
+            if (!Entry.Text.IsEmpty())
+            {
+                const FVector2D TextPosition = CellPosition + (FVector2D(CellSize, CellSize) - Entry.TextSize) * 0.5f;
+                FSlateDrawElement::MakeText(
+                    OutDrawElements,
+                    TextLayer,
+                    AllottedGeometry.ToPaintGeometry(Entry.TextSize, FSlateLayoutTransform(TextPosition)),
+                    Entry.Text,
+                    Entry.Font,
+                    ESlateDrawEffect::None,
+                    Entry.TextColor);
+            }
+        }
+    }
+
+    return TextLayer;
+}
+
+FVector2D SMinesweeperGridCanvas::ComputeDesiredSize(float LayoutScaleMultiplier) const
+{
+    if (!Board)
+    {
+        return FVector2D::ZeroVector;
+    }
+
+    return FVector2D(
+        FMath::Min(Board->GetNumColumns() * DesiredCellSize, MaxDesiredExtent),
+        FMath::Min(Board->GetNumRows() * DesiredCellSize, MaxDesiredExtent));
+}
+
+FReply SMinesweeperGridCanvas::OnMouseButtonDown(const FGeometry& MyGeometry, const FPointerEvent& MouseEvent)
+{
+    if (!Board || Board->GetNumCells() == 0)
+    {
+        return FReply::Unhandled();
+    }
+
+    const FVector2D LocalPosition = MyGeometry.AbsoluteToLocal(MouseEvent.GetScreenSpacePosition());
+    const float CellSize = GetCellSize(MyGeometry.GetLocalSize());
+    if (LocalPosition.X < 0.f || LocalPosition.Y < 0.f)
+    {
+        return FReply::Unhandled();
+    }
+
+    const int32 Row = ViewOrigin.X + FMath::FloorToInt(LocalPosition.Y / CellSize);
+    const int32 Column = ViewOrigin.Y + FMath::FloorToInt(LocalPosition.X / CellSize);
+    if (!Board->IsValidCell(Row, Column))
+    {
+        return FReply::Unhandled();
+    }
+
+    if (MouseEvent.GetEffectingButton() == EKeys::RightMouseButton && OnCellRightClicked.IsBound())
+    {
+        return OnCellRightClicked.Execute(Row, Column);
+    }
+
+    if (MouseEvent.GetEffectingButton() == EKeys::LeftMouseButton && OnCellClicked.IsBound())
+    {
+        return OnCellClicked.Execute(Row, Column);
+    }
+
+    return FReply::Unhandled();
+}
+
+FReply SMinesweeperGridCanvas::OnMouseWheel(const FGeometry& MyGeometry, const FPointerEvent& MouseEvent)
+{
+    if (!Board)
+    {
+        return FReply::Unhandled();
+    }
+
+    const FIntPoint PreviousOrigin = ViewOrigin;
+    const int32 ScrollCells = -FMath::RoundToInt(MouseEvent.GetWheelDelta()) * WheelScrollCells;
+    if (MouseEvent.IsShiftDown())
+    {
+        ViewOrigin.Y += ScrollCells;
+    }
+    else
+    {
+        ViewOrigin.X += ScrollCells;
+    }
+    ClampViewOrigin(MyGeometry.GetLocalSize());
+
+    if (ViewOrigin == PreviousOrigin)
+    {
+        return FReply::Unhandled();
+    }
+
+    Invalidate(EInvalidateWidget::Paint);
+    return FReply::Handled();
+}
+
+float SMinesweeperGridCanvas::GetCellSize(const FVector2D& LocalSize) const
+{
+    const float FitCellSize = FMath::Min(
+        float(LocalSize.X) / FMath::Max(1, Board->GetNumColumns()),
+        float(LocalSize.Y) / FMath::Max(1, Board->GetNumRows()));
+    return FMath::Max(FitCellSize, MinCellSize);
+}
+
+FIntPoint SMinesweeperGridCanvas::GetVisibleCellCount(const FVector2D& LocalSize) const
+{
+    const float CellSize = GetCellSize(LocalSize);
+    return FIntPoint(
+        FMath::Min(Board->GetNumRows() - ViewOrigin.X, FMath::CeilToInt(LocalSize.Y / CellSize)),
+        FMath::Min(Board->GetNumColumns() - ViewOrigin.Y, FMath::CeilToInt(LocalSize.X / CellSize)));
+}
+
+void SMinesweeperGridCanvas::ClampViewOrigin(const FVector2D& LocalSize) const
+{
+    const float CellSize = GetCellSize(LocalSize);
+    const int32 FullyVisibleRows = FMath::FloorToInt(LocalSize.Y / CellSize);
+    const int32 FullyVisibleColumns = FMath::FloorToInt(LocalSize.X / CellSize);
+
+    ViewOrigin.X = FMath::Clamp(ViewOrigin.X, 0, FMath::Max(0, Board->GetNumRows() - FullyVisibleRows));
+    ViewOrigin.Y = FMath::Clamp(ViewOrigin.Y, 0, FMath::Max(0, Board->GetNumColumns() - FullyVisibleColumns));
+}
+
+const FMinesweeperCellVisualTable& SMinesweeperGridCanvas::GetVisualTable(float CellSize) const
+{
+    if (!VisualTable.IsValid() || VisualTable->GetCellSize() != CellSize)
+    {
+        VisualTable = FMinesweeperCellVisualTable::Create(CellSize);
+    }
+    return *VisualTable;
+}
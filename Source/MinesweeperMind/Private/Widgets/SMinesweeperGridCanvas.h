@@ -0,0 +1,63 @@
+#pragma once
+
+#include "Widgets/SLeafWidget.h"
+
+class IMinesweeperBoard;
+class FMinesweeperCellVisualTable;
+class FMinesweeperProbabilityResult;
+
+DECLARE_DELEGATE_RetVal_TwoParams(FReply, FOnMinesweeperCellClicked, int32 /*Row*/, int32 /*Column*/);
+
+/**
+ * Draws a whole Minesweeper board as one leaf widget.
+ * Cells are painted as boxes and cached glyphs straight from the board state, only the ones inside the clip rect
+ * are emitted, and clicks are mapped to cells arithmetically. Boards larger than the view scroll with the mouse wheel.
+ */
+class SMinesweeperGridCanvas final : public SLeafWidget
+{
+public:
+SLATE_BEGIN_ARGS(SMinesweeperGridCanvas)
+		: _Board(nullptr)
+	{}
+	SLATE_ARGUMENT(const IMinesweeperBoard*, Board)
+	SLATE_EVENT(FOnMinesweeperCellClicked, OnCellClicked)
+	SLATE_EVENT(FOnMinesweeperCellClicked, OnCellRightClicked)
+SLATE_END_ARGS()
+
+	void Construct(const FArguments& InArgs);
+
+	/** Call whenever a new game starts, the board may be a different object or have new dimensions. */
+	void SetBoard(const IMinesweeperBoard* InBoard);
+
+	/** Tints hidden cells from green to red by mine probability from the next paint on. Pass null to hide the overlay. */
+	void SetProbabilityOverlay(TSharedPtr<const FMinesweeperProbabilityResult> InProbabilities);
+
+	/** Cells covered by the last paint as (Row, Column) min and exclusive max. Empty before the first paint. */
+	const FIntRect& GetVisibleCellRect() const { return VisibleCellRect; }
+
+	virtual int32 OnPaint(const FPaintArgs& Args, const FGeometry& AllottedGeometry, const FSlateRect& MyCullingRect,
+		FSlateWindowElementList& OutDrawElements, int32 LayerId, const FWidgetStyle& InWidgetStyle, bool bParentEnabled) const override;
+	virtual FVector2D ComputeDesiredSize(float LayoutScaleMultiplier) const override;
+	virtual FReply OnMouseButtonDown(const FGeometry& MyGeometry, const FPointerEvent& MouseEvent) override;
+	virtual FReply OnMouseWheel(const FGeometry& MyGeometry, const FPointerEvent& MouseEvent) override;
+
+private:
+	float GetCellSize(const FVector2D& LocalSize) const;
+	FIntPoint GetVisibleCellCount(const FVector2D& LocalSize) const;
+	void ClampViewOrigin(const FVector2D& LocalSize) const;
+	const FMinesweeperCellVisualTable& GetVisualTable(float CellSize) const;
+
+	const IMinesweeperBoard* Board = nullptr;
+
+	FOnMinesweeperCellClicked OnCellClicked;
+	FOnMinesweeperCellClicked OnCellRightClicked;
+
+	/** Top-left visible cell as (Row, Column) when the board is larger than the view. */
+	mutable FIntPoint ViewOrigin = FIntPoint::ZeroValue;
+	mutable FIntRect VisibleCellRect;
+
+	TSharedPtr<const FMinesweeperProbabilityResult> Probabilities;
+
+	/** Prebuilt cell visuals, replaced only when a new board starts or the painted cell size changes. */
+	mutable TSharedPtr<const FMinesweeperCellVisualTable> VisualTable;
+};
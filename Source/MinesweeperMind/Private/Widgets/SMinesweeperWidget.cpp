@@ -1,22 +1,41 @@
 #include "SMinesweeperWidget.h"
 
-#include "SMinesweeperCellWidget.h"
+#include "SMinesweeperGridCanvas.h"
 #include "SMinesweeperRestartButton.h"
+#include "Core/MinesweeperBoard.h"
+#include "Core/MinesweeperChunkedBoard.h"
+#include "Core/MinesweeperNoGuessGenerator.h"
+#include "Core/MinesweeperProbability.h"
+#include "MinesweeperMindStats.h"
 #include "Widgets/Layout/SBox.h"
-#include "Widgets/Layout/SUniformGridPanel.h"
 #include "Widgets/Text/STextBlock.h"
-#include "Widgets/Input/SButton.h"
-#include "Math/UnrealMathUtility.h"
+#include "Async/Async.h"
+#include "HAL/IConsoleManager.h"
+#include "HAL/PlatformTime.h"
 #include "Logging/LogMacros.h"
 
+namespace
+{
+    TAutoConsoleVariable<bool> CVarShowMineProbabilities(
+        TEXT("MinesweeperMind.ShowMineProbabilities"),
+        false,
+        TEXT("Tints hidden cells by their mine probability, refreshed after every move. Dense boards only."));
+
+    /** Overlay refreshes share the frame with everything else, keep them well inside it. */
+    constexpr double OverlayTimeBudgetSeconds = 0.004;
+
+    /** The first click waits on the search, give up on a no-guess board well before it feels like a hang. */
+    constexpr double NoGuessTimeBudgetSeconds = 0.5;
+}
+
 void SMinesweeperWidget::Construct(const FArguments& InArgs)
 {
     NumRows = InArgs._NumRows;
     NumColumns = InArgs._NumColumns;
     NumMines = InArgs._NumMines;
-
-    const int32 TotalCells = NumRows * NumColumns;
-    NumMines = FMath::Min(TotalCells, NumMines); // Can't have more mines than land.
+    Seed = InArgs._Seed;
+    bFirstClickSafe = InArgs._FirstClickSafe;
+    bNoGuess = InArgs._NoGuess;
 
     ResetGameState();
 
@@ -40,6 +59,17 @@ void SMinesweeperWidget::Construct(const FArguments& InArgs)
                 .OnRestartClicked(FOnRestartClicked::CreateSP(this, &SMinesweeperWidget::RestartGame))
             ]
 
+            // Status
+            + SVerticalBox::Slot()
+            .AutoHeight()
+            .HAlign(HAlign_Center)
+            .Padding(0.f, 0.f, 0.f, 6.f)
+            [
+                SNew(STextBlock)
+                .Text_Lambda([this]() { return StatusText; })
+                .Visibility_Lambda([this]() { return StatusText.IsEmpty() ? EVisibility::Collapsed : EVisibility::Visible; })
+            ]
+
             // Grid Panel
             + SVerticalBox::Slot()
             .FillHeight(1.0f)
@@ -49,7 +79,10 @@ void SMinesweeperWidget::Construct(const FArguments& InArgs)
                 .WidthOverride(400.f)
                 .HeightOverride(400.f)
                 [
-                    GridPanel.ToSharedRef()
+                    SAssignNew(GridCanvas, SMinesweeperGridCanvas)
+                    .Board(Board.Get())
+                    .OnCellClicked(this, &SMinesweeperWidget::OnCellClicked)
+                    .OnCellRightClicked(this, &SMinesweeperWidget::OnCellRightClicked)
                 ]
             ]
         ]
@@ -59,179 +92,189 @@ void SMinesweeperWidget::Construct(const FArguments& InArgs)
 void SMinesweeperWidget::RestartGame()
 {
     ResetGameState();
-    GenerateGrid(NumRows, NumColumns, NumMines);
 }
 
-void SMinesweeperWidget::GenerateGrid(int32 Rows, int32 Columns, int32 Bombs)
+void SMinesweeperWidget::StartNewGame(int32 InNumRows, int32 InNumColumns, int64 InNumMines)
 {
-    SetupGridPanel();
-    CreateCellWidgets();
-    PlaceMines(Bombs);
-    CalculateAdjacency();
+    NumRows = InNumRows;
+    NumColumns = InNumColumns;
+    NumMines = InNumMines;
+    ResetGameState();
 }
 
-void SMinesweeperWidget::PlaceMines(int32 Mines)
+void SMinesweeperWidget::GenerateGrid(int32 Rows, int32 Columns, int64 Bombs)
 {
-    TArray<FIntPoint> AvailablePositions;
-    for (int32 RowIndex = 0; RowIndex < NumRows; ++RowIndex)
-    {
-        for (int32 ColumnIndex = 0; ColumnIndex < NumColumns; ++ColumnIndex)
-        {
-            AvailablePositions.Add(FIntPoint(RowIndex, ColumnIndex));
-        }
-    }
+    MINESWEEPER_SCOPE_CYCLE_COUNTER(GenerateGrid);
 
-    for (int32 MineIndex = 0; MineIndex < NumMines && !AvailablePositions.IsEmpty(); ++MineIndex)
+    if (int64(Rows) * Columns >= MINESWEEPER_CHUNKED_BOARD_MIN_CELLS)
     {
-        const int32 RandomPositionIndex = FMath::RandRange(0, AvailablePositions.Num() - 1);
-        const FIntPoint MinePosition = AvailablePositions[RandomPositionIndex];
-
-        AvailablePositions.RemoveAtSwap(RandomPositionIndex, 1, EAllowShrinking::No);
-
-        CellsWithMines[MinePosition.X][MinePosition.Y] = true;
+        Board = MakeUnique<FMinesweeperChunkedBoard>();
     }
-}
-
-FReply SMinesweeperWidget::OnCellClicked(int32 Row, int32 Col)
-{
-    if (GameOver || CellsRevealed[Row][Col])
+    else
     {
-        return FReply::Handled();
+        Board = MakeUnique<FMinesweeperBoard>();
     }
+    Board->Initialize(Rows, Columns, Bombs);
 
-    if (CellsWithMines[Row][Col])
+    const uint64 BoardSeed = (Seed != 0) ? Seed : (FPlatformTime::Cycles64() ^ (uint64(FMath::Rand()) << 32));
+    if (bFirstClickSafe || bNoGuess)
     {
-        UpdateCellAppearance(Row, Col, TEXT("💣"), FLinearColor::Red);
-        RevealAllMines();
-        GameOver = true;
+        Board->DeferMinePlacement(BoardSeed);
     }
     else
     {
-        RevealCell(Row, Col);
+        Board->PlaceMines(BoardSeed);
     }
+    UE_LOG(LogTemp, Log, TEXT("Minesweeper board %dx%d with %lld mines, seed %llu."), Rows, Columns, Board->GetNumMines(), BoardSeed);
+
+    ++GameId;
+    NoGuessPendingMoves.Reset();
+    StatusText = FText::GetEmpty();
+    DirtyTiles.Reset();
+    Solver.Reset(*Board);
 
+    if (GridCanvas.IsValid())
+    {
+        GridCanvas->SetBoard(Board.Get());
+    }
+}
+
+FReply SMinesweeperWidget::OnCellClicked(int32 Row, int32 Col)
+{
+    // Clicking a revealed number chords it.
+    const FMinesweeperMove Move(FIntPoint(Row, Col), Board->IsValidCell(Row, Col) && Board->IsRevealed(Row, Col)
+        ? EMinesweeperMoveType::Chord : EMinesweeperMoveType::Reveal);
+    ApplyMoves(MakeArrayView(&Move, 1));
     return FReply::Handled();
 }
 
 FReply SMinesweeperWidget::OnCellRightClicked(int32 Row, int32 Col)
 {
-    if (GameOver || CellsRevealed[Row][Col])
-    {
-        return FReply::Handled();
-    }
-    
-    CellsFlagged[Row][Col] = !CellsFlagged[Row][Col];
-    FString CellText = CellsFlagged[Row][Col] ? TEXT("🚩") : TEXT(" ");
-    UpdateCellAppearance(Row, Col, CellText, FSlateColor(FLinearColor::White));
-
+    const FMinesweeperMove Move(FIntPoint(Row, Col), EMinesweeperMoveType::Flag);
+    ApplyMoves(MakeArrayView(&Move, 1));
     return FReply::Handled();
 }
 
-void SMinesweeperWidget::RevealAllMines()
+void SMinesweeperWidget::ApplyMoves(TArrayView<const FMinesweeperMove> Moves)
 {
-    for (int32 RowIndex = 0; RowIndex < NumRows; ++RowIndex)
+    // The board is on hold until the search places its mines.
+    if (!NoGuessPendingMoves.IsEmpty())
+    {
+        return;
+    }
+
+    if (bNoGuess && !Board->AreMinesPlaced())
     {
-        for (int32 ColumnIndex = 0; ColumnIndex < NumColumns; ++ColumnIndex)
+        // The batch's first reveal is the first click.
+        for (const FMinesweeperMove& Move : Moves)
         {
-            if (!CellsRevealed[RowIndex][ColumnIndex])
+            if (Move.Type == EMinesweeperMoveType::Reveal && Board->IsValidCell(Move.Cell.X, Move.Cell.Y))
             {
-                if (CellsWithMines[RowIndex][ColumnIndex])
+                // The search plays whole boards, which only makes sense while they are dense.
+                if (Board->GetNumCells() < MINESWEEPER_CHUNKED_BOARD_MIN_CELLS)
                 {
-                    UpdateCellAppearance(RowIndex, ColumnIndex, TEXT("💣"), FLinearColor::Red);
+                    StartNoGuessSearch(Move.Cell, Moves);
+                    return;
                 }
-                Cells[RowIndex][ColumnIndex]->SetBackgroundColor(FLinearColor::Red);
+
+                UE_LOG(LogTemp, Warning, TEXT("No-guess boards are not generated at %dx%d, placing the mines around the first click only."),
+                    Board->GetNumRows(), Board->GetNumColumns());
+                StatusText = FText::FromString(TEXT("Too large for a no-guess board, this one may need a guess."));
+                break;
             }
         }
     }
+
+    Board->ApplyMoves(Moves, Changes);
+    if (Changes.IsEmpty())
+    {
+        return;
+    }
+
+    if (!Board->IsGameOver() || Board->IsGameWon())
+    {
+        Solver.AddRevealedCells(Changes.Revealed);
+    }
+
+    if (Board->IsGameOver())
+    {
+        // Losing shows every mine and tints every hidden cell, winning redraws the whole board too.
+        MarkAllCellsDirty();
+        if (Board->IsGameWon())
+        {
+            HandleGameWon();
+        }
+        return;
+    }
+
+    for (const FIntPoint& Cell : Changes.Revealed)
+    {
+        MarkCellDirty(Cell);
+    }
+    for (const FIntPoint& Cell : Changes.Flagged)
+    {
+        MarkCellDirty(Cell);
+    }
 }
 
-void SMinesweeperWidget::CalculateAdjacency()
+void SMinesweeperWidget::StartNoGuessSearch(const FIntPoint& FirstClick, TArrayView<const FMinesweeperMove> Moves)
 {
-    for (int32 RowIndex = 0; RowIndex < NumRows; ++RowIndex)
+    NoGuessPendingMoves = TArray<FMinesweeperMove>(Moves);
+    StatusText = FText::FromString(TEXT("Searching for a no-guess board..."));
+
+    // The search checks candidates in parallel and can take the whole budget, keep it off the game thread. A restart
+    // or a closed window while it runs drops its result.
+    const TWeakPtr<SMinesweeperWidget> WeakWidget = StaticCastSharedRef<SMinesweeperWidget>(AsShared());
+    const uint32 SearchGameId = GameId;
+    const int32 Rows = Board->GetNumRows();
+    const int32 Columns = Board->GetNumColumns();
+    const int64 Mines = Board->GetNumMines();
+    const uint64 BaseSeed = Board->GetSeed();
+    Async(EAsyncExecution::Thread, [WeakWidget, SearchGameId, Rows, Columns, Mines, BaseSeed, FirstClick]()
     {
-        for (int32 ColIndex = 0; ColIndex < NumColumns; ++ColIndex)
-        {
-            if (CellsWithMines[RowIndex][ColIndex])
-            {
-                AdjacentMines[RowIndex][ColIndex] = -1;
-                continue;
-            }
+        FMinesweeperNoGuessSettings Settings;
+        Settings.TimeBudgetSeconds = NoGuessTimeBudgetSeconds;
+        const FMinesweeperNoGuessResult Result = FMinesweeperNoGuessGenerator::Generate(Rows, Columns, Mines, FirstClick, BaseSeed, Settings);
 
-            int32 MineCounter = 0;
-            for (int32 OffsetRow = -1; OffsetRow <= 1; ++OffsetRow)
+        AsyncTask(ENamedThreads::GameThread, [WeakWidget, SearchGameId, FirstClick, Result]()
+        {
+            if (const TSharedPtr<SMinesweeperWidget> Widget = WeakWidget.Pin())
             {
-                for (int32 OffsetCol = -1; OffsetCol <= 1; ++OffsetCol)
-                {
-                    int32 NeighborRow = RowIndex + OffsetRow;
-                    int32 NeighborCol = ColIndex + OffsetCol;
-                    
-                    if (NeighborRow >= 0 && NeighborRow < NumRows &&
-                        NeighborCol >= 0 && NeighborCol < NumColumns &&
-                        CellsWithMines[NeighborRow][NeighborCol])
-                    {
-                        ++MineCounter;
-                    }
-                }
+                Widget->OnNoGuessSearchFinished(SearchGameId, FirstClick, Result);
             }
-            AdjacentMines[RowIndex][ColIndex] = MineCounter;
-        }
-    }
+        });
+    });
 }
 
-void SMinesweeperWidget::RevealCell(int32 RowIndex, int32 ColIndex)
+void SMinesweeperWidget::OnNoGuessSearchFinished(uint32 SearchGameId, const FIntPoint& FirstClick, const FMinesweeperNoGuessResult& Result)
 {
-    if (CellsRevealed[RowIndex][ColIndex])
+    if (SearchGameId != GameId)
     {
         return;
     }
 
-    FString CellText = (AdjacentMines[RowIndex][ColIndex] > 0)
-                           ? FString::FromInt(AdjacentMines[RowIndex][ColIndex])
-                           : TEXT(" ");
-    FSlateColor CellTextColor = (AdjacentMines[RowIndex][ColIndex] > 0)
-                                    ? GetNumberColor(AdjacentMines[RowIndex][ColIndex])
-                                    : FSlateColor(FLinearColor::Black);
-
-    UpdateCellAppearance(RowIndex, ColIndex, CellText, CellTextColor);
-    CellsRevealed[RowIndex][ColIndex] = true;
-    Cells[RowIndex][ColIndex]->SetBackgroundColor(FLinearColor(0.8f, 0.8f, 0.8f, 1.f)); // Light Gray
-
-    ++SafeCellsRevealed;
-    CheckWinCondition();
-
-    if (AdjacentMines[RowIndex][ColIndex] == 0)
+    Board->PlaceMines(Result.Seed, FirstClick);
+    if (Result.bFound)
     {
-        RecursivelyRevealNeighbors(RowIndex, ColIndex);
+        UE_LOG(LogTemp, Log, TEXT("No-guess board found after %d attempts in %.2f ms, seed %llu."),
+            Result.NumAttempts, Result.ElapsedSeconds * 1000.0, Result.Seed);
+        StatusText = FText::GetEmpty();
     }
-}
-
-FSlateColor SMinesweeperWidget::GetNumberColor(int32 Number) const
-{
-    switch (Number)
+    else
     {
-    case 1: return FSlateColor(FLinearColor::Blue);
-    case 2: return FSlateColor(FLinearColor::Green);
-    case 3: return FSlateColor(FLinearColor::Red);
-    case 4: return FSlateColor(FLinearColor(0.5f, 0.f, 0.5f)); // Purple
-    case 5: return FSlateColor(FLinearColor(0.5f, 0.f, 0.f));   // Maroon
-    case 6: return FSlateColor(FLinearColor(0.25f, 0.88f, 0.81f)); // Turquoise
-    case 7: return FSlateColor(FLinearColor::Black);
-    case 8: return FSlateColor(FLinearColor::Gray);
-    default: return FSlateColor(FLinearColor::Black);
+        UE_LOG(LogTemp, Warning, TEXT("No no-guess board found in %d attempts and %.2f ms, using seed %llu, which may need a guess."),
+            Result.NumAttempts, Result.ElapsedSeconds * 1000.0, Result.Seed);
+        StatusText = FText::FromString(TEXT("No no-guess board found in time, this one may need a guess."));
     }
+
+    const TArray<FMinesweeperMove> Moves = MoveTemp(NoGuessPendingMoves);
+    NoGuessPendingMoves.Reset();
+    ApplyMoves(Moves);
 }
 
 void SMinesweeperWidget::InitializeGameState()
 {
-    GameOver = false;
-    GameWon = false;
-    SafeCellsRevealed = 0;
-
-    CellsFlagged.Empty();
-    CellsRevealed.Empty();
-    CellsWithMines.Empty();
-    AdjacentMines.Empty();
-    Cells.Empty();
+    Changes.Reset();
 }
 
 void SMinesweeperWidget::ResetGameState()
@@ -240,94 +283,100 @@ void SMinesweeperWidget::ResetGameState()
     GenerateGrid(NumRows, NumColumns, NumMines);
 }
 
-void SMinesweeperWidget::SetupGridPanel()
+void SMinesweeperWidget::MarkCellDirty(const FIntPoint& Cell)
 {
-    if (!GridPanel.IsValid())
-    {
-        GridPanel = SNew(SUniformGridPanel);
-    }
-    GridPanel->ClearChildren();
+    DirtyTiles.Add(FIntPoint(Cell.X >> FMinesweeperChunkedBoard::ChunkShift, Cell.Y >> FMinesweeperChunkedBoard::ChunkShift));
+    ScheduleFlush();
 }
 
-void SMinesweeperWidget::CreateCellWidgets()
+void SMinesweeperWidget::MarkAllCellsDirty()
 {
-    CellsFlagged.SetNum(NumRows);
-    CellsRevealed.SetNum(NumRows);
-    CellsWithMines.SetNum(NumRows);
-    AdjacentMines.SetNum(NumRows);
-    Cells.SetNum(NumRows);
+    bFullRefreshPending = true;
+    ScheduleFlush();
+}
 
-    for (int32 Row = 0; Row < NumRows; ++Row)
+void SMinesweeperWidget::ScheduleFlush()
+{
+    if (!FlushTimerHandle.IsValid())
     {
-        CellsFlagged[Row].SetNumZeroed(NumColumns);
-        CellsRevealed[Row].SetNumZeroed(NumColumns);
-        CellsWithMines[Row].SetNumZeroed(NumColumns);
-        AdjacentMines[Row].SetNumZeroed(NumColumns);
-        Cells[Row].SetNum(NumColumns);
-
-        for (int32 Col = 0; Col < NumColumns; ++Col)
-        {
-            Cells[Row][Col] =
-                SNew(SMinesweeperCellWidget)
-                .OnClicked(FOnClicked::CreateSP(this, &SMinesweeperWidget::OnCellClicked, Row, Col))
-                .OnRightClicked(FOnClicked::CreateSP(this, &SMinesweeperWidget::OnCellRightClicked, Row, Col))
-                .CellText(FText::FromString(TEXT(" ")))
-                .TextColor(FSlateColor(FLinearColor::Black));
-
-            GridPanel->AddSlot(Row, Col)
-            [
-                Cells[Row][Col].ToSharedRef()
-            ];
-        }
+        FlushTimerHandle = RegisterActiveTimer(0.f, FWidgetActiveTimerDelegate::CreateSP(this, &SMinesweeperWidget::FlushDirtyCells));
     }
 }
 
-void SMinesweeperWidget::UpdateCellAppearance(int32 Row, int32 Col, const FString& Text, const FSlateColor& Color)
+EActiveTimerReturnType SMinesweeperWidget::FlushDirtyCells(double InCurrentTime, float InDeltaTime)
 {
-    Cells[Row][Col]->UpdateCell(FText::FromString(Text), Color);
-}
+    MINESWEEPER_SCOPE_CYCLE_COUNTER(FlushDirtyCells);
 
-void SMinesweeperWidget::CheckWinCondition()
-{
-    const int32 TotalSafeCells = (NumRows * NumColumns) - NumMines;
-    if (SafeCellsRevealed == TotalSafeCells)
+    LastFlushInvalidations = 0;
+
+    // Text and colour changes never change the canvas size, so a single paint invalidation covers every dirty cell.
+    // Changes that are all scrolled out of view don't need one at all.
+    const bool bOverlayChanged = !DirtyTiles.IsEmpty() && UpdateProbabilityOverlay();
+    if (GridCanvas.IsValid() && (bFullRefreshPending || bOverlayChanged || AreAnyDirtyTilesVisible()))
     {
-        GameWon = true;
-        GameOver = true;
-        UE_LOG(LogTemp, Log, TEXT("Congratulations! You win!"));
-        HighlightAllSafeCells();
+        GridCanvas->Invalidate(EInvalidateWidget::Paint);
+        ++LastFlushInvalidations;
+        ++TotalInvalidations;
+        INC_DWORD_STAT(STAT_MinesweeperInvalidations);
     }
+
+    DirtyTiles.Reset();
+    bFullRefreshPending = false;
+    FlushTimerHandle.Reset();
+
+    return EActiveTimerReturnType::Stop;
 }
 
-void SMinesweeperWidget::RecursivelyRevealNeighbors(int32 RowIndex, int32 ColIndex)
+bool SMinesweeperWidget::AreAnyDirtyTilesVisible() const
 {
-    for (int32 OffsetRow = -1; OffsetRow <= 1; ++OffsetRow)
+    const FIntRect& VisibleCells = GridCanvas->GetVisibleCellRect();
+    if (VisibleCells.IsEmpty())
+    {
+        // Nothing painted yet, so there is no view to cull against.
+        return DirtyTiles.Num() > 0;
+    }
+
+    const int32 Shift = FMinesweeperChunkedBoard::ChunkShift;
+    const FIntRect VisibleTiles(
+        FIntPoint(VisibleCells.Min.X >> Shift, VisibleCells.Min.Y >> Shift),
+        FIntPoint((VisibleCells.Max.X - 1) >> Shift, (VisibleCells.Max.Y - 1) >> Shift));
+
+    for (const FIntPoint& Tile : DirtyTiles)
     {
-        for (int32 OffsetCol = -1; OffsetCol <= 1; ++OffsetCol)
+        if (Tile.X >= VisibleTiles.Min.X && Tile.X <= VisibleTiles.Max.X && Tile.Y >= VisibleTiles.Min.Y && Tile.Y <= VisibleTiles.Max.Y)
         {
-            int32 NeighborRow = RowIndex + OffsetRow;
-            int32 NeighborCol = ColIndex + OffsetCol;
-            
-            if (NeighborRow >= 0 && NeighborRow < NumRows &&
-                NeighborCol >= 0 && NeighborCol < NumColumns &&
-                !CellsRevealed[NeighborRow][NeighborCol])
-            {
-                RevealCell(NeighborRow, NeighborCol);
-            }
+            return true;
         }
     }
+    return false;
 }
 
-void SMinesweeperWidget::HighlightAllSafeCells()
+bool SMinesweeperWidget::UpdateProbabilityOverlay()
 {
-    for (int32 Row = 0; Row < NumRows; ++Row)
+    if (!GridCanvas.IsValid())
     {
-        for (int32 Col = 0; Col < NumColumns; ++Col)
-        {
-            if (!CellsWithMines[Row][Col])
-            {
-                Cells[Row][Col]->SetBackgroundColor(FLinearColor::Green);
-            }
-        }
+        return false;
     }
+
+    // Probabilities scan the whole board, which only makes sense while it is dense.
+    if (!CVarShowMineProbabilities.GetValueOnGameThread() || Board->IsGameOver() || !Board->AreMinesPlaced()
+        || Board->GetNumCells() >= MINESWEEPER_CHUNKED_BOARD_MIN_CELLS)
+    {
+        GridCanvas->SetProbabilityOverlay(nullptr);
+        return false;
+    }
+
+    MINESWEEPER_SCOPE_CYCLE_COUNTER(ProbabilityOverlay);
+    Solver.Solve();
+
+    FMinesweeperProbabilitySettings Settings;
+    Settings.TimeBudgetSeconds = OverlayTimeBudgetSeconds;
+    Settings.Seed = Board->GetSeed();
+    GridCanvas->SetProbabilityOverlay(FMinesweeperProbability::Calculate(*Board, &Solver, Settings));
+    return true;
+}
+
+void SMinesweeperWidget::HandleGameWon()
+{
+    UE_LOG(LogTemp, Log, TEXT("Congratulations! You win!"));
 }
@@ -1,20 +1,23 @@
 #pragma once
 
 #include "Widgets/SCompoundWidget.h"
+#include "Core/IMinesweeperBoard.h"
+#include "Core/MinesweeperSolver.h"
 
 #define DEFAULT_MINESWEEPER_NUM_MINES 15
 #define DEFAULT_MINESWEEPER_NUM_ROWS 10
 #define DEFAULT_MINESWEEPER_NUM_COLUMNS 10
 
+/** Boards with at least this many cells use chunked storage instead of one dense array. */
+#define MINESWEEPER_CHUNKED_BOARD_MIN_CELLS (int64(8192) * 8192)
+
 class SMinesweeperRestartButton;
-class SMinesweeperCellWidget;
-class SUniformGridPanel;
-class SButton;
-class STextBlock;
+class SMinesweeperGridCanvas;
+struct FMinesweeperNoGuessResult;
 
 /**
- * Generates a grid of buttons, places mines randomly,
- * calculates adjacent number of mines, and updates cells when revealed
+ * Hosts a board and the canvas that paints it. Small boards are dense, huge ones chunked.
+ * All game rules live in the board, the widget only forwards input and observes the result.
  */
 class SMinesweeperWidget final : public SCompoundWidget
 {
@@ -23,50 +26,93 @@ SLATE_BEGIN_ARGS(SMinesweeperWidget)
 		: _NumRows(DEFAULT_MINESWEEPER_NUM_ROWS)
 		, _NumColumns(DEFAULT_MINESWEEPER_NUM_COLUMNS)
 		, _NumMines(DEFAULT_MINESWEEPER_NUM_MINES)
+		, _Seed(0)
+		, _FirstClickSafe(true)
+		, _NoGuess(false)
 	{}
 	SLATE_ARGUMENT(int32, NumRows)
 	SLATE_ARGUMENT(int32, NumColumns)
-	SLATE_ARGUMENT(int32, NumMines)
+	SLATE_ARGUMENT(int64, NumMines)
+	/** Seed for the board's mine placement stream. 0 picks a new random seed for every game. */
+	SLATE_ARGUMENT(uint64, Seed)
+	/** Defer mine placement until the first click so that cell and its neighbours are always safe. */
+	SLATE_ARGUMENT(bool, FirstClickSafe)
+	/** Only hand out boards the solver can clear from the first click without guessing. Implies FirstClickSafe. */
+	SLATE_ARGUMENT(bool, NoGuess)
 SLATE_END_ARGS()
 
 	void Construct(const FArguments& InArgs);
 	void RestartGame();
 
+	/** Replaces the board with a new game of the given size, later restarts keep it. */
+	void StartNewGame(int32 InNumRows, int32 InNumColumns, int64 InNumMines);
+
+	/**
+	 * Applies a batch of reveals, flags and chords in one pass, as agents and solvers produce them. The board merges
+	 * their flood fills and the canvas is refreshed once for the whole batch.
+	 */
+	void ApplyMoves(TArrayView<const FMinesweeperMove> Moves);
+
+	/**
+	 * Paint invalidations issued by the most recent flush of dirty cells, 0 or 1. Flushes run at most once per frame, so
+	 * every move made within a frame shares one.
+	 */
+	int32 GetLastFlushInvalidations() const { return LastFlushInvalidations; }
+	int32 GetTotalInvalidations() const { return TotalInvalidations; }
+
 private:
 	TSharedPtr<SMinesweeperRestartButton> RestartButton;
-	bool GameOver = false;
-	bool GameWon = false;         
-	int32 SafeCellsRevealed = 0;
+	TSharedPtr<SMinesweeperGridCanvas> GridCanvas;
 
-	int32 NumMines = DEFAULT_MINESWEEPER_NUM_MINES;
+	int64 NumMines = DEFAULT_MINESWEEPER_NUM_MINES;
 	int32 NumRows = DEFAULT_MINESWEEPER_NUM_ROWS;
 	int32 NumColumns = DEFAULT_MINESWEEPER_NUM_COLUMNS;
+	uint64 Seed = 0;
+	bool bFirstClickSafe = true;
+	bool bNoGuess = false;
+
+	TUniquePtr<IMinesweeperBoard> Board;
+
+	/** Follows every reveal so deductions stay incremental, feeds the probability overlay. */
+	FMinesweeperSolver Solver;
 
-	TSharedPtr<SUniformGridPanel> GridPanel;
-	TArray<TArray<TSharedPtr<SMinesweeperCellWidget>>> Cells;
+	/** Scratch change set reused by every batch so clicks don't allocate. */
+	FMinesweeperChangeSet Changes;
 
-	TArray<TArray<bool>> CellsWithMines;
-	TArray<TArray<bool>> CellsRevealed;
-	TArray<TArray<bool>> CellsFlagged;
-	TArray<TArray<int32>> AdjacentMines;
+	/**
+	 * 64x64 cell tiles changed since the last flush, flushed at most once per frame. Sparse so huge boards don't pay
+	 * for a per-cell bitmap, and only tiles inside the canvas' visible cells cause a repaint.
+	 */
+	TSet<FIntPoint> DirtyTiles;
+	bool bFullRefreshPending = false;
+	TWeakPtr<FActiveTimerHandle> FlushTimerHandle;
 
-	void GenerateGrid(int32 RowSize, int32 ColumnSize, int32 BombCount);
-	void PlaceMines(int32 BombCount);
-	void CalculateAdjacency();
+	int32 LastFlushInvalidations = 0;
+	int32 TotalInvalidations = 0;
+
+	/** Bumped by every new board so a no-guess search finishing after a restart is ignored. */
+	uint32 GameId = 0;
+
+	/** Moves of the first click, held while the no-guess search places the mines off the game thread. */
+	TArray<FMinesweeperMove> NoGuessPendingMoves;
+
+	/** Shown under the restart button, e.g. while searching or when a board may need a guess. */
+	FText StatusText;
+
+	void GenerateGrid(int32 RowSize, int32 ColumnSize, int64 BombCount);
 
 	FReply OnCellClicked(int32 Row, int32 Col);
 	FReply OnCellRightClicked(int32 Row, int32 Col);
-	void RevealCell(int32 RowIndex, int32 ColumnIndex);
-	void RevealAllMines();
-
-	FSlateColor GetNumberColor(int32 Number) const;
 
+	void StartNoGuessSearch(const FIntPoint& FirstClick, TArrayView<const FMinesweeperMove> Moves);
+	void OnNoGuessSearchFinished(uint32 SearchGameId, const FIntPoint& FirstClick, const FMinesweeperNoGuessResult& Result);
 	void InitializeGameState();
 	void ResetGameState();
-	void SetupGridPanel();
-	void CreateCellWidgets();
-	void UpdateCellAppearance(int32 Row, int32 Col, const FString& Text, const FSlateColor& Color);
-	void CheckWinCondition();
-	void RecursivelyRevealNeighbors(int32 RowIndex, int32 ColIndex);
-	void HighlightAllSafeCells();
-};
\ No newline at end of file
+	void MarkCellDirty(const FIntPoint& Cell);
+	void MarkAllCellsDirty();
+	void ScheduleFlush();
+	EActiveTimerReturnType FlushDirtyCells(double InCurrentTime, float InDeltaTime);
+	bool AreAnyDirtyTilesVisible() const;
+	bool UpdateProbabilityOverlay();
+	void HandleGameWon();
+};
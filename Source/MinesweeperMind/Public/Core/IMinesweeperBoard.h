@@ -0,0 +1,132 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Core/MinesweeperMove.h"
+
+/**
+ * Bit layout of a single packed board cell.
+ * The low nibble holds the number of adjacent mines (0-8), the high nibble holds the state flags.
+ */
+namespace MinesweeperCell
+{
+	constexpr uint8 AdjacencyMask = 0x0F;
+	constexpr uint8 Mine = 0x10;
+	constexpr uint8 Revealed = 0x20;
+	constexpr uint8 Flagged = 0x40;
+}
+
+enum class EMinesweeperRevealResult : uint8
+{
+	/** Cell was out of bounds, already revealed, or the game is over. */
+	Ignored,
+	/** One or more safe cells were revealed. */
+	Revealed,
+	/** The cell was a mine, the game is lost. */
+	HitMine
+};
+
+/** Cells one batch of moves changed, so whoever draws the board refreshes once per batch. */
+struct FMinesweeperChangeSet
+{
+	/** Newly revealed cells, flood fills included, and the mine that ended the game if one was hit. */
+	TArray<FIntPoint> Revealed;
+
+	/** Cells whose flag was toggled. */
+	TArray<FIntPoint> Flagged;
+
+	/** Revealed cells that lost a flag by being revealed, so the batch can be undone. Only dense boards report these. */
+	TArray<FIntPoint> Unflagged;
+
+	void Reset()
+	{
+		Revealed.Reset();
+		Flagged.Reset();
+		Unflagged.Reset();
+	}
+
+	bool IsEmpty() const { return Revealed.IsEmpty() && Flagged.IsEmpty(); }
+};
+
+/**
+ * Game state and rules of one Minesweeper board, independent of how the cells are stored.
+ * SMinesweeperWidget and its canvas only talk to this interface, so dense and chunked storage are interchangeable.
+ */
+class MINESWEEPERMIND_API IMinesweeperBoard
+{
+public:
+	virtual ~IMinesweeperBoard() = default;
+
+	/**
+	 * Allocates an empty board, clearing any previous game. A mine count that doesn't fit, around the first click's
+	 * opening on a dense board, is clamped with a warning.
+	 */
+	virtual void Initialize(int32 InNumRows, int32 InNumColumns, int64 InNumMines) = 0;
+
+	/**
+	 * Places the mines deterministically from Seed. If SafeCell is valid it and its eight neighbours never
+	 * receive a mine.
+	 */
+	virtual void PlaceMines(uint64 Seed, const FIntPoint& SafeCell = FIntPoint(INDEX_NONE, INDEX_NONE)) = 0;
+
+	/** Leaves the board empty until the first reveal, which then places mines around a guaranteed safe opening. */
+	virtual void DeferMinePlacement(uint64 Seed) = 0;
+
+	/**
+	 * Reveals a cell, flood filling through empty cells without recursion.
+	 * OutRevealed receives every newly revealed cell as one batch, the win check runs once per batch.
+	 */
+	virtual EMinesweeperRevealResult Reveal(int32 Row, int32 Column, TArray<FIntPoint>& OutRevealed) = 0;
+
+	/** Returns true if the flag state of the cell changed. */
+	virtual bool ToggleFlag(int32 Row, int32 Column) = 0;
+
+	/**
+	 * Applies any move type through Reveal and ToggleFlag. OutRevealed receives every cell a reveal or chord opened.
+	 * Returns true if the board changed, check IsGameOver for the outcome.
+	 */
+	bool ApplyMove(const FMinesweeperMove& Move, TArray<FIntPoint>& OutRevealed);
+
+	/**
+	 * Applies Moves in order with the same outcome as one ApplyMove each, stopping once the game is over.
+	 * OutChanges receives everything the batch changed. The default goes through ApplyMove, boards override it
+	 * to merge the batch's flood fills and win checks.
+	 */
+	virtual void ApplyMoves(TArrayView<const FMinesweeperMove> Moves, FMinesweeperChangeSet& OutChanges);
+
+	/** True if Chord applies at the cell, a revealed number with exactly that many flagged neighbours. */
+	bool CanChord(int32 Row, int32 Column) const;
+
+	/** Packed cell, see MinesweeperCell. Only valid for cells inside the board. */
+	virtual uint8 GetCell(int32 Row, int32 Column) const = 0;
+
+	virtual int32 GetNumRows() const = 0;
+	virtual int32 GetNumColumns() const = 0;
+	virtual int64 GetNumMines() const = 0;
+	virtual int64 GetSafeCellsRevealed() const = 0;
+
+	virtual bool AreMinesPlaced() const = 0;
+	virtual uint64 GetSeed() const = 0;
+	/** Cell kept clear of mines during placement, or (INDEX_NONE, INDEX_NONE). */
+	virtual FIntPoint GetSafeCell() const = 0;
+
+	virtual bool IsGameOver() const = 0;
+	virtual bool IsGameWon() const = 0;
+
+	/** Mine that ended the game, or (INDEX_NONE, INDEX_NONE) if no mine was hit. */
+	virtual FIntPoint GetExplodedCell() const = 0;
+
+	/** Bytes held by the board's cell storage. */
+	virtual SIZE_T GetAllocatedSize() const = 0;
+
+	FORCEINLINE int64 GetNumCells() const { return int64(GetNumRows()) * GetNumColumns(); }
+
+	FORCEINLINE bool IsValidCell(int32 Row, int32 Column) const
+	{
+		return Row >= 0 && Row < GetNumRows() && Column >= 0 && Column < GetNumColumns();
+	}
+
+	FORCEINLINE bool IsMine(int32 Row, int32 Column) const { return (GetCell(Row, Column) & MinesweeperCell::Mine) != 0; }
+	FORCEINLINE bool IsRevealed(int32 Row, int32 Column) const { return (GetCell(Row, Column) & MinesweeperCell::Revealed) != 0; }
+	FORCEINLINE bool IsFlagged(int32 Row, int32 Column) const { return (GetCell(Row, Column) & MinesweeperCell::Flagged) != 0; }
+	FORCEINLINE int32 GetAdjacentMines(int32 Row, int32 Column) const { return GetCell(Row, Column) & MinesweeperCell::AdjacencyMask; }
+};
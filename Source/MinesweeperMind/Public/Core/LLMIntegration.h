@@ -5,6 +5,6 @@
 class MINESWEEPERMIND_API LLMIntegration
 {
 public:
- // Calls the Python script and returns a JSON string
- static FString GetMinesweeperDimensions();
+ // Asks the inference worker for grid dimensions and returns them as a JSON string, empty on failure. Repeated queries come from FMinesweeperDimensionCache
+ static FString GetMinesweeperDimensions(const FString& Query = TEXT("Generate an expert Minesweeper grid"));
 };
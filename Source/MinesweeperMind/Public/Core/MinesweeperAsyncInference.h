@@ -0,0 +1,56 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "HAL/CriticalSection.h"
+#include <atomic>
+
+class FJsonObject;
+
+/**
+ * One inference request running on a background thread so the editor never waits on the model.
+ *
+ * Streamed tokens are collected on the worker thread and handed to the game thread in batches, at most once per
+ * TokenBatchSeconds, so a fast model does not rebuild the UI for every token. Both delegates fire on the game thread
+ * and never after Cancel.
+ */
+class MINESWEEPERMIND_API FMinesweeperAsyncInference : public TSharedFromThis<FMinesweeperAsyncInference, ESPMode::ThreadSafe>
+{
+public:
+	/** Text streamed since the previous batch. */
+	DECLARE_DELEGATE_OneParam(FOnTokens, const FString& /*NewText*/);
+	DECLARE_DELEGATE_ThreeParams(FOnFinished, bool /*bSucceeded*/, const TSharedPtr<FJsonObject>& /*Result*/, const FString& /*Error*/);
+
+	/** Starts Method on the shared FMinesweeperInferenceClient. Call from the game thread. */
+	static TSharedRef<FMinesweeperAsyncInference> Start(const FString& Method, const TSharedRef<FJsonObject>& Params, FOnTokens OnTokens, FOnFinished OnFinished);
+
+	/** Stops the request and the worker's generation. Safe to call repeatedly and after the request finished. */
+	void Cancel();
+
+	bool IsRunning() const { return !bCancelRequested && !bFinished; }
+
+private:
+	FMinesweeperAsyncInference(const FString& InMethod, const TSharedRef<FJsonObject>& InParams, FOnTokens InOnTokens, FOnFinished InOnFinished);
+
+	/** Background thread body. */
+	void Run();
+
+	/** Game thread ticker, delivers pending tokens and the result. Returns false once there is nothing left to do. */
+	bool Tick(float DeltaTime);
+
+	FString Method;
+	TSharedRef<FJsonObject> Params;
+	FOnTokens OnTokens;
+	FOnFinished OnFinished;
+
+	std::atomic<bool> bCancelRequested = false;
+	/** Set on the game thread once OnFinished has fired. */
+	std::atomic<bool> bFinished = false;
+
+	/** Guards everything below, written by the background thread and read by Tick. */
+	FCriticalSection PendingMutex;
+	FString PendingText;
+	bool bCallFinished = false;
+	bool bSucceeded = false;
+	TSharedPtr<FJsonObject> Result;
+	FString Error;
+};
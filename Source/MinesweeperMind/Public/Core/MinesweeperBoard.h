@@ -0,0 +1,85 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Core/IMinesweeperBoard.h"
+
+/**
+ * Dense Minesweeper board.
+ * Stores the whole board in one flat byte array so it can be driven and inspected without Slate.
+ */
+class MINESWEEPERMIND_API FMinesweeperBoard final : public IMinesweeperBoard
+{
+public:
+	//~ Begin IMinesweeperBoard Interface
+	virtual void Initialize(int32 InNumRows, int32 InNumColumns, int64 InNumMines) override;
+
+	/** Uses Floyd's sampling algorithm on a PCG stream and then calculates adjacency. Costs O(mines) regardless of board size. */
+	virtual void PlaceMines(uint64 InSeed, const FIntPoint& InSafeCell = FIntPoint(INDEX_NONE, INDEX_NONE)) override;
+	virtual void DeferMinePlacement(uint64 InSeed) override;
+	virtual EMinesweeperRevealResult Reveal(int32 Row, int32 Column, TArray<FIntPoint>& OutRevealed) override;
+	virtual bool ToggleFlag(int32 Row, int32 Column) override;
+
+	/** Seeds every safe reveal and chord of the batch into one flood fill, followed by one win check. */
+	virtual void ApplyMoves(TArrayView<const FMinesweeperMove> Moves, FMinesweeperChangeSet& OutChanges) override;
+
+	virtual uint8 GetCell(int32 Row, int32 Column) const override { return Cells[ToIndex(Row, Column)]; }
+	virtual int32 GetNumRows() const override { return NumRows; }
+	virtual int32 GetNumColumns() const override { return NumColumns; }
+	virtual int64 GetNumMines() const override { return NumMines; }
+	virtual int64 GetSafeCellsRevealed() const override { return SafeCellsRevealed; }
+
+	virtual bool AreMinesPlaced() const override { return bMinesPlaced; }
+	virtual uint64 GetSeed() const override { return Seed; }
+	virtual FIntPoint GetSafeCell() const override { return SafeCell; }
+
+	virtual bool IsGameOver() const override { return bGameOver; }
+	virtual bool IsGameWon() const override { return bGameWon; }
+	virtual FIntPoint GetExplodedCell() const override;
+	virtual SIZE_T GetAllocatedSize() const override { return Cells.GetAllocatedSize() + RevealStack.GetAllocatedSize(); }
+	//~ End IMinesweeperBoard Interface
+
+	void CalculateAdjacency();
+
+	/**
+	 * Places mines from a bitmap instead of the seed, one bit per cell, row major, least significant bit first.
+	 * Seed and SafeCell are only recorded. Used to replay snapshots that carry their own mine layout.
+	 */
+	void PlaceMinesFromLayout(TArrayView<const uint8> MineBits, uint64 InSeed, const FIntPoint& InSafeCell);
+
+	/**
+	 * Takes back the most recent change set still applied, cells given as row major indices, in time proportional to
+	 * their number. Flag toggles are flipped back, revealed cells hidden again with their flags restored, and the game
+	 * is no longer over since nothing is ever applied after it ends. Mines stay where the first reveal placed them.
+	 */
+	void RevertChanges(TArrayView<const int32> Revealed, TArrayView<const int32> Flagged, TArrayView<const int32> Unflagged);
+
+	/** Raw packed cells, row major. */
+	FORCEINLINE const uint8* GetCellData() const { return Cells.GetData(); }
+
+private:
+	FORCEINLINE int32 ToIndex(int32 Row, int32 Column) const { return Row * NumColumns + Column; }
+
+	void PushReveal(int32 CellIndex);
+
+	/** Reveals everything on RevealStack and what it opens, appending to OutRevealed and any cleared flags to OutUnflagged. */
+	void FloodReveal(TArray<FIntPoint>& OutRevealed, TArray<FIntPoint>* OutUnflagged = nullptr);
+	void CheckWinCondition();
+
+	TArray<uint8> Cells;
+
+	/** Pending empty cells of the current flood fill. Kept between reveals so its allocation is reused. */
+	TArray<int32> RevealStack;
+
+	int32 NumRows = 0;
+	int32 NumColumns = 0;
+	int32 NumMines = 0;
+	int32 SafeCellsRevealed = 0;
+	int32 ExplodedIndex = INDEX_NONE;
+
+	uint64 Seed = 0;
+	FIntPoint SafeCell = FIntPoint(INDEX_NONE, INDEX_NONE);
+	bool bMinesPlaced = false;
+
+	bool bGameOver = false;
+	bool bGameWon = false;
+};
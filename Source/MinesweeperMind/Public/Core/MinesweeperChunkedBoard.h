@@ -0,0 +1,132 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Core/IMinesweeperBoard.h"
+
+/**
+ * Sparse Minesweeper board for grids far too large to allocate densely.
+ *
+ * Cells live in 64x64 chunks that are only created when a reveal or flag touches them. A chunk's mine layout is a
+ * pure function of the board seed and the chunk coordinate, so neighbouring chunks never need to exist to compute a
+ * border cell's adjacency, reads of cells outside any chunk compute them from the seed, and a chunk that hasn't been
+ * touched for a while is compressed down to its run-length encoded revealed/flagged bits. Memory grows with the
+ * explored area, not the board area or how much of it is looked at.
+ *
+ * Mines are spread evenly: every chunk receives its share of the total, then Floyd-samples positions inside itself.
+ */
+class MINESWEEPERMIND_API FMinesweeperChunkedBoard final : public IMinesweeperBoard
+{
+public:
+	static constexpr int32 ChunkShift = 6;
+	static constexpr int32 ChunkSize = 1 << ChunkShift;
+	static constexpr int32 ChunkMask = ChunkSize - 1;
+	static constexpr int32 CellsPerChunk = ChunkSize * ChunkSize;
+
+	//~ Begin IMinesweeperBoard Interface
+	virtual void Initialize(int32 InNumRows, int32 InNumColumns, int64 InNumMines) override;
+	virtual void PlaceMines(uint64 InSeed, const FIntPoint& InSafeCell = FIntPoint(INDEX_NONE, INDEX_NONE)) override;
+	virtual void DeferMinePlacement(uint64 InSeed) override;
+	virtual EMinesweeperRevealResult Reveal(int32 Row, int32 Column, TArray<FIntPoint>& OutRevealed) override;
+	virtual bool ToggleFlag(int32 Row, int32 Column) override;
+
+	/** Never creates or decompresses a chunk, cells outside a hot chunk are computed from the seed and compressed state. */
+	virtual uint8 GetCell(int32 Row, int32 Column) const override;
+	virtual int32 GetNumRows() const override { return NumRows; }
+	virtual int32 GetNumColumns() const override { return NumColumns; }
+	virtual int64 GetNumMines() const override { return NumMines; }
+	virtual int64 GetSafeCellsRevealed() const override { return SafeCellsRevealed; }
+
+	virtual bool AreMinesPlaced() const override { return bMinesPlaced; }
+	virtual uint64 GetSeed() const override { return Seed; }
+	virtual FIntPoint GetSafeCell() const override { return SafeCell; }
+
+	virtual bool IsGameOver() const override { return bGameOver; }
+	virtual bool IsGameWon() const override { return bGameWon; }
+	virtual FIntPoint GetExplodedCell() const override { return ExplodedCell; }
+	virtual SIZE_T GetAllocatedSize() const override;
+	//~ End IMinesweeperBoard Interface
+
+	/** Compresses every chunk that hasn't been touched in the last ColdMoveThreshold moves. Also runs periodically on its own. */
+	void CompressColdChunks();
+
+	int32 GetNumChunks() const { return Chunks.Num(); }
+	int32 GetNumCompressedChunks() const;
+
+private:
+	struct FChunk
+	{
+		/** Packed cells while hot, empty while compressed. */
+		TArray<uint8> Cells;
+		/** Run-length encoded revealed and flagged row bits while compressed. */
+		TArray<uint8> CompressedState;
+		uint32 LastTouchedMove = 0;
+	};
+
+	static FORCEINLINE uint64 MakeChunkKey(int32 ChunkRow, int32 ChunkColumn)
+	{
+		return (uint64(uint32(ChunkRow)) << 32) | uint32(ChunkColumn);
+	}
+
+	/** Cell of a hot chunk for writing, the chunk is created or decompressed first. Only moves call this. */
+	FORCEINLINE uint8& AccessCell(int32 Row, int32 Column)
+	{
+		uint8* ChunkCells = GetHotChunkCells(Row >> ChunkShift, Column >> ChunkShift);
+		return ChunkCells[((Row & ChunkMask) << ChunkShift) | (Column & ChunkMask)];
+	}
+
+	uint8* GetHotChunkCells(int32 ChunkRow, int32 ChunkColumn);
+	void WarmChunk(FChunk& Chunk, int32 ChunkRow, int32 ChunkColumn) const;
+	void CompressChunk(FChunk& Chunk);
+
+	/** The chunk if one was created, hot or compressed. */
+	const FChunk* FindChunk(int32 ChunkRow, int32 ChunkColumn) const;
+
+	/** Revealed and flagged bits of one cell of a compressed chunk, read from its runs. */
+	static uint8 ReadCompressedState(const FChunk& Chunk, int32 LocalRow, int32 LocalColumn);
+
+	/** Whether the seeded layout puts a mine on the cell, through a few cached chunk layouts. */
+	bool IsLayoutMine(int32 Row, int32 Column) const;
+	void ResetReadLayouts();
+
+	/** One bit per cell, one word per chunk row, for the deterministic mine layout of a chunk. */
+	void BuildMineLayout(int32 ChunkRow, int32 ChunkColumn, uint64 (&OutRowBits)[ChunkSize]) const;
+	int32 GetChunkMineShare(int32 ChunkRow, int32 ChunkColumn) const;
+	void GetExcludedCells(int32 ChunkRow, int32 ChunkColumn, TArray<int32, TInlineAllocator<9>>& OutExcludedCells) const;
+
+	void EndMove();
+	void CheckWinCondition();
+
+	TMap<uint64, TUniquePtr<FChunk>> Chunks;
+
+	/** Most recently accessed chunk, flood fills mostly stay inside one. */
+	uint64 CachedChunkKey = MAX_uint64;
+	FChunk* CachedChunk = nullptr;
+	uint32 MoveCounter = 0;
+
+	/** Layouts GetCell built for cells outside hot chunks, enough for the 3x3 around a chunk corner. */
+	struct FReadLayout
+	{
+		uint64 Key = MAX_uint64;
+		uint64 RowBits[ChunkSize];
+	};
+	mutable FReadLayout ReadLayouts[4];
+	mutable int32 NextReadLayout = 0;
+
+	TArray<FIntPoint> RevealStack;
+
+	int32 NumRows = 0;
+	int32 NumColumns = 0;
+	int32 NumChunkRows = 0;
+	int32 NumChunkColumns = 0;
+	int64 NumMines = 0;
+	double MineDensity = 0.0;
+	int64 SafeCellsRevealed = 0;
+	FIntPoint ExplodedCell = FIntPoint(INDEX_NONE, INDEX_NONE);
+
+	uint64 Seed = 0;
+	FIntPoint SafeCell = FIntPoint(INDEX_NONE, INDEX_NONE);
+	bool bMinesPlaced = false;
+
+	bool bGameOver = false;
+	bool bGameWon = false;
+};
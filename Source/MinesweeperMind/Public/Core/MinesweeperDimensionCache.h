@@ -0,0 +1,82 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Containers/LruCache.h"
+#include "HAL/CriticalSection.h"
+
+class FJsonObject;
+
+struct FMinesweeperDimensionCacheStats
+{
+	int32 NumMemoryHits = 0;
+	int32 NumDiskHits = 0;
+	int32 NumMisses = 0;
+	/** Answers the model produced and the cache stored. */
+	int32 NumStores = 0;
+	/** Time spent in Find, hits and misses alike. */
+	double LookupSeconds = 0.0;
+	/** Time the model took for the stored answers, what an average hit saves. */
+	double ModelSeconds = 0.0;
+
+	int32 GetNumHits() const { return NumMemoryHits + NumDiskHits; }
+	double GetHitRate() const { return GetNumHits() + NumMisses > 0 ? double(GetNumHits()) / (GetNumHits() + NumMisses) : 0.0; }
+};
+
+/**
+ * Remembers generate_dimensions answers so a repeated request skips the model. Queries are keyed by their
+ * FMinesweeperIntentParser::Normalize form, so "expert", "hard level" and "make an expert game" share one entry.
+ *
+ * Recent entries live in an in-memory LRU, every entry is also written to the plugin's Saved/QueryCache directory and
+ * survives editor restarts. Both tiers are keyed by a fingerprint of the model files, the worker command line and the
+ * prompt script, so swapping the model or editing the prompt template starts from an empty cache and the stale
+ * directory is removed. The fingerprint is taken once and again only when the worker command line changes or
+ * InvalidateFingerprint is called, lookups never touch the model files. Safe to use from any thread.
+ */
+class MINESWEEPERMIND_API FMinesweeperDimensionCache
+{
+public:
+	/** Cache stored under the plugin's Saved directory, sized by MinesweeperMind.DimensionCache.MemoryEntries. */
+	static FMinesweeperDimensionCache& Get();
+
+	/**
+	 * InDirectory holds the disk tier, none if empty. The fingerprint reads LargeLanguageModels and Scripts under
+	 * InContentDir, the plugin's Content directory if empty.
+	 */
+	FMinesweeperDimensionCache(const FString& InDirectory, int32 InMaxMemoryEntries, const FString& InContentDir = FString());
+
+	/** The stored answer for Query, memory first and then disk. Null on a miss or when the cache is disabled. */
+	TSharedPtr<FJsonObject> Find(const FString& Query);
+
+	/** Stores a good answer for Query. ModelSeconds is how long the model took to produce it. */
+	void Add(const FString& Query, const TSharedRef<FJsonObject>& Result, double ModelSeconds);
+
+	/** Drops both tiers. */
+	void Clear();
+
+	/** Fingerprints the model files and scripts again on the next lookup, for when they changed on disk. */
+	void InvalidateFingerprint();
+
+	FMinesweeperDimensionCacheStats GetStats() const;
+
+private:
+	/** The fingerprint for the current worker settings, computed on first use. Expects Mutex to be held. */
+	const FString& GetFingerprint();
+
+	/** Hash of everything that can change an answer apart from the query. Scans the models and hashes the scripts. */
+	FString ComputeFingerprint(const FString& WorkerCommandLine) const;
+
+	/** Directory for Fingerprint's entries, empty without a disk tier. Removes other fingerprints' directories the first time it is seen. Expects Mutex to be held. */
+	FString GetEntryDirectory(const FString& Fingerprint);
+
+	FString Directory;
+	FString ContentDir;
+	int32 MaxMemoryEntries;
+	mutable FCriticalSection Mutex;
+	/** Keyed by fingerprint and normalized query. */
+	TLruCache<FString, TSharedPtr<FJsonObject>> MemoryEntries;
+	FString PrunedFingerprint;
+	FString CachedFingerprint;
+	/** Worker command line CachedFingerprint was computed for. */
+	FString FingerprintWorkerCommandLine;
+	FMinesweeperDimensionCacheStats Stats;
+};
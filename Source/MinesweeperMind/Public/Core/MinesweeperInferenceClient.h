@@ -0,0 +1,99 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "HAL/CriticalSection.h"
+#include "HAL/PlatformProcess.h"
+#include "Templates/Function.h"
+#include <atomic>
+
+class FJsonObject;
+
+struct FMinesweeperInferenceWorkerSettings
+{
+	/** Program that runs the worker. */
+	FString Executable = TEXT("python");
+	/** Worker command line, empty runs the plugin's Content/Scripts/inference_worker.py. Append --stub to run without a model. */
+	FString Arguments;
+	/** Longest a request may go without hearing from the worker, the first one includes loading the model. */
+	double TimeoutSeconds = 120.0;
+	/** Times a request restarts a worker that died underneath it before giving up. */
+	int32 MaxRestarts = 1;
+
+	bool operator==(const FMinesweeperInferenceWorkerSettings& Other) const
+	{
+		return Executable == Other.Executable && Arguments == Other.Arguments && TimeoutSeconds == Other.TimeoutSeconds && MaxRestarts == Other.MaxRestarts;
+	}
+};
+
+/**
+ * Talks to a long-lived inference worker process over its stdin and stdout, so the model is loaded once instead of
+ * once per request.
+ *
+ * Every message is a 4-byte little-endian length followed by UTF-8 JSON. Requests carry an id and the worker echoes it,
+ * answers to requests that already timed out or were cancelled are recognised by their id and dropped. The worker is
+ * started on the first call and started again when it has exited. Calls block and are serialized, so any thread may
+ * make them, see FMinesweeperAsyncInference for the non-blocking form.
+ */
+class MINESWEEPERMIND_API FMinesweeperInferenceClient
+{
+public:
+	explicit FMinesweeperInferenceClient(const FMinesweeperInferenceWorkerSettings& InSettings = FMinesweeperInferenceWorkerSettings());
+	~FMinesweeperInferenceClient();
+
+	FMinesweeperInferenceClient(const FMinesweeperInferenceClient&) = delete;
+	FMinesweeperInferenceClient& operator=(const FMinesweeperInferenceClient&) = delete;
+
+	/** Sends Method with Params and waits for the answer. On failure OutError says why and OutResult is null. */
+	bool Call(const FString& Method, const TSharedRef<FJsonObject>& Params, TSharedPtr<FJsonObject>& OutResult, FString& OutError);
+
+	/**
+	 * Like Call, but the worker streams partial answers to OnToken on the calling thread as it produces them. Setting
+	 * bCancelRequested from any thread makes the call return false within a millisecond and tells the worker to stop.
+	 */
+	bool CallStreaming(const FString& Method, const TSharedRef<FJsonObject>& Params, TFunctionRef<void(const FString& /*Token*/)> OnToken,
+		const std::atomic<bool>& bCancelRequested, TSharedPtr<FJsonObject>& OutResult, FString& OutError);
+
+	/** Closes the worker's stdin so it exits, and kills it if it does not. */
+	void Stop();
+
+	bool IsWorkerRunning();
+	const FMinesweeperInferenceWorkerSettings& GetSettings() const { return Settings; }
+	int32 GetNumWorkerStarts() const { return NumWorkerStarts; }
+
+	/**
+	 * Shared client built from the MinesweeperMind.Inference.* console variables. Changing them swaps in a new client,
+	 * callers that still hold the old one finish on it.
+	 */
+	static TSharedRef<FMinesweeperInferenceClient> Get();
+
+	/** Stops the shared worker, called on module shutdown. */
+	static void Shutdown();
+
+private:
+	bool CallInternal(const FString& Method, const TSharedRef<FJsonObject>& Params, const TFunctionRef<void(const FString&)>* OnToken,
+		const std::atomic<bool>* bCancelRequested, TSharedPtr<FJsonObject>& OutResult, FString& OutError);
+	bool StartWorker(FString& OutError);
+	bool SendFrame(const FString& Json);
+	/** Stops the worker generating RequestId, whatever it still sends for that id is dropped by the next call. */
+	void SendCancel(int64 RequestId);
+	/** Waits for the next complete frame until Deadline. False on timeout, cancellation or when the worker exited. */
+	bool ReceiveFrame(FString& OutJson, double Deadline, const std::atomic<bool>* bCancelRequested);
+	/** Ends the worker if it is running and releases the process and pipes. Expects Mutex to be held. */
+	void StopWorker();
+	void DrainWorkerLog();
+
+	FMinesweeperInferenceWorkerSettings Settings;
+	FCriticalSection Mutex;
+
+	FProcHandle Process;
+	void* StdInRead = nullptr;
+	void* StdInWrite = nullptr;
+	void* StdOutRead = nullptr;
+	void* StdOutWrite = nullptr;
+	void* StdErrRead = nullptr;
+	void* StdErrWrite = nullptr;
+
+	TArray<uint8> ReceiveBuffer;
+	int64 NextRequestId = 1;
+	int32 NumWorkerStarts = 0;
+};
@@ -0,0 +1,63 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+enum class EMinesweeperBoardRequestSource : uint8
+{
+	/** FMinesweeperIntentParser recognised the text, no model involved. */
+	Parser,
+	/** The text needed the model's generate_dimensions. */
+	Model,
+	/** An earlier model answer to the same normalized query, see FMinesweeperDimensionCache. */
+	Cache,
+};
+
+struct FMinesweeperBoardRequest
+{
+	int32 NumRows = 0;
+	int32 NumColumns = 0;
+	int64 NumMines = 0;
+	EMinesweeperBoardRequestSource Source = EMinesweeperBoardRequestSource::Parser;
+
+	/** At least one row, column and mine, and at least one safe cell. */
+	bool IsValid() const { return NumRows > 0 && NumColumns > 0 && NumMines > 0 && NumMines < int64(NumRows) * NumColumns; }
+};
+
+enum class EMinesweeperIntentMatch : uint8
+{
+	/** Nothing in the text is about a board, treat it as conversation. */
+	NotABoard,
+	/** Looks like a board request the parser cannot fully account for, ask the model. */
+	NeedsModel,
+	/** Every word and number was understood. */
+	Parsed,
+};
+
+/**
+ * Turns board requests such as "10 10 15", "3x3 with 2 mines", "expert" or "16 by 30, 99 mines" into dimensions
+ * without the model. It only answers when it can account for every word and number in the text, anything else is left
+ * to the model, so a confident parse is never a guess.
+ *
+ * Presets: beginner 9x9 with 10 mines, intermediate 16x16 with 40, expert 16x30 with 99. Explicit numbers override
+ * the preset, a size without a mine count gets the default 15% density.
+ */
+class MINESWEEPERMIND_API FMinesweeperIntentParser
+{
+public:
+	static EMinesweeperIntentMatch Parse(const FString& Text, FMinesweeperBoardRequest& OutRequest);
+
+	/**
+	 * Canonical form of a board request for caching, "Make an EXPERT game" and "hard level" both become "expert".
+	 * Filler words and punctuation are dropped, synonyms are folded and numbers kept in order.
+	 */
+	static FString Normalize(const FString& Text);
+
+	/** Counts an answered board request by the path that produced it. */
+	static void RecordAnswer(EMinesweeperBoardRequestSource Source);
+
+	static int32 GetNumParserAnswers();
+	static int32 GetNumModelAnswers();
+	static int32 GetNumCacheAnswers();
+	/** Share of answered board requests the model never saw, parsed or cached. */
+	static double GetModelBypassRate();
+};
@@ -0,0 +1,51 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include <atomic>
+
+/** A model file, where it comes from and what it must hash to. */
+struct FMinesweeperModelAsset
+{
+	FString Url;
+	/** Absolute path of the downloaded file. */
+	FString Path;
+	/** Expected SHA-256, lowercase hex. */
+	FString Sha256;
+
+	/**
+	 * The model llm_manager.py uses, in the plugin's Content/LargeLanguageModels. MinesweeperMind.Model.Url replaces
+	 * where it is downloaded from, the file must still hash the same.
+	 */
+	static FMinesweeperModelAsset GetDefault();
+};
+
+/**
+ * Downloads and verifies model files without holding them in memory.
+ *
+ * A verified file gets a stamp next to it, Path + ".verified.json" with its size, modification time and hash. While
+ * the stamp matches the file, later checks skip hashing. llm_manager.py reads and writes the same stamp. Downloads
+ * stream to Path + ".part" in ranged chunks, so an interrupted download resumes where it stopped. This works with any
+ * HTTP server that honours Range requests, anything else is streamed in one go.
+ *
+ * Everything here blocks and must run off the game thread.
+ */
+class MINESWEEPERMIND_API FMinesweeperModelAssets
+{
+public:
+	/** Lowercase hex SHA-256 of the file, read in blocks. Empty if it cannot be read or bCancelRequested was set. */
+	static FString HashFile(const FString& Path, const std::atomic<bool>* bCancelRequested = nullptr);
+
+	static FString GetStampPath(const FString& ModelPath);
+
+	/** Whether the stamp says the file at Asset.Path, as it is now, hashes to Asset.Sha256. Does not read the model. */
+	static bool HasValidStamp(const FMinesweeperModelAsset& Asset);
+
+	/** Hashes Asset.Path and stamps it if it matches. */
+	static bool Verify(const FMinesweeperModelAsset& Asset, FString& OutError);
+
+	/** Downloads Asset.Url, resuming a previous partial download, verifies it and moves it to Asset.Path. */
+	static bool Download(const FMinesweeperModelAsset& Asset, FString& OutError);
+
+	/** Makes sure a verified copy of Asset is on disk: checks the stamp, else hashes the file, else downloads it. */
+	static bool Ensure(const FMinesweeperModelAsset& Asset, FString& OutError);
+};
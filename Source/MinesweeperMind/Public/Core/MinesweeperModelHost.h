@@ -0,0 +1,71 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Containers/Ticker.h"
+#include "HAL/CriticalSection.h"
+#include <atomic>
+
+class FJsonObject;
+
+struct FMinesweeperModelStats
+{
+	/** As of the last answer from the worker, a request may have loaded the model since. */
+	bool bLoaded = false;
+	/** How long the last load took inside the worker. */
+	double LoadSeconds = 0.0;
+	/** Resident size of the worker process, 0 when the worker cannot tell. */
+	int64 ResidentBytes = 0;
+	int32 NumWarmups = 0;
+	int32 NumEvictions = 0;
+};
+
+/**
+ * Decides when the inference worker's model is loaded, so neither editor startup nor the first chat message pays for
+ * it. The module starts the host once the editor is up. Nothing is loaded at startup. The model is warmed up in the
+ * background when the Minesweeper Mind window opens or once the editor has been idle for
+ * MinesweeperMind.Model.IdleWarmupSeconds. It is evicted again when free physical memory drops below
+ * MinesweeperMind.Model.MinFreeMemoryMB.
+ *
+ * The worker shares one model between all of its callers, see model_host.py. A request that arrives before warmup
+ * simply loads it itself.
+ */
+class MINESWEEPERMIND_API FMinesweeperModelHost : public TSharedFromThis<FMinesweeperModelHost, ESPMode::ThreadSafe>
+{
+public:
+	/** Called by the module. */
+	static void Startup();
+	static void Shutdown();
+
+	/** Null before Startup and in commandlets, which have no use for a warm model. */
+	static TSharedPtr<FMinesweeperModelHost, ESPMode::ThreadSafe> Get();
+
+	/** Loads the model on a background thread unless it is loaded, loading or memory is short. */
+	void RequestWarmup();
+
+	/** Releases the model on a background thread, the worker keeps running. */
+	void Evict();
+
+	/** Asks the worker for its current numbers and logs them. */
+	void RefreshStats();
+
+	FMinesweeperModelStats GetStats() const;
+
+private:
+	/** Game thread, checks for idle time and memory pressure. */
+	bool Tick(float DeltaTime);
+
+	/** Runs Method on the worker in the background, at most one at a time. False if one is already running. */
+	bool RunInBackground(const FString& Method);
+	void ApplyStats(const FString& Method, const TSharedPtr<FJsonObject>& Result);
+
+	static bool IsMemoryLow();
+
+	FTSTicker::FDelegateHandle TickerHandle;
+	double StartTime = 0.0;
+	double LastEvictionTime = -MAX_dbl;
+	bool bIdleWarmupDone = false;
+	std::atomic<bool> bBusy = false;
+
+	mutable FCriticalSection StatsMutex;
+	FMinesweeperModelStats Stats;
+};
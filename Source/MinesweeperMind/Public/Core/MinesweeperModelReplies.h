@@ -0,0 +1,44 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Core/MinesweeperMove.h"
+
+class FJsonObject;
+
+/**
+ * generate_dimensions reply, {"rows":16,"columns":30,"mines":99}. The worker holds the model to that shape with the
+ * "dimensions" grammar in Content/Scripts/reply_grammars.py.
+ */
+struct MINESWEEPERMIND_API FMinesweeperDimensionReply
+{
+	/** Largest count the grammar writes, five digits. Every count is at least 1. */
+	static constexpr int32 MaxCount = 99999;
+
+	int32 Rows = 0;
+	int32 Columns = 0;
+	int64 Mines = 0;
+
+	/** Reads the JSON text of a reply. False unless it is an object of just the three counts, each in range. */
+	static bool Parse(const FString& Json, FMinesweeperDimensionReply& OutReply);
+
+	/** Reads the "text" field of a worker result. */
+	static bool ParseResult(const TSharedPtr<FJsonObject>& Result, FMinesweeperDimensionReply& OutReply);
+};
+
+/** agent_move reply, {"action":"reveal","row":3,"column":4}, held to the "move" grammar. */
+struct MINESWEEPERMIND_API FMinesweeperMoveReply
+{
+	/** Largest row or column the grammar writes, four digits. */
+	static constexpr int32 MaxIndex = 9999;
+
+	FMinesweeperMove Move;
+
+	/** Reads the JSON text of a reply. False unless it is an object of just a known action and two indices in range. */
+	static bool Parse(const FString& Json, FMinesweeperMoveReply& OutReply);
+
+	/** Reads the "text" field of a worker result. */
+	static bool ParseResult(const TSharedPtr<FJsonObject>& Result, FMinesweeperMoveReply& OutReply);
+
+	/** The JSON the model answers with for Move, so transcripts quote the agent the way it speaks. */
+	static FString ToJson(const FMinesweeperMove& Move);
+};
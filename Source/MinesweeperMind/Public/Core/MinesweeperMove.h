@@ -0,0 +1,26 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+enum class EMinesweeperMoveType : uint8
+{
+	Reveal,
+	Flag,
+	/** Reveals every unflagged neighbour of a revealed number whose flags already match it. */
+	Chord
+};
+
+/** One player action, the unit agents, simulations and replays exchange. */
+struct FMinesweeperMove
+{
+	FIntPoint Cell = FIntPoint(INDEX_NONE, INDEX_NONE);
+	EMinesweeperMoveType Type = EMinesweeperMoveType::Reveal;
+
+	FMinesweeperMove() = default;
+	FMinesweeperMove(const FIntPoint& InCell, EMinesweeperMoveType InType)
+		: Cell(InCell)
+		, Type(InType)
+	{}
+
+	bool IsValid() const { return Cell.X != INDEX_NONE; }
+};
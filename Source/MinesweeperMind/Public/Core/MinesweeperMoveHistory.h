@@ -0,0 +1,80 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Core/IMinesweeperBoard.h"
+
+class FMinesweeperBoard;
+
+/**
+ * Undo and redo for a dense board, kept as a log of what each step changed rather than copies of the board.
+ *
+ * A step is one Apply, a single move or a batch. Its moves and the cells it revealed, flagged or unflagged are stored
+ * as ranges of two contiguous arenas, cells as row major indices, so undoing a flood fill that opened 100k cells
+ * touches those 100k cells and nothing else. Redo plays the step's moves again, which repeats it exactly now that
+ * the mines are placed. Applying after an undo drops the steps that could have been redone.
+ */
+class MINESWEEPERMIND_API FMinesweeperMoveHistory
+{
+public:
+	/** Forgets every step and binds the history to a board, which must only change through Apply from now on. */
+	void Reset(FMinesweeperBoard& InBoard);
+
+	/** Applies Moves as one step. Steps that change nothing aren't recorded and keep the redo steps. */
+	const FMinesweeperChangeSet& Apply(TArrayView<const FMinesweeperMove> Moves);
+	const FMinesweeperChangeSet& Apply(const FMinesweeperMove& Move) { return Apply(MakeArrayView(&Move, 1)); }
+
+	/** Takes back the most recent step. False if there is none. */
+	bool Undo();
+
+	/** Applies the most recently undone step again. False if there is none. */
+	bool Redo();
+
+	bool CanUndo() const { return NumApplied > 0; }
+	bool CanRedo() const { return NumApplied < Steps.Num(); }
+
+	/** Steps currently applied, the rest can be redone. */
+	int32 GetNumApplied() const { return NumApplied; }
+	int32 GetNumSteps() const { return Steps.Num(); }
+
+	/** What the last Apply, Undo or Redo changed, for redrawing. An undo reports the cells it hid again as Revealed. */
+	const FMinesweeperChangeSet& GetLastChanges() const { return Changes; }
+
+	/** Moves of the applied steps in order, what a snapshot of the current position records. */
+	TArrayView<const FMinesweeperMove> GetAppliedMoves() const;
+
+	/**
+	 * Saves the board's setup and the applied moves as a snapshot, which FMinesweeperSnapshotFile maps back and replays
+	 * to this position. The setup records the mines as placed, an undone first reveal doesn't move them.
+	 */
+	bool SaveSnapshot(const FString& Path, bool bWithMineLayout = false) const;
+
+	/** Bytes held by the step table and both arenas. */
+	SIZE_T GetAllocatedSize() const;
+
+private:
+	struct FStep
+	{
+		int32 FirstMove = 0;
+		int32 NumMoves = 0;
+		int32 FirstCell = 0;
+		int32 NumRevealed = 0;
+		int32 NumFlagged = 0;
+		int32 NumUnflagged = 0;
+	};
+
+	/** Appends Points to the cell arena as indices. */
+	void AppendCells(TArrayView<const FIntPoint> Points);
+
+	FMinesweeperBoard* Board = nullptr;
+
+	TArray<FStep> Steps;
+	int32 NumApplied = 0;
+
+	/** Every step's moves, back to back. */
+	TArray<FMinesweeperMove> MoveArena;
+
+	/** Every step's revealed, flagged and unflagged cells, back to back in that order. */
+	TArray<int32> CellArena;
+
+	FMinesweeperChangeSet Changes;
+};
@@ -0,0 +1,40 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+struct FMinesweeperNoGuessSettings
+{
+	/** Wall time to spend searching before giving up. */
+	double TimeBudgetSeconds = 1.0;
+	/** Hard cap on candidates, 0 for no cap. */
+	int32 MaxAttempts = 0;
+	/** Candidates checked per parallel round, 0 for one per core. */
+	int32 BatchSize = 0;
+};
+
+struct FMinesweeperNoGuessResult
+{
+	/** False if the budget ran out first, Seed is then the last candidate tried. */
+	bool bFound = false;
+	/** Pass to PlaceMines together with the first click to rebuild the board. */
+	uint64 Seed = 0;
+	int32 NumAttempts = 0;
+	double ElapsedSeconds = 0.0;
+};
+
+/**
+ * Searches for boards that can be won from the first click without guessing.
+ *
+ * Mine placement is a pure function of seed and first click, so candidates are just seeds. Each round checks a batch
+ * of them in parallel by playing the board with FMinesweeperSolver, and the lowest-numbered candidate that the solver
+ * clears wins, which keeps the result independent of thread timing.
+ */
+class MINESWEEPERMIND_API FMinesweeperNoGuessGenerator
+{
+public:
+	static FMinesweeperNoGuessResult Generate(int32 NumRows, int32 NumColumns, int64 NumMines, const FIntPoint& FirstClick,
+		uint64 BaseSeed, const FMinesweeperNoGuessSettings& Settings = FMinesweeperNoGuessSettings());
+
+	/** Plays the board from FirstClick with solver moves only and returns whether that wins. */
+	static bool IsSolvableWithoutGuessing(int32 NumRows, int32 NumColumns, int64 NumMines, const FIntPoint& FirstClick, uint64 Seed);
+};
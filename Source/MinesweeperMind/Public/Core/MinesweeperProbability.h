@@ -0,0 +1,80 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+class IMinesweeperBoard;
+class FMinesweeperSolver;
+
+struct FMinesweeperProbabilitySettings
+{
+	/** Components with more cells than this skip exact enumeration and are sampled straight away. */
+	int32 MaxExactComponentSize = 256;
+	/**
+	 * Wall time for exact enumeration. Components still enumerating when it runs out switch to sampling, which may take
+	 * half as long again, so a calculation ends within one and a half budgets.
+	 */
+	double TimeBudgetSeconds = 0.010;
+	/** Upper bound on sampling steps per component, reached first on small boards. */
+	int32 MaxSampleSteps = 200000;
+	/** Seed of the sampling streams, so repeated calls on the same position agree. */
+	uint64 Seed = 0;
+};
+
+/** Mine probability of every hidden cell of a board at one point in time. */
+class MINESWEEPERMIND_API FMinesweeperProbabilityResult
+{
+public:
+	/** Probability in [0, 1] that a hidden cell is a mine. Meaningless for revealed cells. */
+	float GetMineProbability(int32 Row, int32 Column) const
+	{
+		const float* Probability = CellProbabilities.Find(FIntPoint(Row, Column));
+		return Probability ? *Probability : InteriorProbability;
+	}
+
+	/** Frontier and solver-known cells. Every other hidden cell has the interior probability. */
+	const TMap<FIntPoint, float>& GetCellProbabilities() const { return CellProbabilities; }
+	float GetInteriorProbability() const { return InteriorProbability; }
+
+	/** Hidden cell with the lowest mine probability, preferring frontier cells on ties. (INDEX_NONE, INDEX_NONE) if none. */
+	FIntPoint GetSafestCell() const { return SafestCell; }
+
+	/** False if any component was sampled instead of enumerated. */
+	bool IsExact() const { return bExact; }
+	int32 GetNumComponents() const { return NumComponents; }
+	int32 GetNumSampledComponents() const { return NumSampledComponents; }
+	double GetElapsedSeconds() const { return ElapsedSeconds; }
+
+private:
+	friend class FMinesweeperProbability;
+
+	TMap<FIntPoint, float> CellProbabilities;
+	float InteriorProbability = 0.f;
+	FIntPoint SafestCell = FIntPoint(INDEX_NONE, INDEX_NONE);
+
+	bool bExact = true;
+	int32 NumComponents = 0;
+	int32 NumSampledComponents = 0;
+	double ElapsedSeconds = 0.0;
+};
+
+/**
+ * Mine probabilities for positions the deterministic solver can't crack.
+ *
+ * The frontier (hidden cells next to a revealed number) is split into components that share no constraint. Each
+ * component is enumerated independently with backtracking, in parallel, counting its solutions per number of mines.
+ * The per-component counts are then combined under the global mine count, weighting every total by the number of ways
+ * to place the rest of the mines in the interior cells. Binomials are evaluated in log space so large boards don't
+ * overflow. Components too large to enumerate within the time budget are estimated with a constraint-preserving
+ * random walk instead.
+ */
+class MINESWEEPERMIND_API FMinesweeperProbability
+{
+public:
+	/**
+	 * Scans the whole board. If a solver is given, its known mines and safe cells are taken as fixed, which shrinks
+	 * the frontier considerably after a few solver passes.
+	 */
+	static TSharedRef<const FMinesweeperProbabilityResult> Calculate(const IMinesweeperBoard& Board,
+		const FMinesweeperSolver* Solver = nullptr,
+		const FMinesweeperProbabilitySettings& Settings = FMinesweeperProbabilitySettings());
+};
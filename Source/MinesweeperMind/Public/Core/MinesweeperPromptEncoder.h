@@ -0,0 +1,83 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Core/MinesweeperMove.h"
+
+class IMinesweeperBoard;
+
+/** Estimated token counts of one game's prompts, see FMinesweeperPromptEncoder::EstimateTokens. */
+struct FMinesweeperPromptStats
+{
+	int32 NumMoves = 0;
+	/** Times the transcript outgrew the budget and was started over from the current frontier. */
+	int32 NumRebaselines = 0;
+	/** Size of the prompt as it stands. */
+	int32 PromptTokens = 0;
+	/** Tokens added to the transcript, all the model has to evaluate when it keeps the rest cached. */
+	int64 AppendedTokens = 0;
+	/** Sum of every prompt sent, what the model evaluates when nothing is cached. */
+	int64 SentTokens = 0;
+
+	double GetAppendedTokensPerMove() const { return NumMoves > 0 ? double(AppendedTokens) / NumMoves : 0.0; }
+	double GetSentTokensPerMove() const { return NumMoves > 0 ? double(SentTokens) / NumMoves : 0.0; }
+};
+
+/**
+ * Builds the agent's prompt from the frontier only: revealed numbers that still border hidden cells, and flags.
+ * Everything else is either hidden or settled and costs no tokens. The frontier is written one row per line as runs,
+ * "3: 4=12F 9=1" is 3,4=1 3,5=2 3,6=F 3,9=1.
+ *
+ * The prompt is a chat transcript that only ever grows. The system text and the frontier at the start never change,
+ * each move appends the agent's answer and a diff of the frontier entries it added ("+row,column=n") and removed
+ * ("-row,column"). llama.cpp keeps the evaluated prefix cached, so a move costs the model its diff rather than the
+ * whole board. When the transcript would outgrow TokenBudget it is started over from the current frontier once.
+ *
+ * The transcript uses the Zephyr chat markup the worker's chat prompt uses. The agent's turns are quoted as the JSON the
+ * "move" grammar makes it answer with, see FMinesweeperMoveReply, so they match the tokens it generated.
+ */
+class MINESWEEPERMIND_API FMinesweeperPromptEncoder
+{
+public:
+	/** Leaves room for the answer in the model's 2048 token context. */
+	static constexpr int32 DefaultTokenBudget = 1536;
+
+	explicit FMinesweeperPromptEncoder(int32 InTokenBudget = DefaultTokenBudget);
+
+	/** Starts a transcript for the board as it is now, usually before the first move. */
+	void BeginGame(const IMinesweeperBoard& Board);
+
+	/** Appends Move and the frontier changes it caused. RevealedCells is what ApplyMove reported. */
+	void AddMove(const IMinesweeperBoard& Board, const FMinesweeperMove& Move, TArrayView<const FIntPoint> RevealedCells);
+
+	/** Transcript plus the opening of the agent's turn, ready to send. Every later prompt starts with this one. */
+	FString GetPrompt() const;
+
+	const FMinesweeperPromptStats& GetStats() const { return Stats; }
+
+	/**
+	 * Approximate Llama tokenizer count: every digit and punctuation mark is a token, as is every run of letters.
+	 * Enough to budget the transcript and compare encodings, the worker reports exact counts.
+	 */
+	static int32 EstimateTokens(FStringView Text);
+
+	/** Whole board as one character per cell, the naive encoding, kept for comparison. */
+	static FString EncodeGrid(const IMinesweeperBoard& Board);
+
+private:
+	/** Frontier entry of a cell: its number, FlagEntry, or NoEntry when the cell is not on the frontier. */
+	static uint8 GetEntry(const IMinesweeperBoard& Board, int32 Row, int32 Column);
+	static void AppendEntry(FString& Out, const FIntPoint& Cell, uint8 Entry);
+
+	/** System text and the full frontier, the start of a transcript. */
+	void Rebaseline(const IMinesweeperBoard& Board);
+	void Append(const FString& Text);
+
+	static constexpr uint8 NoEntry = 0xFF;
+	static constexpr uint8 FlagEntry = 0xFE;
+
+	int32 TokenBudget;
+	FString Transcript;
+	/** Frontier as the transcript last described it. */
+	TMap<FIntPoint, uint8> Frontier;
+	FMinesweeperPromptStats Stats;
+};
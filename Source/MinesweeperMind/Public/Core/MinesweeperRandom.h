@@ -0,0 +1,68 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+ * PCG32 random stream (O'Neill, pcg-random.org).
+ * Small, fast and fully determined by its seed and stream id, so every board can own one and boards generated
+ * on different threads never share state.
+ */
+class FMinesweeperRandom
+{
+public:
+	explicit FMinesweeperRandom(uint64 Seed, uint64 StreamId = 0)
+		: State(0)
+		, Increment((StreamId << 1u) | 1u)
+	{
+		NextUInt32();
+		State += Seed;
+		NextUInt32();
+	}
+
+	FORCEINLINE uint32 NextUInt32()
+	{
+		const uint64 OldState = State;
+		State = OldState * 6364136223846793005ull + Increment;
+
+		const uint32 XorShifted = static_cast<uint32>(((OldState >> 18u) ^ OldState) >> 27u);
+		const uint32 Rotation = static_cast<uint32>(OldState >> 59u);
+		return (XorShifted >> Rotation) | (XorShifted << ((0u - Rotation) & 31u));
+	}
+
+	/** Uniform value in [0, Bound) without modulo bias. */
+	FORCEINLINE uint32 NextBounded(uint32 Bound)
+	{
+		checkSlow(Bound > 0);
+		const uint32 Threshold = (0u - Bound) % Bound;
+		for (;;)
+		{
+			const uint32 Value = NextUInt32();
+			if (Value >= Threshold)
+			{
+				return Value % Bound;
+			}
+		}
+	}
+
+	/** Uniform value in [0, 1). */
+	FORCEINLINE double NextFraction()
+	{
+		return NextUInt32() * (1.0 / 4294967296.0);
+	}
+
+	/**
+	 * Seed number Index of a family derived from BaseSeed, one SplitMix64 step (Steele et al.) so consecutive indices
+	 * spread over the whole seed space. No-guess candidates and simulated games are numbered this way.
+	 */
+	static FORCEINLINE uint64 MixSeed(uint64 BaseSeed, int64 Index)
+	{
+		uint64 Value = BaseSeed + (uint64(Index) + 1) * 0x9E3779B97F4A7C15ull;
+		Value = (Value ^ (Value >> 30)) * 0xBF58476D1CE4E5B9ull;
+		Value = (Value ^ (Value >> 27)) * 0x94D049BB133111EBull;
+		return Value ^ (Value >> 31);
+	}
+
+private:
+	uint64 State;
+	uint64 Increment;
+};
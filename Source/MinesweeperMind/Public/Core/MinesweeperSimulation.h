@@ -0,0 +1,91 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Core/MinesweeperMove.h"
+#include "Templates/Function.h"
+
+class IMinesweeperBoard;
+
+/**
+ * Decides the moves of one simulated game. A policy instance only ever plays one game at a time and is never shared
+ * between threads, so it may keep whatever incremental state it likes.
+ */
+class MINESWEEPERMIND_API IMinesweeperMovePolicy
+{
+public:
+	virtual ~IMinesweeperMovePolicy() = default;
+
+	/** Called once the board is initialized, before the first move. */
+	virtual void BeginGame(const IMinesweeperBoard& Board) {}
+
+	/** Next move for the board. An invalid move ends the game as a loss. */
+	virtual FMinesweeperMove ChooseMove(const IMinesweeperBoard& Board) = 0;
+
+	/** Called after each applied move with the cells it revealed. */
+	virtual void OnMoveApplied(const FMinesweeperMove& Move, TArrayView<const FIntPoint> RevealedCells) {}
+};
+
+using FMinesweeperMovePolicyFactory = TFunction<TUniquePtr<IMinesweeperMovePolicy>(uint64 /*GameSeed*/)>;
+
+struct FMinesweeperSimulationSettings
+{
+	int32 NumGames = 1000;
+	int32 NumRows = 16;
+	int32 NumColumns = 30;
+	float MineDensity = 0.20625f;
+	uint64 BaseSeed = 1;
+	/** Generate boards that can be cleared without guessing, see FMinesweeperNoGuessGenerator. */
+	bool bNoGuess = false;
+	/** Safety net against policies that never finish a game. */
+	int32 MaxMovesPerGame = 100000;
+	/** Run games on worker threads. Off gives clean single-core numbers. */
+	bool bParallel = true;
+	/** When set, every lost game is written here as a snapshot, see FMinesweeperSnapshot. */
+	FString FailureSnapshotDir;
+	/**
+	 * Lifts the wall-clock budgets of guesses and no-guess searches, so a seed plays the same games on any machine.
+	 * Meant for tests on small boards, a guess without a budget can take far longer.
+	 */
+	bool bDeterministic = false;
+};
+
+struct FMinesweeperSimulationReport
+{
+	FString PolicyName;
+	FMinesweeperSimulationSettings Settings;
+
+	int32 NumGames = 0;
+	int32 NumWins = 0;
+	/** No-guess games the generator found no guess-free board for in time. They are played anyway and may need a guess. */
+	int32 NumNoGuessFailures = 0;
+	int64 NumMoves = 0;
+	double ElapsedSeconds = 0.0;
+
+	double GamesPerSecond = 0.0;
+	double MovesPerSecond = 0.0;
+	/** Time per move including the policy's decision, in microseconds. */
+	double MoveMicrosecondsP50 = 0.0;
+	double MoveMicrosecondsP99 = 0.0;
+	uint64 PeakUsedPhysicalBytes = 0;
+
+	double GetWinRate() const { return NumGames > 0 ? double(NumWins) / NumGames : 0.0; }
+
+	/** Flat JSON object with every field, stable enough to diff between builds. */
+	FString ToJson() const;
+};
+
+/** Plays many seeded games without any UI, spread over worker threads, and measures the loop. */
+class MINESWEEPERMIND_API FMinesweeperSimulation
+{
+public:
+	static FMinesweeperSimulationReport Run(const FMinesweeperSimulationSettings& Settings, const FString& PolicyName, const FMinesweeperMovePolicyFactory& PolicyFactory);
+
+	/**
+	 * Built-in policies: "Solver" (deductions, then the lowest mine probability), "Random" and "Agent" (the model through
+	 * the inference worker). Null for unknown names. See FMinesweeperSimulationSettings::bDeterministic.
+	 */
+	static TUniquePtr<IMinesweeperMovePolicy> CreatePolicy(const FString& PolicyName, uint64 GameSeed, bool bDeterministic = false);
+
+	/** Candidates a deterministic no-guess search tries before settling for a board that may need a guess. */
+	static constexpr int32 DeterministicNoGuessMaxAttempts = 1000;
+};
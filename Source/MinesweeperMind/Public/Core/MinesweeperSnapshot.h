@@ -0,0 +1,109 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Core/MinesweeperMove.h"
+#include "Templates/Function.h"
+
+class IMappedFileHandle;
+class IMappedFileRegion;
+class IMinesweeperBoard;
+class FMinesweeperBoard;
+
+enum class EMinesweeperBoardKind : uint8
+{
+	/** FMinesweeperBoard. */
+	Dense,
+	/** FMinesweeperChunkedBoard, which lays its mines out differently for the same seed. */
+	Chunked,
+};
+
+/** Everything needed to rebuild a board as it was before its first move. */
+struct FMinesweeperGameSetup
+{
+	EMinesweeperBoardKind BoardKind = EMinesweeperBoardKind::Dense;
+	int32 NumRows = 0;
+	int32 NumColumns = 0;
+	/** As passed to Initialize, a board may end up with fewer once it keeps its opening clear. */
+	int64 NumMines = 0;
+	uint64 Seed = 0;
+	/** Mines were placed around SafeCell before the first move, otherwise the first reveal placed them. */
+	bool bMinesPlaced = false;
+	FIntPoint SafeCell = FIntPoint(INDEX_NONE, INDEX_NONE);
+
+	/** Empty board of the right kind with its mines placed or deferred like the original. */
+	TUniquePtr<IMinesweeperBoard> CreateBoard() const;
+};
+
+/**
+ * Versioned binary file for a whole game, small enough to attach to a bug report and exact enough to replay.
+ *
+ * Layout, little-endian:
+ *   header      56 bytes: magic "MSGS", version, board kind, flags, the FMinesweeperGameSetup fields, move count and
+ *               move log size
+ *   mine bits   optional, one bit per cell, row major, least significant bit first
+ *   move log    one varint per move: zigzag delta of the cell index to the previous move, shifted left by two, with
+ *               the move type in the low two bits
+ *
+ * Mine placement is a pure function of seed and opening, so normally the seed is all that is stored. Embedding the
+ * mine bits keeps a snapshot valid even if the placement algorithm ever changes, at one bit per cell. Bump Version
+ * whenever either changes meaning.
+ */
+class MINESWEEPERMIND_API FMinesweeperSnapshot
+{
+public:
+	static constexpr uint16 Version = 1;
+
+	/** Serializes a game. Pass MineLayoutBoard, a dense board with the game's mines, to embed the mine bits. */
+	static void Write(const FMinesweeperGameSetup& Setup, TArrayView<const FMinesweeperMove> Moves, TArray<uint8>& OutData,
+		const FMinesweeperBoard* MineLayoutBoard = nullptr);
+
+	static bool WriteToFile(const FString& Path, const FMinesweeperGameSetup& Setup, TArrayView<const FMinesweeperMove> Moves,
+		const FMinesweeperBoard* MineLayoutBoard = nullptr);
+};
+
+/**
+ * Reads a snapshot in place. Nothing is copied, moves are decoded as they are visited and mine bits are read straight
+ * from the data, so the view is only valid while the data is.
+ */
+class MINESWEEPERMIND_API FMinesweeperSnapshotView
+{
+public:
+	/** Checks the header and walks the move log once. On failure OutError says why and the view stays empty. */
+	bool Initialize(TArrayView<const uint8> InData, FString& OutError);
+
+	const FMinesweeperGameSetup& GetSetup() const { return Setup; }
+	int32 GetNumMoves() const { return NumMoves; }
+	bool HasMineLayout() const { return !MineBits.IsEmpty(); }
+
+	/** Calls Visitor for each move in order until it returns false. */
+	void ForEachMove(TFunctionRef<bool(const FMinesweeperMove& /*Move*/)> Visitor) const;
+
+	/** Board after the first NumMovesToApply moves, all of them by default. Null if the snapshot is empty. */
+	TUniquePtr<IMinesweeperBoard> Replay(int32 NumMovesToApply = MAX_int32) const;
+
+private:
+	FMinesweeperGameSetup Setup;
+	TArrayView<const uint8> MineBits;
+	TArrayView<const uint8> MoveLog;
+	int32 NumMoves = 0;
+};
+
+/** A snapshot file, memory-mapped where the platform allows and read into memory otherwise. */
+class MINESWEEPERMIND_API FMinesweeperSnapshotFile
+{
+public:
+	~FMinesweeperSnapshotFile();
+
+	static TUniquePtr<FMinesweeperSnapshotFile> Open(const FString& Path, FString& OutError);
+
+	const FMinesweeperSnapshotView& GetView() const { return View; }
+	bool IsMapped() const { return MappedRegion.IsValid(); }
+
+private:
+	FMinesweeperSnapshotFile() = default;
+
+	TUniquePtr<IMappedFileHandle> MappedFile;
+	TUniquePtr<IMappedFileRegion> MappedRegion;
+	TArray<uint8> LoadedData;
+	FMinesweeperSnapshotView View;
+};
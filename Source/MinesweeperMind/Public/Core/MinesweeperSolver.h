@@ -0,0 +1,75 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+class IMinesweeperBoard;
+
+/**
+ * Deterministic solver over the visible state of a board.
+ *
+ * Every revealed number is a constraint "this many mines among my hidden neighbours". The solver applies the
+ * single-cell rules (no mines left, or as many mines as hidden cells) and the subset/superset rule between two
+ * overlapping constraints, and keeps going until nothing changes. A work queue holds only the constraints whose
+ * neighbourhood changed, so feeding it the cells of one reveal costs about as much as that reveal.
+ *
+ * Only revealed cells are read. Player flags are ignored, the solver keeps its own set of deduced mines.
+ */
+class MINESWEEPERMIND_API FMinesweeperSolver
+{
+public:
+	/** Forgets all knowledge and binds the solver to a board. Does not read any cells. */
+	void Reset(const IMinesweeperBoard& InBoard);
+
+	/** Reset and queue every revealed cell of the board. Cost is proportional to the board size. */
+	void ScanBoard(const IMinesweeperBoard& InBoard);
+
+	/** Queues the constraints affected by cells revealed since the last call, e.g. the batch returned by a reveal. */
+	void AddRevealedCells(TArrayView<const FIntPoint> RevealedCells);
+
+	/** Runs the rules until no queued constraint yields anything new. Returns true if any cell was deduced. */
+	bool Solve();
+
+	/** Deduced safe cells that are still hidden, in the order they were found. */
+	const TArray<FIntPoint>& GetSafeCells() const { return SafeCells; }
+	/** Every deduced mine. */
+	const TArray<FIntPoint>& GetMineCells() const { return MineCells; }
+
+	bool IsKnownSafe(int32 Row, int32 Column) const;
+	bool IsKnownMine(int32 Row, int32 Column) const;
+
+	/** Constraints examined by the most recent Solve, for profiling. */
+	int32 GetNumConstraintsVisited() const { return NumConstraintsVisited; }
+
+private:
+	static constexpr int32 TileShift = 6;
+	static constexpr int32 TileMask = (1 << TileShift) - 1;
+
+	/** Unknown neighbours of a constraint cell as bits of a 7x7 window around Origin, plus the mines still missing among them. */
+	struct FConstraint
+	{
+		uint64 UnknownMask = 0;
+		int32 RemainingMines = 0;
+	};
+
+	bool ReadConstraint(const FIntPoint& Cell, const FIntPoint& Origin, FConstraint& OutConstraint) const;
+	bool ApplyRules(const FIntPoint& Cell);
+	void MarkCells(const FIntPoint& Origin, uint64 Mask, bool bMines);
+	void QueueConstraintsAround(const FIntPoint& Cell);
+	void QueueConstraint(const FIntPoint& Cell);
+
+	/** Knowledge bits per cell, stored in 64x64 tiles created on first write so huge boards stay sparse. */
+	uint8 GetKnowledge(int32 Row, int32 Column) const;
+	uint8& GetMutableKnowledge(int32 Row, int32 Column);
+
+	const IMinesweeperBoard* Board = nullptr;
+
+	TMap<uint64, TArray<uint8>> KnowledgeTiles;
+	uint64 CachedTileKey = MAX_uint64;
+	uint8* CachedTile = nullptr;
+
+	TArray<FIntPoint> WorkQueue;
+	TArray<FIntPoint> SafeCells;
+	TArray<FIntPoint> MineCells;
+
+	int32 NumConstraintsVisited = 0;
+};